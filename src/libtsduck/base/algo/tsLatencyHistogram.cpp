@@ -0,0 +1,179 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsLatencyHistogram.h"
+
+constexpr size_t ts::LatencyHistogram::LINEAR_BUCKETS;
+constexpr size_t ts::LatencyHistogram::SUB_BUCKETS;
+constexpr size_t ts::LatencyHistogram::BUCKET_COUNT;
+
+
+//----------------------------------------------------------------------------
+// Constructor and reset.
+//----------------------------------------------------------------------------
+
+ts::LatencyHistogram::LatencyHistogram() :
+    _count(0),
+    _sum(0),
+    _min(0),
+    _max(0),
+    _buckets()
+{
+}
+
+void ts::LatencyHistogram::reset()
+{
+    _count = _sum = _min = _max = 0;
+    std::fill(std::begin(_buckets), std::end(_buckets), 0);
+}
+
+
+//----------------------------------------------------------------------------
+// Index of the bucket for a value and upper bound of a bucket.
+//----------------------------------------------------------------------------
+
+size_t ts::LatencyHistogram::BucketIndex(uint64_t value)
+{
+    if (value < LINEAR_BUCKETS) {
+        return size_t(value);
+    }
+
+    // Find the rank of the most significant bit, at least 4 here.
+    size_t msb = 4;
+    for (size_t shift = 32; shift > 0; shift /= 2) {
+        if (msb + shift < 64 && (value >> (msb + shift)) != 0) {
+            msb += shift;
+        }
+    }
+
+    // The 3 bits after the most significant bit select the sub-bucket.
+    return LINEAR_BUCKETS + (msb - 4) * SUB_BUCKETS + size_t((value >> (msb - 3)) & (SUB_BUCKETS - 1));
+}
+
+uint64_t ts::LatencyHistogram::BucketUpperBound(size_t index)
+{
+    if (index < LINEAR_BUCKETS) {
+        return index;
+    }
+    const size_t msb = 4 + (index - LINEAR_BUCKETS) / SUB_BUCKETS;
+    const uint64_t sub = (index - LINEAR_BUCKETS) % SUB_BUCKETS;
+    // Warning: the last bucket overflows 64 bits, saturate it.
+    return msb == 63 && sub == SUB_BUCKETS - 1 ? std::numeric_limits<uint64_t>::max() : ((SUB_BUCKETS + sub + 1) << (msb - 3)) - 1;
+}
+
+
+//----------------------------------------------------------------------------
+// Add values in the histogram.
+//----------------------------------------------------------------------------
+
+void ts::LatencyHistogram::add(NanoSecond value)
+{
+    const uint64_t val = value < 0 ? 0 : uint64_t(value);
+    _buckets[BucketIndex(val)]++;
+    _sum += val;
+    _min = _count == 0 ? val : std::min(_min, val);
+    _max = std::max(_max, val);
+    _count++;
+}
+
+void ts::LatencyHistogram::add(const LatencyHistogram& other)
+{
+    if (other._count > 0) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            _buckets[i] += other._buckets[i];
+        }
+        _sum += other._sum;
+        _min = _count == 0 ? other._min : std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+        _count += other._count;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get a percentile of the values.
+//----------------------------------------------------------------------------
+
+ts::NanoSecond ts::LatencyHistogram::percentile(double percent) const
+{
+    if (_count == 0) {
+        return 0;
+    }
+
+    // Rank of the requested value, from 1 to _count.
+    const double rank = std::max(1.0, std::ceil(double(_count) * std::min(100.0, std::max(0.0, percent)) / 100.0));
+    uint64_t cumulated = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        cumulated += _buckets[i];
+        if (double(cumulated) >= rank) {
+            return NanoSecond(std::min(_max, std::max(_min, BucketUpperBound(i))));
+        }
+    }
+    return NanoSecond(_max);
+}
+
+
+//----------------------------------------------------------------------------
+// Formatting.
+//----------------------------------------------------------------------------
+
+ts::UString ts::LatencyHistogram::DurationString(NanoSecond value)
+{
+    if (value < 10 * NanoSecPerMicroSec) {
+        return UString::Format(u"%d ns", {value});
+    }
+    else if (value < 10 * NanoSecPerMilliSec) {
+        return UString::Format(u"%d us", {value / NanoSecPerMicroSec});
+    }
+    else if (value < 10 * NanoSecPerSec) {
+        return UString::Format(u"%d ms", {value / NanoSecPerMilliSec});
+    }
+    else {
+        return UString::Format(u"%'d s", {value / NanoSecPerSec});
+    }
+}
+
+ts::UString ts::LatencyHistogram::summary() const
+{
+    return UString::Format(u"min: %s, p50: %s, p90: %s, p99: %s, p99.9: %s, max: %s",
+                           {DurationString(minimum()), DurationString(percentile(50.0)), DurationString(percentile(90.0)),
+                            DurationString(percentile(99.0)), DurationString(percentile(99.9)), DurationString(maximum())});
+}
+
+void ts::LatencyHistogram::toJSON(json::Value& obj) const
+{
+    obj.add(u"count", int64_t(_count));
+    obj.add(u"min", minimum());
+    obj.add(u"mean", mean());
+    obj.add(u"p50", percentile(50.0));
+    obj.add(u"p90", percentile(90.0));
+    obj.add(u"p99", percentile(99.0));
+    obj.add(u"p999", percentile(99.9));
+    obj.add(u"max", maximum());
+}
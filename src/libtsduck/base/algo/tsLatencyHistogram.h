@@ -0,0 +1,151 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Histogram of durations with logarithmic buckets.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+#include "tsjsonObject.h"
+
+namespace ts {
+    //!
+    //! Histogram of durations in nanoseconds with logarithmic buckets.
+    //! @ingroup cpp
+    //!
+    //! The precision is relative, like in HDR histograms: values below 16 are
+    //! exact, larger values are grouped in 8 buckets per power of 2, giving a
+    //! relative error lower than 12.5% on all percentiles. The memory footprint
+    //! is fixed and adding a value is a constant-time operation without allocation.
+    //!
+    //! This class is not thread-safe. Applications shall use their own synchronization.
+    //!
+    class TSDUCKDLL LatencyHistogram
+    {
+    public:
+        //!
+        //! Constructor.
+        //!
+        LatencyHistogram();
+
+        //!
+        //! Reset the content of the histogram.
+        //!
+        void reset();
+
+        //!
+        //! Add a value in the histogram.
+        //! @param [in] value The value to add. Negative values are counted as zero.
+        //!
+        void add(NanoSecond value);
+
+        //!
+        //! Add all values of another histogram in this one.
+        //! @param [in] other The histogram to merge in this one.
+        //!
+        void add(const LatencyHistogram& other);
+
+        //!
+        //! Get the number of values in the histogram.
+        //! @return The number of values.
+        //!
+        uint64_t count() const { return _count; }
+
+        //!
+        //! Get the minimum value in the histogram.
+        //! @return The minimum value, zero if the histogram is empty.
+        //!
+        NanoSecond minimum() const { return _count == 0 ? 0 : NanoSecond(_min); }
+
+        //!
+        //! Get the maximum value in the histogram.
+        //! @return The maximum value.
+        //!
+        NanoSecond maximum() const { return NanoSecond(_max); }
+
+        //!
+        //! Get the mean value in the histogram.
+        //! @return The mean value, zero if the histogram is empty.
+        //!
+        NanoSecond mean() const { return _count == 0 ? 0 : NanoSecond(_sum / _count); }
+
+        //!
+        //! Get the sum of all values in the histogram.
+        //! @return The sum of all values.
+        //!
+        NanoSecond sum() const { return NanoSecond(_sum); }
+
+        //!
+        //! Get a percentile of the values.
+        //! @param [in] percent The percentile, from 0 to 100.
+        //! @return The upper bound of the bucket which contains the percentile,
+        //! never more than the maximum value.
+        //!
+        NanoSecond percentile(double percent) const;
+
+        //!
+        //! Format a one-line summary of the histogram (min, percentiles, max).
+        //! @return The summary string.
+        //!
+        UString summary() const;
+
+        //!
+        //! Add the content of the histogram in a JSON object.
+        //! The fields are @c count, @c min, @c mean, @c p50, @c p90, @c p99, @c p999
+        //! and @c max. All durations are in nanoseconds.
+        //! @param [in,out] obj The JSON object to update.
+        //!
+        void toJSON(json::Value& obj) const;
+
+        //!
+        //! Format a duration in nanoseconds using the most appropriate unit (ns, us, ms, s).
+        //! @param [in] value A duration in nanoseconds.
+        //! @return The formatted string.
+        //!
+        static UString DurationString(NanoSecond value);
+
+    private:
+        // Values 0 to 15 have one bucket each, then 8 buckets per power of 2 up to 2^63.
+        static constexpr size_t LINEAR_BUCKETS = 16;
+        static constexpr size_t SUB_BUCKETS = 8;
+        static constexpr size_t BUCKET_COUNT = LINEAR_BUCKETS + (64 - 4) * SUB_BUCKETS;
+
+        uint64_t _count;
+        uint64_t _sum;
+        uint64_t _min;
+        uint64_t _max;
+        uint64_t _buckets[BUCKET_COUNT];
+
+        // Index of the bucket for a value and upper bound of a bucket.
+        static size_t BucketIndex(uint64_t value);
+        static uint64_t BucketUpperBound(size_t index);
+    };
+}
@@ -34,6 +34,7 @@
 #include "tsVersionInfo.h"
 #include "tsOutputPager.h"
 #include "tsDuckConfigFile.h"
+#include "tsStartupProfile.h"
 
 // Unlimited number of occurences
 const size_t ts::Args::UNLIMITED_COUNT = std::numeric_limits<size_t>::max();
@@ -996,6 +997,8 @@ bool ts::Args::analyze(int argc, char* argv[], bool processRedirections)
 
 bool ts::Args::analyze(const UString& app_name, const UStringVector& arguments, bool processRedirections)
 {
+    StartupProfile::Phase phase(u"command line analysis");
+
     // Save command line and arguments.
     _app_name = app_name;
     _args = arguments;
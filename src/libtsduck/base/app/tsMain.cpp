@@ -31,6 +31,7 @@
 #include "tsConsoleState.h"
 #include "tsIPUtils.h"
 #include "tsCOM.h"
+#include "tsStartupProfile.h"
 
 
 //----------------------------------------------------------------------------
@@ -42,21 +43,37 @@ int MainWrapper(int (*func)(int argc, char* argv[]), int argc, char* argv[])
     // Save console state, set UTF-8 output, restore state on exit.
     ts::ConsoleState _consoleState;
 
+    // Filter out the startup profile option, which enables the profiling of initialization phases.
+    std::vector<char*> args;
+    args.reserve(size_t(argc) + 1);
+    for (int i = 0; i < argc; ++i) {
+        if (i > 0 && ::strcmp(argv[i], ts::StartupProfile::OPTION) == 0) {
+            ts::StartupProfile::Enable();
+        }
+        else {
+            args.push_back(argv[i]);
+        }
+    }
+    args.push_back(nullptr);
+    ts::StartupProfile::AddPhase(u"static initialization", ts::StartupProfile::SinceStartup());
+
+    int status = EXIT_FAILURE;
     try {
 
 #if defined(TS_WINDOWS)
         // Initialize COM and networking.
         ts::COM com;
-        if (!com.isInitialized() || !ts::IPInitialize()) {
-            return EXIT_FAILURE;
-        }
+        if (com.isInitialized() && ts::IPInitialize())
 #endif
-
-        // Actual application code.
-        return func(argc, argv);
+        {
+            // Actual application code.
+            ts::StartupProfile::Phase phase(u"main function (total)");
+            status = func(int(args.size() - 1), args.data());
+        }
     }
     catch (const std::exception& e) {
         std::cerr << "Program aborted: " << e.what() << std::endl;
-        return EXIT_FAILURE;
+        status = EXIT_FAILURE;
     }
+    return status;
 }
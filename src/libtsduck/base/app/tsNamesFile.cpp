@@ -34,6 +34,13 @@
 #include "tsMutex.h"
 #include "tsGuardMutex.h"
 #include "tsSingletonManager.h"
+#include "tsByteBlock.h"
+#include "tsSysUtils.h"
+#include "tsNullReport.h"
+#include "tsTime.h"
+#include "tsStartupProfile.h"
+#include "tsVersion.h"
+#include <atomic>
 
 
 //----------------------------------------------------------------------------
@@ -42,16 +49,16 @@
 
 namespace {
     struct Predef {
-        const ts::NamesFile* volatile instance;
+        std::atomic<const ts::NamesFile*> instance;
         const ts::UChar* name;
         bool merge;
     };
     Predef PredefData[] = {
-        {nullptr, u"tsduck.dtv.names", true},      // DTV
-        {nullptr, u"tsduck.ip.names", false},      // IP
-        {nullptr, u"tsduck.oui.names", false},     // OUI
-        {nullptr, u"tsduck.dektec.names", false},  // DEKTEC
-        {nullptr, u"tsduck.hides.names", false},   // HIDES
+        {{nullptr}, u"tsduck.dtv.names", true},      // DTV
+        {{nullptr}, u"tsduck.ip.names", false},      // IP
+        {{nullptr}, u"tsduck.oui.names", false},     // OUI
+        {{nullptr}, u"tsduck.dektec.names", false},  // DEKTEC
+        {{nullptr}, u"tsduck.hides.names", false},   // HIDES
     };
     constexpr size_t PredefDataCount = sizeof(PredefData) / sizeof(Predef);
 }
@@ -189,17 +196,19 @@ const ts::NamesFile* ts::NamesFile::Instance(const UString& fileName, bool merge
 const ts::NamesFile* ts::NamesFile::Instance(Predefined index)
 {
     // Using predefined indexes of file names saves string lookup and thread synchronization.
-    // The pointer is initially null and then always holds the same value. Even if the first
-    // two call are simultaneous, the instance field is overwritten with the same value.
+    // The atomic pointer is initially null and then always holds the same value. Even if the
+    // first two call are simultaneous, the instance field is overwritten with the same value.
     if (size_t(index) >= PredefDataCount) {
         CERR.error(u"internal error, invalid predefined .names file index");
         return nullptr; // and the application will likely crash...
     }
     Predef* pr = PredefData + size_t(index);
-    if (pr->instance == nullptr) {
-        pr->instance = AllInstances::Instance()->getFile(pr->name, pr->merge);
+    const NamesFile* instance = pr->instance;
+    if (instance == nullptr) {
+        instance = AllInstances::Instance()->getFile(pr->name, pr->merge);
+        pr->instance = instance;
     }
-    return pr->instance;
+    return instance;
 }
 
 void ts::NamesFile::DeleteInstance(Predefined index)
@@ -235,15 +244,22 @@ ts::NamesFile::NamesFile(const UString& fileName, bool mergeExtensions) :
     _log(CERR),
     _configFile(SearchConfigurationFile(fileName)),
     _configErrors(0),
+    _fromCache(false),
+    _names(),
     _sections()
 {
+    StartupProfile::Phase phase(u"names files loading");
+
+    // List of text files to load.
+    std::vector<SourceFile> sources;
+
     // Locate the configuration file.
     if (_configFile.empty()) {
         // Cannot load configuration, names will not be available.
         _log.error(u"configuration file '%s' not found", {fileName});
     }
     else {
-        loadFile(_configFile);
+        sources.push_back(SourceFile(_configFile));
     }
 
     // Merge extensions if required.
@@ -257,10 +273,29 @@ ts::NamesFile::NamesFile(const UString& fileName, bool mergeExtensions) :
                 _log.error(u"extension file '%s' not found", {name});
             }
             else {
-                loadFile(path);
+                sources.push_back(SourceFile(path));
             }
         }
     }
+
+    // Try to load the binary cache of the same set of files.
+    const UString cache(sources.empty() ? UString() : CacheFileName(sources));
+    if (!cache.empty() && loadCache(cache, sources)) {
+        _fromCache = true;
+        _log.debug(u"loaded names cache %s", {cache});
+        return;
+    }
+
+    // Parse all text files.
+    for (const auto& src : sources) {
+        loadFile(src.path);
+    }
+    sortEntries();
+
+    // Save a binary cache for the next time, only when the text files are error-free.
+    if (!cache.empty() && _configErrors == 0) {
+        saveCache(cache, sources);
+    }
 }
 
 
@@ -371,10 +406,11 @@ bool ts::NamesFile::decodeDefinition(const UString& line, ConfigSection* section
         valid = range.substr(0, dash).toInteger(first, ignore, 0, UString()) && range.substr(dash + 1).toInteger(last, ignore, 0, UString()) && last >= first;
     }
 
-    // Add the definition.
+    // Add the definition. The name is appended to the pool of names.
     if (valid) {
         if (section->freeRange(first, last)) {
-            section->addEntry(first, last, value);
+            section->parsed[first] = ConfigEntry{first, last, uint32_t(_names.size()), uint32_t(value.size())};
+            _names.append(value);
         }
         else {
             _log.error(u"%s: range 0x%X-0x%X overlaps with an existing range", {_configFile, first, last});
@@ -386,27 +422,33 @@ bool ts::NamesFile::decodeDefinition(const UString& line, ConfigSection* section
 
 
 //----------------------------------------------------------------------------
-// Destructor: free all resources.
+// Move parsed entries into sorted vectors after loading all text files.
 //----------------------------------------------------------------------------
 
-ts::NamesFile::~NamesFile()
+void ts::NamesFile::sortEntries()
 {
-    // Deallocate all configuration sections.
     for (const auto& it : _sections) {
-        delete it.second;
+        ConfigSection* section = it.second;
+        section->entries.reserve(section->entries.size() + section->parsed.size());
+        for (const auto& ent : section->parsed) {
+            section->entries.push_back(ent.second);
+        }
+        section->parsed.clear();
     }
-    _sections.clear();
 }
 
 
 //----------------------------------------------------------------------------
-// Configuration entry.
+// Destructor: free all resources.
 //----------------------------------------------------------------------------
 
-ts::NamesFile::ConfigEntry::ConfigEntry(Value l, const UString& n) :
-    last(l),
-    name(n)
+ts::NamesFile::~NamesFile()
 {
+    // Deallocate all configuration sections.
+    for (const auto& it : _sections) {
+        delete it.second;
+    }
+    _sections.clear();
 }
 
 
@@ -416,18 +458,10 @@ ts::NamesFile::ConfigEntry::ConfigEntry(Value l, const UString& n) :
 
 ts::NamesFile::ConfigSection::ConfigSection() :
     bits(0),
+    inherit(),
     entries(),
-    inherit()
-{
-}
-
-ts::NamesFile::ConfigSection::~ConfigSection()
+    parsed()
 {
-    // Deallocate all configuration entries.
-    for (const auto& it : entries) {
-        delete it.second;
-    }
-    entries.clear();
 }
 
 
@@ -438,15 +472,15 @@ ts::NamesFile::ConfigSection::~ConfigSection()
 bool ts::NamesFile::ConfigSection::freeRange(Value first, Value last) const
 {
     // Get an iterator pointing to the first element that is "not less" than 'first'.
-    auto it = entries.lower_bound(first);
+    auto it = parsed.lower_bound(first);
 
-    if (it != entries.end() && it->first <= last) {
+    if (it != parsed.end() && it->first <= last) {
         // This is an existing range which starts inside [first..last].
         assert(it->first >= first);
         return false;
     }
 
-    if (it != entries.begin() && (--it)->second->last >= first) {
+    if (it != parsed.begin() && (--it)->second.last >= first) {
         // The previous range ends inside [first..last].
         assert(it->first < first);
         return false;
@@ -458,42 +492,256 @@ bool ts::NamesFile::ConfigSection::freeRange(Value first, Value last) const
 
 
 //----------------------------------------------------------------------------
-// Add a new configuration entry.
+// Get the entry containing a value, null if not found.
 //----------------------------------------------------------------------------
 
-void ts::NamesFile::ConfigSection::addEntry(Value first, Value last, const UString& name)
+const ts::NamesFile::ConfigEntry* ts::NamesFile::ConfigSection::getEntry(Value val) const
 {
-    ConfigEntry* entry = new ConfigEntry(last, name);
-    CheckNonNull(entry);
-    entries.insert(std::make_pair(first, entry));
+    // Binary search of the first entry which starts after 'val'.
+    // The entry containing 'val', if any, is the previous one.
+    const auto it = std::upper_bound(entries.begin(), entries.end(), val, [](Value v, const ConfigEntry& e) { return v < e.first; });
+    if (it == entries.begin()) {
+        return nullptr;
+    }
+    const ConfigEntry& entry(*(it - 1));
+    return val <= entry.last ? &entry : nullptr;
 }
 
 
 //----------------------------------------------------------------------------
-// Get a name from a value, empty if not found.
+// Description of a source text file.
 //----------------------------------------------------------------------------
 
-ts::UString ts::NamesFile::ConfigSection::getName(Value val) const
+ts::NamesFile::SourceFile::SourceFile(const UString& p) :
+    path(p),
+    size(p.empty() ? -1 : GetFileSize(p)),
+    time(p.empty() ? 0 : GetFileModificationTimeUTC(p) - Time::Epoch)
+{
+}
+
+bool ts::NamesFile::SourceFile::operator==(const SourceFile& other) const
 {
-    // Eliminate trivial cases which would cause issues with code below.
-    if (entries.empty()) {
+    return path == other.path && size == other.size && time == other.time;
+}
+
+
+//----------------------------------------------------------------------------
+// Binary cache files.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Header of a binary cache file. The file is specific to the local system (native byte order)
+    // and to a version of the library. Increment the format version when the cache layout changes.
+    constexpr char CACHE_MAGIC[8] = {'T', 'S', 'N', 'A', 'M', 'E', 'S', 0};
+    constexpr uint32_t CACHE_FORMAT_VERSION = 2;
+    constexpr uint32_t CACHE_BYTE_ORDER = 0x01020304;
+    constexpr uint32_t CACHE_LIBRARY_VERSION = (TS_VERSION_MAJOR << 24) | (TS_VERSION_MINOR << 16) | TS_COMMIT;
+
+    // Append native binary data and strings in a cache buffer.
+    template <typename INT>
+    void CacheAppend(ts::ByteBlock& buf, INT value)
+    {
+        buf.append(&value, sizeof(value));
+    }
+    void CacheAppend(ts::ByteBlock& buf, const ts::UString& str)
+    {
+        CacheAppend(buf, uint32_t(str.size()));
+        buf.append(str.data(), str.size() * sizeof(ts::UChar));
+    }
+
+    // Read native binary data and strings from a cache buffer.
+    class CacheReader
+    {
+        TS_NOBUILD_NOCOPY(CacheReader);
+    public:
+        CacheReader(const ts::ByteBlock& buf) : _data(buf.data()), _remain(buf.size()), _valid(true) {}
+        bool valid() const { return _valid; }
+        bool eof() const { return _remain == 0; }
+        void invalidate() { _valid = false; }
+
+        // Get the address of a memory area and skip it, null on error.
+        const uint8_t* skip(size_t size)
+        {
+            if (!_valid || size > _remain) {
+                _valid = false;
+                return nullptr;
+            }
+            const uint8_t* const addr = _data;
+            _data += size;
+            _remain -= size;
+            return addr;
+        }
+
+        template <typename INT>
+        INT get()
+        {
+            INT value = 0;
+            const uint8_t* const addr = skip(sizeof(value));
+            if (addr != nullptr) {
+                ::memcpy(&value, addr, sizeof(value));
+            }
+            return value;
+        }
+
+        void get(ts::UString& str)
+        {
+            const size_t size = get<uint32_t>();
+            const uint8_t* const addr = skip(size * sizeof(ts::UChar));
+            if (addr == nullptr) {
+                str.clear();
+            }
+            else {
+                str.resize(size);
+                ::memcpy(&str[0], addr, size * sizeof(ts::UChar));
+            }
+        }
+
+    private:
+        const uint8_t* _data;
+        size_t         _remain;
+        bool           _valid;
+    };
+}
+
+// Name of the directory for the binary cache. The cache is used only when explicitly requested.
+ts::UString ts::NamesFile::CacheDirectory()
+{
+    return GetEnvironment(u"TSDUCK_CACHE_DIR");
+}
+
+// Name of the binary cache file for a list of source files.
+ts::UString ts::NamesFile::CacheFileName(const std::vector<SourceFile>& sources)
+{
+    const UString dir(CacheDirectory());
+    if (dir.empty() || sources.empty()) {
         return UString();
     }
 
-    // The key in the 'entries' map is the _first_ value of a range.
-    // Get an iterator pointing to the first element that is "not less" than 'val'.
-    auto it = entries.lower_bound(val);
+    // The same main file can be loaded with different sets of extensions (depending on the application).
+    // Use a hash of all file names (FNV-1a) to get distinct cache files.
+    uint32_t hash = 0x811C9DC5;
+    for (const auto& src : sources) {
+        for (UChar c : src.path) {
+            hash = (hash ^ uint32_t(c)) * 0x01000193;
+        }
+        hash = (hash ^ uint32_t(SearchPathSeparator)) * 0x01000193;
+    }
+    return UString::Format(u"%s%c%s-%08X.cache", {dir, PathSeparator, BaseName(sources[0].path), hash});
+}
 
-    if (it == entries.end() || (it != entries.begin() && it->first != val)) {
-        // There is no entry with a value range starting at 'val'.
-        // Maybe 'val' is in the range of the previous entry.
-        --it;
+// Load the binary cache.
+bool ts::NamesFile::loadCache(const UString& fileName, const std::vector<SourceFile>& sources)
+{
+    ByteBlock buf;
+    if (!buf.loadFromFile(fileName)) {
+        return false;
     }
+    CacheReader rd(buf);
 
-    assert(it != entries.end());
-    assert(it->second != nullptr);
+    // Check the header: format, byte order, library version, entry layout and list of source files.
+    const uint8_t* const magic = rd.skip(sizeof(CACHE_MAGIC));
+    if (magic == nullptr || ::memcmp(magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        rd.get<uint32_t>() != CACHE_FORMAT_VERSION ||
+        rd.get<uint32_t>() != CACHE_BYTE_ORDER ||
+        rd.get<uint32_t>() != CACHE_LIBRARY_VERSION ||
+        rd.get<uint32_t>() != sizeof(ConfigEntry))
+    {
+        _log.debug(u"names cache %s was created by another version", {fileName});
+        return false;
+    }
+    if (rd.get<uint32_t>() != sources.size()) {
+        _log.debug(u"names cache %s is obsolete", {fileName});
+        return false;
+    }
+    for (const auto& src : sources) {
+        SourceFile cached;
+        rd.get(cached.path);
+        cached.size = rd.get<int64_t>();
+        cached.time = rd.get<int64_t>();
+        if (!rd.valid() || !(cached == src)) {
+            _log.debug(u"names cache %s is obsolete", {fileName});
+            return false;
+        }
+    }
+
+    // Pool of names.
+    rd.get(_names);
+
+    // Load all sections.
+    const size_t count = rd.get<uint32_t>();
+    for (size_t i = 0; rd.valid() && i < count; ++i) {
+        UString name;
+        rd.get(name);
+        ConfigSection* section = new ConfigSection;
+        CheckNonNull(section);
+        _sections.insert(std::make_pair(name, section));
+        rd.get(section->inherit);
+        section->bits = rd.get<uint32_t>();
+        const size_t entries = rd.get<uint32_t>();
+        const uint8_t* const addr = rd.skip(entries * sizeof(ConfigEntry));
+        if (addr != nullptr) {
+            section->entries.resize(entries);
+            ::memcpy(section->entries.data(), addr, entries * sizeof(ConfigEntry));
+            // Check that name references are valid.
+            for (const auto& ent : section->entries) {
+                if (size_t(ent.name_offset) + size_t(ent.name_length) > _names.size()) {
+                    rd.invalidate();
+                    break;
+                }
+            }
+        }
+    }
 
-    return val >= it->first && val <= it->second->last ? it->second->name : UString();
+    // In case of corrupted cache, cleanup everything and parse the text files.
+    if (!rd.valid() || !rd.eof()) {
+        _log.debug(u"names cache %s is corrupted", {fileName});
+        for (const auto& it : _sections) {
+            delete it.second;
+        }
+        _sections.clear();
+        _names.clear();
+        return false;
+    }
+    return true;
+}
+
+// Save the binary cache.
+void ts::NamesFile::saveCache(const UString& fileName, const std::vector<SourceFile>& sources) const
+{
+    ByteBlock buf;
+    buf.append(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    CacheAppend(buf, CACHE_FORMAT_VERSION);
+    CacheAppend(buf, CACHE_BYTE_ORDER);
+    CacheAppend(buf, CACHE_LIBRARY_VERSION);
+    CacheAppend(buf, uint32_t(sizeof(ConfigEntry)));
+    CacheAppend(buf, uint32_t(sources.size()));
+    for (const auto& src : sources) {
+        CacheAppend(buf, src.path);
+        CacheAppend(buf, src.size);
+        CacheAppend(buf, src.time);
+    }
+    CacheAppend(buf, _names);
+    CacheAppend(buf, uint32_t(_sections.size()));
+    for (const auto& it : _sections) {
+        CacheAppend(buf, it.first);
+        CacheAppend(buf, it.second->inherit);
+        CacheAppend(buf, uint32_t(it.second->bits));
+        CacheAppend(buf, uint32_t(it.second->entries.size()));
+        buf.append(it.second->entries.data(), it.second->entries.size() * sizeof(ConfigEntry));
+    }
+
+    // Write a temporary file and rename it. Concurrent applications never see a partial cache.
+    const UString tmpName(UString::Format(u"%s.%d.tmp", {fileName, CurrentProcessId()}));
+    if (!CreateDirectory(DirectoryName(fileName), true, NULLREP) || !buf.saveToFile(tmpName, &NULLREP)) {
+        _log.debug(u"error creating names cache %s", {fileName});
+    }
+    else if (RenameFile(tmpName, fileName, NULLREP) || (DeleteFile(fileName, NULLREP) && RenameFile(tmpName, fileName, NULLREP))) {
+        _log.debug(u"created names cache %s", {fileName});
+    }
+    else {
+        _log.debug(u"error creating names cache %s", {fileName});
+        DeleteFile(tmpName, NULLREP);
+    }
 }
 
 
@@ -595,37 +843,46 @@ ts::UString ts::NamesFile::Formatted(Value value, const UString& name, NamesFlag
 // Get the section and name from a value, empty if not found.
 //----------------------------------------------------------------------------
 
-void ts::NamesFile::getName(const UString& sectionName, Value value, ConfigSection*& section, UString& name) const
+const ts::NamesFile::ConfigSection* ts::NamesFile::getSection(const UString& sectionName) const
 {
-    // Normalized section name.
-    UString sname(NormalizedSectionName(sectionName));
+    // Most section names are already normalized, avoid building a new string.
+    auto it = _sections.find(sectionName);
+    if (it == _sections.end()) {
+        const UString sname(NormalizedSectionName(sectionName));
+        if (sname != sectionName) {
+            it = _sections.find(sname);
+        }
+    }
+    return it == _sections.end() ? nullptr : it->second;
+}
 
+void ts::NamesFile::getName(const UString& sectionName, Value value, const ConfigSection*& section, UString& name) const
+{
     // Limit the number of inheritance levels to avoid infinite loop.
     int levels = 16;
 
     // Loop on inherited sections, until a name is found.
-    for (;;) {
-        // Get the section.
-        const auto it = _sections.find(sname);
-        if (it == _sections.end()) {
-            // Section not found, no name.
-            section = nullptr;
-            name.clear();
-            return;
-        }
+    section = getSection(sectionName);
+    while (section != nullptr) {
 
         // Get the name of the value in the section.
-        section = it->second;
-        name = section->getName(value);
-
-        // Return when name found or no "superclass" or too many levels of inheritance.
-        if (!name.empty() || section->inherit.empty() || levels-- <= 0) {
+        const ConfigEntry* const entry = section->getEntry(value);
+        if (entry != nullptr) {
+            name.assign(_names, entry->name_offset, entry->name_length);
             return;
         }
 
+        // Return when no "superclass" or too many levels of inheritance.
+        if (section->inherit.empty() || levels-- <= 0) {
+            break;
+        }
+
         // Loop on "superclass".
-        sname = NormalizedSectionName(section->inherit);
+        section = getSection(section->inherit);
     }
+
+    // Name not found.
+    name.clear();
 }
 
 
@@ -635,7 +892,7 @@ void ts::NamesFile::getName(const UString& sectionName, Value value, ConfigSecti
 
 bool ts::NamesFile::nameExists(const UString& sectionName, Value value) const
 {
-    ConfigSection* section = nullptr;
+    const ConfigSection* section = nullptr;
     UString name;
     getName(sectionName, value, section, name);
     return !name.empty();
@@ -648,7 +905,7 @@ bool ts::NamesFile::nameExists(const UString& sectionName, Value value) const
 
 ts::UString ts::NamesFile::nameFromSection(const UString& sectionName, Value value, NamesFlags flags, size_t bits, Value alternateValue) const
 {
-    ConfigSection* section = nullptr;
+    const ConfigSection* section = nullptr;
     UString name;
     getName(sectionName, value, section, name);
 
@@ -668,7 +925,7 @@ ts::UString ts::NamesFile::nameFromSection(const UString& sectionName, Value val
 
 ts::UString ts::NamesFile::nameFromSectionWithFallback(const UString& sectionName, Value value1, Value value2, NamesFlags flags, size_t bits, Value alternateValue) const
 {
-    ConfigSection* section = nullptr;
+    const ConfigSection* section = nullptr;
     UString name;
     getName(sectionName, value1, section, name);
 
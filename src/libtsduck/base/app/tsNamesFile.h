@@ -66,6 +66,13 @@ namespace ts {
     //! In an instance of NamesFile, all names are loaded from one configuration file.
     //! @ingroup app
     //!
+    //! The text ".names" files are the reference. When the environment variable @c TSDUCK_CACHE_DIR
+    //! is defined, a compiled binary version of their content is saved in this directory after parsing
+    //! the text files. The next time the same set of files is loaded, the binary cache is used instead
+    //! of parsing the text files, unless one of the text files was modified or replaced after the
+    //! creation of the cache or the cache was created by another version of TSDuck. Without
+    //! @c TSDUCK_CACHE_DIR, there is no cache and nothing is written on disk.
+    //!
     class TSDUCKDLL NamesFile
     {
         TS_NOBUILD_NOCOPY(NamesFile);
@@ -149,6 +156,18 @@ namespace ts {
         //!
         size_t errorCount() const { return _configErrors; }
 
+        //!
+        //! Check if the content was loaded from the binary cache.
+        //! @return True if the content was loaded from the binary cache, false if the text files were parsed.
+        //!
+        bool loadedFromCache() const { return _fromCache; }
+
+        //!
+        //! Get the name of the directory where binary caches of names files are stored.
+        //! @return The name of the cache directory or an empty string if the cache is disabled.
+        //!
+        static UString CacheDirectory();
+
         //!
         //! Check if a name exists in a specified section.
         //! @param [in] sectionName Name of section to search. Not case-sensitive.
@@ -219,19 +238,22 @@ namespace ts {
         static void UnregisterExtensionFile(const UString& filename);
 
     private:
-        // Description of a configuration entry.
-        // The first value of the range is the key in a map.
+        // Description of a configuration entry: a range of values and the offset of its name in the pool of names.
+        // This is a trivially copyable structure without padding, directly stored in the binary cache.
         class ConfigEntry
         {
         public:
-            Value   last;   // Last value in the range.
-            UString name;   // Associated name.
-
-            ConfigEntry(Value l = 0, const UString& n = UString());
+            Value    first;        // First value in the range.
+            Value    last;         // Last value in the range.
+            uint32_t name_offset;  // Offset of the name in _names.
+            uint32_t name_length;  // Length of the name in characters.
         };
 
-        // Map of configuration entries, indexed by first value of the range.
-        typedef std::map<Value, ConfigEntry*> ConfigEntryMap;
+        // Vector of configuration entries, sorted by first value of the range.
+        typedef std::vector<ConfigEntry> ConfigEntryVector;
+
+        // Map of configuration entries, indexed by first value of the range, used while parsing text files.
+        typedef std::map<Value, ConfigEntry> ConfigEntryMap;
 
         // Description of a configuration section.
         // The name of the section is the key in a map.
@@ -239,26 +261,35 @@ namespace ts {
         {
             TS_NOCOPY(ConfigSection);
         public:
-            size_t          bits;      // Number of significant bits in values of the type.
-            ConfigEntryMap  entries;   // All entries, indexed by names.
-            UString         inherit;   // Redirect to this section if value not found.
+            size_t            bits;      // Number of significant bits in values of the type.
+            UString           inherit;   // Redirect to this section if value not found.
+            ConfigEntryVector entries;   // All entries, sorted by first value.
+            ConfigEntryMap    parsed;    // Entries while parsing text files, moved into entries at end of load.
 
             ConfigSection();
-            ~ConfigSection();
 
-            // Check if a range is free, ie no value is defined in the range.
+            // Check if a range is free, ie no value is defined in the range (while parsing text files).
             bool freeRange(Value first, Value last) const;
 
-            // Add a new entry.
-            void addEntry(Value first, Value last, const UString& name);
-
-            // Get a name from a value, empty if not found.
-            UString getName(Value val) const;
+            // Get the entry containing a value, null if not found.
+            const ConfigEntry* getEntry(Value val) const;
         };
 
         // Map of configuration sections, indexed by name.
         typedef std::map<UString, ConfigSection*> ConfigSectionMap;
 
+        // Description of a source text file, as referenced in the binary cache.
+        class SourceFile
+        {
+        public:
+            UString path;   // Full path of the text file.
+            int64_t size;   // File size in bytes.
+            int64_t time;   // Modification time in milliseconds since Epoch.
+
+            SourceFile(const UString& p = UString());
+            bool operator==(const SourceFile& other) const;
+        };
+
         // Decode a line as "first[-last] = name". Return true on success, false on error.
         bool decodeDefinition(const UString& line, ConfigSection* section);
 
@@ -271,8 +302,23 @@ namespace ts {
         // Load a configuration file and merge its content into this instance.
         void loadFile(const UString& fileName);
 
+        // Move parsed entries into sorted vectors after loading all text files.
+        void sortEntries();
+
+        // Name of the binary cache file for a list of source files, empty if cache is disabled.
+        static UString CacheFileName(const std::vector<SourceFile>& sources);
+
+        // Load the binary cache. Return false if non-existent, invalid or obsolete.
+        bool loadCache(const UString& fileName, const std::vector<SourceFile>& sources);
+
+        // Save the binary cache. Errors are silently ignored, the cache is just an optimization.
+        void saveCache(const UString& fileName, const std::vector<SourceFile>& sources) const;
+
+        // Get the section for a section name, null if not found.
+        const ConfigSection* getSection(const UString& sectionName) const;
+
         // Get the section and name from a value, empty if not found. Section can be null.
-        void getName(const UString& sectionName, Value value, ConfigSection*& section, UString& name) const;
+        void getName(const UString& sectionName, Value value, const ConfigSection*& section, UString& name) const;
 
         // Normalized section name.
         static UString NormalizedSectionName(const UString& sectionName) { return sectionName.toTrimmed().toLower(); }
@@ -281,6 +327,8 @@ namespace ts {
         Report&          _log;           // Error logger.
         const UString    _configFile;    // Configuration file path.
         size_t           _configErrors;  // Number of errors in configuration file.
+        bool             _fromCache;     // Content was loaded from the binary cache.
+        UString          _names;         // Pool of all names, referenced by ConfigEntry.
         ConfigSectionMap _sections;      // Configuration sections.
     };
 
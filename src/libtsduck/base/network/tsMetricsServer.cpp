@@ -0,0 +1,325 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMetricsServer.h"
+#include "tsGuardMutex.h"
+#include "tsGuardCondition.h"
+#include "tsReportBuffer.h"
+#include "tsNullMutex.h"
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr ts::MilliSecond ts::MetricsServer::DEFAULT_INTERVAL;
+#endif
+
+// Maximum size of an HTTP request header and reception timeout.
+namespace {
+    constexpr size_t MAX_REQUEST_SIZE = 4096;
+    constexpr ts::MilliSecond REQUEST_TIMEOUT = 5 * ts::MilliSecPerSec;
+}
+
+ts::MetricsCollectorInterface::~MetricsCollectorInterface()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::MetricsServer::Metric::Metric(const UString& labels, int64_t scale) :
+    _labels(labels),
+    _scale(std::max<int64_t>(1, scale)),
+    _value(0)
+{
+}
+
+ts::MetricsServer::MetricsServer(Report& report) :
+    _report(report, u"metrics: "),
+    _collector(nullptr),
+    _is_open(false),
+    _terminate(false),
+    _interval(DEFAULT_INTERVAL),
+    _tcp_server(),
+    _server_thread(*this),
+    _snapshot_thread(*this),
+    _families_mutex(),
+    _families(),
+    _snapshot_mutex(),
+    _snapshot(),
+    _wake_mutex(),
+    _wake_cond()
+{
+}
+
+ts::MetricsServer::~MetricsServer()
+{
+    close();
+}
+
+ts::MetricsServer::ServerThread::~ServerThread()
+{
+    waitForTermination();
+}
+
+ts::MetricsServer::SnapshotThread::~SnapshotThread()
+{
+    waitForTermination();
+}
+
+
+//----------------------------------------------------------------------------
+// Register a metric.
+//----------------------------------------------------------------------------
+
+ts::MetricsServer::Metric& ts::MetricsServer::addMetric(const UString& name, Type type, const UString& help, const UString& labels, int64_t scale)
+{
+    GuardMutex lock(_families_mutex);
+    auto fam = _families.begin();
+    while (fam != _families.end() && fam->name != name) {
+        ++fam;
+    }
+    if (fam == _families.end()) {
+        fam = _families.emplace(_families.end(), name, type, help);
+    }
+    // std::list never moves its elements, the returned reference remains valid.
+    fam->metrics.emplace_back(labels, scale);
+    return fam->metrics.back();
+}
+
+
+//----------------------------------------------------------------------------
+// Start / stop the server.
+//----------------------------------------------------------------------------
+
+bool ts::MetricsServer::open(const IPv4SocketAddress& address, MilliSecond interval, bool reuse_port)
+{
+    if (_is_open) {
+        _report.error(u"metrics server already started");
+        return false;
+    }
+
+    if (!_tcp_server.open(_report) ||
+        !_tcp_server.reusePort(reuse_port, _report) ||
+        !_tcp_server.bind(address, _report) ||
+        !_tcp_server.listen(5, _report))
+    {
+        _tcp_server.close(NULLREP);
+        _report.error(u"error starting TCP server for metrics");
+        return false;
+    }
+
+    _interval = interval > 0 ? interval : DEFAULT_INTERVAL;
+    _terminate = false;
+    _is_open = true;
+
+    // Build a first snapshot before accepting the first request.
+    updateSnapshot();
+    _snapshot_thread.start();
+    _server_thread.start();
+    return true;
+}
+
+void ts::MetricsServer::close()
+{
+    if (_is_open) {
+        // Closing the TCP server forces the server thread to terminate.
+        _terminate = true;
+        _tcp_server.close(NULLREP);
+        {
+            GuardCondition lock(_wake_mutex, _wake_cond);
+            lock.signal();
+        }
+        _server_thread.waitForTermination();
+        _snapshot_thread.waitForTermination();
+        _is_open = false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Snapshot of the metrics.
+//----------------------------------------------------------------------------
+
+void ts::MetricsServer::updateSnapshot()
+{
+    // Let the application refresh the metrics which are not updated in real time.
+    if (_collector != nullptr) {
+        _collector->collectMetrics(*this);
+    }
+
+    // Render all metrics, without holding the snapshot mutex.
+    std::string text;
+    std::string value;
+    {
+        GuardMutex lock(_families_mutex);
+        for (const auto& fam : _families) {
+            const std::string name(fam.name.toUTF8());
+            UString help(fam.help);
+            help.substitute(u"\\", u"\\\\");
+            help.substitute(u"\n", u"\\n");
+            text.append("# HELP ");
+            text.append(name);
+            text.append(" ");
+            text.append(help.toUTF8());
+            text.append("\n# TYPE ");
+            text.append(name);
+            text.append(fam.type == Type::COUNTER ? " counter\n" : " gauge\n");
+            for (const auto& met : fam.metrics) {
+                text.append(name);
+                if (!met._labels.empty()) {
+                    text.append("{");
+                    text.append(met._labels.toUTF8());
+                    text.append("}");
+                }
+                const int64_t val = met.value();
+                if (met._scale == 1) {
+                    value = std::to_string(val);
+                }
+                else {
+                    char buf[64];
+                    std::snprintf(buf, sizeof(buf), "%.9g", double(val) / double(met._scale));
+                    value = buf;
+                }
+                text.append(" ");
+                text.append(value);
+                text.append("\n");
+            }
+        }
+    }
+
+    // Publish the new snapshot.
+    GuardMutex lock(_snapshot_mutex);
+    _snapshot.swap(text);
+}
+
+std::string ts::MetricsServer::snapshot() const
+{
+    GuardMutex lock(_snapshot_mutex);
+    return _snapshot;
+}
+
+void ts::MetricsServer::SnapshotThread::main()
+{
+    _server._report.debug(u"snapshot thread started");
+    GuardCondition lock(_server._wake_mutex, _server._wake_cond);
+    while (!_server._terminate) {
+        lock.waitCondition(_server._interval);
+        if (!_server._terminate) {
+            _server.updateSnapshot();
+        }
+    }
+    _server._report.debug(u"snapshot thread completed");
+}
+
+
+//----------------------------------------------------------------------------
+// Server thread.
+//----------------------------------------------------------------------------
+
+void ts::MetricsServer::ServerThread::main()
+{
+    _server._report.debug(u"server thread started");
+
+    // Get accept errors in a buffer since some errors are normal on termination.
+    ReportBuffer<NullMutex> error(_server._report.maxSeverity());
+    IPv4SocketAddress source;
+    TCPConnection conn;
+
+    // Requests are short, process one at a time.
+    while (_server._tcp_server.accept(conn, source, error)) {
+        _server._report.debug(u"connection from %s", {source});
+        _server.processRequest(conn);
+        conn.closeWriter(NULLREP);
+        conn.close(NULLREP);
+    }
+
+    if (!_server._terminate && !error.emptyMessages()) {
+        _server._report.error(error.getMessages());
+    }
+    _server._report.debug(u"server thread completed");
+}
+
+
+//----------------------------------------------------------------------------
+// Process one HTTP request.
+//----------------------------------------------------------------------------
+
+void ts::MetricsServer::processRequest(TCPConnection& conn)
+{
+    // Read the request header, until an empty line.
+    std::string request;
+    char buf[1024];
+    size_t size = 0;
+    if (!conn.setReceiveTimeout(REQUEST_TIMEOUT, _report)) {
+        return;
+    }
+    while (request.find("\r\n\r\n") == std::string::npos &&
+           request.find("\n\n") == std::string::npos &&
+           request.size() < MAX_REQUEST_SIZE &&
+           conn.receive(buf, sizeof(buf), size, nullptr, NULLREP))
+    {
+        request.append(buf, size);
+    }
+
+    // Analyze the request line: method, path, version.
+    UStringVector fields;
+    UString::FromUTF8(request.substr(0, request.find_first_of("\r\n"))).split(fields, u' ', true, true);
+    const bool get = fields.size() >= 2 && fields[0] == u"GET";
+    const bool head = fields.size() >= 2 && fields[0] == u"HEAD";
+    const UString path(fields.size() >= 2 ? fields[1].substr(0, fields[1].find(u'?')) : UString());
+
+    std::string status;
+    std::string type("text/plain; charset=utf-8");
+    std::string body;
+    if (!get && !head) {
+        status = "405 Method Not Allowed";
+        body = "method not allowed\n";
+    }
+    else if (path != u"/metrics" && path != u"/") {
+        status = "404 Not Found";
+        body = "not found, use /metrics\n";
+    }
+    else {
+        status = "200 OK";
+        type = "text/plain; version=0.0.4; charset=utf-8";
+        body = snapshot();
+    }
+
+    std::string response("HTTP/1.1 ");
+    response.append(status);
+    response.append("\r\nContent-Type: ");
+    response.append(type);
+    response.append("\r\nContent-Length: ");
+    response.append(std::to_string(body.size()));
+    response.append("\r\nConnection: close\r\n\r\n");
+    if (!head) {
+        response.append(body);
+    }
+    conn.send(response.data(), response.size(), _report);
+}
@@ -0,0 +1,259 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Embedded HTTP server for Prometheus / OpenMetrics metrics.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTCPServer.h"
+#include "tsIPv4SocketAddress.h"
+#include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsReportWithPrefix.h"
+
+namespace ts {
+
+    class MetricsServer;
+
+    //!
+    //! Abstract interface of a class which refreshes the metrics of a MetricsServer.
+    //! @ingroup net
+    //!
+    class TSDUCKDLL MetricsCollectorInterface
+    {
+    public:
+        //!
+        //! Invoked by the metrics server before each snapshot of the metrics.
+        //! Invoked in the context of the snapshot thread of the server, never on scrape.
+        //! @param [in,out] server The metrics server.
+        //!
+        virtual void collectMetrics(MetricsServer& server) = 0;
+
+        //!
+        //! Virtual destructor.
+        //!
+        virtual ~MetricsCollectorInterface();
+    };
+
+    //!
+    //! Embedded HTTP server for Prometheus / OpenMetrics metrics.
+    //! @ingroup net
+    //!
+    //! The application registers metrics once and then updates their values at any
+    //! time, from any thread. Updating a metric is a lock-free atomic operation.
+    //! A background thread periodically renders all metrics in the Prometheus text
+    //! exposition format. HTTP requests on "/metrics" return the last snapshot.
+    //! Therefore, the cost of a scrape is independent from the number of metrics
+    //! and never interferes with the threads which update the metrics.
+    //!
+    class TSDUCKDLL MetricsServer
+    {
+        TS_NOCOPY(MetricsServer);
+    public:
+        //!
+        //! Type of metric.
+        //!
+        enum class Type {
+            COUNTER,  //!< Monotonic counter.
+            GAUGE,    //!< Value which can go up and down.
+        };
+
+        //!
+        //! One time series, a metric value with a given set of labels.
+        //! A Metric object is owned by the server and remains valid until the server is destroyed.
+        //!
+        class TSDUCKDLL Metric
+        {
+            TS_NOBUILD_NOCOPY(Metric);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] labels Labels of the time series, e.g. @c plugin="zap",index="2".
+            //! @param [in] scale The exported value is the internal integer value divided by @a scale.
+            //! Typically used to export seconds from a value in nanoseconds.
+            //!
+            Metric(const UString& labels, int64_t scale);
+
+            //!
+            //! Set the value of the metric.
+            //! @param [in] value New value.
+            //!
+            void set(int64_t value) { _value.store(value, std::memory_order_relaxed); }
+
+            //!
+            //! Add to the value of the metric.
+            //! @param [in] value Value to add (or subtract when negative).
+            //!
+            void add(int64_t value = 1) { _value.fetch_add(value, std::memory_order_relaxed); }
+
+            //!
+            //! Get the current value of the metric.
+            //! @return The current value.
+            //!
+            int64_t value() const { return _value.load(std::memory_order_relaxed); }
+
+        private:
+            friend class MetricsServer;
+            const UString        _labels;
+            const int64_t        _scale;
+            std::atomic<int64_t> _value;
+        };
+
+        //!
+        //! Default interval between two snapshots of the metrics.
+        //!
+        static constexpr MilliSecond DEFAULT_INTERVAL = 5 * MilliSecPerSec;
+
+        //!
+        //! Constructor.
+        //! @param [in,out] report Where to report errors.
+        //!
+        MetricsServer(Report& report);
+
+        //!
+        //! Destructor.
+        //!
+        ~MetricsServer();
+
+        //!
+        //! Register a metric.
+        //! Several time series with the same name and distinct labels can be registered.
+        //! They share the same type and help text, the ones of the first registration.
+        //! @param [in] name Metric name, e.g. @c tsp_packets_total.
+        //! @param [in] type Metric type.
+        //! @param [in] help Help text.
+        //! @param [in] labels Labels of the time series, e.g. @c plugin="zap",index="2".
+        //! @param [in] scale The exported value is the internal integer value divided by @a scale.
+        //! @return A reference to the new metric. It remains valid until the server is destroyed.
+        //!
+        Metric& addMetric(const UString& name, Type type, const UString& help, const UString& labels = UString(), int64_t scale = 1);
+
+        //!
+        //! Set the collector which refreshes the metrics before each snapshot.
+        //! @param [in] collector Collector instance or null pointer for none.
+        //!
+        void setCollector(MetricsCollectorInterface* collector) { _collector = collector; }
+
+        //!
+        //! Start the server.
+        //! @param [in] address Local socket address to listen to.
+        //! @param [in] interval Interval between two snapshots of the metrics.
+        //! @param [in] reuse_port Set the 'reuse port' socket option.
+        //! @return True on success, false on error.
+        //!
+        bool open(const IPv4SocketAddress& address, MilliSecond interval = DEFAULT_INTERVAL, bool reuse_port = false);
+
+        //!
+        //! Stop the server.
+        //!
+        void close();
+
+        //!
+        //! Check if the server is started.
+        //! @return True if the server is started.
+        //!
+        bool isOpen() const { return _is_open; }
+
+        //!
+        //! Get the local socket address of the server.
+        //! Useful when the server was opened on port zero (dynamically allocated port).
+        //! @param [out] address Local socket address.
+        //! @return True on success, false on error.
+        //!
+        bool getLocalAddress(IPv4SocketAddress& address) { return _tcp_server.getLocalAddress(address, _report); }
+
+        //!
+        //! Refresh the snapshot of the metrics now, without waiting for the next interval.
+        //!
+        void updateSnapshot();
+
+        //!
+        //! Get the last snapshot of the metrics in Prometheus text format.
+        //! @return The last snapshot in UTF-8.
+        //!
+        std::string snapshot() const;
+
+    private:
+        // A metric family, all time series with the same name.
+        class Family
+        {
+        public:
+            UString           name;
+            Type              type;
+            UString           help;
+            std::list<Metric> metrics;
+            Family(const UString& n, Type t, const UString& h) : name(n), type(t), help(h), metrics() {}
+        };
+
+        // Server thread: accept connections and send the snapshot.
+        class ServerThread : public Thread
+        {
+            TS_NOBUILD_NOCOPY(ServerThread);
+        public:
+            ServerThread(MetricsServer& server) : Thread(), _server(server) {}
+            virtual ~ServerThread() override;
+        private:
+            MetricsServer& _server;
+            virtual void main() override;
+        };
+
+        // Snapshot thread: periodically render the metrics.
+        class SnapshotThread : public Thread
+        {
+            TS_NOBUILD_NOCOPY(SnapshotThread);
+        public:
+            SnapshotThread(MetricsServer& server) : Thread(), _server(server) {}
+            virtual ~SnapshotThread() override;
+        private:
+            MetricsServer& _server;
+            virtual void main() override;
+        };
+
+        ReportWithPrefix           _report;
+        MetricsCollectorInterface* _collector;
+        volatile bool              _is_open;
+        volatile bool              _terminate;
+        MilliSecond                _interval;
+        TCPServer                  _tcp_server;
+        ServerThread               _server_thread;
+        SnapshotThread             _snapshot_thread;
+        Mutex                      _families_mutex;   // Protect the list of families, not the metric values.
+        std::list<Family>          _families;
+        mutable Mutex              _snapshot_mutex;   // Protect _snapshot.
+        std::string                _snapshot;
+        Mutex                      _wake_mutex;       // Used to wake up the snapshot thread.
+        Condition                  _wake_cond;
+
+        // Process one HTTP request.
+        void processRequest(TCPConnection& conn);
+    };
+}
@@ -0,0 +1,221 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsSocketPoller.h"
+#include "tsIPUtils.h"
+
+#if defined(TS_LINUX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <sys/epoll.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::SocketPoller::SocketPoller() :
+#if defined(TS_LINUX)
+    _contexts(),
+    _epfd(::epoll_create1(EPOLL_CLOEXEC))
+#else
+    _contexts(),
+    _modified(false),
+    _pollfds()
+#endif
+{
+}
+
+ts::SocketPoller::~SocketPoller()
+{
+#if defined(TS_LINUX)
+    if (_epfd >= 0) {
+        ::close(_epfd);
+    }
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Register, modify, unregister sockets.
+//----------------------------------------------------------------------------
+
+#if defined(TS_LINUX)
+bool ts::SocketPoller::control(int op, SysSocketType sock, bool write, Report& report)
+{
+    if (_epfd < 0) {
+        report.error(u"epoll not available");
+        return false;
+    }
+    ::epoll_event ev;
+    TS_ZERO(ev);
+    ev.events = uint32_t(EPOLLIN | EPOLLRDHUP) | (write ? uint32_t(EPOLLOUT) : 0);
+    ev.data.fd = sock;
+    if (::epoll_ctl(_epfd, op, sock, &ev) < 0) {
+        report.error(u"epoll_ctl error: %s", {SysErrorCodeMessage()});
+        return false;
+    }
+    return true;
+}
+#endif
+
+bool ts::SocketPoller::add(const Socket& sock, void* context, bool write, Report& report)
+{
+    const SysSocketType fd = sock.getSocket();
+    if (fd == SYS_SOCKET_INVALID || _contexts.find(fd) != _contexts.end()) {
+        report.error(u"invalid or already registered socket");
+        return false;
+    }
+#if defined(TS_LINUX)
+    if (!control(EPOLL_CTL_ADD, fd, write, report)) {
+        return false;
+    }
+#else
+    _modified = true;
+#endif
+    _contexts[fd] = std::make_pair(context, write);
+    return true;
+}
+
+bool ts::SocketPoller::setWrite(const Socket& sock, bool write, Report& report)
+{
+    const auto it = _contexts.find(sock.getSocket());
+    if (it == _contexts.end()) {
+        report.error(u"socket not registered in poller");
+        return false;
+    }
+    if (it->second.second != write) {
+#if defined(TS_LINUX)
+        if (!control(EPOLL_CTL_MOD, it->first, write, report)) {
+            return false;
+        }
+#else
+        _modified = true;
+#endif
+        it->second.second = write;
+    }
+    return true;
+}
+
+bool ts::SocketPoller::remove(const Socket& sock, Report& report)
+{
+    const auto it = _contexts.find(sock.getSocket());
+    if (it == _contexts.end()) {
+        report.error(u"socket not registered in poller");
+        return false;
+    }
+#if defined(TS_LINUX)
+    control(EPOLL_CTL_DEL, it->first, false, report);
+#else
+    _modified = true;
+#endif
+    _contexts.erase(it);
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Wait for events on the registered sockets.
+//----------------------------------------------------------------------------
+
+bool ts::SocketPoller::wait(std::vector<Event>& events, MilliSecond timeout, Report& report)
+{
+    events.clear();
+    const int msec = timeout == Infinite ? -1 : int(std::max<MilliSecond>(0, std::min<MilliSecond>(timeout, std::numeric_limits<int>::max())));
+
+#if defined(TS_LINUX)
+
+    if (_epfd < 0) {
+        report.error(u"epoll not available");
+        return false;
+    }
+    std::vector<::epoll_event> evs(std::max<size_t>(1, _contexts.size()));
+    const int count = ::epoll_wait(_epfd, evs.data(), int(evs.size()), msec);
+    if (count < 0) {
+        if (errno == EINTR) {
+            return true;
+        }
+        report.error(u"epoll_wait error: %s", {SysErrorCodeMessage()});
+        return false;
+    }
+    events.resize(size_t(count));
+    for (int i = 0; i < count; ++i) {
+        const auto it = _contexts.find(evs[i].data.fd);
+        events[i].context = it == _contexts.end() ? nullptr : it->second.first;
+        events[i].readable = (evs[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0;
+        events[i].writable = (evs[i].events & EPOLLOUT) != 0;
+        events[i].error = (evs[i].events & (EPOLLHUP | EPOLLERR)) != 0;
+    }
+
+#else
+
+    // Rebuild the array of pollfd only when the list of sockets changed.
+    if (_modified) {
+        _pollfds.resize(_contexts.size());
+        size_t i = 0;
+        for (const auto& it : _contexts) {
+            _pollfds[i].fd = it.first;
+            _pollfds[i].events = POLLIN | (it.second.second ? POLLOUT : 0);
+            _pollfds[i].revents = 0;
+            i++;
+        }
+        _modified = false;
+    }
+
+#if defined(TS_WINDOWS)
+    const int count = ::WSAPoll(_pollfds.data(), ULONG(_pollfds.size()), msec);
+#else
+    const int count = ::poll(_pollfds.data(), ::nfds_t(_pollfds.size()), msec);
+#endif
+    if (count < 0) {
+        const SysSocketErrorCode err = LastSysSocketErrorCode();
+#if !defined(TS_WINDOWS)
+        if (err == EINTR) {
+            return true;
+        }
+#endif
+        report.error(u"poll error: %s", {SysSocketErrorCodeMessage(err)});
+        return false;
+    }
+    for (const auto& pfd : _pollfds) {
+        if (pfd.revents != 0) {
+            Event ev;
+            ev.context = _contexts[pfd.fd].first;
+            ev.readable = (pfd.revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+            ev.writable = (pfd.revents & POLLOUT) != 0;
+            ev.error = (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0;
+            events.push_back(ev);
+        }
+    }
+
+#endif
+
+    return true;
+}
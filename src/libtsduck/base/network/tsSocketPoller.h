@@ -0,0 +1,136 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Wait for I/O events on many sockets in one thread.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsSocket.h"
+
+#if !defined(TS_LINUX) && !defined(TS_WINDOWS)
+    #include "tsBeforeStandardHeaders.h"
+    #include <poll.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+namespace ts {
+    //!
+    //! Wait for I/O events on many sockets in one thread.
+    //! @ingroup net
+    //!
+    //! This class uses epoll() on Linux, poll() on other UNIX systems and WSAPoll() on Windows.
+    //! Sockets are registered with an application context which is returned with their events.
+    //! The sockets must remain open while they are registered.
+    //!
+    class TSDUCKDLL SocketPoller
+    {
+        TS_NOCOPY(SocketPoller);
+    public:
+        //!
+        //! Description of an event on a socket.
+        //!
+        class TSDUCKDLL Event
+        {
+        public:
+            void* context;   //!< Application context of the socket, as registered.
+            bool  readable;  //!< Data can be read from the socket, or the peer closed the connection.
+            bool  writable;  //!< Data can be written to the socket.
+            bool  error;     //!< Error or hang-up on the socket.
+            //!
+            //! Constructor.
+            //!
+            Event() : context(nullptr), readable(false), writable(false), error(false) {}
+        };
+
+        //!
+        //! Constructor.
+        //!
+        SocketPoller();
+
+        //!
+        //! Destructor.
+        //!
+        ~SocketPoller();
+
+        //!
+        //! Register a socket.
+        //! @param [in] sock An open socket.
+        //! @param [in] context Application context, returned with the events of the socket.
+        //! @param [in] write If true, also wait for the socket to be writable.
+        //! The socket is always polled for read.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool add(const Socket& sock, void* context, bool write, Report& report = CERR);
+
+        //!
+        //! Modify the write polling of a registered socket.
+        //! @param [in] sock A registered socket.
+        //! @param [in] write If true, also wait for the socket to be writable.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool setWrite(const Socket& sock, bool write, Report& report = CERR);
+
+        //!
+        //! Unregister a socket.
+        //! @param [in] sock A registered socket.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool remove(const Socket& sock, Report& report = CERR);
+
+        //!
+        //! Get the number of registered sockets.
+        //! @return The number of registered sockets.
+        //!
+        size_t size() const { return _contexts.size(); }
+
+        //!
+        //! Wait for events on the registered sockets.
+        //! @param [out] events Returned events. Empty on timeout.
+        //! @param [in] timeout Maximum waiting time in milliseconds. Use Infinite to wait forever.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success (including timeout), false on error.
+        //!
+        bool wait(std::vector<Event>& events, MilliSecond timeout, Report& report = CERR);
+
+    private:
+        std::map<SysSocketType, std::pair<void*, bool>> _contexts;  // Registered sockets: context, write.
+#if defined(TS_LINUX)
+        int _epfd;  // epoll file descriptor
+        bool control(int op, SysSocketType sock, bool write, Report& report);
+#else
+        bool _modified;                  // The socket list was modified since the last wait.
+        std::vector<::pollfd> _pollfds;  // Built from _contexts before each wait.
+#endif
+    };
+}
@@ -52,7 +52,8 @@ ts::UDPSocket::UDPSocket(bool auto_open, Report& report) :
 #if !defined(TS_NO_SSM)
     _ssmcast(),
 #endif
-    _mcast()
+    _mcast(),
+    _tx_time(false)
 {
     if (auto_open) {
         // Returned value ignored on purpose, the socket is marked as closed in the object on error.
@@ -270,6 +271,34 @@ bool ts::UDPSocket::setReceiveTimestamps(bool on, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Enable or disable the kernel pacing of sent packets.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::setTransmitTime(bool on, Report& report)
+{
+#if defined(TS_LINUX) && defined(SO_TXTIME)
+    // The transmission times are expressed on the monotonic clock, like ts::Monotonic.
+    ::sock_txtime config;
+    TS_ZERO(config);
+    config.clockid = CLOCK_MONOTONIC;
+    config.flags = 0;
+    if (on && ::setsockopt(getSocket(), SOL_SOCKET, SO_TXTIME, &config, sizeof(config)) != 0) {
+        report.error(u"socket option SO_TXTIME: " + SysSocketErrorCodeMessage());
+        return false;
+    }
+    _tx_time = on;
+    return true;
+#else
+    if (on) {
+        report.error(u"kernel packet pacing is not supported on this system");
+        return false;
+    }
+    return true;
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Enable or disable the broadcast option.
 //----------------------------------------------------------------------------
@@ -456,6 +485,52 @@ bool ts::UDPSocket::send(const void* data, size_t size, const IPv4SocketAddress&
 }
 
 
+//----------------------------------------------------------------------------
+// Send a message to the default destination at a given time.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::sendAt(const void* data, size_t size, NanoSecond tx_time, Report& report)
+{
+#if defined(TS_LINUX) && defined(SO_TXTIME)
+    if (_tx_time && tx_time >= 0) {
+        ::sockaddr addr;
+        _default_destination.copy(addr);
+
+        ::iovec vec;
+        vec.iov_base = const_cast<void*>(data);
+        vec.iov_len = size;
+
+        // Control message with the transmission time as a 64-bit value in nanoseconds.
+        uint8_t control[CMSG_SPACE(sizeof(uint64_t))];
+        TS_ZERO(control);
+
+        ::msghdr hdr;
+        TS_ZERO(hdr);
+        hdr.msg_name = &addr;
+        hdr.msg_namelen = sizeof(addr);
+        hdr.msg_iov = &vec;
+        hdr.msg_iovlen = 1;
+        hdr.msg_control = control;
+        hdr.msg_controllen = sizeof(control);
+
+        ::cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_TXTIME;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+        const uint64_t txtime = uint64_t(tx_time);
+        ::memcpy(CMSG_DATA(cmsg), &txtime, sizeof(txtime));
+
+        if (::sendmsg(getSocket(), &hdr, 0) < 0) {
+            report.error(u"error sending UDP message: " + SysSocketErrorCodeMessage());
+            return false;
+        }
+        return true;
+    }
+#endif
+    return send(data, size, _default_destination, report);
+}
+
+
 //----------------------------------------------------------------------------
 // Receive a message.
 // If abort interface is non-zero, invoke it when I/O is interrupted
@@ -222,6 +222,23 @@ namespace ts {
         //!
         bool setReceiveTimestamps(bool on, Report& report = CERR);
 
+        //!
+        //! Enable or disable the kernel pacing of sent packets.
+        //!
+        //! When enabled, sendAt() passes the transmission time of each packet to the kernel
+        //! which holds the packet until that time. This requires the "fq" or "etf" queuing
+        //! discipline on the output interface. The transmission times are based on the
+        //! monotonic clock (see Monotonic::nanoSeconds()).
+        //!
+        //! Currently, this option is supported on Linux only (SO_TXTIME).
+        //! Enabling it on other systems is an error.
+        //!
+        //! @param [in] on If true, kernel pacing is activated on the socket. Otherwise, it is disabled.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        bool setTransmitTime(bool on, Report& report = CERR);
+
         //!
         //! Enable or disable the broadcast option.
         //!
@@ -322,6 +339,21 @@ namespace ts {
         //!
         virtual bool send(const void* data, size_t size, Report& report = CERR);
 
+        //!
+        //! Send a message to the default destination address and port at a given time.
+        //!
+        //! When kernel pacing is enabled (see setTransmitTime()), the kernel holds the message
+        //! until the specified time. Otherwise, the message is sent immediately.
+        //!
+        //! @param [in] data Address of the message to send.
+        //! @param [in] size Size in bytes of the message to send.
+        //! @param [in] tx_time Transmission time in nanoseconds on the monotonic clock.
+        //! When negative, the message is sent immediately.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        bool sendAt(const void* data, size_t size, NanoSecond tx_time, Report& report = CERR);
+
         //!
         //! Receive a message.
         //!
@@ -410,6 +442,7 @@ namespace ts {
         SSMReqSet         _ssmcast;  // Current set of source-specific multicast memberships
 #endif
         MReqSet           _mcast;    // Current set of multicast memberships
+        bool              _tx_time;  // Kernel pacing (SO_TXTIME) is enabled
 
         // Perform one receive operation. Hide the system mud.
         SysSocketErrorCode receiveOne(void* data, size_t max_size, size_t& ret_size, IPv4SocketAddress& sender, IPv4SocketAddress& destination, Report& report, MicroSecond* timestamp);
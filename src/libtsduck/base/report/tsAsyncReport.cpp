@@ -28,20 +28,52 @@
 //----------------------------------------------------------------------------
 
 #include "tsAsyncReport.h"
+#include "tsGuardCondition.h"
+#include "tsSysUtils.h"
 
 
 //----------------------------------------------------------------------------
 // Default constructor
 //----------------------------------------------------------------------------
 
+namespace {
+    // Round the queue size up to a power of 2.
+    size_t RingSize(size_t count)
+    {
+        size_t size = 2;
+        while (size < count && size < (size_t(1) << (8 * sizeof(size_t) - 2))) {
+            size <<= 1;
+        }
+        return size;
+    }
+}
+
+constexpr size_t ts::AsyncReport::MAX_BATCH;
+constexpr ts::MilliSecond ts::AsyncReport::IDLE_WAIT;
+
 ts::AsyncReport::AsyncReport(int max_severity, const AsyncReportArgs& args) :
     Report(max_severity),
     Thread(ThreadAttributes().setPriority(ThreadAttributes::GetMinimumPriority())),
-    _log_queue(args.log_msg_count),
+    _slots(RingSize(args.log_msg_count)),
+    _mask(_slots.size() - 1),
+    _enqueue_pos(0),
+    _dequeue_pos(0),
+    _dropped(0),
+    _reported_drops(0),
+    _stop(false),
+    _wake_mutex(),
+    _wake_cond(),
+    _current_time(),
+    _batch(),
     _time_stamp(args.timed_log),
     _synchronous(args.sync_log),
     _terminated(false)
 {
+    // Initial sequence number of each slot is its index in the ring.
+    for (size_t i = 0; i < _slots.size(); ++i) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
     // Start the logging thread
     start();
 }
@@ -64,9 +96,12 @@ ts::AsyncReport::~AsyncReport()
 void ts::AsyncReport::terminate()
 {
     if (!_terminated) {
-        // Insert an "end of report" message in the queue.
-        // This message will tell the logging thread to terminate.
-        _log_queue.forceEnqueue(new LogMessage(true, 0, UString()));
+        // Tell the logging thread to terminate after logging all pending messages.
+        _stop = true;
+        {
+            GuardCondition lock(_wake_mutex, _wake_cond);
+            lock.signal();
+        }
 
         // Wait for termination of the logging thread
         waitForTermination();
@@ -75,6 +110,67 @@ void ts::AsyncReport::terminate()
 }
 
 
+//----------------------------------------------------------------------------
+// Lock-free ring of messages (multiple producers, single consumer).
+//----------------------------------------------------------------------------
+
+bool ts::AsyncReport::enqueue(int severity, const UString& msg)
+{
+    Slot* slot = nullptr;
+    size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        slot = &_slots[pos & _mask];
+        const size_t seq = slot->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = intptr_t(seq) - intptr_t(pos);
+        if (diff == 0) {
+            // The slot is free, try to reserve it.
+            if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The slot still contains a message from the previous round: the ring is full.
+            return false;
+        }
+        else {
+            // Another producer took the slot, retry with the next one.
+            pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // The slot is reserved. The message string is reused from the previous round,
+    // there is no allocation in steady state unless the message is longer.
+    slot->severity = severity;
+    slot->time = _time_stamp ? Time::CurrentUTC() : Time::Epoch;
+    slot->message.assign(msg);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+ts::AsyncReport::Slot* ts::AsyncReport::dequeue()
+{
+    Slot* slot = &_slots[_dequeue_pos & _mask];
+    return slot->sequence.load(std::memory_order_acquire) == _dequeue_pos + 1 ? slot : nullptr;
+}
+
+void ts::AsyncReport::release(Slot* slot)
+{
+    // Make the slot available to producers for the next round.
+    slot->sequence.store(_dequeue_pos + _mask + 1, std::memory_order_release);
+    _dequeue_pos++;
+}
+
+void ts::AsyncReport::wakeUp()
+{
+    // Never wait for the mutex. If the logging thread currently holds it, it is
+    // awake anyway or it will check the queue again after IDLE_WAIT.
+    GuardCondition lock(_wake_mutex, _wake_cond, 0);
+    if (lock.isLocked()) {
+        lock.signal();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Message logging method.
 //----------------------------------------------------------------------------
@@ -90,10 +186,18 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
     ::OutputDebugStringW(msgNewLine.wc_str());
 #endif
 
-    if (!_terminated) {
-        // Enqueue the message immediately (timeout = 0), drop message on overflow.
-        // On the contrary, in synchronous mode, wait infinitely until the message is queued.
-        _log_queue.enqueue(new LogMessage(false, severity, msg), _synchronous ? Infinite : 0);
+    if (!_terminated && !_stop) {
+        // Enqueue the message immediately, drop message on overflow.
+        // On the contrary, in synchronous mode, wait until the message is queued.
+        while (!enqueue(severity, msg)) {
+            if (!_synchronous) {
+                _dropped++;
+                return;
+            }
+            wakeUp();
+            SleepThread(1);
+        }
+        wakeUp();
     }
 }
 
@@ -104,23 +208,57 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
 
 void ts::AsyncReport::main()
 {
-    LogMessagePtr msg;
-
     // Notify subclasses (if any) of thread start.
     asyncThreadStarted();
 
-    while (_log_queue.dequeue(msg) && !msg->terminate) {
+    bool fatal = false;
+    while (!fatal) {
 
-        asyncThreadLog(msg->severity, msg->message);
+        // Deliver a batch of messages.
+        size_t count = 0;
+        Slot* slot = nullptr;
+        while (!fatal && count < MAX_BATCH && (slot = dequeue()) != nullptr) {
+            _current_time = slot->time;
+            asyncThreadLog(slot->severity, slot->message);
+            fatal = slot->severity == Severity::Fatal;
+            release(slot);
+            count++;
+        }
+
+        // Report dropped messages, if any.
+        const uint64_t dropped = _dropped;
+        if (dropped != _reported_drops) {
+            _current_time = _time_stamp ? Time::CurrentUTC() : Time::Epoch;
+            asyncThreadLog(Severity::Warning, UString::Format(u"%'d log messages dropped, queue overflow", {dropped - _reported_drops}));
+            _reported_drops = dropped;
+            count++;
+        }
 
-        // Abort application on fatal error
-        if (msg->severity == Severity::Fatal) {
-            ::exit(EXIT_FAILURE);
+        if (count > 0) {
+            asyncThreadFlush();
+        }
+        else if (_stop) {
+            // Queue is empty and termination was requested.
+            break;
+        }
+        else {
+            // Queue is empty, wait for a new message.
+            GuardCondition lock(_wake_mutex, _wake_cond);
+            if (dequeue() == nullptr && !_stop) {
+                lock.waitCondition(IDLE_WAIT);
+            }
         }
     }
 
+    // Abort application on fatal error
+    if (fatal) {
+        ::exit(EXIT_FAILURE);
+    }
+
     if (_max_severity >= Severity::Debug) {
+        _current_time = _time_stamp ? Time::CurrentUTC() : Time::Epoch;
         asyncThreadLog(Severity::Debug, u"Report logging thread terminated");
+        asyncThreadFlush();
     }
 
     // Notify subclasses (if any) of thread completion.
@@ -139,12 +277,27 @@ void ts::AsyncReport::asyncThreadStarted()
 
 void ts::AsyncReport::asyncThreadLog(int severity, const UString& message)
 {
-    // The default implementation logs on stderr.
-    std::cerr << "* ";
+    // The default implementation accumulates the messages for stderr.
+    UString line(u"* ");
     if (_time_stamp) {
-        std::cerr << ts::Time::CurrentLocalTime().format(ts::Time::DATETIME) << " - ";
+        // Use the binary time stamp which was captured when the message was enqueued.
+        line.append((_current_time == Time::Epoch ? Time::CurrentLocalTime() : _current_time.UTCToLocal()).format(Time::DATETIME));
+        line.append(u" - ");
+    }
+    line.append(Severity::Header(severity));
+    line.append(message);
+    line.append(LINE_FEED);
+    _batch.append(line.toUTF8());
+}
+
+void ts::AsyncReport::asyncThreadFlush()
+{
+    // Write the complete batch in one single operation.
+    if (!_batch.empty()) {
+        std::cerr.write(_batch.data(), std::streamsize(_batch.size()));
+        std::cerr.flush();
+        _batch.clear();
     }
-    std::cerr << Severity::Header(severity) << message << std::endl;
 }
 
 void ts::AsyncReport::asyncThreadCompleted()
@@ -35,9 +35,10 @@
 #pragma once
 #include "tsReport.h"
 #include "tsAsyncReportArgs.h"
-#include "tsMessageQueue.h"
-#include "tsNullMutex.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
 #include "tsThread.h"
+#include "tsTime.h"
 
 namespace ts {
     //!
@@ -53,7 +54,13 @@ namespace ts {
     //! cannot immediately enqueue a message or if the internal queue of messages is
     //! full, the message is dropped. In other words, reporting messages is guaranteed
     //! to never block, slow down or crash the application. Messages are dropped when
-    //! necessary to avoid that kind of problem.
+    //! necessary to avoid that kind of problem. The number of dropped messages is
+    //! counted and periodically reported by the logging thread.
+    //!
+    //! The internal queue is a lock-free multi-producer single-consumer ring of
+    //! preallocated message slots. Application threads never take a lock to log a
+    //! message. The logging thread drains the messages by batches and, by default,
+    //! writes each batch in one single output operation.
     //!
     //! Messages are displayed on the standard error device by default.
     //!
@@ -106,6 +113,12 @@ namespace ts {
         //!
         void terminate();
 
+        //!
+        //! Get the number of messages which were dropped because the queue was full.
+        //! @return The number of dropped messages since the creation of the report.
+        //!
+        uint64_t droppedMessages() const { return _dropped; }
+
     protected:
         //!
         //! This method is called in the context of the asynchronous logging thread when it starts.
@@ -121,6 +134,25 @@ namespace ts {
         //!
         virtual void asyncThreadLog(int severity, const UString& message);
 
+        //!
+        //! This method is called in the context of the asynchronous logging thread
+        //! after a batch of messages was passed to asyncThreadLog().
+        //! The default implementation writes all messages of the batch on the standard error.
+        //! Subclasses which override asyncThreadLog() may override this one to flush
+        //! their own output.
+        //!
+        virtual void asyncThreadFlush();
+
+        //!
+        //! Get the time stamp of the message which is currently logged.
+        //! Must be called in the context of asyncThreadLog() only.
+        //! When time stamps are activated, the time is captured in binary form when the
+        //! message is enqueued, not when it is displayed.
+        //! @return The UTC time when the current message was enqueued or Time::Epoch if
+        //! time stamps are not activated.
+        //!
+        Time asyncThreadMessageTime() const { return _current_time; }
+
         //!
         //! This method is called in the context of the asynchronous logging thread when it completes.
         //! The default implementation does nothing. Subclasses may override it to get notified.
@@ -134,22 +166,50 @@ namespace ts {
         // This hook is invoked in the context of the logging thread.
         virtual void main() override;
 
-        // The application threads send that type of message to the logging thread
-        struct LogMessage
-        {
-            LogMessage(bool t, int s, const UString& m) : terminate(t), severity(s), message(m) {}
+        // Maximum number of messages which are delivered in one batch.
+        static constexpr size_t MAX_BATCH = 64;
+
+        // Maximum wait time of the logging thread when the queue is empty.
+        // The logging thread is signaled when a message is enqueued but the signal
+        // is skipped when the producer cannot immediately get the mutex.
+        static constexpr MilliSecond IDLE_WAIT = 100;
 
-            bool    terminate;  // ask the logging thread to terminate
-            int     severity;
-            UString message;
+        // One preallocated slot in the ring of messages. The sequence number
+        // implements the lock-free handoff between producers and consumer.
+        struct Slot
+        {
+            Slot() : sequence(0), severity(0), time(), message() {}
+            std::atomic<size_t> sequence;
+            int                 severity;
+            Time                time;
+            UString             message;
         };
-        typedef SafePtr <LogMessage, NullMutex> LogMessagePtr;
-        typedef MessageQueue <LogMessage, NullMutex> LogMessageQueue;
+
+        // Try to enqueue a message, return false when the ring is full.
+        bool enqueue(int severity, const UString& msg);
+
+        // Dequeue a message, return null when the ring is empty.
+        // The returned slot must be released after use.
+        Slot* dequeue();
+        void release(Slot* slot);
+
+        // Wake up the logging thread without blocking.
+        void wakeUp();
 
         // Private members:
-        LogMessageQueue _log_queue;
-        volatile bool   _time_stamp;
-        volatile bool   _synchronous;
-        volatile bool   _terminated;
+        std::vector<Slot>     _slots;          // Ring of messages, size is a power of 2.
+        const size_t          _mask;           // Ring size minus one.
+        std::atomic<size_t>   _enqueue_pos;    // Next position for producers.
+        size_t                _dequeue_pos;    // Next position for the consumer (logging thread only).
+        std::atomic<uint64_t> _dropped;        // Number of dropped messages.
+        uint64_t              _reported_drops; // Number of dropped messages which were already reported.
+        std::atomic<bool>     _stop;           // Request the logging thread to terminate.
+        Mutex                 _wake_mutex;     // Mutex to signal the logging thread.
+        Condition             _wake_cond;      // Condition to signal the logging thread.
+        Time                  _current_time;   // Time stamp of current message (logging thread only).
+        std::string           _batch;          // Current batch of output text (logging thread only).
+        volatile bool         _time_stamp;
+        volatile bool         _synchronous;
+        volatile bool         _terminated;
     };
 }
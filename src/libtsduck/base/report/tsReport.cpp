@@ -136,16 +136,54 @@ void ts::Report::log(int severity, const UString& msg)
     }
 }
 
+// Formatted messages are built in a per-thread buffer which is reused from one message
+// to another, avoiding a heap allocation per message. If a message is logged while another
+// one is being formatted in the same thread (typically from inside writeLog()), a local
+// string is used instead.
+
+namespace {
+    class FormatBuffer
+    {
+        TS_NOCOPY(FormatBuffer);
+    public:
+        ts::UString text;
+        bool busy;
+        FormatBuffer() : text(), busy(false) {}
+        void release()
+        {
+            // Do not keep exceptionally large buffers forever.
+            if (text.capacity() > 16384) {
+                ts::UString().swap(text);
+            }
+            busy = false;
+        }
+    };
+    thread_local FormatBuffer format_buffer;
+}
+
 void ts::Report::log(int severity, const UChar* fmt, std::initializer_list<ArgMixIn> args)
 {
     if (severity <= _max_severity) {
-        log(severity, UString::Format(fmt, args));
+        if (format_buffer.busy) {
+            log(severity, UString::Format(fmt, args));
+        }
+        else {
+            format_buffer.busy = true;
+            format_buffer.text.clear();
+            try {
+                format_buffer.text.format(fmt, args);
+                log(severity, format_buffer.text);
+            }
+            catch (...) {
+                format_buffer.release();
+                throw;
+            }
+            format_buffer.release();
+        }
     }
 }
 
 void ts::Report::log(int severity, const UString& fmt, std::initializer_list<ArgMixIn> args)
 {
-    if (severity <= _max_severity) {
-        log(severity, UString::Format(fmt, args));
-    }
+    log(severity, fmt.c_str(), args);
 }
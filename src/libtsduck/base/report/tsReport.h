@@ -339,3 +339,40 @@ namespace ts {
         volatile bool _got_errors;
     };
 }
+
+//!
+//! @hideinitializer
+//! Log a message on a report only if its severity is enabled.
+//! Unlike the methods of ts::Report, the arguments of the message are not even evaluated when
+//! the severity is not enabled. Use this macro in hot paths, typically for per-packet debug
+//! messages and when the arguments are expensive to build.
+//! @param report A ts::Report object (not a pointer).
+//! @param severity Message severity.
+//! @param ... Message text or format string with its list of arguments, as for ts::Report::log().
+//!
+#define TS_LOG(report, severity, ...)                                    \
+    do {                                                                 \
+        ts::Report& _ts_log_report_(report);                             \
+        const int _ts_log_severity_ = (severity);                        \
+        if (_ts_log_severity_ <= _ts_log_report_.maxSeverity()) {        \
+            _ts_log_report_.log(_ts_log_severity_, __VA_ARGS__);         \
+        }                                                                \
+    } while (false)
+
+//!
+//! @hideinitializer
+//! Log a verbose message on a report, without evaluating its arguments when the severity is not enabled.
+//! @param report A ts::Report object (not a pointer).
+//! @param ... Message text or format string with its list of arguments.
+//! @see TS_LOG
+//!
+#define TS_VERBOSE(report, ...) TS_LOG(report, ts::Severity::Verbose, __VA_ARGS__)
+
+//!
+//! @hideinitializer
+//! Log a debug message on a report, without evaluating its arguments when the severity is not enabled.
+//! @param report A ts::Report object (not a pointer).
+//! @param ... Message text or format string with its list of arguments.
+//! @see TS_LOG
+//!
+#define TS_DEBUG(report, ...) TS_LOG(report, ts::Severity::Debug, __VA_ARGS__)
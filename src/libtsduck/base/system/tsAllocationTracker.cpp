@@ -0,0 +1,332 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsAllocationTracker.h"
+#include "tsGuardMutex.h"
+#include "tsjsonArray.h"
+#include "tsjsonObject.h"
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::AllocationTracker::MAX_SUBSYSTEMS;
+#endif
+
+volatile bool ts::AllocationTracker::_enabled = false;
+
+namespace {
+
+    // Counters for one thread tag. Several threads may share the same tag.
+    class TagCounters
+    {
+        TS_NOBUILD_NOCOPY(TagCounters);
+    public:
+        TagCounters(const ts::UString& tag) : name(tag), count(), bytes() {}
+        const ts::UString name;
+        std::atomic<uint64_t> count[ts::AllocationTracker::MAX_SUBSYSTEMS];
+        std::atomic<uint64_t> bytes[ts::AllocationTracker::MAX_SUBSYSTEMS];
+    };
+
+    // Registry of subsystems and thread tags. The TagCounters are never deleted
+    // because they can be referenced from thread-local pointers.
+    class Registry
+    {
+        TS_NOCOPY(Registry);
+    public:
+        Registry();
+        ts::Mutex mutex;
+        ts::UStringVector subsystems;
+        std::vector<TagCounters*> tags;
+        TagCounters* main_tag;
+        TagCounters* getTag(const ts::UString& name);
+
+        // Access the registry instance. Allocated once, never deleted because
+        // allocations may be counted until the very end of the process.
+        static Registry& Instance();
+    };
+
+    Registry::Registry() :
+        mutex(),
+        subsystems({u"other"}),
+        tags(),
+        main_tag(nullptr)
+    {
+        main_tag = getTag(u"main");
+    }
+
+    Registry& Registry::Instance()
+    {
+        static Registry* const instance = new Registry;
+        return *instance;
+    }
+
+    // Must be called with the mutex held.
+    TagCounters* Registry::getTag(const ts::UString& name)
+    {
+        for (auto tag : tags) {
+            if (tag->name == name) {
+                return tag;
+            }
+        }
+        tags.push_back(new TagCounters(name));
+        return tags.back();
+    }
+
+    // The global counters of the main tag are set once the registry is built.
+    // The thread-local data are trivial types, usable at any time in the life of the thread.
+    std::atomic<TagCounters*> default_tag(nullptr);
+    thread_local TagCounters* current_tag = nullptr;
+    thread_local size_t current_subsystem = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Replacement of the global allocation operators.
+//----------------------------------------------------------------------------
+
+#if defined(TS_ALLOCATION_TRACKING)
+
+void* operator new(size_t size)
+{
+    ts::AllocationTracker::Count(size);
+    void* const ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    ts::AllocationTracker::Count(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& nt) noexcept
+{
+    return operator new(size, nt);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
+
+
+//----------------------------------------------------------------------------
+// Enable or disable the counting of allocations.
+//----------------------------------------------------------------------------
+
+bool ts::AllocationTracker::IsSupported()
+{
+#if defined(TS_ALLOCATION_TRACKING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ts::AllocationTracker::Enable(bool on)
+{
+    if (!IsSupported()) {
+        return false;
+    }
+    if (on && default_tag == nullptr) {
+        // Build the registry before counting.
+        default_tag = Registry::Instance().main_tag;
+    }
+    _enabled = on;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Count one allocation. Must not allocate memory.
+//----------------------------------------------------------------------------
+
+void ts::AllocationTracker::Count(size_t size)
+{
+    if (_enabled) {
+        TagCounters* const tag = current_tag != nullptr ? current_tag : default_tag.load(std::memory_order_relaxed);
+        if (tag != nullptr) {
+            tag->count[current_subsystem].fetch_add(1, std::memory_order_relaxed);
+            tag->bytes[current_subsystem].fetch_add(size, std::memory_order_relaxed);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Subsystems and thread tags.
+//----------------------------------------------------------------------------
+
+size_t ts::AllocationTracker::Subsystem(const UString& name)
+{
+    Registry& reg(Registry::Instance());
+    GuardMutex lock(reg.mutex);
+    for (size_t i = 0; i < reg.subsystems.size(); ++i) {
+        if (reg.subsystems[i] == name) {
+            return i;
+        }
+    }
+    if (reg.subsystems.size() >= MAX_SUBSYSTEMS) {
+        return 0;
+    }
+    reg.subsystems.push_back(name);
+    return reg.subsystems.size() - 1;
+}
+
+void ts::AllocationTracker::SetThreadTag(const UString& tag)
+{
+    if (IsSupported()) {
+        Registry& reg(Registry::Instance());
+        GuardMutex lock(reg.mutex);
+        current_tag = reg.getTag(tag);
+    }
+}
+
+ts::AllocationTracker::Scope::Scope(size_t subsystem) :
+    _previous(current_subsystem)
+{
+    current_subsystem = subsystem < MAX_SUBSYSTEMS ? subsystem : 0;
+}
+
+ts::AllocationTracker::Scope::~Scope()
+{
+    current_subsystem = _previous;
+}
+
+
+//----------------------------------------------------------------------------
+// Get, reset and display counters.
+//----------------------------------------------------------------------------
+
+void ts::AllocationTracker::Reset()
+{
+    Registry& reg(Registry::Instance());
+    GuardMutex lock(reg.mutex);
+    for (auto tag : reg.tags) {
+        for (size_t i = 0; i < MAX_SUBSYSTEMS; ++i) {
+            tag->count[i] = 0;
+            tag->bytes[i] = 0;
+        }
+    }
+}
+
+void ts::AllocationTracker::GetCounters(std::vector<Counters>& counters)
+{
+    counters.clear();
+    {
+        Registry& reg(Registry::Instance());
+        GuardMutex lock(reg.mutex);
+        for (auto tag : reg.tags) {
+            for (size_t i = 0; i < reg.subsystems.size(); ++i) {
+                const uint64_t count = tag->count[i];
+                if (count > 0) {
+                    counters.emplace_back();
+                    counters.back().thread = tag->name;
+                    counters.back().subsystem = reg.subsystems[i];
+                    counters.back().count = count;
+                    counters.back().bytes = tag->bytes[i];
+                }
+            }
+        }
+    }
+    std::sort(counters.begin(), counters.end(), [](const Counters& c1, const Counters& c2) { return c1.bytes > c2.bytes; });
+}
+
+void ts::AllocationTracker::GetTotal(uint64_t& count, uint64_t& bytes)
+{
+    count = bytes = 0;
+    Registry& reg(Registry::Instance());
+    GuardMutex lock(reg.mutex);
+    for (auto tag : reg.tags) {
+        for (size_t i = 0; i < MAX_SUBSYSTEMS; ++i) {
+            count += tag->count[i];
+            bytes += tag->bytes[i];
+        }
+    }
+}
+
+void ts::AllocationTracker::Display(Report& report, int severity)
+{
+    std::vector<Counters> counters;
+    GetCounters(counters);
+    if (counters.empty()) {
+        report.log(severity, u"no allocation was counted");
+    }
+    for (const auto& c : counters) {
+        report.log(severity, u"allocations: %s / %s: %'d allocations, %'d bytes", {c.thread, c.subsystem, c.count, c.bytes});
+    }
+}
+
+void ts::AllocationTracker::ToJSON(json::ValuePtr& value)
+{
+    std::vector<Counters> counters;
+    GetCounters(counters);
+    value = new json::Array;
+    for (const auto& c : counters) {
+        json::ValuePtr jc(new json::Object);
+        jc->add(u"thread", c.thread);
+        jc->add(u"subsystem", c.subsystem);
+        jc->add(u"count", int64_t(c.count));
+        jc->add(u"bytes", int64_t(c.bytes));
+        value->set(jc);
+    }
+}
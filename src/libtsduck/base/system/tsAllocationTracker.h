@@ -0,0 +1,195 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  @ingroup cpp
+//!  Allocation tracking per subsystem and per thread.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+#include "tsReport.h"
+#include "tsjsonValue.h"
+
+namespace ts {
+    //!
+    //! Allocation tracking per subsystem and per thread.
+    //! @ingroup cpp
+    //!
+    //! When the library is compiled with the macro @c TS_ALLOCATION_TRACKING (use @c ALLOCTRACKING=1
+    //! on the make command line), the global allocation operators are replaced to count the number
+    //! of allocations and allocated bytes. Without this macro, nothing is counted and there is no
+    //! runtime overhead.
+    //!
+    //! Even when compiled in, the counting is disabled by default and must be enabled at run time
+    //! using Enable(). In @a tsp, this is done using the option @c --allocation-tracking.
+    //!
+    //! Each allocation is accounted in two dimensions:
+    //! - The thread tag. Each ts::Thread is tagged with its name when it starts. The plugin
+    //!   threads of @a tsp are tagged with the plugin name. Untagged threads (typically the
+    //!   main thread) are accounted under the tag "main".
+    //! - The subsystem. A subsystem is a named section of code, typically a class, which is
+    //!   declared using the macro TS_ALLOCATION_SCOPE() at the beginning of a function. The
+    //!   innermost scope receives the allocations. Allocations outside any scope are accounted
+    //!   under the subsystem "other".
+    //!
+    //! Note that the allocations which are served by ts::MemoryPool from its free lists do not
+    //! reach the global allocation operators and are not counted.
+    //!
+    class TSDUCKDLL AllocationTracker
+    {
+    public:
+        //!
+        //! Maximum number of subsystems. Additional subsystems are accounted as "other".
+        //!
+        static constexpr size_t MAX_SUBSYSTEMS = 64;
+
+        //!
+        //! Allocation counters for one subsystem in one thread tag.
+        //!
+        class TSDUCKDLL Counters
+        {
+        public:
+            UString  thread {};     //!< Thread tag.
+            UString  subsystem {};  //!< Subsystem name.
+            uint64_t count = 0;     //!< Number of allocations.
+            uint64_t bytes = 0;     //!< Total allocated bytes.
+        };
+
+        //!
+        //! Check if allocation tracking is compiled in the library.
+        //! @return True if allocation tracking is supported.
+        //!
+        static bool IsSupported();
+
+        //!
+        //! Enable or disable the counting of allocations.
+        //! @param [in] on True to enable, false to disable.
+        //! @return True on success, false if allocation tracking is not supported.
+        //!
+        static bool Enable(bool on = true);
+
+        //!
+        //! Check if the counting of allocations is enabled.
+        //! @return True if the counting of allocations is enabled.
+        //!
+        static bool IsEnabled() { return _enabled; }
+
+        //!
+        //! Get the index of a subsystem, register it the first time.
+        //! @param [in] name Subsystem name.
+        //! @return Subsystem index.
+        //!
+        static size_t Subsystem(const UString& name);
+
+        //!
+        //! Set the tag of the current thread.
+        //! @param [in] tag Thread tag. All threads with the same tag share the same counters.
+        //!
+        static void SetThreadTag(const UString& tag);
+
+        //!
+        //! Reset all counters.
+        //!
+        static void Reset();
+
+        //!
+        //! Get all non-zero counters.
+        //! @param [out] counters Returned counters, sorted by decreasing number of bytes.
+        //!
+        static void GetCounters(std::vector<Counters>& counters);
+
+        //!
+        //! Get the total allocations in all threads and subsystems.
+        //! @param [out] count Total number of allocations.
+        //! @param [out] bytes Total allocated bytes.
+        //!
+        static void GetTotal(uint64_t& count, uint64_t& bytes);
+
+        //!
+        //! Display all non-zero counters on a report.
+        //! @param [in,out] report Where to display the counters.
+        //! @param [in] severity Severity of the messages.
+        //!
+        static void Display(Report& report, int severity = Severity::Info);
+
+        //!
+        //! Build a JSON representation of all non-zero counters.
+        //! @param [out] value A JSON array of objects, one per counter.
+        //!
+        static void ToJSON(json::ValuePtr& value);
+
+        //!
+        //! Count one allocation in the current thread and subsystem.
+        //! Called by the global allocation operators. Never allocates memory.
+        //! @param [in] size Allocated size in bytes.
+        //!
+        static void Count(size_t size);
+
+        //!
+        //! Declare that the current thread executes inside a subsystem.
+        //! The previous subsystem of the thread is restored when the object is destroyed.
+        //! Use the macro TS_ALLOCATION_SCOPE() instead of directly declaring an instance.
+        //!
+        class TSDUCKDLL Scope
+        {
+            TS_NOBUILD_NOCOPY(Scope);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] subsystem Subsystem index, as returned by Subsystem().
+            //!
+            Scope(size_t subsystem);
+            //!
+            //! Destructor.
+            //!
+            ~Scope();
+        private:
+            size_t _previous;
+        };
+
+    private:
+        static volatile bool _enabled;
+    };
+}
+
+//!
+//! @hideinitializer
+//! Declare that the rest of the current block executes inside an allocation tracking subsystem.
+//! Does nothing when the library is not compiled with @c TS_ALLOCATION_TRACKING.
+//! @param name Subsystem name, a string literal.
+//!
+#if defined(TS_ALLOCATION_TRACKING) || defined(DOXYGEN)
+#define TS_ALLOCATION_SCOPE(name)                                                                                          \
+    static const size_t TS_UNIQUE_NAME(_ts_alloc_subsystem) = ts::AllocationTracker::Subsystem(name);                      \
+    ts::AllocationTracker::Scope TS_UNIQUE_NAME(_ts_alloc_scope)(TS_UNIQUE_NAME(_ts_alloc_subsystem))
+#else
+#define TS_ALLOCATION_SCOPE(name) do {} while (false)
+#endif
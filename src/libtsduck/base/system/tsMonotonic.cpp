@@ -114,7 +114,27 @@ void ts::Monotonic::getSystemTime()
 // Wait until the time of the monotonic clock.
 //----------------------------------------------------------------------------
 
-void ts::Monotonic::wait()
+void ts::Monotonic::wait(NanoSecond spin)
+{
+    if (spin <= 0) {
+        sleepUntil();
+    }
+    else {
+        // Sleep until the start of the active wait.
+        Monotonic now(true);
+        if (*this - now > spin) {
+            Monotonic start(*this);
+            start -= spin;
+            start.sleepUntil();
+        }
+        // Actively poll the clock until due time.
+        do {
+            now.getSystemTime();
+        } while (now < *this);
+    }
+}
+
+void ts::Monotonic::sleepUntil()
 {
 #if defined(TS_WINDOWS)
 
@@ -158,10 +158,22 @@ namespace ts {
             return (_value - t._value) * NS_PER_TICK;
         }
 
+        //!
+        //! Get the value of the monotonic clock in nanoseconds.
+        //! The origin of the clock is system-specific. The value can be compared with
+        //! other values of the same clock. On Linux, this is the CLOCK_MONOTONIC clock.
+        //! @return The value of the monotonic clock in nanoseconds.
+        //!
+        NanoSecond nanoSeconds() const { return _value * NS_PER_TICK; }
+
         //!
         //! Wait until the time of the monotonic clock.
+        //! @param [in] spin Duration in nanoseconds of a final active wait. When positive, the
+        //! thread sleeps until @a spin nanoseconds before the due time and then actively polls
+        //! the clock until the due time. This absorbs the wake-up latency of the system at the
+        //! expense of some CPU time. When zero or negative, the thread only sleeps.
         //!
-        void wait();
+        void wait(NanoSecond spin = 0);
 
         //!
         //! This static method requests a minimum resolution, in nano-seconds, for the timers.
@@ -175,6 +187,9 @@ namespace ts {
         // Monotonic clock value in system ticks
         int64_t _value;
 
+        // Passive wait until the time of the monotonic clock.
+        void sleepUntil();
+
 #if defined(TS_WINDOWS)
         // Timer handle
         ::HANDLE _handle;
@@ -0,0 +1,199 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsStartupProfile.h"
+#include "tsMutex.h"
+#include "tsGuardMutex.h"
+
+namespace {
+    // Enabled state: -1 = not yet checked, 0 = disabled, 1 = enabled.
+    // Constant-initialized, usable at any time during the static initialization.
+    std::atomic<int> _enabled(-1);
+
+    // Time of the static initialization of the library (approximately).
+    const ts::Monotonic _startup(true);
+
+    // Cumulated description of a phase.
+    class PhaseData
+    {
+    public:
+        ts::UString name;
+        ts::NanoSecond duration;
+        size_t count;
+        PhaseData(const ts::UString& n, ts::NanoSecond d) : name(n), duration(d), count(1) {}
+    };
+
+    // Repository of phases, created on first use.
+    class PhaseRepository
+    {
+        TS_NOCOPY(PhaseRepository);
+    public:
+        ts::Mutex mutex;
+        std::vector<PhaseData> phases;
+        PhaseRepository() : mutex(), phases() {}
+        static PhaseRepository& Instance()
+        {
+            static PhaseRepository repo;
+            return repo;
+        }
+    };
+
+    // Display the profile when the application exits.
+    void DisplayAtExit()
+    {
+        ts::StartupProfile::Display();
+    }
+
+    // Set the enabled state.
+    void SetEnabled(bool on)
+    {
+        if (on) {
+            // The first time profiling is enabled, create the repository and register the final display.
+            // Since the repository is built first, it will be destroyed after the display at exit.
+            static std::atomic<bool> registered(false);
+            if (!registered.exchange(true)) {
+                PhaseRepository::Instance();
+                std::atexit(DisplayAtExit);
+            }
+        }
+        _enabled.store(on ? 1 : 0, std::memory_order_relaxed);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Enable / disable startup profiling.
+//----------------------------------------------------------------------------
+
+bool ts::StartupProfile::IsEnabled()
+{
+    int state = _enabled.load(std::memory_order_relaxed);
+    if (state < 0) {
+        // First call, check the environment. Use raw getenv(), may be called during static initialization.
+        const char* env = ::getenv("TSDUCK_STARTUP_PROFILE");
+        state = env != nullptr && env[0] != '\0';
+        SetEnabled(state > 0);
+    }
+    return state > 0;
+}
+
+void ts::StartupProfile::Enable(bool on)
+{
+    SetEnabled(on);
+}
+
+
+//----------------------------------------------------------------------------
+// Get the time since the initialization of the library.
+//----------------------------------------------------------------------------
+
+ts::NanoSecond ts::StartupProfile::SinceStartup()
+{
+    return Monotonic(true) - _startup;
+}
+
+
+//----------------------------------------------------------------------------
+// Accumulate the duration of an initialization phase.
+//----------------------------------------------------------------------------
+
+void ts::StartupProfile::AddPhase(const UString& phase, NanoSecond duration)
+{
+    if (IsEnabled()) {
+        PhaseRepository& repo(PhaseRepository::Instance());
+        GuardMutex lock(repo.mutex);
+        for (auto& it : repo.phases) {
+            if (it.name == phase) {
+                it.duration += duration;
+                it.count++;
+                return;
+            }
+        }
+        repo.phases.push_back(PhaseData(phase, duration));
+    }
+}
+
+void ts::StartupProfile::Clear()
+{
+    PhaseRepository& repo(PhaseRepository::Instance());
+    GuardMutex lock(repo.mutex);
+    repo.phases.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Format and display the startup profile.
+//----------------------------------------------------------------------------
+
+ts::UString ts::StartupProfile::ToText()
+{
+    PhaseRepository& repo(PhaseRepository::Instance());
+    GuardMutex lock(repo.mutex);
+
+    size_t width = 0;
+    for (const auto& it : repo.phases) {
+        width = std::max(width, it.name.width());
+    }
+
+    UString text;
+    for (const auto& it : repo.phases) {
+        text += UString::Format(u"  %s %s %9'd us", {it.name, UString(width + 2 - it.name.width(), u'.'), it.duration / NanoSecPerMicroSec});
+        if (it.count > 1) {
+            text += UString::Format(u" (%d times)", {it.count});
+        }
+        text.append(u"\n");
+    }
+    return text;
+}
+
+void ts::StartupProfile::Display()
+{
+    if (IsEnabled()) {
+        std::cerr << "* Startup profile:" << std::endl << ToText();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Measure the duration of an initialization phase.
+//----------------------------------------------------------------------------
+
+ts::StartupProfile::Phase::Phase(const UChar* name) :
+    _name(name),
+    _enabled(IsEnabled()),
+    _start(_enabled)
+{
+}
+
+ts::StartupProfile::Phase::~Phase()
+{
+    if (_enabled) {
+        AddPhase(_name, Monotonic(true) - _start);
+    }
+}
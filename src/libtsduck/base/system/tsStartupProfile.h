@@ -0,0 +1,132 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Profiling of the initialization phases of an application.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+#include "tsMonotonic.h"
+
+namespace ts {
+    //!
+    //! Profiling of the initialization phases of an application.
+    //! @ingroup system
+    //!
+    //! Short-lived commands may spend more time initializing than working. This class
+    //! accumulates the time which is spent in the main initialization phases (static
+    //! initialization of the library, materialization of the PSI repository, loading
+    //! of names files, loading of plugin libraries, analysis of command lines, etc.)
+    //!
+    //! Profiling is disabled by default and costs one boolean test per phase. It is
+    //! enabled when the environment variable @c TSDUCK_STARTUP_PROFILE is defined and
+    //! not empty, or when the command is invoked with the option @c --startup-profile
+    //! (see MainWrapper()). The profile is displayed on the standard error when the
+    //! application exits.
+    //!
+    //! All methods are static and thread-safe.
+    //!
+    class TSDUCKDLL StartupProfile
+    {
+        TS_NOBUILD_NOCOPY(StartupProfile);
+    public:
+        //!
+        //! Name of the command line option which enables the startup profile.
+        //!
+        static constexpr const char* OPTION = "--startup-profile";
+
+        //!
+        //! Check if startup profiling is enabled.
+        //! @return True if startup profiling is enabled.
+        //!
+        static bool IsEnabled();
+
+        //!
+        //! Enable or disable startup profiling.
+        //! @param [in] on True to enable, false to disable.
+        //!
+        static void Enable(bool on = true);
+
+        //!
+        //! Accumulate the duration of an initialization phase.
+        //! Successive durations for the same phase name are cumulated.
+        //! Does nothing when startup profiling is disabled.
+        //! @param [in] phase Name of the initialization phase.
+        //! @param [in] duration Duration of the phase in nanoseconds.
+        //!
+        static void AddPhase(const UString& phase, NanoSecond duration);
+
+        //!
+        //! Get the time since the initialization of the library.
+        //! @return The number of nanoseconds since the TSDuck library was initialized.
+        //!
+        static NanoSecond SinceStartup();
+
+        //!
+        //! Format the startup profile as a text.
+        //! @return A multi-line text describing all recorded phases, in order of first occurence.
+        //!
+        static UString ToText();
+
+        //!
+        //! Display the startup profile on the standard error if startup profiling is enabled.
+        //!
+        static void Display();
+
+        //!
+        //! Clear all recorded phases.
+        //!
+        static void Clear();
+
+        //!
+        //! Measure the duration of an initialization phase.
+        //! The phase starts when the object is constructed and ends when it is destroyed.
+        //!
+        class TSDUCKDLL Phase
+        {
+            TS_NOBUILD_NOCOPY(Phase);
+        public:
+            //!
+            //! Constructor, start the phase.
+            //! @param [in] name Name of the phase. Must be a static string.
+            //!
+            explicit Phase(const UChar* name);
+            //!
+            //! Destructor, end of the phase.
+            //!
+            ~Phase();
+        private:
+            const UChar* _name;
+            bool         _enabled;
+            Monotonic    _start;
+        };
+    };
+}
@@ -34,6 +34,7 @@
 #include "tsSysUtils.h"
 #include "tsSysInfo.h"
 #include "tsIntegerUtils.h"
+#include "tsAllocationTracker.h"
 
 #if defined(TS_LINUX)
     #include "tsBeforeStandardHeaders.h"
@@ -371,6 +372,7 @@ void ts::Thread::mainWrapper()
 #elif defined(TS_WINDOWS)
         ::SetThreadDescription(::GetCurrentThread(), name.wc_str());
 #endif
+        AllocationTracker::SetThreadTag(name);
     }
 
     try {
@@ -27,6 +27,7 @@
 //
 //----------------------------------------------------------------------------
 
+
 #include "tsTextParser.h"
 
 
@@ -36,8 +37,8 @@
 
 ts::TextParser::TextParser(Report& report) :
     _report(report),
-    _lines(),
-    _pos(_lines)
+    _text(),
+    _pos(_text)
 {
 }
 
@@ -53,11 +54,10 @@ ts::TextParser::TextParser(const UString& text, Report& report) :
     loadDocument(text);
 }
 
-ts::TextParser::Position::Position(const UStringList& textLines) :
-    _lines(&textLines),
-    _curLine(textLines.begin()),
-    _curLineNumber(1),
-    _curIndex(0)
+ts::TextParser::Position::Position(const std::string& text) :
+    _text(&text),
+    _offset(0),
+    _line(1)
 {
 }
 
@@ -72,8 +72,8 @@ ts::TextParser::~TextParser()
 
 void ts::TextParser::clear()
 {
-    _lines.clear();
-    _pos = Position(_lines);
+    _text.clear();
+    _pos = Position(_text);
 }
 
 
@@ -83,39 +83,107 @@ void ts::TextParser::clear()
 
 void ts::TextParser::loadDocument(const UStringList& lines)
 {
-    _lines.clear();
-    _pos = Position(lines);
+    _text.clear();
+    std::string line;
+    for (const auto& it : lines) {
+        it.toUTF8(line);
+        _text.append(line);
+        _text.push_back('\n');
+    }
+    _pos = Position(_text);
 }
 
 void ts::TextParser::loadDocument(const UString& text)
 {
-    text.toSubstituted(u"\r", UString()).split(_lines, u'\n', false);
-    _pos = Position(_lines);
+    // Same as splitting the text in lines, ignoring all CR.
+    text.toSubstituted(u"\r", UString()).toUTF8(_text);
+    _text.push_back('\n');
+    _pos = Position(_text);
 }
 
 bool ts::TextParser::loadFile(const UString& fileName)
 {
-    // Load the file into the internal lines buffer.
-    const bool ok = UString::Load(_lines, fileName);
+    // Preallocate the internal buffer to the file size, plus a possible final new-line.
+    std::ifstream strm(fileName.toUTF8().c_str(), std::ios::in | std::ios::binary);
+    _text.clear();
+    if (strm.is_open()) {
+        if (strm.seekg(0, std::ios::end)) {
+            const std::streamoff size = strm.tellg();
+            if (size > 0) {
+                _text.reserve(size_t(size) + 1);
+            }
+            strm.seekg(0, std::ios::beg);
+        }
+        // Clear a possible seek error on a non-seekable file, it is simply read.
+        strm.clear();
+    }
+
+    const bool ok = strm.is_open() && loadUTF8(strm);
     if (!ok) {
         _report.error(u"error reading file %s", {fileName});
     }
-
-    // Initialize the parser on the internal lines buffer, including on file error (empty).
-    _pos = Position(_lines);
     return ok;
 }
 
 bool ts::TextParser::loadStream(std::istream& strm)
 {
-    // Load the file into the internal lines buffer.
-    const bool ok = UString::Load(_lines, strm);
+    _text.clear();
+    const bool ok = loadUTF8(strm);
     if (!ok) {
         _report.error(u"error reading input document");
     }
+    return ok;
+}
 
-    // Initialize the parser on the internal lines buffer, including on file error (empty).
-    _pos = Position(_lines);
+
+//----------------------------------------------------------------------------
+// Load the UTF-8 document from a stream, at end of current internal buffer.
+//----------------------------------------------------------------------------
+
+bool ts::TextParser::loadUTF8(std::istream& strm)
+{
+    // Read the complete stream in the internal buffer, chunk by chunk.
+    constexpr size_t CHUNK_SIZE = 64 * 1024;
+    size_t size = _text.size();
+    while (strm) {
+        _text.resize(size + CHUNK_SIZE);
+        strm.read(&_text[size], std::streamsize(CHUNK_SIZE));
+        size += size_t(strm.gcount());
+    }
+    _text.resize(size);
+    const bool ok = strm.eof() && !strm.bad();
+
+    // Make sure that the last line is terminated.
+    if (!_text.empty() && _text.back() != '\n') {
+        _text.push_back('\n');
+    }
+
+    // Remove trailing CR and leading UTF-8 BOM on each line, in place.
+    // This is what UString::getLine() does when loading a text file line by line.
+    size_t write = 0;
+    size_t read = 0;
+    while (read < _text.size()) {
+        const size_t eol = _text.find('\n', read);
+        assert(eol != std::string::npos);
+        size_t start = read;
+        size_t end = eol;
+        while (end > start && _text[end - 1] == '\r') {
+            --end;
+        }
+        if (end - start >= UString::UTF8_BOM_SIZE && _text.compare(start, UString::UTF8_BOM_SIZE, UString::UTF8_BOM) == 0) {
+            start += UString::UTF8_BOM_SIZE;
+        }
+        if (write != start) {
+            std::copy(_text.begin() + start, _text.begin() + end, _text.begin() + write);
+        }
+        write += end - start;
+        _text[write++] = '\n';
+        read = eol + 1;
+    }
+    _text.resize(write);
+
+    // Initialize the parser on the internal buffer, including on file error (truncated).
+    _pos = Position(_text);
     return ok;
 }
 
@@ -126,12 +194,53 @@ bool ts::TextParser::loadStream(std::istream& strm)
 
 bool ts::TextParser::saveFile(const UString& fileName)
 {
-    return UString::Save(_lines, fileName);
+    std::ofstream strm(fileName.toUTF8().c_str(), std::ios::out | std::ios::binary);
+    return saveStream(strm);
 }
 
 bool ts::TextParser::saveStream(std::ostream& strm)
 {
-    return UString::Save(_lines, strm);
+    strm.write(_text.data(), std::streamsize(_text.size()));
+    return bool(strm);
+}
+
+
+//----------------------------------------------------------------------------
+// Get the character at a given offset in the document, non-ASCII case.
+//----------------------------------------------------------------------------
+
+ts::UChar ts::TextParser::decodeAt(size_t offset, size_t& size) const
+{
+    if (offset >= _text.size()) {
+        size = 0;
+        return CHAR_NULL;
+    }
+
+    const size_t remain = _text.size() - offset;
+    const uint32_t code = uint8_t(_text[offset]);
+    if (code < 0x80) {
+        size = 1;
+        return UChar(code);
+    }
+    else if ((code & 0xE0) == 0xC0 && remain >= 2) {
+        size = 2;
+        return UChar(((code & 0x1F) << 6) | (_text[offset + 1] & 0x3F));
+    }
+    else if ((code & 0xF0) == 0xE0 && remain >= 3) {
+        size = 3;
+        return UChar(((code & 0x0F) << 12) | ((_text[offset + 1] & 0x3F) << 6) | (_text[offset + 2] & 0x3F));
+    }
+    else if ((code & 0xF8) == 0xF0 && remain >= 4) {
+        // Outside the BMP, return the leading surrogate, as in a UTF-16 string.
+        size = 4;
+        const uint32_t cp = ((code & 0x07) << 18) | ((uint32_t(_text[offset + 1] & 0x3F)) << 12) | ((uint32_t(_text[offset + 2] & 0x3F)) << 6) | (_text[offset + 3] & 0x3F);
+        return UChar(0xD800 + ((cp - 0x10000) >> 10));
+    }
+    else {
+        // Invalid UTF-8 sequence, return the Unicode replacement character.
+        size = 1;
+        return UChar(0xFFFD);
+    }
 }
 
 
@@ -142,8 +251,7 @@ bool ts::TextParser::saveStream(std::ostream& strm)
 bool ts::TextParser::seek(const Position& pos)
 {
     // Check that we are still on the same document. This is a minimum fool-proof check.
-    // But there is no guarantee that pos.curLine is still valid.
-    if (pos._lines == _pos._lines) {
+    if (pos._text == _pos._text && pos._offset <= _text.size()) {
         _pos = pos;
         return true;
     }
@@ -159,17 +267,17 @@ bool ts::TextParser::seek(const Position& pos)
 
 bool ts::TextParser::eof() const
 {
-    return _pos._curLine == _pos._lines->end();
+    return _pos._offset >= _text.size();
 }
 
 bool ts::TextParser::eol() const
 {
-    return _pos._curLine == _pos._lines->end() || _pos._curIndex >= _pos._curLine->length();
+    return _pos._offset >= _text.size() || _text[_pos._offset] == '\n';
 }
 
 void ts::TextParser::rewind()
 {
-    _pos = Position(_lines);
+    _pos = Position(_text);
 }
 
 
@@ -179,19 +287,16 @@ void ts::TextParser::rewind()
 
 bool ts::TextParser::skipWhiteSpace()
 {
-    while (_pos._curLine != _pos._lines->end()) {
-        // Skip spaces in current line.
-        while (_pos._curIndex < _pos._curLine->length() && IsSpace((*_pos._curLine)[_pos._curIndex])) {
-            _pos._curIndex++;
+    size_t size = 0;
+    while (_pos._offset < _text.size()) {
+        const UChar c = charAt(_pos._offset, size);
+        if (c == LINE_FEED) {
+            _pos._line++;
         }
-        // Stop if not at end of line (non-space character found).
-        if (_pos._curIndex < _pos._curLine->length()) {
-            return true;
+        else if (!IsSpace(c)) {
+            break;
         }
-        // Move to next line.
-        _pos._curLine++;
-        _pos._curLineNumber++;
-        _pos._curIndex = 0;
+        _pos._offset += size;
     }
     return true;
 }
@@ -203,10 +308,13 @@ bool ts::TextParser::skipWhiteSpace()
 
 bool ts::TextParser::skipLine()
 {
-    while (_pos._curLine != _pos._lines->end()) {
-        _pos._curLine++;
-        _pos._curLineNumber++;
-        _pos._curIndex = 0;
+    const size_t eol = _text.find('\n', _pos._offset);
+    if (eol == std::string::npos) {
+        _pos._offset = _text.size();
+    }
+    else {
+        _pos._offset = eol + 1;
+        _pos._line++;
     }
     return true;
 }
@@ -216,24 +324,41 @@ bool ts::TextParser::skipLine()
 // Check if the current position in the document matches a string.
 //----------------------------------------------------------------------------
 
-bool ts::TextParser::match(const UString& str, bool skipIfMatch, CaseSensitivity cs)
+bool ts::TextParser::match(const UChar* str, size_t len, bool skipIfMatch, CaseSensitivity cs)
 {
-    if (_pos._curLine == _pos._lines->end()) {
-        // Already at end of document.
+    // Each UTF-16 character uses at least one byte in UTF-8.
+    if (_pos._offset + len > _text.size()) {
         return false;
     }
 
-    size_t lineIndex = _pos._curIndex;
-    size_t strIndex = 0;
-    while (strIndex < str.length()) {
-        if (lineIndex >= _pos._curLine->length() || !Match(str[strIndex++], (*_pos._curLine)[lineIndex++], cs)) {
+    size_t offset = _pos._offset;
+    size_t size = 0;
+    for (size_t i = 0; i < len; ++i) {
+        const UChar c = charAt(offset, size);
+        if (size == 0) {
+            // Reached end of document.
+            return false;
+        }
+        else if (size == 4) {
+            // Character outside the BMP, compare the complete surrogate pair.
+            UChar pair[2];
+            UChar* out = pair;
+            const char* in = _text.data() + offset;
+            UString::ConvertUTF8ToUTF16(in, in + size, out, pair + 2);
+            if (i + 1 >= len || str[i] != pair[0] || str[i + 1] != pair[1]) {
+                return false;
+            }
+            ++i;
+        }
+        else if (cs == CASE_SENSITIVE ? str[i] != c : !Match(str[i], c, cs)) {
             // str does not match
             return false;
         }
+        offset += size;
     }
 
     if (skipIfMatch) {
-        _pos._curIndex = lineIndex;
+        _pos._offset = offset;
     }
     return true;
 }
@@ -255,9 +380,9 @@ bool ts::TextParser::isXMLNameChar(UChar c) const
 
 bool ts::TextParser::isAtXMLNameStart() const
 {
-    return _pos._curLine != _pos._lines->end() &&
-        _pos._curIndex < _pos._curLine->length() &&
-        isXMLNameStartChar((*_pos._curLine)[_pos._curIndex]);
+    size_t size = 0;
+    const UChar c = charAt(_pos._offset, size);
+    return size > 0 && isXMLNameStartChar(c);
 }
 
 
@@ -274,12 +399,13 @@ bool ts::TextParser::parseXMLName(UString& name)
         return false;
     }
 
-    // Get the name.
-    UChar c;
-    while (_pos._curIndex < _pos._curLine->length() && isXMLNameChar(c = (*_pos._curLine)[_pos._curIndex])) {
-        name.append(c);
-        _pos._curIndex++;
+    // Locate the end of the name and convert it at once.
+    const size_t start = _pos._offset;
+    size_t size = 0;
+    while (isXMLNameChar(charAt(_pos._offset, size)) && size > 0) {
+        _pos._offset += size;
     }
+    name.assignFromUTF8(_text.data() + start, _pos._offset - start);
     return true;
 }
 
@@ -290,10 +416,9 @@ bool ts::TextParser::parseXMLName(UString& name)
 
 bool ts::TextParser::isAtNumberStart() const
 {
-    UChar c = CHAR_NULL;
-    return _pos._curLine != _pos._lines->end() &&
-        _pos._curIndex < _pos._curLine->length() &&
-        (IsDigit(c = (*_pos._curLine)[_pos._curIndex]) || c == u'-' || c == u'+');
+    size_t size = 0;
+    const UChar c = charAt(_pos._offset, size);
+    return IsDigit(c) || c == u'-' || c == u'+';
 }
 
 
@@ -305,29 +430,30 @@ bool ts::TextParser::parseNumericLiteral(UString& str, bool allowHexa, bool allo
 {
     str.clear();
 
-    // Eliminate end of file or line.
-    if (_pos._curLine == _pos._lines->end() || _pos._curIndex >= _pos._curLine->length()) {
-        return false;
-    }
-
-    const UString& line(*_pos._curLine);
-    const size_t end = line.length();
-    size_t index = _pos._curIndex;
+    // The end of line or end of file is never part of a number (CHAR_NULL or LINE_FEED).
+    size_t index = _pos._offset;
+    size_t size = 0;
+    UChar c = charAt(index, size);
 
     // Skip optional sign.
-    if (line[index] == u'-' || line[index] == u'+') {
-        ++index;
+    if (c == u'-' || c == u'+') {
+        index += size;
+        c = charAt(index, size);
     }
 
     // Detect number start.
-    if (index >= end || !IsDigit(line[index])) {
+    if (!IsDigit(c)) {
         return false;
     }
 
     // Detect hexadecimal literal, skip integral part.
-    if (index + 2 < end && line[index] == u'0' && (line[index+1] == u'x' || line[index+1] == u'X') && IsHexa(line[index+2])) {
+    size_t size1 = 0;
+    size_t size2 = 0;
+    const UChar c1 = charAt(index + size, size1);
+    const UChar c2 = charAt(index + size + size1, size2);
+    if (c == u'0' && (c1 == u'x' || c1 == u'X') && IsHexa(c2)) {
         // Detected hexadecimal prefix, skip it.
-        index += 3;
+        index += size + size1 + size2;
         // Reject if hexa not allowed by caller.
         if (!allowHexa) {
             return false;
@@ -335,44 +461,47 @@ bool ts::TextParser::parseNumericLiteral(UString& str, bool allowHexa, bool allo
         // Reject floating point format with hexa.
         allowFloat = false;
         // Skip all hexa digits.
-        while (index < end && IsHexa(line[index])) {
-            ++index;
+        while (IsHexa(c = charAt(index, size))) {
+            index += size;
         }
     }
     else {
         // Skip decimal integral part.
-        while (index < end && IsDigit(line[index])) {
-            ++index;
+        while (IsDigit(c = charAt(index, size))) {
+            index += size;
         }
     }
 
     // Skip additional floating point representation.
     if (allowFloat) {
-        if (index < end && line[index] == u'.') {
-            ++index;
-            while (index < end && IsDigit(line[index])) {
-                ++index;
+        if (c == u'.') {
+            index += size;
+            while (IsDigit(c = charAt(index, size))) {
+                index += size;
             }
         }
-        if (index < end && (line[index] == u'e' || line[index] == u'E')) {
-            ++index;
-            if (index < end && (line[index] == u'+' || line[index] == u'-')) {
-                ++index;
+        if (c == u'e' || c == u'E') {
+            index += size;
+            c = charAt(index, size);
+            if (c == u'+' || c == u'-') {
+                index += size;
+                c = charAt(index, size);
             }
-            while (index < end && IsDigit(line[index])) {
-                ++index;
+            while (IsDigit(c)) {
+                index += size;
+                c = charAt(index, size);
             }
         }
     }
 
     // Reached end of numeric literal. Validate next character.
-    if (index < end && (line[index] == u'.' || line[index] == u'_' || IsAlpha(line[index]))) {
+    if (c == u'.' || c == u'_' || IsAlpha(c)) {
         return false;
     }
     else {
         // Now we have a valid numeric literal.
-        str = _pos._curLine->substr(_pos._curIndex, index - _pos._curIndex);
-        _pos._curIndex = index;
+        str.assignFromUTF8(_text.data() + _pos._offset, index - _pos._offset);
+        _pos._offset = index;
         return true;
     }
 }
@@ -386,18 +515,10 @@ bool ts::TextParser::parseStringLiteral(UString& str, UChar requiredQuote)
 {
     str.clear();
 
-    // Check that we are at the beginning of something.
-    if (_pos._curLine == _pos._lines->end() || _pos._curIndex >= _pos._curLine->length()) {
-        // At eol or eof.
-        return false;
-    }
-
-    const UString& line(*_pos._curLine);
-    const size_t end = line.length();
-    size_t index = _pos._curIndex;
-
-    // Validate the type of quote.
-    const UChar quote = line[index++];
+    // Validate the type of quote (also fail at eol or eof).
+    size_t index = _pos._offset;
+    size_t size = 0;
+    const UChar quote = charAt(index, size);
     if (requiredQuote == u'\'' && quote != u'\'') {
         return false;
     }
@@ -407,25 +528,31 @@ bool ts::TextParser::parseStringLiteral(UString& str, UChar requiredQuote)
     if (quote != u'\'' && quote != u'"') {
         return false;
     }
+    index += size;
 
     // Now parse all characters in the string.
     UChar c = CHAR_NULL;
-    while (index < end && (c = line[index]) != quote) {
-        index++;
+    while ((c = charAt(index, size)) != quote) {
+        if (size == 0 || c == LINE_FEED) {
+            // Reached eol without finding the closing quote.
+            return false;
+        }
+        index += size;
         if (c == u'\\') {
-            index++; // skip character after backslash.
+            // Skip character after backslash.
+            c = charAt(index, size);
+            if (size == 0 || c == LINE_FEED) {
+                return false;
+            }
+            index += size;
         }
     }
-    if (index >= end) {
-        // Reached eol without finding the closing quote.
-        return false;
-    }
-    else {
-        // Now we have a string literal.
-        str = line.substr(_pos._curIndex, index + 1 - _pos._curIndex);
-        _pos._curIndex = index + 1;
-        return true;
-    }
+
+    // Now we have a string literal.
+    index += size;
+    str.assignFromUTF8(_text.data() + _pos._offset, index - _pos._offset);
+    _pos._offset = index;
+    return true;
 }
 
 
@@ -454,31 +581,18 @@ bool ts::TextParser::parseJSONStringLiteral(UString& str)
 // Parse text up to a given token.
 //----------------------------------------------------------------------------
 
-bool ts::TextParser::parseText(UString& result, const UString endToken, bool skipIfMatch, bool translateEntities)
+bool ts::TextParser::parseText(UString& result, const UString& endToken, bool skipIfMatch, bool translateEntities)
 {
-    result.clear();
-    bool found = false;
-
-    // Loop on all lines until the end token is found.
-    while (!found && _pos._curLine != _pos._lines->end()) {
-
-        // Search for the end token in current line.
-        const size_t end = _pos._curLine->find(endToken, _pos._curIndex);
-        if (end == NPOS) {
-            // End token not found, include the complete end of line.
-            result.append(*_pos._curLine, _pos._curIndex);
-            result.append(LINE_FEED);
-            _pos._curLine++;
-            _pos._curLineNumber++;
-            _pos._curIndex = 0;
-        }
-        else {
-            // Found end token, stop here.
-            result.append(*_pos._curLine, _pos._curIndex, end - _pos._curIndex);
-            _pos._curIndex = skipIfMatch ? end + endToken.length() : end;
-            found = true;
-        }
-    }
+    // Search the end token in the UTF-8 document, the text is converted at once.
+    // The end token is never searched across lines, as long as it does not contain a new-line.
+    const std::string token(endToken.toUTF8());
+    const size_t end = _text.find(token, _pos._offset);
+    const bool found = end != std::string::npos;
+    const size_t stop = found ? end : _text.size();
+
+    result.assignFromUTF8(_text.data() + _pos._offset, stop - _pos._offset);
+    _pos._line += std::count(_text.begin() + _pos._offset, _text.begin() + stop, '\n');
+    _pos._offset = found && skipIfMatch ? stop + token.size() : stop;
 
     // Translate HTML entities in the result if required.
     if (translateEntities) {
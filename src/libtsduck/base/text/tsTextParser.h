@@ -38,6 +38,11 @@
 namespace ts {
     //!
     //! A support class for applications which parse various text formats.
+    //!
+    //! The document is internally stored in UTF-8 format and the tokenizer works on bytes.
+    //! Only the extracted tokens (names, literals, text) are converted to UTF-16.
+    //! This avoids the conversion of complete large documents into lists of UTF-16 lines.
+    //!
     //! @ingroup cpp
     //!
     class TextParser
@@ -53,8 +58,7 @@ namespace ts {
 
         //!
         //! Constructor.
-        //! @param [in] lines Reference to a list of text lines forming the document.
-        //! The lifetime of the referenced list must equals or exceeds the lifetime of the parser.
+        //! @param [in] lines List of text lines forming the document.
         //! @param [in,out] report Where to report errors.
         //!
         TextParser(const UStringList& lines, Report& report);
@@ -78,8 +82,7 @@ namespace ts {
 
         //!
         //! Load the document to parse from a list of lines.
-        //! @param [in] lines Reference to a list of text lines forming the document.
-        //! The lifetime of the referenced list must equals or exceeds the lifetime of the parser.
+        //! @param [in] lines List of text lines forming the document.
         //!
         void loadDocument(const UStringList& lines);
 
@@ -91,6 +94,7 @@ namespace ts {
 
         //!
         //! Load the document to parse from a text file.
+        //! The file is loaded in UTF-8 format, without conversion.
         //! @param [in] fileName Name of the file to load.
         //! @return True on success, false on failure.
         //!
@@ -142,16 +146,15 @@ namespace ts {
         private:
             // Constructors.
             Position() = delete;
-            Position(const UStringList&);
+            Position(const std::string&);
 
             // Everything is private to the application.
             // Only TextParser can use it.
             friend class TextParser;
 
-            const UStringList*          _lines;
-            UStringList::const_iterator _curLine;
-            size_t                      _curLineNumber;
-            size_t                      _curIndex;
+            const std::string* _text;    // UTF-8 document.
+            size_t             _offset;  // Byte offset in document.
+            size_t             _line;    // Line number, starting at 1.
         };
 
         //!
@@ -171,11 +174,11 @@ namespace ts {
         //! Get the current line number.
         //! @return The current line number.
         //!
-        size_t lineNumber() const { return _pos._curLineNumber; }
+        size_t lineNumber() const { return _pos._line; }
 
         //!
         //! Skip all whitespaces, including end of lines.
-        //! Note that the optional BOM at start of an UTF-8 file has already been removed by the UTF-16 conversion.
+        //! Note that the optional BOM at start of an UTF-8 file has already been removed when the document was loaded.
         //! @return Always true.
         //!
         bool skipWhiteSpace();
@@ -193,7 +196,33 @@ namespace ts {
         //! @param [in] cs Case sensitivity of the comparision.
         //! @return True if @a str matches the current position in the document.
         //!
-        bool match(const UString& str, bool skipIfMatch, CaseSensitivity cs = CASE_SENSITIVE);
+        bool match(const UString& str, bool skipIfMatch, CaseSensitivity cs = CASE_SENSITIVE)
+        {
+            return match(str.data(), str.length(), skipIfMatch, cs);
+        }
+
+        //!
+        //! Check if the current position in the document matches a nul-terminated string.
+        //! This version avoids the construction of a temporary UString with literal tokens.
+        //! @param [in] str A nul-terminated string to check at the current position in the document.
+        //! @param [in] skipIfMatch If true and @a str matches the current position, skip it in the document.
+        //! @param [in] cs Case sensitivity of the comparision.
+        //! @return True if @a str matches the current position in the document.
+        //!
+        bool match(const UChar* str, bool skipIfMatch, CaseSensitivity cs = CASE_SENSITIVE)
+        {
+            return match(str, str == nullptr ? 0 : std::char_traits<UChar>::length(str), skipIfMatch, cs);
+        }
+
+        //!
+        //! Check if the current position in the document matches a string.
+        //! @param [in] str Address of the string to check at the current position in the document.
+        //! @param [in] len Number of characters in @a str.
+        //! @param [in] skipIfMatch If true and @a str matches the current position, skip it in the document.
+        //! @param [in] cs Case sensitivity of the comparision.
+        //! @return True if @a str matches the current position in the document.
+        //!
+        bool match(const UChar* str, size_t len, bool skipIfMatch, CaseSensitivity cs = CASE_SENSITIVE);
 
         //!
         //! Parse text up to a given token.
@@ -203,7 +232,7 @@ namespace ts {
         //! @param [in] translateEntities If true, translate HTML entities in the text.
         //! @return True on success, false if @a endToken was not found.
         //!
-        virtual bool parseText(UString& result, const UString endToken, bool skipIfMatch, bool translateEntities);
+        virtual bool parseText(UString& result, const UString& endToken, bool skipIfMatch, bool translateEntities);
 
         //!
         //! Check if a character is suitable for starting an XML @e name.
@@ -272,7 +301,23 @@ namespace ts {
 
     private:
         Report&     _report;
-        UStringList _lines;
+        std::string _text;  // UTF-8, CR-LF converted to LF, always terminated by a LF when not empty.
         Position    _pos;
+
+        // Get the character at a given offset in the document. Return its size in bytes in the document.
+        // Return CHAR_NULL at end of document. Characters outside the BMP are returned as their leading surrogate.
+        // The ASCII case is inlined, other characters are decoded by decodeAt().
+        UChar charAt(size_t offset, size_t& size) const
+        {
+            if (offset < _text.size() && uint8_t(_text[offset]) < 0x80) {
+                size = 1;
+                return UChar(_text[offset]);
+            }
+            return decodeAt(offset, size);
+        }
+        UChar decodeAt(size_t offset, size_t& size) const;
+
+        // Load the UTF-8 document from a stream and normalize end of lines.
+        bool loadUTF8(std::istream& strm);
     };
 }
@@ -932,6 +932,17 @@ bool ts::Buffer::backBits(size_t bits)
 bool ts::Buffer::skipReservedBits(size_t bits, int expected)
 {
     expected &= 1;  // force 0 or 1
+
+    // Fast path: check all reserved bits at once, most of the time they are correct.
+    if (!_read_error && bits > 0 && fastReadable(bits) && currentReadBitOffset() + bits <= currentWriteBitOffset()) {
+        const uint64_t all = expected == 0 ? 0 : (~uint64_t(0) >> (64 - bits));
+        if (fastGetBits(bits) == all) {
+            return true;
+        }
+        // At least one invalid reserved bit, go back and check bit by bit.
+        backBits(bits);
+    }
+
     while (!_read_error && bits-- > 0) {
         if (getBit() != expected && !_read_error) {
             // Invalid reserved bit.
@@ -1157,6 +1168,42 @@ uint8_t ts::Buffer::getBit()
 }
 
 
+constexpr size_t ts::Buffer::FAST_BITS_MAX;
+
+
+//----------------------------------------------------------------------------
+// Fast paths for big endian bit fields using one 64-bit memory access.
+//----------------------------------------------------------------------------
+
+uint64_t ts::Buffer::fastGetBits(size_t bits)
+{
+    assert(bits > 0 && bits <= FAST_BITS_MAX);
+    assert(_state.rbyte + 8 <= _buffer_size);
+
+    // Drop the already read bits in MSB, then keep the requested bits.
+    const uint64_t word = GetUInt64BE(_buffer + _state.rbyte) << _state.rbit;
+    const size_t next = _state.rbit + bits;
+    _state.rbyte += next >> 3;
+    _state.rbit = next & 7;
+    return word >> (64 - bits);
+}
+
+void ts::Buffer::fastPutBits(uint64_t value, size_t bits)
+{
+    assert(bits > 0 && bits <= FAST_BITS_MAX);
+    assert(_state.wbyte + 8 <= _buffer_size);
+
+    // Replace the bit field in the 64-bit word, preserve surrounding bits.
+    uint8_t* const addr = _buffer + _state.wbyte;
+    const size_t shift = 64 - _state.wbit - bits;
+    const uint64_t mask = (~uint64_t(0) >> (64 - bits)) << shift;
+    PutUInt64BE(addr, (GetUInt64BE(addr) & ~mask) | ((value << shift) & mask));
+    const size_t next = _state.wbit + bits;
+    _state.wbyte += next >> 3;
+    _state.wbit = next & 7;
+}
+
+
 //----------------------------------------------------------------------------
 // Write the next bit and advance the write pointer.
 //----------------------------------------------------------------------------
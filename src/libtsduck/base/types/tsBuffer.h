@@ -770,6 +770,35 @@ namespace ts {
         template <typename INT, typename std::enable_if<std::is_integral<INT>::value>::type* = nullptr>
         bool putBits(INT value, size_t bits);
 
+        //!
+        //! Read the next n bits as an unsigned integer value and advance the read pointer.
+        //! The number of bits is a compile-time constant. In big endian mode, when the field
+        //! is at most 57 bits wide and not too close to the end of the memory area, the value
+        //! is extracted from one 64-bit memory access, without bit-by-bit processing.
+        //! @tparam BITS Number of bits to read, 1 to 64.
+        //! @tparam INT An unsigned integer type for the result. By default, the smallest
+        //! unsigned integer type which can hold @a BITS bits.
+        //! @return The value of the next @a BITS bits.
+        //!
+        template <size_t BITS,
+                  typename INT = typename std::conditional<(BITS <= 8), uint8_t,
+                                 typename std::conditional<(BITS <= 16), uint16_t,
+                                 typename std::conditional<(BITS <= 32), uint32_t, uint64_t>::type>::type>::type>
+        INT getBits();
+
+        //!
+        //! Put the next n bits from an integer value and advance the write pointer.
+        //! The number of bits is a compile-time constant. In big endian mode, when the field
+        //! is at most 57 bits wide and not too close to the end of the memory area, the value
+        //! is inserted using one 64-bit memory access, without bit-by-bit processing.
+        //! @tparam BITS Number of bits to write, 1 to 64.
+        //! @tparam INT An integer type.
+        //! @param [in] value Integer value to write.
+        //! @return True on success, false on error (read only or no more space to write).
+        //!
+        template <size_t BITS, typename INT, typename std::enable_if<std::is_integral<INT>::value>::type* = nullptr>
+        bool putBits(INT value);
+
 
         //!
         //! Serialize the number of reserved '1' bits
@@ -1419,6 +1448,17 @@ namespace ts {
         // - Advance read pointer.
         const uint8_t* rdb(size_t bytes);
 
+        // Fast paths for big endian bit fields using one unaligned 64-bit memory access.
+        // The bit field may start at any bit offset and must fit in the 64-bit word.
+        // The 8 bytes must be in the addressable area, even beyond the current read or write size.
+        // The caller must have checked that the field is between the read and write pointers
+        // (for read) or before the end of the usable area (for write). Zero bits is not allowed.
+        static constexpr size_t FAST_BITS_MAX = 57;
+        bool fastReadable(size_t bits) const { return _big_endian && bits <= FAST_BITS_MAX && _state.rbyte + 8 <= _buffer_size; }
+        bool fastWritable(size_t bits) const { return _big_endian && bits <= FAST_BITS_MAX && _state.wbyte + 8 <= _buffer_size; }
+        uint64_t fastGetBits(size_t bits);
+        void fastPutBits(uint64_t value, size_t bits);
+
         // Internal put integer method.
         template <typename INT, typename std::enable_if<std::is_integral<INT>::value || std::is_floating_point<INT>::value, int>::type = 0>
         bool putint(INT value, size_t bytes, void (*putBE)(void*,INT), void (*putLE)(void*,INT));
@@ -64,6 +64,11 @@ INT ts::Buffer::getBits(size_t bits)
         return 0;
     }
 
+    // Most bit fields are read using one 64-bit memory access.
+    if (bits > 0 && fastReadable(bits)) {
+        return static_cast<INT>(fastGetBits(bits));
+    }
+
     INT val = 0;
 
     if (_big_endian) {
@@ -128,6 +133,12 @@ bool ts::Buffer::putBits(INT value, size_t bits)
         return false;
     }
 
+    // Most bit fields are written using one 64-bit memory access.
+    if (bits > 0 && fastWritable(bits)) {
+        fastPutBits(static_cast<uint64_t>(value), bits);
+        return true;
+    }
+
     if (_big_endian) {
         // Write leading bits up to byte boundary
         while (bits > 0 && _state.wbit != 0) {
@@ -175,6 +186,39 @@ bool ts::Buffer::putBits(INT value, size_t bits)
 }
 
 
+//----------------------------------------------------------------------------
+// Read or write bit fields with a compile-time size.
+//----------------------------------------------------------------------------
+
+template <size_t BITS, typename INT>
+INT ts::Buffer::getBits()
+{
+    static_assert(BITS > 0 && BITS <= 64, "invalid number of bits");
+    static_assert(std::is_integral<INT>::value && std::is_unsigned<INT>::value, "unsigned integer type required");
+
+    if (BITS <= FAST_BITS_MAX && !_read_error && fastReadable(BITS) && currentReadBitOffset() + BITS <= currentWriteBitOffset()) {
+        return static_cast<INT>(fastGetBits(BITS));
+    }
+    else {
+        return getBits<INT>(BITS);
+    }
+}
+
+template <size_t BITS, typename INT, typename std::enable_if<std::is_integral<INT>::value>::type*>
+bool ts::Buffer::putBits(INT value)
+{
+    static_assert(BITS > 0 && BITS <= 64, "invalid number of bits");
+
+    if (BITS <= FAST_BITS_MAX && !_write_error && !_state.read_only && fastWritable(BITS) && remainingWriteBits() >= BITS) {
+        fastPutBits(static_cast<uint64_t>(value), BITS);
+        return true;
+    }
+    else {
+        return putBits<INT>(value, BITS);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Internal put integer method.
 //----------------------------------------------------------------------------
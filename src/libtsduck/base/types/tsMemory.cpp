@@ -29,6 +29,12 @@
 
 #include "tsMemory.h"
 
+#if defined(TS_X86_64)
+    #include <emmintrin.h>
+#elif defined(TS_ARM64)
+    #include <arm_neon.h>
+#endif
+
 
 //----------------------------------------------------------------------------
 // Check if a memory area starts with the specified prefix
@@ -66,6 +72,52 @@ const uint8_t* ts::LocatePattern(const void* area, size_t area_size, const void*
 }
 
 
+//----------------------------------------------------------------------------
+// Locate a 3-byte pattern 00 00 xx into a memory area.
+//----------------------------------------------------------------------------
+
+const uint8_t* ts::LocateZeroZero(const void* area, size_t area_size, uint8_t third)
+{
+    const uint8_t* a = reinterpret_cast<const uint8_t*>(area);
+    const uint8_t* const end = a + area_size;
+
+    while (end - a >= 3) {
+        // Skip blocks of 16 bytes without any zero: no pattern can start in them.
+        // The SIMD load may read up to 2 bytes after the last possible pattern start,
+        // this is why we check 18 remaining bytes.
+#if defined(TS_X86_64)
+        // SSE2 is always available on x86_64.
+        const __m128i zero = _mm_setzero_si128();
+        while (end - a >= 18 && _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)), zero)) == 0) {
+            a += 16;
+        }
+#elif defined(TS_ARM64)
+        // Advanced SIMD (NEON) is always available on Arm64.
+        while (end - a >= 18 && vmaxvq_u8(vceqzq_u8(vld1q_u8(a))) == 0) {
+            a += 16;
+        }
+#else
+        // Portable version, 8 bytes at a time, using the "has zero byte" bit trick.
+        while (end - a >= 10) {
+            uint64_t x = 0;
+            ::memcpy(&x, a, 8);
+            if (((x - 0x0101010101010101) & ~x & 0x8080808080808080) != 0) {
+                break;
+            }
+            a += 8;
+        }
+#endif
+        // Check the next 16 candidate positions (or less) one by one.
+        for (const uint8_t* const stop = a + std::min<ptrdiff_t>(16, end - a - 2); a < stop; ++a) {
+            if (a[0] == 0x00 && a[1] == 0x00 && a[2] == third) {
+                return a;
+            }
+        }
+    }
+    return nullptr; // not found
+}
+
+
 //----------------------------------------------------------------------------
 // Check if a memory area contains all identical byte values.
 //----------------------------------------------------------------------------
@@ -77,6 +77,19 @@ namespace ts {
     //!
     TSDUCKDLL const uint8_t* LocatePattern(const void* area, size_t area_size, const void* pattern, size_t pattern_size);
 
+    //!
+    //! Locate a 3-byte pattern 00 00 xx into a memory area.
+    //! This is typically used to locate start code prefixes (00 00 01) or
+    //! start code emulation prevention sequences (00 00 03) in video streams.
+    //! The search uses SIMD instructions when available and is much faster than
+    //! LocatePattern() on large areas such as video slices.
+    //! @param [in] area Address of a memory area to check.
+    //! @param [in] area_size Size in bytes of the memory area.
+    //! @param [in] third Value of the third byte in the pattern.
+    //! @return Address of the first occurence of 00 00 @a third in @a area or zero if not found.
+    //!
+    TSDUCKDLL const uint8_t* LocateZeroZero(const void* area, size_t area_size, uint8_t third);
+
     //!
     //! Check if a memory area contains all identical byte values.
     //! @param [in] area Address of a memory area to check.
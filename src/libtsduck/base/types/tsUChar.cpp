@@ -1914,8 +1914,29 @@ namespace {
     }) {}
 }
 
+namespace {
+    // Characteristics of ASCII characters, directly indexed, avoiding map lookups on the most frequent characters.
+    class ASCIICharacteristics
+    {
+    public:
+        uint32_t table[0x80];
+        ASCIICharacteristics() : table()
+        {
+            const auto ll = CharChar::Instance();
+            for (UChar c = 0; c < 0x80; ++c) {
+                const auto it = ll->find(c);
+                table[c] = it == ll->end() ? 0 : it->second;
+            }
+        }
+    };
+}
+
 uint32_t ts::UCharacteristics(UChar c)
 {
+    if (c < 0x80) {
+        static const ASCIICharacteristics ascii;
+        return ascii.table[c];
+    }
     const auto ll = CharChar::Instance();
     const auto it = ll->find(c);
     return it == ll->end() ? 0 : it->second;
@@ -1967,6 +1988,10 @@ bool ts::IsUpper(UChar c)
 
 ts::UChar ts::ToLower(UChar c)
 {
+    if (c < 0x80) {
+        // ASCII fast path.
+        return c >= u'A' && c <= u'Z' ? UChar(c + (u'a' - u'A')) : c;
+    }
     const UChar result = UChar(std::towlower(wint_t(c)));
     if (result != c) {
         // The standard function has found a translation.
@@ -1982,6 +2007,10 @@ ts::UChar ts::ToLower(UChar c)
 
 ts::UChar ts::ToUpper(UChar c)
 {
+    if (c < 0x80) {
+        // ASCII fast path.
+        return c >= u'a' && c <= u'z' ? UChar(c - (u'a' - u'A')) : c;
+    }
     const UChar result = UChar(std::towupper(wint_t(c)));
     if (result != c) {
         // The standard function has found a translation.
@@ -36,6 +36,13 @@
 #include "tsUString.h"
 #include "tsByteBlock.h"
 #include "tsSysUtils.h"
+#include "tsAllocationTracker.h"
+
+#if defined(TS_X86_64)
+    #include <emmintrin.h>
+#elif defined(TS_ARM64)
+    #include <arm_neon.h>
+#endif
 
 // The UTF-8 Byte Order Mark
 const char* const ts::UString::UTF8_BOM = "\xEF\xBB\xBF";
@@ -216,18 +223,23 @@ void ts::UString::ConvertUTF8ToUTF16(const char*& inStart, const char* inEnd, UC
 {
     uint32_t code;
 
+    // Check if a byte is a valid continuation byte, 10xx xxxx.
+    #define TS_UTF8_CONT(b) (((b) & 0xC0) == 0x80)
+
     while (inStart < inEnd && outStart < outEnd) {
 
         // Get current code point at 8-bit value.
         code = *inStart++ & 0xFF;
 
         // Process potential continuation bytes and rebuild the code point.
-        // Note: to speed up the processing, we do not check that continuation bytes,
-        // if any, match the binary pattern 10xxxxxx.
+        // An invalid leading byte or a leading byte which is not followed by the right number of
+        // continuation bytes is ignored. The following bytes are then decoded on their own.
 
         if (code < 0x80) {
             // 0xxx xxxx, ASCII compatible value, one byte encoding.
             *outStart++ = uint16_t(code);
+            // ASCII characters usually come in runs, convert the rest of the run in bulk.
+            ConvertASCIIToUTF16(inStart, inEnd, outStart, outEnd);
         }
         else if ((code & 0xE0) == 0xC0) {
             // 110x xxx, 2 byte encoding.
@@ -235,7 +247,7 @@ void ts::UString::ConvertUTF8ToUTF16(const char*& inStart, const char* inEnd, UC
                 // Invalid truncated input string, stop here.
                 break;
             }
-            else {
+            else if (TS_UTF8_CONT(inStart[0])) {
                 *outStart++ = uint16_t((code & 0x1F) << 6) | (*inStart++ & 0x3F);
             }
         }
@@ -246,7 +258,7 @@ void ts::UString::ConvertUTF8ToUTF16(const char*& inStart, const char* inEnd, UC
                 inStart = inEnd;
                 break;
             }
-            else {
+            else if (TS_UTF8_CONT(inStart[0]) && TS_UTF8_CONT(inStart[1])) {
                 *outStart++ = uint16_t((code & 0x0F) << 12) | uint16_t((uint16_t(inStart[0] & 0x3F)) << 6) | (inStart[1] & 0x3F);
                 inStart += 2;
             }
@@ -258,6 +270,9 @@ void ts::UString::ConvertUTF8ToUTF16(const char*& inStart, const char* inEnd, UC
                 inStart = inEnd;
                 break;
             }
+            else if (!TS_UTF8_CONT(inStart[0]) || !TS_UTF8_CONT(inStart[1]) || !TS_UTF8_CONT(inStart[2])) {
+                // Invalid sequence, ignore the leading byte.
+            }
             else if (outStart + 1 >= outEnd) {
                 // We need 2 16-bit values in UTF-16.
                 inStart--;  // Push back the leading byte into the input buffer.
@@ -265,10 +280,12 @@ void ts::UString::ConvertUTF8ToUTF16(const char*& inStart, const char* inEnd, UC
             }
             else {
                 code = ((code & 0x07) << 18) | ((uint32_t(inStart[0] & 0x3F)) << 12) | ((uint32_t(inStart[1] & 0x3F)) << 6) | (inStart[2] & 0x3F);
-                inStart += 3;
-                code -= 0x10000;
-                *outStart++ = uint16_t(0xD800 + (code >> 10));
-                *outStart++ = uint16_t(0xDC00 + (code & 0x03FF));
+                if (code >= 0x10000 && code <= 0x10FFFF) {
+                    inStart += 3;
+                    code -= 0x10000;
+                    *outStart++ = uint16_t(0xD800 + (code >> 10));
+                    *outStart++ = uint16_t(0xDC00 + (code & 0x03FF));
+                }
             }
         }
         else {
@@ -277,6 +294,61 @@ void ts::UString::ConvertUTF8ToUTF16(const char*& inStart, const char* inEnd, UC
             assert((code & 0xC0) == 0x80 || (code & 0xF8) == 0xF8);
         }
     }
+
+    #undef TS_UTF8_CONT
+}
+
+
+//----------------------------------------------------------------------------
+// Fast conversion of a run of ASCII characters from 8-bit to UTF-16.
+//----------------------------------------------------------------------------
+
+void ts::UString::ConvertASCIIToUTF16(const char*& inStart, const char* inEnd, UChar*& outStart, UChar* outEnd, uint8_t min, uint8_t max)
+{
+    assert(max < 0x80);
+
+#if defined(TS_X86_64)
+    // SSE2 is always available on x86_64. Since max < 0x80, all bytes are compared as signed values:
+    // bytes 0x80-0xFF are negative and are rejected by the comparison with min (min - 1 >= -1).
+    const __m128i vmin = _mm_set1_epi8(char(min - 1));
+    const __m128i vmax = _mm_set1_epi8(char(max));
+    const __m128i zero = _mm_setzero_si128();
+    while (inEnd - inStart >= 16 && outEnd - outStart >= 16) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inStart));
+        const __m128i good = _mm_andnot_si128(_mm_cmpgt_epi8(in, vmax), _mm_cmpgt_epi8(in, vmin));
+        if (_mm_movemask_epi8(good) != 0xFFFF) {
+            break;  // at least one byte out of range, finish with scalar code
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(outStart), _mm_unpacklo_epi8(in, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(outStart + 8), _mm_unpackhi_epi8(in, zero));
+        inStart += 16;
+        outStart += 16;
+    }
+#elif defined(TS_ARM64)
+    // Advanced SIMD (NEON) is always available on Arm64.
+    const uint8x16_t vmin = vdupq_n_u8(min);
+    const uint8x16_t vmax = vdupq_n_u8(max);
+    while (inEnd - inStart >= 16 && outEnd - outStart >= 16) {
+        const uint8x16_t in = vld1q_u8(reinterpret_cast<const uint8_t*>(inStart));
+        if (vminvq_u8(vandq_u8(vcgeq_u8(in, vmin), vcleq_u8(in, vmax))) == 0) {
+            break;  // at least one byte out of range, finish with scalar code
+        }
+        vst1q_u16(reinterpret_cast<uint16_t*>(outStart), vmovl_u8(vget_low_u8(in)));
+        vst1q_u16(reinterpret_cast<uint16_t*>(outStart + 8), vmovl_high_u8(in));
+        inStart += 16;
+        outStart += 16;
+    }
+#endif
+
+    // Remaining characters, one by one.
+    while (inStart < inEnd && outStart < outEnd) {
+        const uint8_t c = uint8_t(*inStart);
+        if (c < min || c > max) {
+            break;
+        }
+        *outStart++ = UChar(c);
+        inStart++;
+    }
 }
 
 
@@ -1880,6 +1952,8 @@ void ts::UString::appendDump(const void *data,
 
 void ts::UString::format(const UChar* fmt, std::initializer_list<ArgMixIn> args)
 {
+    TS_ALLOCATION_SCOPE(u"UString");
+
     // Pre-reserve some space. We don't really know how much. Just address the most common cases.
     reserve(256);
 
@@ -2101,6 +2175,11 @@ void ts::UString::ArgMixInContext::processArg()
         if (cmd != u's' && debugActive()) {
             debug(u"type mismatch, got a string", cmd);
         }
+        // Fast path: a 16-bit string without width constraints is appended without intermediate copy.
+        if (argit->isAnyString16() && minWidth == 0 && !hasDot) {
+            _result.append(argit->toUCharPtr());
+            return;
+        }
         // Get the string parameter.
         UString value;
         if (argit->isAnyString8()) {
@@ -2192,6 +2271,16 @@ void ts::UString::ArgMixInContext::processArg()
             // Format AbstractNumber without decimals.
             _result.append(argit->toAbstractNumber().toString(minWidth, !leftJustified, separatorChar, forceSign, 0, true, FULL_STOP, pad));
         }
+        else if (!forceSign && pad == u' ') {
+            // Most common case, format directly into the result string.
+            if (argit->isSigned()) {
+                const int64_t value = argit->toInt64();
+                appendDecimal(value < 0 ? uint64_t(0) - uint64_t(value) : uint64_t(value), value < 0, minWidth, leftJustified, separatorChar);
+            }
+            else {
+                appendDecimal(argit->toUInt64(), false, minWidth, leftJustified, separatorChar);
+            }
+        }
         else if (argit->size() > 4) {
             // Stored as 64-bit integer.
             if (argit->isSigned()) {
@@ -2213,6 +2302,37 @@ void ts::UString::ArgMixInContext::processArg()
     }
 }
 
+// Anciliary function to append an integer in decimal, without intermediate string.
+void ts::UString::ArgMixInContext::appendDecimal(uint64_t value, bool negative, size_t minWidth, bool leftJustified, UChar separator)
+{
+    // Build the string in reverse order at the end of a local buffer.
+    // Max size: 20 digits, 6 separators, one sign.
+    UChar buffer[32];
+    UChar* const end = buffer + 32;
+    UChar* start = end;
+    int count = 0;
+    do {
+        *--start = u'0' + UChar(value % 10);
+        value /= 10;
+        if (++count % 3 == 0 && value != 0 && separator != CHAR_NULL) {
+            *--start = separator;
+        }
+    } while (value != 0);
+    if (negative) {
+        *--start = u'-';
+    }
+
+    // Insert the string with optional padding.
+    const size_t len = end - start;
+    if (minWidth > len && !leftJustified) {
+        _result.append(minWidth - len, u' ');
+    }
+    _result.append(start, len);
+    if (minWidth > len && leftJustified) {
+        _result.append(minWidth - len, u' ');
+    }
+}
+
 // Anciliary function to extract a size field from a '%' sequence.
 void ts::UString::ArgMixInContext::getFormatSize(size_t& size)
 {
@@ -456,6 +456,21 @@ namespace ts {
         //!
         static void ConvertUTF8ToUTF16(const char*& inStart, const char* inEnd, UChar*& outStart, UChar* outEnd);
 
+        //!
+        //! Fast conversion of a run of ASCII characters from 8-bit to UTF-16.
+        //! Stop when the input buffer is empty, the output buffer is full or a byte is outside
+        //! the specified range, whichever comes first. SIMD instructions are used when available.
+        //! @param [in,out] inStart Address of the input 8-bit buffer to convert.
+        //! Updated upon return to point after the last converted character.
+        //! @param [in] inEnd Address after the end of the input 8-bit buffer.
+        //! @param [in,out] outStart Address of the output UTF-16 buffer to fill.
+        //! Updated upon return to point after the last converted character.
+        //! @param [in] outEnd Address after the end of the output UTF-16 buffer to fill.
+        //! @param [in] min Minimum value of the bytes to convert.
+        //! @param [in] max Maximum value of the bytes to convert. Must be in the ASCII range, lower than 0x80.
+        //!
+        static void ConvertASCIIToUTF16(const char*& inStart, const char* inEnd, UChar*& outStart, UChar* outEnd, uint8_t min = 0x00, uint8_t max = 0x7F);
+
         //!
         //! Assign from a @c std::vector of 16-bit characters of any type.
         //! @tparam CHARTYPE A 16-bit character or integer type.
@@ -2286,6 +2301,16 @@ namespace ts {
             //! @param [in,out] size Size value. Unmodified if no size is found at @e _fmt.
             //!
             void getFormatSize(size_t& size);
+
+            //!
+            //! Internal function to append an integer in decimal, without intermediate string.
+            //! @param [in] value Absolute value of the integer.
+            //! @param [in] negative The integer is negative.
+            //! @param [in] minWidth Minimum width of the field, padded with spaces.
+            //! @param [in] leftJustified Left-justify the field.
+            //! @param [in] separator Thousands separator, CHAR_NULL if none.
+            //!
+            void appendDecimal(uint64_t value, bool negative, size_t minWidth, bool leftJustified, UChar separator);
         };
 
         //!
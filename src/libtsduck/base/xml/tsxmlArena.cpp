@@ -0,0 +1,148 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsxmlArena.h"
+
+namespace {
+    // Size of the blocks which are allocated in the arena.
+    constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    // Larger areas are allocated in their own dedicated block.
+    constexpr size_t MAX_SHARED_SIZE = BLOCK_SIZE / 4;
+
+    // Size of the header before each allocated area. Keep the maximum alignment.
+    constexpr size_t HEADER_SIZE = 16;
+    static_assert(HEADER_SIZE >= sizeof(ts::xml::Arena*), "invalid arena header size");
+
+    // Active arena in the current thread.
+    thread_local ts::xml::Arena* current_arena = nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::xml::Arena::Arena() :
+    _refCount(1),
+    _blocks(),
+    _next(nullptr),
+    _remain(0)
+{
+}
+
+ts::xml::Arena::~Arena()
+{
+    for (auto block : _blocks) {
+        delete[] block;
+    }
+}
+
+void ts::xml::Arena::release()
+{
+    if (_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Activation of an arena in the current thread.
+//----------------------------------------------------------------------------
+
+ts::xml::Arena::Activation::Activation(Arena* arena) :
+    _previous(current_arena)
+{
+    current_arena = arena;
+}
+
+ts::xml::Arena::Activation::~Activation()
+{
+    current_arena = _previous;
+}
+
+
+//----------------------------------------------------------------------------
+// Allocate an area in this arena.
+//----------------------------------------------------------------------------
+
+void* ts::xml::Arena::allocate(size_t size)
+{
+    // Round the size to keep the alignment of the next area.
+    size = (size + HEADER_SIZE - 1) & ~(HEADER_SIZE - 1);
+
+    char* area = nullptr;
+    if (size > MAX_SHARED_SIZE) {
+        // Dedicated block, keep the current block.
+        area = new char[size];
+        _blocks.push_back(area);
+    }
+    else {
+        if (size > _remain) {
+            // Allocate a new current block. The rest of the previous block is lost.
+            _next = new char[BLOCK_SIZE];
+            _remain = BLOCK_SIZE;
+            _blocks.push_back(_next);
+        }
+        area = _next;
+        _next += size;
+        _remain -= size;
+    }
+
+    // Each allocated area references the arena.
+    _refCount.fetch_add(1, std::memory_order_relaxed);
+    return area;
+}
+
+
+//----------------------------------------------------------------------------
+// Allocate and deallocate memory in the active arena or on the heap.
+//----------------------------------------------------------------------------
+
+void* ts::xml::Arena::Allocate(size_t size)
+{
+    Arena* const arena = current_arena;
+    char* const area = static_cast<char*>(arena == nullptr ? ::operator new(size + HEADER_SIZE) : arena->allocate(size + HEADER_SIZE));
+    *reinterpret_cast<Arena**>(area) = arena;
+    return area + HEADER_SIZE;
+}
+
+void ts::xml::Arena::Deallocate(void* ptr)
+{
+    if (ptr != nullptr) {
+        char* const area = static_cast<char*>(ptr) - HEADER_SIZE;
+        Arena* const arena = *reinterpret_cast<Arena**>(area);
+        if (arena == nullptr) {
+            ::operator delete(area);
+        }
+        else {
+            arena->release();
+        }
+    }
+}
@@ -0,0 +1,168 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Memory arena for the nodes of parsed XML documents.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+namespace ts {
+    namespace xml {
+        //!
+        //! Memory arena for the nodes of parsed XML documents.
+        //! @ingroup xml
+        //!
+        //! While a document is parsed, its nodes and attributes are allocated in an arena which
+        //! is owned by the document. The arena is a list of large memory blocks and an allocation
+        //! is a simple pointer increment. Deallocating an object does not free its memory. All
+        //! blocks are freed at once when the document and all objects which were allocated in
+        //! the arena are deleted. Because a node may be moved into another document, the arena
+        //! is reference-counted: one reference per allocated object, plus one for the document.
+        //!
+        //! Each allocated area is preceded by a small header which points to its arena, or is
+        //! null when the area was allocated on the heap, when no arena is active in the current
+        //! thread. Therefore, nodes which are allocated outside parsing always use the heap.
+        //!
+        class TSDUCKDLL Arena
+        {
+            TS_NOCOPY(Arena);
+        public:
+            //!
+            //! Constructor.
+            //! The initial reference belongs to the creator, which must call release() when done.
+            //!
+            Arena();
+
+            //!
+            //! Release one reference to the arena.
+            //! The arena is deleted when the last reference is released.
+            //!
+            void release();
+
+            //!
+            //! Allocate memory in the active arena of the current thread or on the heap.
+            //! @param [in] size Size in bytes of the memory area.
+            //! @return Address of the memory area.
+            //!
+            static void* Allocate(size_t size);
+
+            //!
+            //! Deallocate memory which was returned by Allocate().
+            //! @param [in] ptr Address of the memory area. Ignored when null.
+            //!
+            static void Deallocate(void* ptr);
+
+            //!
+            //! Make an arena active in the current thread during the lifetime of an instance of this class.
+            //!
+            class TSDUCKDLL Activation
+            {
+                TS_NOBUILD_NOCOPY(Activation);
+            public:
+                //!
+                //! Constructor.
+                //! @param [in] arena The arena to activate in the current thread.
+                //!
+                explicit Activation(Arena* arena);
+                //!
+                //! Destructor, restore the previous active arena, if any.
+                //!
+                ~Activation();
+            private:
+                Arena* _previous;
+            };
+
+        private:
+            std::atomic_size_t _refCount;  // Number of references.
+            std::vector<char*> _blocks;    // All allocated blocks.
+            char*              _next;      // Next free area in current block.
+            size_t             _remain;    // Remaining size in current block.
+
+            // Only release() can delete the arena.
+            ~Arena();
+
+            // Allocate an area in this arena.
+            void* allocate(size_t size);
+        };
+
+        //!
+        //! A standard allocator which uses the active arena in the current thread, if any.
+        //! The allocator is stateless, all instances are interchangeable.
+        //! @tparam T Type of objects to allocate.
+        //!
+        template <typename T>
+        class ArenaAllocator
+        {
+        public:
+            typedef T value_type;  //!< Type of objects to allocate.
+
+            //!
+            //! Default constructor.
+            //!
+            ArenaAllocator() = default;
+
+            //!
+            //! Conversion constructor.
+            //!
+            template <typename U>
+            ArenaAllocator(const ArenaAllocator<U>&) {}
+
+            //!
+            //! Allocate objects.
+            //! @param [in] n Number of objects.
+            //! @return Address of the first object.
+            //!
+            T* allocate(size_t n) { return static_cast<T*>(Arena::Allocate(n * sizeof(T))); }
+
+            //!
+            //! Deallocate objects.
+            //! @param [in] p Address of the first object.
+            //! @param [in] n Number of objects.
+            //!
+            void deallocate(T* p, size_t n) { Arena::Deallocate(p); }
+
+            //!
+            //! Equality operator.
+            //! @return Always true, all instances are interchangeable.
+            //!
+            template <typename U>
+            bool operator==(const ArenaAllocator<U>&) const { return true; }
+
+            //!
+            //! Unequality operator.
+            //! @return Always false, all instances are interchangeable.
+            //!
+            template <typename U>
+            bool operator!=(const ArenaAllocator<U>&) const { return false; }
+        };
+    }
+}
@@ -28,6 +28,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsxmlAttribute.h"
+#include "tsxmlNameTable.h"
 
 // A constant static invalid instance.
 const ts::xml::Attribute ts::xml::Attribute::INVALID;
@@ -41,7 +42,7 @@ std::atomic_size_t  ts::xml::Attribute::_allocator(0);
 
 ts::xml::Attribute::Attribute() :
     _valid(false),
-    _name(),
+    _name(NameTable::Instance()->intern(UString())),
     _value(),
     _line(0),
     _sequence(++_allocator)
@@ -50,7 +51,7 @@ ts::xml::Attribute::Attribute() :
 
 ts::xml::Attribute::Attribute(const UString& name, const UString& value, size_t line) :
     _valid(true),
-    _name(name),
+    _name(NameTable::Instance()->intern(name)),
     _value(value),
     _line(line),
     _sequence(++_allocator)
@@ -60,6 +60,32 @@ namespace ts {
             //!
             explicit Attribute(const UString& name, const UString& value = UString(), size_t line = 0);
 
+            //!
+            //! Copy constructor.
+            //! @param [in] other Other instance to copy.
+            //!
+            Attribute(const Attribute& other) = default;
+
+            //!
+            //! Move constructor.
+            //! @param [in,out] other Other instance to move.
+            //!
+            Attribute(Attribute&& other) = default;
+
+            //!
+            //! Assignment operator.
+            //! @param [in] other Other instance to copy.
+            //! @return A reference to this object.
+            //!
+            Attribute& operator=(const Attribute& other) = default;
+
+            //!
+            //! Move assignment operator.
+            //! @param [in,out] other Other instance to move.
+            //! @return A reference to this object.
+            //!
+            Attribute& operator=(Attribute&& other) = default;
+
             //!
             //! Check if the attribute is valid.
             //! @return True if the attribute is valid.
@@ -76,7 +102,7 @@ namespace ts {
             //! Get the attribute name with original case sensitivity.
             //! @return A constant reference to the attribute name with original case sensitivity.
             //!
-            const UString& name() const { return _name; }
+            const UString& name() const { return *_name; }
 
             //!
             //! Get the attribute value.
@@ -229,11 +255,11 @@ namespace ts {
             static const Attribute INVALID;
 
         private:
-            bool    _valid;
-            UString _name;
-            UString _value;
-            size_t  _line;
-            size_t  _sequence;  // insertion sequence
+            bool           _valid;
+            const UString* _name;      // interned name, see NameTable
+            UString        _value;
+            size_t         _line;
+            size_t         _sequence;  // insertion sequence
 
             // An for sequence numbers.
             static std::atomic_size_t _allocator;
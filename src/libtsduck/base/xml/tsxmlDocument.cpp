@@ -42,16 +42,28 @@
 
 ts::xml::Document::Document(Report& report) :
     Node(report, 1),
-    _tweaks()
+    _tweaks(),
+    _arena(nullptr)
 {
 }
 
 ts::xml::Document::Document(const Document& other) :
     Node(other),
-    _tweaks(other._tweaks)
+    _tweaks(other._tweaks),
+    _arena(nullptr)
 {
 }
 
+ts::xml::Document::~Document()
+{
+    // Delete all nodes first. The arena memory is freed when the last node which was allocated in it is deleted.
+    clear();
+    if (_arena != nullptr) {
+        _arena->release();
+        _arena = nullptr;
+    }
+}
+
 ts::xml::Node* ts::xml::Document::clone() const
 {
     return new Document(*this);
@@ -180,6 +192,12 @@ void ts::xml::Document::printClose(TextFormatter& output, size_t levels) const
 
 bool ts::xml::Document::parseNode(TextParser& parser, const Node* parent)
 {
+    // All nodes of the document are allocated in its arena during the parsing.
+    if (_arena == nullptr) {
+        _arena = new Arena;
+    }
+    Arena::Activation activation(_arena);
+
     // The document is a simple list of children.
     if (!parseChildren(parser)) {
         return false;
@@ -59,6 +59,11 @@ namespace ts {
             //!
             Document(const Document& other);
 
+            //!
+            //! Destructor.
+            //!
+            virtual ~Document() override;
+
             //!
             //! Parse an XML document.
             //! @param [in] lines List of text lines forming the XML document.
@@ -166,6 +171,10 @@ namespace ts {
 
         private:
             Tweaks _tweaks;  // Global XML tweaks for the document.
+            Arena* _arena;   // Arena for the nodes of the parsed document, allocated on first parsing.
+
+            // No assignment.
+            Document& operator=(const Document&) = delete;
         };
     }
 }
@@ -39,15 +39,17 @@
 ts::xml::Element::Element(Report& report, size_t line, CaseSensitivity attributeCase) :
     Node(report, line),
     _attributeCase(attributeCase),
-    _attributes()
+    _attributes(AttributeLess(attributeCase))
 {
 }
 
 ts::xml::Element::Element(Node* parent, const UString& name, CaseSensitivity attributeCase, bool last) :
-    Node(parent, name, last), // the "value" of an element node is its name.
+    Node(parent, UString(), last),
     _attributeCase(attributeCase),
-    _attributes()
+    _attributes(AttributeLess(attributeCase))
 {
+    // The "value" of an element node is its name.
+    setInternedValue(name);
 }
 
 ts::xml::Element::Element(const Element& other) :
@@ -349,21 +351,51 @@ ts::UString ts::xml::Element::attributeKey(const UString& attributeName) const
     return _attributeCase == CASE_SENSITIVE ? attributeName : attributeName.toLower();
 }
 
+bool ts::xml::Element::AttributeLess::operator()(const UString* name1, const UString* name2) const
+{
+    if (name1 == name2) {
+        // Same interned name.
+        return false;
+    }
+    else if (_cs == CASE_SENSITIVE) {
+        return *name1 < *name2;
+    }
+    else {
+        // Same order as the lowercase names.
+        const size_t len = std::min(name1->length(), name2->length());
+        for (size_t i = 0; i < len; ++i) {
+            const UChar c1 = ToLower((*name1)[i]);
+            const UChar c2 = ToLower((*name2)[i]);
+            if (c1 != c2) {
+                return c1 < c2;
+            }
+        }
+        return name1->length() < name2->length();
+    }
+}
+
 ts::xml::Element::AttributeMap::const_iterator ts::xml::Element::findAttribute(const UString& attributeName) const
 {
-    return _attributes.find(attributeKey(attributeName));
+    return _attributes.find(&attributeName);
 }
 
 void ts::xml::Element::setAttribute(const UString& name, const UString& value, bool onlyIfNotEmpty)
 {
     if (!onlyIfNotEmpty || !value.empty()) {
-        _attributes[attributeKey(name)] = Attribute(name, value);
+        const Attribute attr(name, value);
+        const auto it = _attributes.find(&name);
+        if (it == _attributes.end()) {
+            _attributes.emplace(&attr.name(), attr);
+        }
+        else {
+            it->second = attr;
+        }
     }
 }
 
 void ts::xml::Element::deleteAttribute(const UString& name)
 {
-    const auto it = _attributes.find(attributeKey(name));
+    const auto it = _attributes.find(&name);
     if (it != _attributes.end()) {
         _attributes.erase(it);
     }
@@ -376,8 +408,12 @@ bool ts::xml::Element::hasAttribute(const UString& name) const
 
 ts::xml::Attribute& ts::xml::Element::refAttribute(const UString& name)
 {
-    const auto it = _attributes.find(attributeKey(name));
-    return it == _attributes.end() ? (_attributes[attributeKey(name)] = Attribute(name, u"")) : it->second;
+    auto it = _attributes.find(&name);
+    if (it == _attributes.end()) {
+        Attribute attr(name, u"");
+        it = _attributes.emplace(&attr.name(), attr).first;
+    }
+    return it->second;
 }
 
 
@@ -714,7 +750,7 @@ void ts::xml::Element::getAttributes(std::map<UString,UString>& attr) const
 {
     attr.clear();
     for (const auto& it : _attributes) {
-        attr[it.first] = it.second.value();
+        attr[attributeKey(*it.first)] = it.second.value();
     }
 }
 
@@ -906,7 +942,7 @@ bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
     }
 
     // The "value" of an element is its tag name.
-    setValue(nodeName);
+    setInternedValue(nodeName);
 
     // Read the list of attributes.
     bool ok = true;
@@ -950,16 +986,17 @@ bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
             // Read attribute value.
             ok = ok && parser.parseText(attrValue, quote, true, true);
 
-            // Store the attribute.
+            // Store the attribute. The map key is the interned name of the attribute.
             if (!ok) {
                 report().error(u"line %d: error parsing attribute '%s' in tag <%s>", {line, attrName, value()});
             }
-            else if (hasAttribute(attrName)) {
-                report().error(u"line %d: duplicate attribute '%s' in tag <%s>", {line, attrName, value()});
-                ok = false;
-            }
             else {
-                _attributes[attributeKey(attrName)] = Attribute(attrName, attrValue, line);
+                Attribute attr(attrName, attrValue, line);
+                const UString* const key = &attr.name();
+                if (!_attributes.emplace(key, std::move(attr)).second) {
+                    report().error(u"line %d: duplicate attribute '%s' in tag <%s>", {line, attrName, value()});
+                    ok = false;
+                }
             }
         }
         else {
@@ -985,7 +1022,7 @@ bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
     ok = parser.match(u"</", true);
     if (ok) {
         UString endTag;
-        ok = parser.skipWhiteSpace() && parser.parseXMLName(endTag) && parser.skipWhiteSpace() && endTag.similar(value());
+        ok = parser.skipWhiteSpace() && parser.parseXMLName(endTag) && parser.skipWhiteSpace() && (endTag == value() || endTag.similar(value()));
         ok = parser.match(u">", true) && ok;
     }
 
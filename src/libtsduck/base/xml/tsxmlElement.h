@@ -35,6 +35,7 @@
 #pragma once
 #include "tsxmlNode.h"
 #include "tsxmlAttribute.h"
+#include "tsxmlArena.h"
 #include "tsByteBlock.h"
 #include "tsVariable.h"
 #include "tsIPv4Address.h"
@@ -62,8 +63,20 @@ namespace ts {
         class TSDUCKDLL Element: public Node
         {
         private:
+            // Comparison of attribute names, case-sensitive or not.
+            class AttributeLess
+            {
+            public:
+                explicit AttributeLess(CaseSensitivity cs) : _cs(cs) {}
+                bool operator()(const UString* name1, const UString* name2) const;
+            private:
+                CaseSensitivity _cs;
+            };
+
             // Attributes are stored indexed by case-(in)sensitive name.
-            typedef std::map<UString, Attribute> AttributeMap;
+            // The keys point to the interned names of the attributes. Since the comparison uses the
+            // string values, a lookup can use the address of any string, without allocation.
+            typedef std::map<const UString*, Attribute, AttributeLess, ArenaAllocator<std::pair<const UString* const, Attribute>>> AttributeMap;
 
         public:
             //!
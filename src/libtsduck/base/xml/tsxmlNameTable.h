@@ -0,0 +1,73 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Table of interned XML names.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+#include "tsSingletonManager.h"
+#include "tsMutex.h"
+#include <unordered_set>
+
+namespace ts {
+    namespace xml {
+        //!
+        //! Table of interned XML names (names of elements and attributes).
+        //! @ingroup xml
+        //!
+        //! XML documents use a small set of names for a large number of elements and attributes.
+        //! Each distinct name is stored only once. The address of an interned name remains valid
+        //! until the end of the application. This class is a thread-safe singleton.
+        //!
+        class TSDUCKDLL NameTable
+        {
+            TS_DECLARE_SINGLETON(NameTable);
+        public:
+            //!
+            //! Get the interned instance of a name, add it in the table if not yet present.
+            //! @param [in] name The name to intern.
+            //! @return The address of the unique instance of @a name.
+            //!
+            const UString* intern(const UString& name);
+
+            //!
+            //! Get the number of interned names.
+            //! @return The number of interned names.
+            //!
+            size_t size() const;
+
+        private:
+            mutable Mutex _mutex;
+            std::unordered_set<UString, std::hash<std::u16string>> _names;
+        };
+    }
+}
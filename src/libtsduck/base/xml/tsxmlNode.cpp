@@ -34,6 +34,7 @@
 #include "tsxmlElement.h"
 #include "tsxmlText.h"
 #include "tsxmlUnknown.h"
+#include "tsxmlNameTable.h"
 #include "tsTextFormatter.h"
 #include "tsNullReport.h"
 
@@ -46,6 +47,7 @@ ts::xml::Node::Node(Report& report, size_t line) :
     RingNode(),
     _report(report),
     _value(),
+    _internedValue(nullptr),
     _parent(nullptr),
     _firstChild(nullptr),
     _inputLineNum(line)
@@ -63,6 +65,7 @@ ts::xml::Node::Node(const Node& other) :
     RingNode(),
     _report(other._report),
     _value(other._value),
+    _internedValue(other._internedValue),
     _parent(nullptr),
     _firstChild(nullptr),
     _inputLineNum(other._inputLineNum)
@@ -80,6 +83,17 @@ ts::xml::Node::~Node()
 }
 
 
+//----------------------------------------------------------------------------
+// Set the value of the node from an interned string.
+//----------------------------------------------------------------------------
+
+void ts::xml::Node::setInternedValue(const UString& value)
+{
+    _internedValue = NameTable::Instance()->intern(value);
+    _value.clear();
+}
+
+
 //----------------------------------------------------------------------------
 // Simple virtual methods
 //----------------------------------------------------------------------------
@@ -108,6 +122,7 @@ void ts::xml::Node::clear()
 
     // Clear other fields.
     _value.clear();
+    _internedValue = nullptr;
     _inputLineNum = 0;
 }
 
@@ -38,6 +38,7 @@
 #include "tsRingNode.h"
 #include "tsTextFormatter.h"
 #include "tsTextParser.h"
+#include "tsxmlArena.h"
 
 namespace ts {
     namespace xml {
@@ -252,14 +253,18 @@ namespace ts {
             //!
             //! @return A constant reference to the node value, as a string.
             //!
-            const UString& value() const { return _value; }
+            const UString& value() const { return _internedValue != nullptr ? *_internedValue : _value; }
 
             //!
             //! Set the value of the node.
             //! @param [in] value New value to set.
             //! @see value()
             //!
-            void setValue(const UString& value) { _value = value; }
+            void setValue(const UString& value)
+            {
+                _value = value;
+                _internedValue = nullptr;
+            }
 
             //!
             //! Remove all comments in the XML node.
@@ -314,6 +319,21 @@ namespace ts {
             //!
             virtual ~Node() override;
 
+            //!
+            //! Allocation of nodes.
+            //! Nodes which are created while a document is parsed are allocated in the arena of the document.
+            //! @param [in] size Size in bytes of the node.
+            //! @return Address of the node.
+            //! @see Arena
+            //!
+            static void* operator new(size_t size) { return Arena::Allocate(size); }
+
+            //!
+            //! Deallocation of nodes.
+            //! @param [in] ptr Address of the node.
+            //!
+            static void operator delete(void* ptr) { Arena::Deallocate(ptr); }
+
         protected:
             //!
             //! Constructor.
@@ -365,12 +385,20 @@ namespace ts {
             //!
             virtual bool parseChildren(TextParser& parser);
 
+            //!
+            //! Set the value of the node from a frequently used string, typically an element name.
+            //! The value is interned in the NameTable and not duplicated in each node.
+            //! @param [in] value New value to set.
+            //!
+            void setInternedValue(const UString& value);
+
         private:
-            Report& _report;        // Where to report errors.
-            UString _value;         // Value of the node, depend on the node type.
-            Node*   _parent;        // Parent node, null for a document.
-            Node*   _firstChild;    // First child, can be null, other children are linked through the RingNode.
-            size_t  _inputLineNum;  // Line number in input document, zero if build programmatically.
+            Report&        _report;         // Where to report errors.
+            UString        _value;          // Value of the node, depend on the node type.
+            const UString* _internedValue;  // Interned value (element names), replaces _value when not null.
+            Node*          _parent;         // Parent node, null for a document.
+            Node*          _firstChild;     // First child, can be null, other children are linked through the RingNode.
+            size_t         _inputLineNum;   // Line number in input document, zero if build programmatically.
 
             // Default XML tweaks for orphan nodes.
             static const Tweaks defaultTweaks;
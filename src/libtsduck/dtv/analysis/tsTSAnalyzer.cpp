@@ -401,18 +401,26 @@ ts::UString ts::TSAnalyzer::ServiceContext::getName() const
 // Update a service context with information from a descriptor list.
 //----------------------------------------------------------------------------
 
-void ts::TSAnalyzer::ServiceContext::update(DuckContext& duck, const DescriptorList& descs)
+void ts::TSAnalyzer::ServiceContext::update(DuckContext& duck, const DescriptorListView& descs)
 {
     // Look for a service_descriptor and get service characteristics.
-    ServiceDescriptor srv_desc;
-    if (descs.search(duck, DID_SERVICE, srv_desc) < descs.size()) {
-        service_type = srv_desc.service_type;
-        // Replace names only if they are not empty.
-        if (!srv_desc.provider_name.empty()) {
-            provider = srv_desc.provider_name;
-        }
-        if (!srv_desc.service_name.empty()) {
-            name = srv_desc.service_name;
+    // Only the first service_descriptor is deserialized.
+    for (const auto& dv : descs) {
+        if (dv.tag() == DID_SERVICE) {
+            Descriptor bindesc;
+            dv.toDescriptor(bindesc);
+            const ServiceDescriptor srv_desc(duck, bindesc);
+            if (srv_desc.isValid()) {
+                service_type = srv_desc.service_type;
+                // Replace names only if they are not empty.
+                if (!srv_desc.provider_name.empty()) {
+                    provider = srv_desc.provider_name;
+                }
+                if (!srv_desc.service_name.empty()) {
+                    name = srv_desc.service_name;
+                }
+            }
+            break;
         }
     }
 }
@@ -600,30 +608,36 @@ void ts::TSAnalyzer::handleTable(SectionDemux&, const BinaryTable& table)
             break;
         }
         case TID_CAT: {
-            const CAT cat(_duck, table);
-            if (pid == PID_CAT && cat.isValid()) {
-                analyzeCAT(cat);
+            if (pid == PID_CAT) {
+                analyzeCAT(table);
             }
             break;
         }
         case TID_PMT: {
-            const PMT pmt(_duck, table);
-            if (pmt.isValid()) {
-                analyzePMT(pid, pmt);
+            // PMT, NIT and SDT are analyzed directly from the binary sections, without full deserialization.
+            if (table.sectionCount() > 0) {
+                const PMTView pmt(*table.sectionAt(0));
+                if (pmt.isValid()) {
+                    analyzePMT(pid, pmt);
+                }
             }
             break;
         }
         case TID_NIT_ACT: {
-            const NIT nit(_duck, table);
-            if (nit.isValid()) {
-                analyzeNIT(pid, nit);
+            for (size_t i = 0; i < table.sectionCount(); ++i) {
+                const NITView nit(*table.sectionAt(i));
+                if (nit.isValid()) {
+                    analyzeNIT(pid, nit);
+                }
             }
             break;
         }
         case TID_SDT_ACT: {
-            const SDT sdt(_duck, table);
-            if (sdt.isValid()) {
-                analyzeSDT(sdt);
+            for (size_t i = 0; i < table.sectionCount(); ++i) {
+                const SDTView sdt(*table.sectionAt(i));
+                if (sdt.isValid()) {
+                    analyzeSDT(sdt);
+                }
             }
             break;
         }
@@ -702,10 +716,16 @@ void ts::TSAnalyzer::analyzePAT(const PAT& pat)
 // Analyze a CAT
 //----------------------------------------------------------------------------
 
-void ts::TSAnalyzer::analyzeCAT(const CAT& cat)
+void ts::TSAnalyzer::analyzeCAT(const BinaryTable& table)
 {
-    // Analyze the CA descriptors to find EMM PIDs
-    analyzeDescriptors(cat.descs);
+    // Analyze the CA descriptors to find EMM PIDs.
+    // The payload of all CAT sections is a list of descriptors.
+    for (size_t i = 0; i < table.sectionCount(); ++i) {
+        const Section& section(*table.sectionAt(i));
+        if (section.isValid()) {
+            analyzeDescriptors(DescriptorListView(section.payload(), section.payloadSize()));
+        }
+    }
 }
 
 
@@ -713,51 +733,50 @@ void ts::TSAnalyzer::analyzeCAT(const CAT& cat)
 // Analyze a PMT
 //----------------------------------------------------------------------------
 
-void ts::TSAnalyzer::analyzePMT(PID pid, const PMT& pmt)
+void ts::TSAnalyzer::analyzePMT(PID pid, const PMTView& pmt)
 {
     // Count the number of PMT's on this PID
     PIDContextPtr ps(getPID(pid));
     ps->pmt_cnt++;
 
     // Get service description
-    ServiceContextPtr svp(getService(pmt.service_id));
+    ServiceContextPtr svp(getService(pmt.serviceId()));
 
     // Check that this PMT was expected on this PID
     if (svp->pmt_pid != pid) {
         // PAT/PMT inconsistency: Found a PMT on a PID which was not
         // referenced as a PMT PID in the PAT.
-        ps->addService(pmt.service_id);
+        ps->addService(pmt.serviceId());
         ps->description = u"PMT";
     }
 
     // Locate PCR PID
-    if (pmt.pcr_pid != 0 && pmt.pcr_pid != PID_NULL) {
-        svp->pcr_pid = pmt.pcr_pid;
+    if (pmt.pcrPID() != 0 && pmt.pcrPID() != PID_NULL) {
+        svp->pcr_pid = pmt.pcrPID();
         // This PID is the PCR PID for this service. Initial description
         // will normally be replaced later by "Audio", "Video", etc.
         // Some encoders, however, generate a dedicated PID for PCR's.
-        ps = getPID(pmt.pcr_pid, u"PCR (not otherwise referenced)");
+        ps = getPID(pmt.pcrPID(), u"PCR (not otherwise referenced)");
         ps->is_pcr_pid = true;
-        ps->addService(pmt.service_id);
+        ps->addService(pmt.serviceId());
     }
 
     // Process "program info" list of descriptors.
-    analyzeDescriptors(pmt.descs, svp.pointer());
+    analyzeDescriptors(pmt.descs(), svp.pointer());
 
     // Some broadcasters incorrectly place the service_descriptor in the PMT instead of the SDT.
-    svp->update(_duck, pmt.descs);
+    svp->update(_duck, pmt.descs());
 
     // Process all "elementary stream info"
-    for (auto& it : pmt.streams) {
-        const PID es_pid = it.first;
-        const PMT::Stream& stream(it.second);
+    for (const auto& stream : pmt.streams()) {
+        const PID es_pid = stream.pid();
         ps = getPID(es_pid);
-        ps->addService(pmt.service_id);
-        ps->stream_type = stream.stream_type;
-        ps->carry_audio = ps->carry_audio || StreamTypeIsAudio(stream.stream_type);
-        ps->carry_video = ps->carry_video || StreamTypeIsVideo(stream.stream_type);
-        ps->carry_pes = ps->carry_pes || StreamTypeIsPES(stream.stream_type);
-        if (!ps->carry_section && !ps->carry_t2mi && StreamTypeIsSection(stream.stream_type)) {
+        ps->addService(pmt.serviceId());
+        ps->stream_type = stream.streamType();
+        ps->carry_audio = ps->carry_audio || StreamTypeIsAudio(stream.streamType());
+        ps->carry_video = ps->carry_video || StreamTypeIsVideo(stream.streamType());
+        ps->carry_pes = ps->carry_pes || StreamTypeIsPES(stream.streamType());
+        if (!ps->carry_section && !ps->carry_t2mi && StreamTypeIsSection(stream.streamType())) {
             ps->carry_section = true;
             _demux.addPID(es_pid);
         }
@@ -768,8 +787,8 @@ void ts::TSAnalyzer::analyzePMT(PID pid, const PMT& pmt)
             AppendUnique(ps->attributes, ps->audio2.toString());
         }
 
-        ps->description = names::StreamType(stream.stream_type);
-        analyzeDescriptors(stream.descs, svp.pointer(), ps.pointer());
+        ps->description = names::StreamType(stream.streamType());
+        analyzeDescriptors(stream.descs(), svp.pointer(), ps.pointer());
     }
 }
 
@@ -778,7 +797,7 @@ void ts::TSAnalyzer::analyzePMT(PID pid, const PMT& pmt)
 // Analyze a NIT
 //----------------------------------------------------------------------------
 
-void ts::TSAnalyzer::analyzeNIT(PID pid, const NIT& nit)
+void ts::TSAnalyzer::analyzeNIT(PID pid, const NITView& nit)
 {
     PIDContextPtr ps(getPID(pid));
 
@@ -789,10 +808,17 @@ void ts::TSAnalyzer::analyzeNIT(PID pid, const NIT& nit)
 
     // Search network name. If not present, desc.name is empty.
     NetworkNameDescriptor desc;
-    nit.descs.search(_duck, DID_NETWORK_NAME, desc);
+    for (const auto& dv : nit.descs()) {
+        if (dv.tag() == DID_NETWORK_NAME) {
+            Descriptor bindesc;
+            dv.toDescriptor(bindesc);
+            desc.deserialize(_duck, bindesc);
+            break;
+        }
+    }
 
     // Format network description as attribute of PID.
-    AppendUnique(ps->attributes, UString::Format(u"Network: 0x%X (%<d) %s", {nit.network_id, desc.name}).toTrimmed());
+    AppendUnique(ps->attributes, UString::Format(u"Network: 0x%X (%<d) %s", {nit.id(), desc.name}).toTrimmed());
 }
 
 
@@ -800,13 +826,13 @@ void ts::TSAnalyzer::analyzeNIT(PID pid, const NIT& nit)
 // Analyze an SDT
 //----------------------------------------------------------------------------
 
-void ts::TSAnalyzer::analyzeSDT(const SDT& sdt)
+void ts::TSAnalyzer::analyzeSDT(const SDTView& sdt)
 {
     // Register characteristics of all services
-    for (auto& it : sdt.services) {
-        ServiceContextPtr svp(getService(it.first)); // it->first = map key = service id
-        svp->orig_netw_id = sdt.onetw_id;
-        svp->update(_duck, it.second.descs);
+    for (const auto& srv : sdt.services()) {
+        ServiceContextPtr svp(getService(srv.serviceId()));
+        svp->orig_netw_id = sdt.onetwId();
+        svp->update(_duck, srv.descs());
     }
 }
 
@@ -953,30 +979,37 @@ ts::UString ts::TSAnalyzer::PIDContext::fullDescription(bool include_attributes)
 //  If ps is not 0, we are in the description of this PID in a PMT.
 //----------------------------------------------------------------------------
 
-void ts::TSAnalyzer::analyzeDescriptors(const DescriptorList& descs, ServiceContext* svp, PIDContext* ps)
+void ts::TSAnalyzer::analyzeDescriptors(const DescriptorListView& descs, ServiceContext* svp, PIDContext* ps)
 {
-    for (size_t di = 0; di < descs.count(); ++di) {
+    // Current private data specifier in the descriptor list.
+    PDS pds = 0;
+
+    // A Descriptor object is built only for the few descriptors which need a full deserialization.
+    Descriptor bindesc;
+
+    for (const auto& dv : descs) {
 
-        const Descriptor& bindesc(*descs[di]);
-        const uint8_t* data = bindesc.payload();
-        size_t size = bindesc.payloadSize();
+        const uint8_t* data = dv.payload();
+        size_t size = dv.payloadSize();
+        dv.updatePDS(pds);
 
-        switch (descs[di]->tag()) {
+        switch (dv.tag()) {
             case DID_CA: {
                 // MPEG standard CA descriptor.
-                analyzeCADescriptor(bindesc, svp, ps);
+                analyzeCADescriptor(dv, svp, ps);
                 break;
             }
             case DID_ISDB_CA:
             case DID_ISDB_COND_PLAYBACK: {
                 // ISDB specific CA descriptors.
-                if (_duck.actualPDS(descs.privateDataSpecifier(di)) == PDS_ISDB) {
-                    analyzeCADescriptor(bindesc, svp, ps, u" (ISDB)");
+                if (_duck.actualPDS(pds) == PDS_ISDB) {
+                    analyzeCADescriptor(dv, svp, ps, u" (ISDB)");
                 }
                 break;
             }
             case DID_LANGUAGE: {
                 if (ps != nullptr) {
+                    dv.toDescriptor(bindesc);
                     const ISO639LanguageDescriptor desc(_duck, bindesc);
                     for (auto& e : desc.entries) {
                         AppendUnique(ps->languages, e.language_code);
@@ -1006,6 +1039,7 @@ void ts::TSAnalyzer::analyzeDescriptors(const DescriptorList& descs, ServiceCont
             case DID_AAC: {
                 if (ps != nullptr) {
                     // The presence of this descriptor indicates an AAC, E-AAC or HE-AAC audio track.
+                    dv.toDescriptor(bindesc);
                     const AACDescriptor desc(_duck, bindesc);
                     const UString type(desc.aacTypeString());
                     if (!type.empty()) {
@@ -1042,6 +1076,7 @@ void ts::TSAnalyzer::analyzeDescriptors(const DescriptorList& descs, ServiceCont
             case DID_SUBTITLING: {
                 if (ps != nullptr) {
                     ps->description = u"Subtitles";
+                    dv.toDescriptor(bindesc);
                     const SubtitlingDescriptor desc(_duck, bindesc);
                     for (auto& e : desc.entries) {
                         AppendUnique(ps->languages, e.language_code);
@@ -1053,6 +1088,7 @@ void ts::TSAnalyzer::analyzeDescriptors(const DescriptorList& descs, ServiceCont
             case DID_TELETEXT: {
                 if (ps != nullptr) {
                     ps->description = u"Teletext";
+                    dv.toDescriptor(bindesc);
                     const TeletextDescriptor desc(_duck, bindesc);
                     for (auto& e : desc.entries) {
                         AppendUnique(ps->languages, e.language_code);
@@ -1198,7 +1234,7 @@ void ts::TSAnalyzer::analyzeDescriptors(const DescriptorList& descs, ServiceCont
 //  If svp is 0, we are in the CAT.
 //----------------------------------------------------------------------------
 
-void ts::TSAnalyzer::analyzeCADescriptor(const Descriptor& desc, ServiceContext* svp, PIDContext* ps, const UString& suffix)
+void ts::TSAnalyzer::analyzeCADescriptor(const DescriptorView& desc, ServiceContext* svp, PIDContext* ps, const UString& suffix)
 {
     const uint8_t* data(desc.payload());
     size_t size(desc.payloadSize());
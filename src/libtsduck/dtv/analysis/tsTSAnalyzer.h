@@ -42,6 +42,9 @@
 #include "tsPMT.h"
 #include "tsNIT.h"
 #include "tsSDT.h"
+#include "tsPMTView.h"
+#include "tsSDTView.h"
+#include "tsNITView.h"
 #include "tsTDT.h"
 #include "tsTOT.h"
 #include "tsMGT.h"
@@ -218,7 +221,7 @@ namespace ts {
             //! @param [in,out] duck TSDuck execution context.
             //! @param [in] descs Descriptor list from SDT or PMT.
             //!
-            void update(DuckContext& duck, const DescriptorList& descs);
+            void update(DuckContext& duck, const DescriptorListView& descs);
         };
 
         //!
@@ -509,10 +512,10 @@ namespace ts {
 
         // Analyze the various PSI tables
         void analyzePAT(const PAT&);
-        void analyzeCAT(const CAT&);
-        void analyzePMT(PID pid, const PMT&);
-        void analyzeNIT(PID pid, const NIT&);
-        void analyzeSDT(const SDT&);
+        void analyzeCAT(const BinaryTable&);
+        void analyzePMT(PID pid, const PMTView&);
+        void analyzeNIT(PID pid, const NITView&);
+        void analyzeSDT(const SDTView&);
         void analyzeTDT(const TDT&);
         void analyzeTOT(const TOT&);
         void analyzeMGT(const MGT&);
@@ -522,13 +525,13 @@ namespace ts {
         // Analyse a list of descriptors.
         // If svp is not 0, we are in the PMT of the specified service.
         // If ps is not 0, we are in the description of this PID in a PMT.
-        void analyzeDescriptors(const DescriptorList& descs, ServiceContext* svp = nullptr, PIDContext* ps = nullptr);
+        void analyzeDescriptors(const DescriptorListView& descs, ServiceContext* svp = nullptr, PIDContext* ps = nullptr);
 
         // Analyse one CA descriptor, either from the CAT or a PMT.
         // If svp is not 0, we are in the PMT of the specified service.
         // If ps is not 0, we are in the description of this PID in a PMT.
         // If svp is 0, we are in the CAT.
-        void analyzeCADescriptor(const Descriptor& desc, ServiceContext* svp = nullptr, PIDContext* ps = nullptr, const UString& suffix = UString());
+        void analyzeCADescriptor(const DescriptorView& desc, ServiceContext* svp = nullptr, PIDContext* ps = nullptr, const UString& suffix = UString());
 
         // Implementation of TableHandlerInterface
         virtual void handleTable(SectionDemux&, const BinaryTable&) override;
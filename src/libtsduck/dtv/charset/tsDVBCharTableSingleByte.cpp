@@ -95,15 +95,33 @@ ts::DVBCharTableSingleByte::DVBCharTableSingleByte(const UChar* name, uint32_t t
 
 bool ts::DVBCharTableSingleByte::decode(UString& str, const uint8_t* dvb, size_t dvbSize) const
 {
+    // Each byte is decoded into at most one character. Size the output once, truncate at the end.
     str.clear();
-    str.reserve(dvbSize);
+    str.resize(dvb == nullptr ? 0 : dvbSize);
+    UChar* const out = const_cast<UChar*>(str.data());
+    size_t outSize = 0;
+
     bool status = true;
     bool reverseNext = false;  // after decoding next character, it shall be swapped with previous one.
     bool hasDiacritical = false;
 
-    for (; dvb != nullptr && dvbSize > 0; --dvbSize) {
+    while (dvb != nullptr && dvbSize > 0) {
+        // Runs of printable ASCII characters are identical in all DVB tables and converted in bulk.
+        // Short runs are not worth the call, they are decoded one by one.
+        if (!reverseNext && dvbSize >= 16 && *dvb >= 0x20 && *dvb <= 0x7E) {
+            const char* in = reinterpret_cast<const char*>(dvb);
+            UChar* outNext = out + outSize;
+            UString::ConvertASCIIToUTF16(in, in + dvbSize, outNext, out + str.size(), 0x20, 0x7E);
+            const size_t count = in - reinterpret_cast<const char*>(dvb);
+            outSize += count;
+            dvb += count;
+            dvbSize -= count;
+            continue;
+        }
+
         // Get next byte
         const uint8_t b = *dvb++;
+        --dvbSize;
         // Convert it to a code point
         uint16_t cp = 0;
         if (b >= 0x20 && b <= 0x7E) {
@@ -120,21 +138,24 @@ bool ts::DVBCharTableSingleByte::decode(UString& str, const uint8_t* dvb, size_t
             // Untranslatable character.
             status = false;
         }
-        else if (reverseNext && !str.empty()) {
+        else if (reverseNext && outSize > 0) {
             // Insert decoded character before the previous one.
             // This is typically a letter coming after a reversable diacritical mark.
             // In Unicode, the letter must preceed the diacritical mark.
-            str.insert(str.length() - 1, 1, UChar(cp));
+            out[outSize] = out[outSize - 1];
+            out[outSize - 1] = UChar(cp);
+            outSize++;
         }
         else {
             // Simply add the decoded character.
-            str.push_back(UChar(cp));
+            out[outSize++] = UChar(cp);
         }
         // Try the presence of diacritical, reversable or not.
         hasDiacritical = hasDiacritical || IsCombiningDiacritical(UChar(cp));
         // Shall we perform mark/letter swap next time?
         reverseNext = b >= 0xA0 && _reversedDiacritical.test(b - 0xA0);
     }
+    str.resize(outSize);
 
     // If some diacritical mark was found, try to combine them.
     if (hasDiacritical) {
@@ -51,7 +51,7 @@ ts::DVBCharTableUTF8::DVBCharTableUTF8(const UChar* name) :
 
 bool ts::DVBCharTableUTF8::decode(UString& str, const uint8_t* dvb, size_t dvbSize) const
 {
-    str = UString::FromUTF8(reinterpret_cast<const char*>(dvb), dvbSize);
+    str.assignFromUTF8(reinterpret_cast<const char*>(dvb), dvbSize);
     return true;
 }
 
@@ -29,6 +29,7 @@
 
 #include "tsAVCAttributes.h"
 #include "tsAVCSequenceParameterSet.h"
+#include "tsAVC.h"
 #include "tsNamesFile.h"
 
 
@@ -41,7 +42,8 @@ ts::AVCAttributes::AVCAttributes() :
     _vsize(0),
     _profile(0),
     _level(0),
-    _chroma(0)
+    _chroma(0),
+    _last_sps()
 {
 }
 
@@ -95,12 +97,24 @@ ts::UString ts::AVCAttributes::chromaFormatName() const
 
 bool ts::AVCAttributes::moreBinaryData(const uint8_t* data, size_t size)
 {
-    // Parse AVC access unit. We are interested in "sequence parameter set" only.
+    // We are interested in "sequence parameter set" only. Look at the NALunit type
+    // before parsing: most NALunits are slices which are skipped without analysis.
+    if (data == nullptr || size == 0 || !((data[0] & 0x1F) == AVC_AUT_SEQPARAMS)) {
+        return false;
+    }
+
+    // The same SPS is usually repeated before each intra-coded image. Don't parse it again.
+    if (_is_valid && _last_sps.size() == size && ::memcmp(_last_sps.data(), data, size) == 0) {
+        return false;
+    }
+
+    // Parse AVC access unit.
     AVCSequenceParameterSet params(data, size);
 
     if (!params.valid) {
         return false;
     }
+    _last_sps.copy(data, size);
 
     // Compute final values.
     const size_t hsize = params.frameWidth();
@@ -29,6 +29,7 @@
 
 #include "tsHEVCAttributes.h"
 #include "tsHEVCSequenceParameterSet.h"
+#include "tsHEVC.h"
 #include "tsNamesFile.h"
 
 
@@ -41,7 +42,8 @@ ts::HEVCAttributes::HEVCAttributes() :
     _vsize(0),
     _profile(0),
     _level(0),
-    _chroma(0)
+    _chroma(0),
+    _last_sps()
 {
 }
 
@@ -95,12 +97,24 @@ ts::UString ts::HEVCAttributes::chromaFormatName() const
 
 bool ts::HEVCAttributes::moreBinaryData(const uint8_t* data, size_t size)
 {
-    // Parse HEVC access unit. We are interested in "sequence parameter set" only.
+    // We are interested in "sequence parameter set" only. Look at the NALunit type
+    // before parsing: most NALunits are slices which are skipped without analysis.
+    if (data == nullptr || size == 0 || !(((data[0] >> 1) & 0x3F) == HEVC_AUT_SPS_NUT)) {
+        return false;
+    }
+
+    // The same SPS is usually repeated before each intra-coded image. Don't parse it again.
+    if (_is_valid && _last_sps.size() == size && ::memcmp(_last_sps.data(), data, size) == 0) {
+        return false;
+    }
+
+    // Parse HEVC access unit.
     HEVCSequenceParameterSet params(data, size);
 
     if (!params.valid) {
         return false;
     }
+    _last_sps.copy(data, size);
 
     // Compute final values.
     const size_t hsize = params.frameWidth();
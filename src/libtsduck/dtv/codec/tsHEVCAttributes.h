@@ -34,6 +34,7 @@
 
 #pragma once
 #include "tsAbstractAudioVideoAttributes.h"
+#include "tsByteBlock.h"
 
 namespace ts {
     //!
@@ -107,10 +108,11 @@ namespace ts {
         UString chromaFormatName() const;
 
     private:
-        size_t  _hsize;    // Horizontal size in pixel
-        size_t  _vsize;    // Vertical size in pixel
-        int     _profile;  // HEVC profile
-        int     _level;    // HEVC level
-        uint8_t _chroma;   // Chroma format code (CHROMA_* from tsMPEG.h)
+        size_t    _hsize;    // Horizontal size in pixel
+        size_t    _vsize;    // Vertical size in pixel
+        int       _profile;  // HEVC profile
+        int       _level;    // HEVC level
+        uint8_t   _chroma;   // Chroma format code (CHROMA_* from tsMPEG.h)
+        ByteBlock _last_sps; // Last analyzed sequence parameter set, not analyzed again when repeated
     };
 }
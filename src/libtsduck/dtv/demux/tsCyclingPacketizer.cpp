@@ -40,6 +40,8 @@ ts::CyclingPacketizer::CyclingPacketizer(const DuckContext& duck, PID pid, Stuff
     Packetizer(duck, pid, this),
     _stuffing(stuffing),
     _bitrate(bitrate),
+    _packet_cache(false),
+    _last_provided(),
     _section_count(0),
     _sched_sections(),
     _other_sections(),
@@ -59,7 +61,8 @@ ts::CyclingPacketizer::SectionDesc::SectionDesc(const SectionPtr& sec, MilliSeco
     repetition(rep),
     last_packet(0),
     due_packet(0),
-    last_cycle(0)
+    last_cycle(0),
+    packets()
 {
 }
 
@@ -249,6 +252,7 @@ void ts::CyclingPacketizer::removeAll()
     _sched_packets = 0;
     _sched_sections.clear();
     _other_sections.clear();
+    _last_provided.clear();
 }
 
 
@@ -370,6 +374,9 @@ void ts::CyclingPacketizer::provideSection(SectionCounter counter, SectionPtr& s
         _other_sections.push_back(sp);
     }
 
+    // Keep track of the last provided section for the cache of pre-packetized sections.
+    _last_provided = sp;
+
     if (sp.isNull()) {
         // No section to provide
         sect.clear();
@@ -408,6 +415,43 @@ bool ts::CyclingPacketizer::doStuffing()
 }
 
 
+//----------------------------------------------------------------------------
+// Get the pre-packetized form of a section. Inherited from Packetizer.
+//----------------------------------------------------------------------------
+
+ts::Packetizer::TSPacketVectorPtr ts::CyclingPacketizer::getSectionPackets(const SectionPtr& section)
+{
+    // The packetizer always asks for the last provided section.
+    if (!_packet_cache || _last_provided.isNull() || _last_provided->section != section) {
+        return TSPacketVectorPtr();
+    }
+
+    // Packetize the section the first time it is used, followed by stuffing.
+    // The PID and continuity counters are set by the packetizer when the packets are sent.
+    if (_last_provided->packets.isNull()) {
+        const Section& sect(*section);
+        TSPacketVectorPtr pkts(new TSPacketVector(sect.packetCount()));
+        size_t next_byte = 0;
+        for (size_t i = 0; i < pkts->size(); ++i) {
+            TSPacket& pkt((*pkts)[i]);
+            uint8_t* data = pkt.b + 4;
+            pkt.b[0] = SYNC_BYTE;
+            PutUInt16(pkt.b + 1, i == 0 ? 0x4000 : 0x0000);  // payload_unit_start_indicator on first packet
+            pkt.b[3] = 0x10;  // no adaptation field, has payload
+            if (i == 0) {
+                *data++ = 0x00;  // pointer_field, section starts immediately
+            }
+            const size_t length = std::min<size_t>(sect.size() - next_byte, pkt.b + PKT_SIZE - data);
+            ::memcpy(data, sect.content() + next_byte, length);  // Flawfinder: ignore: memcpy()
+            ::memset(data + length, 0xFF, pkt.b + PKT_SIZE - data - length);
+            next_byte += length;
+        }
+        _last_provided->packets = pkts;
+    }
+    return _last_provided->packets;
+}
+
+
 //----------------------------------------------------------------------------
 // Return true when the last generated packet was the last packet in the cycle.
 //----------------------------------------------------------------------------
@@ -443,6 +487,7 @@ std::ostream& ts::CyclingPacketizer::display(std::ostream& strm) const
 {
     Packetizer::display(strm)
         << "  Stuffing policy: " << int(_stuffing) << std::endl
+        << "  Packet cache: " << UString::YesNo(_packet_cache) << std::endl
         << "  Bitrate: " << _bitrate << " b/s" << std::endl
         << "  Current cycle: " << _current_cycle << std::endl
         << "  Remaining sections in cycle: " << _remain_in_cycle << std::endl
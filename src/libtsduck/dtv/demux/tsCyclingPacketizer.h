@@ -133,6 +133,30 @@ namespace ts {
             return _bitrate;
         }
 
+        //!
+        //! Enable or disable the cache of pre-packetized sections.
+        //!
+        //! When the cache is enabled, each section is packetized only once, the first time it
+        //! is sent. At each repetition, the same TS packets are sent again and only the continuity
+        //! counters are updated. The cache is used for all sections which start at the beginning
+        //! of a TS packet, typically when the stuffing policy is ALWAYS or with small tables.
+        //! The generated packets are identical, with or without cache.
+        //!
+        //! The sections shall not be modified once they are added in the packetizer.
+        //! Instead, remove the previous sections and add new ones. A new section is
+        //! packetized again.
+        //!
+        //! @param [in] on When true, enable the cache of pre-packetized sections.
+        //! The cache is disabled by default.
+        //!
+        void setPacketCache(bool on) { _packet_cache = on; }
+
+        //!
+        //! Check if the cache of pre-packetized sections is enabled.
+        //! @return True if the cache of pre-packetized sections is enabled.
+        //!
+        bool packetCache() const { return _packet_cache; }
+
         //!
         //! Add one section into the packetizer.
         //! The contents of the sections are shared.
@@ -227,11 +251,12 @@ namespace ts {
         {
         public:
             // Public fields
-            SectionPtr     section;     // Pointer to section
-            MilliSecond    repetition;  // Repetition rate, zero if none
-            PacketCounter  last_packet; // Packet index of last time the section was sent
-            PacketCounter  due_packet;  // Packet index of next time
-            SectionCounter last_cycle;  // Cycle index of last time the section was sent
+            SectionPtr        section;     // Pointer to section
+            MilliSecond       repetition;  // Repetition rate, zero if none
+            PacketCounter     last_packet; // Packet index of last time the section was sent
+            PacketCounter     due_packet;  // Packet index of next time
+            SectionCounter    last_cycle;  // Cycle index of last time the section was sent
+            TSPacketVectorPtr packets;     // Pre-packetized section, when the cache is used
 
             // Constructor
             SectionDesc(const SectionPtr& sec, MilliSecond rep);
@@ -252,6 +277,8 @@ namespace ts {
         // Private members:
         StuffingPolicy  _stuffing;
         BitRate         _bitrate;
+        bool            _packet_cache;    // Use pre-packetized sections.
+        SectionDescPtr  _last_provided;   // Last provided section.
         size_t          _section_count;   // Number of sections in the 2 lists
         SectionDescList _sched_sections;  // Scheduled sections, with repetition rates
         SectionDescList _other_sections;  // Unscheduled sections
@@ -272,6 +299,9 @@ namespace ts {
         virtual void provideSection(SectionCounter, SectionPtr&) override;
         virtual bool doStuffing() override;
 
+        // Inherited from Packetizer
+        virtual TSPacketVectorPtr getSectionPackets(const SectionPtr& section) override;
+
         // Hide this method, we do not want the section provider to be replaced
         void setSectionProvider(SectionProviderInterface*) = delete;
     };
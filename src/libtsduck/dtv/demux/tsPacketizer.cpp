@@ -44,7 +44,8 @@ ts::Packetizer::Packetizer(const DuckContext& duck, PID pid, SectionProviderInte
     _section(nullptr),
     _next_byte(0),
     _section_out_count(0),
-    _section_in_count(0)
+    _section_in_count(0),
+    _section_packets()
 {
 }
 
@@ -61,10 +62,21 @@ void ts::Packetizer::reset()
 {
     AbstractPacketizer::reset();
     _section.clear();
+    _section_packets.clear();
     _next_byte = 0;
 }
 
 
+//----------------------------------------------------------------------------
+// Get the pre-packetized form of a section. Default: none.
+//----------------------------------------------------------------------------
+
+ts::Packetizer::TSPacketVectorPtr ts::Packetizer::getSectionPackets(const SectionPtr&)
+{
+    return TSPacketVectorPtr();
+}
+
+
 //----------------------------------------------------------------------------
 // Build the next MPEG packet for the list of sections.
 //----------------------------------------------------------------------------
@@ -86,6 +98,33 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
         return false;
     }
 
+    // When a section starts at the beginning of a packet, check if it is already packetized.
+    if (_next_byte == 0) {
+        _section_packets = getSectionPackets(_section);
+    }
+    if (!_section_packets.isNull()) {
+        // The first packet contains a pointer field, the other ones only contain section data.
+        const size_t index = _next_byte == 0 ? 0 : 1 + (_next_byte - (PKT_SIZE - 5)) / (PKT_SIZE - 4);
+        const bool last = index + 1 >= _section_packets->size();
+        // The last pre-packetized packet is usable only when stuffing is required after the section.
+        if (index < _section_packets->size() && (!last || _provider == nullptr || _provider->doStuffing())) {
+            pkt = (*_section_packets)[index];
+            configurePacket(pkt, false);  // PID, continuity, count packets.
+            if (last) {
+                _section_out_count++;
+                _section.clear();
+                _section_packets.clear();
+                _next_byte = 0;
+            }
+            else {
+                _next_byte += index == 0 ? PKT_SIZE - 5 : PKT_SIZE - 4;
+            }
+            return true;
+        }
+        // Packetize the end of the section on the fly.
+        _section_packets.clear();
+    }
+
     // Various values to build the MPEG header.
     uint16_t pusi = 0x0000;         // payload_unit_start_indicator (set: 0x4000)
     uint8_t pointer_field = 0x00;   // pointer_field (used only if pusi is set)
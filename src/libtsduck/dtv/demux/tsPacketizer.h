@@ -35,6 +35,7 @@
 #pragma once
 #include "tsAbstractPacketizer.h"
 #include "tsSectionProviderInterface.h"
+#include "tsTSPacket.h"
 
 namespace ts {
     //!
@@ -104,6 +105,29 @@ namespace ts {
         virtual bool getNextPacket(TSPacket& packet) override;
         virtual std::ostream& display(std::ostream& strm) const override;
 
+    protected:
+        //!
+        //! Safe pointer to the TS packets of a pre-packetized section (not thread-safe).
+        //!
+        typedef SafePtr<TSPacketVector, NullMutex> TSPacketVectorPtr;
+
+        //!
+        //! Get the pre-packetized form of a section.
+        //!
+        //! This method is invoked each time a section starts at the beginning of a TS packet.
+        //! A subclass which maintains a cache of packetized sections may return the TS packets
+        //! for this section, as if the section was followed by stuffing. Only the PID and the
+        //! continuity counter are updated in the returned packets. If stuffing is not required
+        //! after the section, the last packet is rebuilt to pack the beginning of the next section.
+        //!
+        //! The default implementation returns a null pointer, meaning that the section is
+        //! packetized on the fly.
+        //!
+        //! @param [in] section The section to packetize.
+        //! @return A safe pointer to the TS packets of the section or a null pointer if unavailable.
+        //!
+        virtual TSPacketVectorPtr getSectionPackets(const SectionPtr& section);
+
     private:
         SectionProviderInterface* _provider;
         bool           _split_headers;     // Allowed to split section header beetwen TS packets.
@@ -111,5 +135,6 @@ namespace ts {
         size_t         _next_byte;         // Next byte to insert in current section
         SectionCounter _section_out_count; // Number of output (packetized) sections
         SectionCounter _section_in_count;  // Number of input (provided) sections
+        TSPacketVectorPtr _section_packets; // Pre-packetized current section, if any
     };
 }
@@ -34,6 +34,7 @@
 #include "tsTSPacket.h"
 #include "tsReportFile.h"
 #include "tsEIT.h"
+#include "tsAllocationTracker.h"
 
 
 //----------------------------------------------------------------------------
@@ -253,6 +254,8 @@ void ts::SectionDemux::immediateResetPID(PID pid)
 
 void ts::SectionDemux::feedPacket(const TSPacket& pkt)
 {
+    TS_ALLOCATION_SCOPE(u"SectionDemux");
+
     if (_pid_filter[pkt.getPID()]) {
         processPacket(pkt);
     }
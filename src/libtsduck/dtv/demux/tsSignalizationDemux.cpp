@@ -37,6 +37,7 @@
 #include "tsISDBAccessControlDescriptor.h"
 #include "tsCAT.h"
 #include "tsSDT.h"
+#include "tsSDTView.h"
 #include "tsBAT.h"
 #include "tsRST.h"
 #include "tsTDT.h"
@@ -696,46 +697,66 @@ void ts::SignalizationDemux::handleTable(SectionDemux&, const BinaryTable& table
             break;
         }
         case TID_PMT: {
-            const PMT pmt(_duck, table);
-            if (pmt.isValid()) {
-                handlePMT(pmt, pid);
+            // Don't deserialize PMT's for unknown services, they are ignored.
+            if (Contains(_services, table.tableIdExtension())) {
+                const PMT pmt(_duck, table);
+                if (pmt.isValid()) {
+                    handlePMT(pmt, pid);
+                }
             }
             break;
         }
         case TID_TSDT: {
-            const TSDT tsdt(_duck, table);
-            if (tsdt.isValid() && pid == PID_TSDT && _handler != nullptr && isFilteredTableId(TID_TSDT)) {
-                _handler->handleTSDT(tsdt, pid);
+            if (pid == PID_TSDT && _handler != nullptr && isFilteredTableId(TID_TSDT)) {
+                const TSDT tsdt(_duck, table);
+                if (tsdt.isValid()) {
+                    _handler->handleTSDT(tsdt, pid);
+                }
             }
             break;
         }
         case TID_NIT_ACT:
         case TID_NIT_OTH:  {
-            const NIT nit(_duck, table);
-            if (nit.isValid() && pid == nitPID()) {
-                handleNIT(nit, pid);
+            // A NIT Other is useless when not notified to the application.
+            if (pid == nitPID() && (tid == TID_NIT_ACT || (_handler != nullptr && isFilteredTableId(tid)))) {
+                const NIT nit(_duck, table);
+                if (nit.isValid()) {
+                    handleNIT(nit, pid);
+                }
             }
             break;
         }
         case TID_SDT_ACT:
         case TID_SDT_OTH:  {
-            const SDT sdt(_duck, table);
-            if (sdt.isValid() && pid == PID_SDT) {
-                handleSDT(sdt, pid);
+            if (pid == PID_SDT) {
+                if (_handler != nullptr && isFilteredTableId(tid)) {
+                    const SDT sdt(_duck, table);
+                    if (sdt.isValid()) {
+                        handleSDT(sdt, pid);
+                    }
+                }
+                else if (tid == TID_SDT_ACT && table.isValid()) {
+                    // The SDT is not notified to the application, directly read the binary sections.
+                    handleSDT(table);
+                }
             }
             break;
         }
         case TID_BAT: {
-            const BAT bat(_duck, table);
-            if (bat.isValid() && pid == PID_BAT && _handler != nullptr && isFilteredTableId(tid)) {
-                _handler->handleBAT(bat, pid);
+            if (pid == PID_BAT && _handler != nullptr && isFilteredTableId(tid)) {
+                const BAT bat(_duck, table);
+                if (bat.isValid()) {
+                    _handler->handleBAT(bat, pid);
+                }
             }
             break;
         }
         case TID_RST: {
-            const RST rst(_duck, table);
-            if (rst.isValid() && pid == PID_RST && _handler != nullptr && isFilteredTableId(tid)) {
-                _handler->handleRST(rst, pid);
+            if (pid == PID_RST && _handler != nullptr && isFilteredTableId(tid)) {
+                const RST rst(_duck, table);
+                if (rst.isValid()) {
+                    _handler->handleRST(rst, pid);
+                }
             }
             break;
         }
@@ -787,9 +808,11 @@ void ts::SignalizationDemux::handleTable(SectionDemux&, const BinaryTable& table
             break;
         }
         case TID_RRT: {
-            const RRT rrt(_duck, table);
-            if (rrt.isValid() && pid == PID_PSIP && _handler != nullptr && isFilteredTableId(tid)) {
-                _handler->handleRRT(rrt, pid);
+            if (pid == PID_PSIP && _handler != nullptr && isFilteredTableId(tid)) {
+                const RRT rrt(_duck, table);
+                if (rrt.isValid()) {
+                    _handler->handleRRT(rrt, pid);
+                }
             }
             break;
         }
@@ -1069,6 +1092,39 @@ void ts::SignalizationDemux::handleSDT(const SDT& sdt, PID pid)
 }
 
 
+//----------------------------------------------------------------------------
+// Process a binary SDT Actual which is not notified to the application.
+//----------------------------------------------------------------------------
+
+void ts::SignalizationDemux::handleSDT(const BinaryTable& table)
+{
+    // Same processing as handleSDT() on an SDT Actual, without deserialization.
+    for (size_t i = 0; i < table.sectionCount(); ++i) {
+        const SDTView sdt(*table.sectionAt(i));
+        if (!sdt.isValid()) {
+            continue;
+        }
+
+        // Get transport stream identification.
+        _ts_id = sdt.tsId();
+        _orig_network_id = sdt.onetwId();
+
+        // Collect service information. Loop on all services in the section.
+        for (const auto& sdt_srv : sdt.services()) {
+            const auto srv(getServiceContext(sdt_srv.serviceId(), CreateService::IF_MAY_EXIST));
+            if (!srv.isNull()) {
+                sdt_srv.updateService(_duck, srv->service);
+                // If the service description changed, notify the application.
+                if (_handler != nullptr && srv->service.isModified()) {
+                    _handler->handleService(_ts_id, srv->service, srv->pmt, false);
+                    srv->service.clearModified();
+                }
+            }
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Process an MGT.
 //----------------------------------------------------------------------------
@@ -483,6 +483,7 @@ namespace ts {
         void handlePMT(const PMT&, PID);
         void handleNIT(const NIT&, PID);
         void handleSDT(const SDT&, PID);
+        void handleSDT(const BinaryTable&);
         void handleMGT(const MGT&, PID);
         void handleSAT(const SAT&, PID);
 
@@ -89,6 +89,15 @@ namespace ts {
             //!
             bool send(const Message& msg, Logger& logger);
 
+            //!
+            //! Serialize and send several TLV messages in one single send operation.
+            //! All messages are serialized in the same buffer.
+            //! @param [in] msgs The messages to send.
+            //! @param [in,out] logger Where to report errors and messages.
+            //! @return True on success, false on error.
+            //!
+            bool send(const std::vector<const Message*>& msgs, Logger& logger);
+
             //!
             //! Receive a TLV message.
             //! Wait for the message, deserialize it and validate it.
@@ -113,6 +122,20 @@ namespace ts {
             //!
             bool receive(MessagePtr& msg, const AbortInterface* abort, Logger& logger);
 
+            //!
+            //! Receive all available TLV messages without waiting for a complete message.
+            //!
+            //! This method performs one single receive operation on the socket and returns all
+            //! complete messages. Incomplete messages are kept in an internal buffer until the
+            //! rest is received. This method is typically called when an event-driven application
+            //! knows that the socket is readable (see SocketPoller). Do not mix with receive().
+            //!
+            //! @param [out] msgs Received valid messages. Invalid messages are processed as in receive().
+            //! @param [in,out] logger Where to report errors and messages.
+            //! @return True on success, false on error or disconnection.
+            //!
+            bool receiveAvailable(std::vector<MessagePtr>& msgs, Logger& logger);
+
             //!
             //! Get invalid incoming messages processing.
             //! @return True if, when an invalid message is received, the corresponding
@@ -155,6 +178,11 @@ namespace ts {
             size_t          _invalid_msg_count;
             MUTEX           _send_mutex;
             MUTEX           _receive_mutex;
+            ByteBlock       _receive_buffer;  // Partially received messages in receiveAvailable().
+
+            // Analyze a received message. Process invalid messages.
+            // Return false on fatal error. Set valid to false on invalid message.
+            bool analyzeMessage(const uint8_t* data, size_t size, MessagePtr& msg, bool& valid, Logger& logger);
         };
     }
 }
@@ -46,7 +46,8 @@ ts::tlv::Connection<MUTEX>::Connection(const Protocol* protocol, bool auto_error
     _max_invalid_msg(max_invalid_msg),
     _invalid_msg_count(0),
     _send_mutex(),
-    _receive_mutex()
+    _receive_mutex(),
+    _receive_buffer()
 {
 }
 
@@ -95,6 +96,24 @@ bool ts::tlv::Connection<MUTEX>::send(const Message& msg, Logger& logger)
 }
 
 
+template <class MUTEX>
+bool ts::tlv::Connection<MUTEX>::send(const std::vector<const Message*>& msgs, Logger& logger)
+{
+    ByteBlockPtr bbp(new ByteBlock);
+    bbp->reserve(256 * msgs.size());
+    Serializer serial(bbp);
+    for (const auto msg : msgs) {
+        if (msg != nullptr) {
+            logger.log(*msg, u"sending message to " + peerName());
+            msg->serialize(serial);
+        }
+    }
+
+    GuardMutex lock(_send_mutex);
+    return bbp->empty() || SuperClass::send(bbp->data(), bbp->size(), logger.report());
+}
+
+
 //----------------------------------------------------------------------------
 // Receive a TLV message (wait for the message, deserialize it and validate it)
 //----------------------------------------------------------------------------
@@ -135,33 +154,102 @@ bool ts::tlv::Connection<MUTEX>::receive(MessagePtr& msg, const AbortInterface*
         }
 
         // Analyze the message
-        MessageFactory mf(bb.data(), bb.size(), _protocol);
-        if (mf.errorStatus() == tlv::OK) {
-            _invalid_msg_count = 0;
-            mf.factory(msg);
-            if (!msg.isNull()) {
-                logger.log(*msg, u"received message from " + peerName());
-            }
+        bool valid = false;
+        if (!analyzeMessage(bb.data(), bb.size(), msg, valid, logger)) {
+            return false;
+        }
+        else if (valid) {
             return true;
         }
+    }
+}
 
-        // Received an invalid message
-        _invalid_msg_count++;
 
-        // Send back an error message if necessary
-        if (_auto_error_response) {
-            MessagePtr resp;
-            mf.buildErrorResponse(resp);
-            if (!send(*resp, logger.report())) {
-                return false;
-            }
+//----------------------------------------------------------------------------
+// Receive all available TLV messages without waiting.
+//----------------------------------------------------------------------------
+
+template <class MUTEX>
+bool ts::tlv::Connection<MUTEX>::receiveAvailable(std::vector<MessagePtr>& msgs, Logger& logger)
+{
+    const bool has_version(_protocol->hasVersion());
+    const size_t header_size(has_version ? 5 : 4);
+    const size_t length_offset(has_version ? 3 : 2);
+
+    msgs.clear();
+    GuardMutex lock(_receive_mutex);
+
+    // Receive what is available in the socket, at most 64 kB, in one single system call.
+    const size_t previous = _receive_buffer.size();
+    size_t size = 0;
+    _receive_buffer.resize(previous + 0x10000);
+    const bool ok = SuperClass::receive(_receive_buffer.data() + previous, 0x10000, size, nullptr, logger.report());
+    _receive_buffer.resize(previous + (ok ? size : 0));
+    if (!ok) {
+        return false;
+    }
+
+    // Extract all complete messages.
+    size_t start = 0;
+    while (_receive_buffer.size() - start >= header_size) {
+        const size_t msg_size = header_size + GetUInt16(_receive_buffer.data() + start + length_offset);
+        if (_receive_buffer.size() - start < msg_size) {
+            break; // incomplete message
         }
+        MessagePtr msg;
+        bool valid = false;
+        if (!analyzeMessage(_receive_buffer.data() + start, msg_size, msg, valid, logger)) {
+            return false;
+        }
+        if (!msg.isNull()) {
+            msgs.push_back(msg);
+        }
+        start += msg_size;
+    }
+    _receive_buffer.erase(0, start);
+    return true;
+}
+
 
-        // If invalid message max has been reached, break the connection
-        if (_max_invalid_msg > 0 && _invalid_msg_count >= _max_invalid_msg) {
-            logger.report().error(u"too many invalid messages from %s, disconnecting", {peerName()});
-            disconnect(logger.report());
+//----------------------------------------------------------------------------
+// Analyze a received message. Process invalid messages.
+//----------------------------------------------------------------------------
+
+template <class MUTEX>
+bool ts::tlv::Connection<MUTEX>::analyzeMessage(const uint8_t* data, size_t size, MessagePtr& msg, bool& valid, Logger& logger)
+{
+    msg.clear();
+    valid = false;
+
+    // Analyze the message
+    MessageFactory mf(data, size, _protocol);
+    if (mf.errorStatus() == tlv::OK) {
+        _invalid_msg_count = 0;
+        valid = true;
+        mf.factory(msg);
+        if (!msg.isNull()) {
+            logger.log(*msg, u"received message from " + peerName());
+        }
+        return true;
+    }
+
+    // Received an invalid message
+    _invalid_msg_count++;
+
+    // Send back an error message if necessary
+    if (_auto_error_response) {
+        MessagePtr resp;
+        mf.buildErrorResponse(resp);
+        if (!send(*resp, logger.report())) {
             return false;
         }
     }
+
+    // If invalid message max has been reached, break the connection
+    if (_max_invalid_msg > 0 && _invalid_msg_count >= _max_invalid_msg) {
+        logger.report().error(u"too many invalid messages from %s, disconnecting", {peerName()});
+        disconnect(logger.report());
+        return false;
+    }
+    return true;
 }
@@ -48,6 +48,7 @@ ts::EITGenerator::EITGenerator(DuckContext& duck, PID pid, EITOptions options, c
     _max_bitrate(0),
     _ts_bitrate(0),
     _ref_time(),
+    _next_update(),
     _ref_time_pkt(0),
     _eit_inter_pkt(0),
     _last_eit_pkt(0),
@@ -86,6 +87,7 @@ void ts::EITGenerator::reset()
     _max_bitrate = 0;
     _ts_bitrate = 0;
     _ref_time.clear();
+    _next_update.clear();
     _ref_time_pkt = 0;
     _eit_inter_pkt = 0;
     _last_eit_pkt = 0;
@@ -133,7 +135,6 @@ ts::EITGenerator::Event::Event(const uint8_t*& data, size_t& size) :
 ts::EITGenerator::ESection::ESection(EITGenerator* gen, const ServiceIdTriplet& srv, TID tid, uint8_t section_number, uint8_t last_section_number) :
     obsolete(false),
     injected(false),
-    next_inject(),
     section()
 {
     // Build section data.
@@ -312,10 +313,13 @@ bool ts::EITGenerator::loadEvents(const ServiceIdTriplet& service_id, const uint
         // segment if necessary. This is the minimum to store an event. We do not try to create
         // empty intermediate segments. This will be done in regenerateSchedule().
 
+        // Events are usually loaded in chronological order. Therefore, the search starts from
+        // the end of the lists of segments and events. Loading a large EPG remains linear.
+
         const Time seg_start_time(EIT::SegmentStartTime(ev->start_time));
-        auto seg_iter = srv->segments.begin();
-        while (seg_iter != srv->segments.end() && (*seg_iter)->start_time < seg_start_time) {
-            ++seg_iter;
+        auto seg_iter = srv->segments.end();
+        while (seg_iter != srv->segments.begin() && (*std::prev(seg_iter))->start_time >= seg_start_time) {
+            --seg_iter;
         }
         if (seg_iter == srv->segments.end() || (*seg_iter)->start_time != seg_start_time) {
             // The segment does not exist, create it.
@@ -327,9 +331,9 @@ bool ts::EITGenerator::loadEvents(const ServiceIdTriplet& service_id, const uint
         ESegment& seg(**seg_iter);
 
         // Insert the binary event in the list of events for that segment.
-        auto ev_iter = seg.events.begin();
-        while (ev_iter != seg.events.end() && (*ev_iter)->start_time < ev->start_time) {
-            ++ev_iter;
+        auto ev_iter = seg.events.end();
+        while (ev_iter != seg.events.begin() && (*std::prev(ev_iter))->start_time >= ev->start_time) {
+            --ev_iter;
         }
         if (ev_iter != seg.events.end() && (*ev_iter)->event_id == ev->event_id && (*ev_iter)->event_data == ev->event_data) {
             // Duplicate event, ignore it.
@@ -344,9 +348,11 @@ bool ts::EITGenerator::loadEvents(const ServiceIdTriplet& service_id, const uint
     }
 
     // If some events were added, it may be necessary to regenerate the EIT p/f in this service.
+    // The new events may also start or end before the next scheduled update.
     if (ev_count > 0) {
         assert(srv != nullptr);
         regeneratePresentFollowing(service_id, *srv, now);
+        invalidateNextUpdate();
     }
     return success;
 }
@@ -471,6 +477,7 @@ void ts::EITGenerator::setTransportStreamId(uint16_t new_ts_id)
     const uint16_t old_ts_id = _actual_ts_id_set ? _actual_ts_id : 0xFFFF;
     _actual_ts_id = new_ts_id;
     _actual_ts_id_set = true;
+    invalidateNextUpdate();
 
     // No longer need the PAT when the TS id is known.
     _demux.removePID(PID_PAT);
@@ -560,6 +567,7 @@ void ts::EITGenerator::setOptions(EITOptions options)
     // Update the options.
     const EITOptions old_options = _options;
     _options = options;
+    invalidateNextUpdate();
 
     // If the new options request to load events from input EIT's, demux the EIT PID.
     if (bool(options & EITOptions::LOAD_INPUT)) {
@@ -673,7 +681,8 @@ void ts::EITGenerator::setCurrentTime(Time current_utc)
     _ref_time_pkt = _packet_index;
     _duck.report().debug(u"setting TS time to %s at packet index %'d", {_ref_time, _ref_time_pkt});
 
-    // Update EIT database if necessary.
+    // Update EIT database if necessary. The new time may be before the previous one.
+    invalidateNextUpdate();
     updateForNewTime(_ref_time);
 }
 
@@ -706,11 +715,11 @@ void ts::EITGenerator::markObsoleteSection(ESection& sec)
             // Loop on all injection queues.
             for (size_t index = 0; index < _injects.size(); ++index) {
                 // Loop on all sections in the queue.
-                ESectionList& list(_injects[index]);
-                auto it = list.begin();
-                while (it != list.end()) {
-                    if ((*it)->obsolete) {
-                        it = list.erase(it);
+                ESectionQueue& queue(_injects[index]);
+                auto it = queue.begin();
+                while (it != queue.end()) {
+                    if (it->second->obsolete) {
+                        it = queue.erase(it);
                     }
                     else {
                         ++it;
@@ -727,32 +736,14 @@ void ts::EITGenerator::markObsoleteSection(ESection& sec)
 // Enqueue a section for injection.
 //----------------------------------------------------------------------------
 
-void ts::EITGenerator::enqueueInjectSection(const ESectionPtr& sec, const Time& next_inject, bool try_front)
+void ts::EITGenerator::enqueueInjectSection(const ESectionPtr& sec, const Time& next_inject)
 {
-    // Update section injection time.
-    sec->next_inject = next_inject;
-
     // Compute which injection queue to use.
-    ESectionList& list(_injects[size_t(_profile.sectionToProfile(*sec->section))]);
+    ESectionQueue& queue(_injects[size_t(_profile.sectionToProfile(*sec->section))]);
 
-    // Even start at from or back of the queue (possible optimization).
-    if (try_front) {
-        auto it = list.begin();
-        while (it != list.end() && (*it)->next_inject <= next_inject) {
-            ++it;
-        }
-        list.insert(it, sec);
-    }
-    else {
-        auto it = list.end();
-        while (it != list.begin() && (*--it)->next_inject > next_inject) {
-        }
-        if (it != list.end()) {
-            // it points to a section before sec, must insert after.
-            ++it;
-        }
-        list.insert(it, sec);
-    }
+    // Insert after all sections with the same injection time. Most of the time, a requeued section
+    // goes at the end of the queue, which is the hint, making the insertion constant-time.
+    queue.emplace_hint(queue.end(), next_inject, sec);
 }
 
 
@@ -834,7 +825,7 @@ bool ts::EITGenerator::regeneratePresentFollowingSection(const ServiceIdTriplet&
             sec->section->recomputeCRC();
         }
         // Place the section in the inject queue.
-        enqueueInjectSection(sec, inject_time, true);
+        enqueueInjectSection(sec, inject_time);
         // Section was modified.
         return true;
     }
@@ -1028,7 +1019,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                             // Sections are independently versioned, this one is complete.
                             sec->section->recomputeCRC();
                         }
-                        enqueueInjectSection(sec, getCurrentTime(), true);
+                        enqueueInjectSection(sec, getCurrentTime());
 
                         // Move to next section (if it exists).
                         ++sec_iter;
@@ -1046,7 +1037,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                         const ESectionPtr sec(new ESection(this, service_id, table_id, first_section_number, first_section_number));
                         CheckNonNull(sec.pointer());
                         seg.sections.push_back(sec);
-                        enqueueInjectSection(sec, getCurrentTime(), true);
+                        enqueueInjectSection(sec, getCurrentTime());
                     }
                 }
 
@@ -1155,13 +1146,18 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
 void ts::EITGenerator::updateForNewTime(const Time& now)
 {
     // We cannot regenerate EIT if the TS id or the current time is unknown.
-    if (!_actual_ts_id_set || now == Time::Epoch) {
+    // Nothing to do if nothing changed since last update.
+    if (!_actual_ts_id_set || now == Time::Epoch || (_next_update != Time::Epoch && now < _next_update)) {
         return;
     }
 
     // Reference time for EIT schedule.
     const Time last_midnight(now.thisDay());
 
+    // Without any event, the database changes with time when the next segment starts.
+    // Since 3-hour segments are aligned on midnight, this includes the change of day.
+    _next_update = EIT::SegmentStartTime(now) + EIT::SEGMENT_DURATION;
+
     // Loop on all services.
     for (auto& srv_iter : _services) {
 
@@ -1205,6 +1201,24 @@ void ts::EITGenerator::updateForNewTime(const Time& now)
 
         // Renew EIT p/f of the service when necessary.
         regeneratePresentFollowing(service_id, srv, now);
+
+        // Events in the first non-empty segment start or end before the next segment starts.
+        // This is where the EIT p/f changes and where events become obsolete. All events of
+        // the segment are checked, including overlapping ones, not only the first one. Events
+        // in later segments start after the next segment, already in _next_update.
+        for (const auto& seg : srv.segments) {
+            if (!seg->events.empty()) {
+                for (const auto& ev : seg->events) {
+                    if (now < ev->start_time) {
+                        _next_update = std::min(_next_update, ev->start_time);
+                    }
+                    else if (now < ev->end_time) {
+                        _next_update = std::min(_next_update, ev->end_time);
+                    }
+                }
+                break;
+            }
+        }
     }
 }
 
@@ -1224,7 +1238,7 @@ void ts::EITGenerator::provideSection(SectionCounter counter, SectionPtr& sectio
     const Time now(getCurrentTime());
 
     // Update EIT's according to current time.
-    updateForNewTime(getCurrentTime());
+    updateForNewTime(now);
 
     // Make sure the EIT schedule are up-to-date.
     regenerateSchedule(now);
@@ -1234,11 +1248,11 @@ void ts::EITGenerator::provideSection(SectionCounter counter, SectionPtr& sectio
 
         // Check if the first section in the queue is ready for injection.
         // Loop on obsolete events. Return on first injected event.
-        while (!_injects[index].empty() && _injects[index].front()->next_inject <= now) {
+        while (!_injects[index].empty() && _injects[index].begin()->first <= now) {
 
             // Remove the first section from the queue.
-            const ESectionPtr sec(_injects[index].front());
-            _injects[index].pop_front();
+            const ESectionPtr sec(_injects[index].begin()->second);
+            _injects[index].erase(_injects[index].begin());
 
             if (sec->obsolete) {
                 // This is an obsolete section, no longer in the base, drop it.
@@ -1251,9 +1265,10 @@ void ts::EITGenerator::provideSection(SectionCounter counter, SectionPtr& sectio
                 sec->injected = true;
 
                 // Requeue next iteration of that section.
-                enqueueInjectSection(sec, now + _profile.repetitionSeconds(*sec->section) * MilliSecPerSec, false);
+                const Time next_inject(now + _profile.repetitionSeconds(*sec->section) * MilliSecPerSec);
+                enqueueInjectSection(sec, next_inject);
                 _duck.report().log(2, u"inject section TID 0x%X (%<d), service 0x%X (%<d), at %s, requeue for %s",
-                                   {section->tableId(), section->tableIdExtension(), now, sec->next_inject});
+                                   {section->tableId(), section->tableIdExtension(), now, next_inject});
                 return;
             }
         }
@@ -1347,6 +1362,7 @@ void ts::EITGenerator::dumpInternalState(int lev) const
         rep.log(lev, u"TS bitrate: %'d b/s, max EIT bitrate: %'d b/s", {_ts_bitrate, _max_bitrate});
         rep.log(lev, u"Services count: %d", {_services.size()});
         rep.log(lev, u"Reference time: %s at packet %'d", {_ref_time, _ref_time_pkt});
+        rep.log(lev, u"Next EPG update: %s", {_next_update});
         rep.log(lev, u"Obsolete sections count: %d", {_obsolete_count});
         rep.log(lev, u"Regenerate: %s", {_regenerate});
 
@@ -1377,8 +1393,8 @@ void ts::EITGenerator::dumpInternalState(int lev) const
         for (size_t index = 0; index < _injects.size(); ++index) {
             rep.log(lev, u"");
             rep.log(lev, u"- Injection queue #%d: %d sections", {index, _injects[index].size()});
-            for (auto it = _injects[index].begin(); it != _injects[index].end(); ++it) {
-                dumpSection(lev, u"  - ", *it);
+            for (const auto& it : _injects[index]) {
+                dumpSection(lev, u"  - ", it.second, it.first);
             }
         }
         rep.log(lev, u"");
@@ -1390,7 +1406,7 @@ void ts::EITGenerator::dumpInternalState(int lev) const
 // Dump the internal state of an ESection for dumpInternalState().
 //----------------------------------------------------------------------------
 
-void ts::EITGenerator::dumpSection(int lev, const UString& margin, const ESectionPtr& sec) const
+void ts::EITGenerator::dumpSection(int lev, const UString& margin, const ESectionPtr& sec, const Time& next_inject) const
 {
     Report& rep(_duck.report());
 
@@ -1402,7 +1418,10 @@ void ts::EITGenerator::dumpSection(int lev, const UString& margin, const ESectio
 
     // Eliminate null Section in ESection.
     const UString space(margin.size(), SPACE);
-    const UString desc(UString::Format(u"next inject: %s, obsolete: %s, injected: %s", {sec->next_inject, sec->obsolete, sec->injected}));
+    UString desc(UString::Format(u"obsolete: %s, injected: %s", {sec->obsolete, sec->injected}));
+    if (next_inject != Time::Epoch) {
+        desc.insert(0, UString::Format(u"next inject: %s, ", {next_inject}));
+    }
     if (sec->section.isNull()) {
         rep.log(lev, u"%s(null section)", {margin});
         rep.log(lev, u"%s%s", {space, desc});
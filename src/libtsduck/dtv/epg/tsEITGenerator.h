@@ -381,7 +381,6 @@ namespace ts {
         public:
             bool       obsolete;     // The section is obsolete, discard it when found in an injection list.
             bool       injected;     // Indicate that the data part of the section is used in a packetizer.
-            Time       next_inject;  // Date of next injection.
             SectionPtr section;      // Safe pointer to the EIT section.
 
             // Constructor, build an empty section for the specified service (CRC32 not set).
@@ -454,8 +453,15 @@ namespace ts {
         // to inject, it is passed to the packetizer and requeued at the end of the list
         // for the next injection.
 
+        //
+        // The injection lists are indexed by next injection time. Inserting a section is
+        // logarithmic in the size of the list, even with very large EPG's. In case of equal
+        // injection times, a new section is inserted after the existing ones. The key of
+        // the list is the only place where the next injection time of a section is stored.
+
         typedef std::map<ServiceIdTriplet, EService> EServiceMap;
-        typedef std::array<ESectionList, EITRepetitionProfile::PROFILE_COUNT> ESectionListArray;
+        typedef std::multimap<Time, ESectionPtr> ESectionQueue;
+        typedef std::array<ESectionQueue, EITRepetitionProfile::PROFILE_COUNT> ESectionQueueArray;
 
         // ---------------------------
         // EITGenerator private fields
@@ -470,6 +476,7 @@ namespace ts {
         BitRate              _max_bitrate;       // Max EIT bitrate.
         BitRate              _ts_bitrate;        // Declared TS bitrate.
         Time                 _ref_time;          // Last reference time.
+        Time                 _next_update;       // Next time the EPG content changes with time (Epoch: unknown, check now).
         PacketCounter        _ref_time_pkt;      // Packet index at last reference time.
         PacketCounter        _eit_inter_pkt;     // Inter-packet distance in the EIT PID (zero if unbound).
         PacketCounter        _last_eit_pkt;      // Packet index at last EIT insertion.
@@ -478,7 +485,7 @@ namespace ts {
         SectionDemux         _demux;             // Section demux for input stream, get PAT, TDT, TOT, EIT.
         Packetizer           _packetizer;        // Packetizer for generated EIT's.
         EServiceMap          _services;          // Map of services -> segments -> events and sections.
-        ESectionListArray    _injects;           // Arrays of sections for injection.
+        ESectionQueueArray   _injects;           // Arrays of sections for injection.
         size_t               _obsolete_count;    // Number of obsolete sections in the injection lists.
         std::map<uint64_t,uint8_t> _versions;    // Last version of sections.
 
@@ -488,8 +495,14 @@ namespace ts {
         // Update the EIT database according to the current time.
         // Obsolete events, sections and segments are discarded.
         // Segments which must be regenerated are marked as such (will be actually regenerated later, when used).
+        // The database is actually inspected only when the time reaches _next_update, the next time
+        // where some event starts or ends or a new segment starts. Since this method is called for
+        // each injected section, most calls return immediately, even with large EPG's.
         void updateForNewTime(const Time& now);
 
+        // Force the EIT database to be inspected on next updateForNewTime().
+        void invalidateNextUpdate() { _next_update = Time::Epoch; }
+
         // Regenerate, if necessary, EIT p/f in a service. Return true if section is modified.
         void regeneratePresentFollowing(const ServiceIdTriplet& service_id, EService& srv, const Time& now);
         bool regeneratePresentFollowingSection(const ServiceIdTriplet& service_id, ESectionPtr& sec, TID tid, bool section_number, const EventPtr& event, const Time&inject_time);
@@ -506,10 +519,10 @@ namespace ts {
         void markObsoleteSegment(ESegment& seg);
 
         // Enqueue a section for injection.
-        void enqueueInjectSection(const ESectionPtr& sec, const Time& next_inject, bool try_front);
+        void enqueueInjectSection(const ESectionPtr& sec, const Time& next_inject);
 
-        // Helper for dumpInternalState()
-        void dumpSection(int level, const UString& margin, const ESectionPtr& section) const;
+        // Helper for dumpInternalState(). The next injection time is known for sections in injection lists only.
+        void dumpSection(int level, const UString& margin, const ESectionPtr& section, const Time& next_inject = Time::Epoch) const;
 
         // Implementation of SectionHandlerInterface.
         virtual void handleSection(SectionDemux& demux, const Section& section) override;
@@ -33,6 +33,7 @@
 #include "tsDuckContext.h"
 #include "tsSection.h"
 #include "tsxmlElement.h"
+#include "tsAllocationTracker.h"
 
 
 //----------------------------------------------------------------------------
@@ -369,6 +370,8 @@ bool ts::BinaryTable::addSections(SectionPtrVector::const_iterator first, Sectio
 
 bool ts::BinaryTable::addSection(const SectionPtr& sect, bool replace, bool grow)
 {
+    TS_ALLOCATION_SCOPE(u"BinaryTable");
+
     // Reject invalid sections
 
     if (sect.isNull() || !sect->isValid()) {
@@ -447,6 +450,8 @@ bool ts::BinaryTable::addSection(const SectionPtr& sect, bool replace, bool grow
 
 bool ts::BinaryTable::packSections()
 {
+    TS_ALLOCATION_SCOPE(u"BinaryTable");
+
     // There is nothing to do if no section is missing.
     if (_missing_count > 0) {
         assert(!_is_valid);
@@ -500,7 +505,8 @@ ts::BinaryTable::XMLOptions::XMLOptions() :
     forceGeneric(false),
     setPID(false),
     setLocalTime(false),
-    setPackets(false)
+    setPackets(false),
+    localTime()
 {
 }
 
@@ -573,7 +579,7 @@ ts::xml::Element* ts::BinaryTable::toXML(DuckContext& duck, xml::Element* parent
             meta->setIntAttribute(u"PID", _source_pid);
         }
         if (opt.setLocalTime) {
-            meta->setDateTimeAttribute(u"time", Time::CurrentLocalTime());
+            meta->setDateTimeAttribute(u"time", opt.localTime == Time::Epoch ? Time::CurrentLocalTime() : opt.localTime);
         }
         if (opt.setPackets) {
             meta->setIntAttribute(u"first_ts_packet", firstTSPacketIndex());
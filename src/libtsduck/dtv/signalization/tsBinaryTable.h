@@ -38,6 +38,7 @@
 #include "tsTS.h"
 #include "tsxml.h"
 #include "tsSection.h"
+#include "tsTime.h"
 
 namespace ts {
 
@@ -310,6 +311,7 @@ namespace ts {
             bool setPID;        //!< Add a metadata element with the source PID, when available.
             bool setLocalTime;  //!< Add a metadata element with the current local time.
             bool setPackets;    //!< Add a metadata element with the index of the first and last TS packets of the table.
+            Time localTime;     //!< With setLocalTime, time to use instead of the current local time. Ignored if Time::Epoch.
         };
 
         //!
@@ -32,6 +32,7 @@
 #include "tsAbstractTable.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsAllocationTracker.h"
 
 
 //----------------------------------------------------------------------------
@@ -111,6 +112,8 @@ bool ts::DescriptorList::operator==(const DescriptorList& other) const
 
 bool ts::DescriptorList::add(const DescriptorPtr& desc)
 {
+    TS_ALLOCATION_SCOPE(u"DescriptorList");
+
     PDS pds = 0;
 
     if (desc.isNull() || !desc->isValid()) {
@@ -144,6 +147,8 @@ bool ts::DescriptorList::add(const DescriptorPtr& desc)
 
 bool ts::DescriptorList::add(DuckContext& duck, const AbstractDescriptor& desc)
 {
+    TS_ALLOCATION_SCOPE(u"DescriptorList");
+
     DescriptorPtr pd(new Descriptor);
     CheckNonNull(pd.pointer());
     return desc.serialize(duck, *pd) && add(pd);
@@ -156,6 +161,8 @@ bool ts::DescriptorList::add(DuckContext& duck, const AbstractDescriptor& desc)
 
 bool ts::DescriptorList::add(const void* data, size_t size)
 {
+    TS_ALLOCATION_SCOPE(u"DescriptorList");
+
     const uint8_t* desc = reinterpret_cast<const uint8_t*>(data);
     size_t length = 0;
     bool success = true;
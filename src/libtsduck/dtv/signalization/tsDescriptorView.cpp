@@ -0,0 +1,75 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsDescriptorView.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::DescriptorView::DescriptorView(const uint8_t* data, size_t size) :
+    _data(nullptr),
+    _size(0)
+{
+    // Invalid descriptor if truncated.
+    if (data != nullptr && size >= 2 && size >= 2 + size_t(data[1])) {
+        _data = data;
+        _size = 2 + size_t(data[1]);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Build a Descriptor object from this view.
+//----------------------------------------------------------------------------
+
+bool ts::DescriptorView::toDescriptor(Descriptor& desc) const
+{
+    if (_data == nullptr) {
+        desc.invalidate();
+        return false;
+    }
+    else {
+        desc = Descriptor(_data, _size);
+        return desc.isValid();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get the private data specifier.
+//----------------------------------------------------------------------------
+
+void ts::DescriptorView::updatePDS(PDS& pds) const
+{
+    if (_data != nullptr && _data[0] == DID_PRIV_DATA_SPECIF && _size >= 6) {
+        pds = GetUInt32(_data + 2);
+    }
+}
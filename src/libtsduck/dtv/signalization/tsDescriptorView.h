@@ -0,0 +1,136 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view of a descriptor in a binary section.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsLoopView.h"
+#include "tsDescriptor.h"
+
+namespace ts {
+    //!
+    //! Read-only view of a descriptor in a binary section.
+    //! @ingroup mpeg
+    //!
+    //! The view directly points into the binary content of a section. Nothing
+    //! is allocated or copied. A Descriptor object can be built on demand when
+    //! a descriptor of interest needs to be fully deserialized.
+    //!
+    class TSDUCKDLL DescriptorView
+    {
+    public:
+        //!
+        //! Default constructor, an invalid descriptor.
+        //!
+        DescriptorView() : _data(nullptr), _size(0) {}
+
+        //!
+        //! Constructor.
+        //! @param [in] data Address of the descriptor.
+        //! @param [in] size Size of the memory area, starting at @a data. This can be larger than the descriptor.
+        //!
+        DescriptorView(const uint8_t* data, size_t size);
+        //! Copy constructor.
+        //! @param [in] other Other instance to copy.
+        DescriptorView(const DescriptorView& other) = default;
+        //! Assignment operator.
+        //! @param [in] other Other instance to copy.
+        //! @return A reference to this object.
+        DescriptorView& operator=(const DescriptorView& other) = default;
+
+        //!
+        //! Check if the descriptor is valid.
+        //! @return True if the descriptor is valid.
+        //!
+        bool isValid() const { return _data != nullptr; }
+
+        //!
+        //! Get the descriptor tag.
+        //! @return The descriptor tag, 0xFF if the descriptor is invalid.
+        //!
+        DID tag() const { return _data == nullptr ? DID(0xFF) : _data[0]; }
+
+        //!
+        //! Get the address of the descriptor, including the tag and length.
+        //! @return The address of the descriptor.
+        //!
+        const uint8_t* content() const { return _data; }
+
+        //!
+        //! Get the size of the descriptor, including the tag and length.
+        //! @return The size of the descriptor in bytes.
+        //!
+        size_t size() const { return _size; }
+
+        //!
+        //! Get the address of the descriptor payload.
+        //! @return The address of the descriptor payload.
+        //!
+        const uint8_t* payload() const { return _data == nullptr ? nullptr : _data + 2; }
+
+        //!
+        //! Get the size of the descriptor payload.
+        //! @return The size of the descriptor payload in bytes.
+        //!
+        size_t payloadSize() const { return _size < 2 ? 0 : _size - 2; }
+
+        //!
+        //! Build a Descriptor object from this view.
+        //! The descriptor content is copied.
+        //! @param [out] desc The returned descriptor.
+        //! @return True on success, false if this view is invalid.
+        //!
+        bool toDescriptor(Descriptor& desc) const;
+
+        //!
+        //! Get the private data specifier if this descriptor is a private_data_specifier_descriptor.
+        //! @param [in,out] pds Updated with the private data specifier if this descriptor is a
+        //! private_data_specifier_descriptor. Unchanged otherwise.
+        //!
+        void updatePDS(PDS& pds) const;
+
+        //!
+        //! Get the size of this entry in the list of descriptors (for LoopView).
+        //! @return The size of the descriptor in bytes, zero if invalid.
+        //!
+        size_t entrySize() const { return _size; }
+
+    private:
+        const uint8_t* _data;
+        size_t         _size;
+    };
+
+    //!
+    //! Read-only view of a list of descriptors in a binary section.
+    //!
+    typedef LoopView<DescriptorView> DescriptorListView;
+}
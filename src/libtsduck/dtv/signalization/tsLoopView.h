@@ -0,0 +1,177 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view of a list of variable-size entries in a binary section.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+namespace ts {
+    //!
+    //! Read-only view of a list of variable-size entries in a binary section.
+    //! @ingroup mpeg
+    //!
+    //! A view directly iterates over the binary content of a section, without
+    //! copying or allocating anything. The viewed memory area must remain valid
+    //! as long as the view and its iterators are used.
+    //!
+    //! The iteration stops on the first truncated or malformed entry.
+    //!
+    //! @tparam ENTRY A class describing one entry in the list. It must have a
+    //! default constructor (an invalid entry), a constructor from the address and
+    //! remaining size of the memory area, starting at the entry, and a method
+    //! @c entrySize() returning the total size of the entry in bytes or zero if
+    //! the entry is invalid or truncated.
+    //!
+    template <class ENTRY>
+    class LoopView
+    {
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] data Address of the list of entries.
+        //! @param [in] size Size in bytes of the list of entries.
+        //!
+        LoopView(const uint8_t* data = nullptr, size_t size = 0) : _data(data), _size(data == nullptr ? 0 : size) {}
+        //! Copy constructor.
+        //! @param [in] other Other instance to copy.
+        LoopView(const LoopView& other) = default;
+        //! Assignment operator.
+        //! @param [in] other Other instance to copy.
+        //! @return A reference to this object.
+        LoopView& operator=(const LoopView& other) = default;
+
+        //!
+        //! Constant iterator over the entries of the list.
+        //!
+        class const_iterator
+        {
+        public:
+            //! Default constructor, same as end of list.
+            const_iterator() : _entry(), _next(nullptr), _remain(0) {}
+            //! Constructor.
+            //! @param [in] data Address of the first entry.
+            //! @param [in] size Size in bytes of the list of entries.
+            const_iterator(const uint8_t* data, size_t size) : _entry(), _next(data), _remain(size) { load(); }
+            //! Copy constructor.
+            //! @param [in] other Other instance to copy.
+            const_iterator(const const_iterator& other) = default;
+            //! Assignment operator.
+            //! @param [in] other Other instance to copy.
+            //! @return A reference to this object.
+            const_iterator& operator=(const const_iterator& other) = default;
+            //! Access the current entry.
+            //! @return A constant reference to the current entry.
+            const ENTRY& operator*() const { return _entry; }
+            //! Access the current entry.
+            //! @return A constant pointer to the current entry.
+            const ENTRY* operator->() const { return &_entry; }
+            //! Move to next entry.
+            //! @return A reference to this object.
+            const_iterator& operator++() { load(); return *this; }
+            //! Equality operator.
+            //! @param [in] other Other iterator to compare.
+            //! @return True if both iterators point to the same entry.
+            bool operator==(const const_iterator& other) const { return _next == other._next && _remain == other._remain; }
+            //! Unequality operator.
+            //! @param [in] other Other iterator to compare.
+            //! @return True if both iterators point to different entries.
+            bool operator!=(const const_iterator& other) const { return !operator==(other); }
+        private:
+            ENTRY          _entry;   // Current entry.
+            const uint8_t* _next;    // Address of next entry, null at end of list.
+            size_t         _remain;  // Remaining size after current entry.
+
+            // Load the next entry, becomes the end of list on error.
+            void load()
+            {
+                _entry = _remain == 0 ? ENTRY() : ENTRY(_next, _remain);
+                const size_t size = _entry.entrySize();
+                if (size == 0 || size > _remain) {
+                    _next = nullptr;
+                    _remain = 0;
+                }
+                else {
+                    _next += size;
+                    _remain -= size;
+                }
+            }
+        };
+
+        //!
+        //! Get an iterator to the first entry.
+        //! @return An iterator to the first entry.
+        //!
+        const_iterator begin() const { return const_iterator(_data, _size); }
+
+        //!
+        //! Get an iterator to the end of the list.
+        //! @return An iterator to the end of the list.
+        //!
+        const_iterator end() const { return const_iterator(); }
+
+        //!
+        //! Check if the list is empty.
+        //! @return True if the list has no valid entry.
+        //!
+        bool empty() const { return begin() == end(); }
+
+        //!
+        //! Count the number of valid entries in the list.
+        //! @return The number of valid entries in the list.
+        //!
+        size_t count() const
+        {
+            size_t n = 0;
+            for (auto it = begin(); it != end(); ++it) {
+                n++;
+            }
+            return n;
+        }
+
+        //!
+        //! Get the address of the list of entries.
+        //! @return The address of the list of entries.
+        //!
+        const uint8_t* data() const { return _data; }
+
+        //!
+        //! Get the size in bytes of the list of entries.
+        //! @return The size in bytes of the list of entries.
+        //!
+        size_t size() const { return _size; }
+
+    private:
+        const uint8_t* _data;
+        size_t         _size;
+    };
+}
@@ -74,7 +74,7 @@ ts::PID ts::PSIBuffer::getPID()
         skipReservedBits(3);
     }
     if (currentReadBitOffset() % 8 == 3) {
-        return getBits<PID>(13);
+        return getBits<13, PID>();
     }
     else {
         setReadError();
@@ -88,7 +88,7 @@ bool ts::PSIBuffer::putPID(PID pid)
         return putUInt16(0xE000 | pid);
     }
     else if (currentWriteBitOffset() % 8 == 3) {
-        return putBits(pid, 13);
+        return putBits<13>(pid);
     }
     else {
         setWriteError();
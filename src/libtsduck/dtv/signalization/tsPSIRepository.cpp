@@ -32,6 +32,8 @@
 #include "tsAlgorithm.h"
 #include "tsCerrReport.h"
 #include "tsNames.h"
+#include "tsGuardMutex.h"
+#include "tsStartupProfile.h"
 
 TS_DEFINE_SINGLETON(ts::PSIRepository);
 
@@ -41,6 +43,10 @@ TS_DEFINE_SINGLETON(ts::PSIRepository);
 //----------------------------------------------------------------------------
 
 ts::PSIRepository::PSIRepository() :
+    _mutex(),
+    _materialized(false),
+    _deferredFirst(nullptr),
+    _deferredLast(nullptr),
     _tables(),
     _descriptors(),
     _tableNames(),
@@ -72,6 +78,7 @@ ts::PSIRepository::DescriptorDescription::DescriptorDescription(DescriptorFactor
 }
 
 
+
 //----------------------------------------------------------------------------
 // Check if a PID is present in a table description.
 //----------------------------------------------------------------------------
@@ -116,6 +123,7 @@ void ts::PSIRepository::TableDescription::addPIDs(std::initializer_list<PID> mor
 template <typename FUNCTION, typename std::enable_if<std::is_pointer<FUNCTION>::value>::type*>
 FUNCTION ts::PSIRepository::getTableFunction(TID tid, Standards standards, PID pid, uint16_t cas, FUNCTION TableDescription::* member) const
 {
+    materialize();
     // Try to find an exact match with standard and CAS id.
     // Otherwise, will use a fallback once for same tid.
     FUNCTION fallbackFunc = nullptr;
@@ -161,6 +169,7 @@ FUNCTION ts::PSIRepository::getTableFunction(TID tid, Standards standards, PID p
 template <typename FUNCTION, typename std::enable_if<std::is_pointer<FUNCTION>::value>::type*>
 FUNCTION ts::PSIRepository::getDescriptorFunction(const EDID& edid, TID tid, FUNCTION DescriptorDescription::* member) const
 {
+    materialize();
     auto it(_descriptors.end());
 
     if (edid.isStandard() && tid != TID_NULL) {
@@ -286,6 +295,46 @@ ts::PSIRepository::RegisterDescriptor::RegisterDescriptor(DisplayCADescriptorFun
 }
 
 
+//----------------------------------------------------------------------------
+// Deferred registration of tables and descriptors.
+//----------------------------------------------------------------------------
+
+ts::PSIRepository::DeferredRegistration::DeferredRegistration(RegistrationFunction func) :
+    _func(func),
+    _next(nullptr)
+{
+    PSIRepository* const repo = PSIRepository::Instance();
+    GuardMutex lock(repo->_mutex);
+    if (repo->_materialized) {
+        // Late registration, typically from a shared library, apply it now.
+        _func();
+    }
+    else {
+        // Link the registration at end of list, keep the order of registrations.
+        if (repo->_deferredLast == nullptr) {
+            repo->_deferredFirst = this;
+        }
+        else {
+            repo->_deferredLast->_next = this;
+        }
+        repo->_deferredLast = this;
+    }
+}
+
+void ts::PSIRepository::applyDeferredRegistrations()
+{
+    GuardMutex lock(_mutex);
+    if (!_materialized) {
+        StartupProfile::Phase phase(u"PSI repository materialization");
+        for (const DeferredRegistration* reg = _deferredFirst; reg != nullptr; reg = reg->_next) {
+            reg->_func();
+        }
+        _deferredFirst = _deferredLast = nullptr;
+        _materialized.store(true, std::memory_order_release);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Get registered items.
 //----------------------------------------------------------------------------
@@ -307,12 +356,14 @@ ts::LogSectionFunction ts::PSIRepository::getSectionLog(TID id, Standards standa
 
 ts::PSIRepository::TableFactory ts::PSIRepository::getTableFactory(const UString& node_name) const
 {
+    materialize();
     const auto it = node_name.findSimilar(_tableNames);
     return it != _tableNames.end() ? it->second : nullptr;
 }
 
 ts::PSIRepository::DescriptorFactory ts::PSIRepository::getDescriptorFactory(const UString& node_name) const
 {
+    materialize();
     const auto it = node_name.findSimilar(_descriptorNames);
     return it != _descriptorNames.end() ? it->second : nullptr;
 }
@@ -329,6 +380,7 @@ ts::DisplayDescriptorFunction ts::PSIRepository::getDescriptorDisplay(const EDID
 
 ts::DisplayCADescriptorFunction ts::PSIRepository::getCADescriptorDisplay(uint16_t cas_id) const
 {
+    materialize();
     const auto it = _casIdDescriptorDisplays.find(cas_id);
     return it != _casIdDescriptorDisplays.end() ? it->second : nullptr;
 }
@@ -340,6 +392,7 @@ ts::DisplayCADescriptorFunction ts::PSIRepository::getCADescriptorDisplay(uint16
 
 ts::Standards ts::PSIRepository::getTableStandards(TID tid, PID pid) const
 {
+    materialize();
     // Accumulate the common subset of all standards for this table id.
     Standards standards = Standards::NONE;
     for (auto it = _tables.lower_bound(tid); it != _tables.end() && it->first == tid; ++it) {
@@ -366,6 +419,7 @@ ts::Standards ts::PSIRepository::getTableStandards(TID tid, PID pid) const
 
 bool ts::PSIRepository::isDescriptorAllowed(const UString& desc_node_name, TID table_id) const
 {
+    materialize();
     auto it = desc_node_name.findSimilar(_descriptorTablesIds);
     if (it == _descriptorTablesIds.end()) {
         // Not a table-specific descriptor, allowed anywhere
@@ -391,6 +445,7 @@ bool ts::PSIRepository::isDescriptorAllowed(const UString& desc_node_name, TID t
 
 ts::UString ts::PSIRepository::descriptorTables(const DuckContext& duck, const UString& desc_node_name) const
 {
+    materialize();
     auto it = desc_node_name.findSimilar(_descriptorTablesIds);
     UString result;
 
@@ -412,6 +467,7 @@ ts::UString ts::PSIRepository::descriptorTables(const DuckContext& duck, const U
 
 void ts::PSIRepository::getRegisteredTableIds(std::vector<TID>& ids) const
 {
+    materialize();
     ids.clear();
     TID previous = TID_NULL;
     for (const auto& it : _tables) {
@@ -425,6 +481,7 @@ void ts::PSIRepository::getRegisteredTableIds(std::vector<TID>& ids) const
 
 void ts::PSIRepository::getRegisteredDescriptorIds(std::vector<EDID>& ids) const
 {
+    materialize();
     ids.clear();
     for (const auto& it : _descriptors) {
         ids.push_back(it.first);
@@ -433,11 +490,13 @@ void ts::PSIRepository::getRegisteredDescriptorIds(std::vector<EDID>& ids) const
 
 void ts::PSIRepository::getRegisteredTableNames(UStringList& names) const
 {
+    materialize();
     names = MapKeysList(_tableNames);
 }
 
 void ts::PSIRepository::getRegisteredDescriptorNames(UStringList& names) const
 {
+    materialize();
     names = MapKeysList(_descriptorNames);
 }
 
@@ -39,6 +39,7 @@
 #include "tsTablesPtr.h"
 #include "tsSingletonManager.h"
 #include "tsVersionInfo.h"
+#include "tsMutex.h"
 
 namespace ts {
 
@@ -56,6 +57,15 @@ namespace ts {
     //! single thread). Then, the singleton is only read during the execution of the
     //! application. So, no explicit synchronization is required.
     //!
+    //! Deferred registration: The registration macros do not register anything during the
+    //! initialization of the application. They only link a static DeferredRegistration instance,
+    //! without any allocation. The actual registrations are performed (the repository is
+    //! "materialized") the first time the repository is queried. Short-lived applications which
+    //! never use tables or descriptors do not pay the price of building the lookup structures.
+    //! Registrations which occur after the materialization (typically when a shared library is
+    //! loaded) are immediately applied. The materialization is protected by a mutex and can be
+    //! triggered from any thread.
+    //!
     //! @ingroup mpeg
     //!
     class TSDUCKDLL PSIRepository
@@ -301,9 +311,6 @@ namespace ts {
             //! @see TS_REGISTER_CA_DESCRIPTOR
             //!
             RegisterDescriptor(DisplayCADescriptorFunction displayFunction, uint16_t minCAS, uint16_t maxCAS = CASID_NULL);
-
-        private:
-            void registerXML(DescriptorFactory factory, const EDID& edid, const UString& xmlName, const UString& xmlNameLegacy);
         };
 
         //!
@@ -364,6 +371,23 @@ namespace ts {
             DescriptorDescription(DescriptorFactory fact = nullptr, DisplayDescriptorFunction disp = nullptr);
         };
 
+        // Deferred registrations, protected by the mutex.
+        Mutex                 _mutex;          // Protect deferred registrations and materialization.
+        std::atomic<bool>     _materialized;   // The lookup structures are up-to-date.
+        DeferredRegistration* _deferredFirst;  // First registration which is not yet applied.
+        DeferredRegistration* _deferredLast;   // Last registration which is not yet applied.
+
+        // Apply all deferred registrations in the lookup structures.
+        void applyDeferredRegistrations();
+
+        // Make sure that the lookup structures are materialized before a query.
+        void materialize() const
+        {
+            if (!_materialized.load(std::memory_order_acquire)) {
+                const_cast<PSIRepository*>(this)->applyDeferredRegistrations();
+            }
+        }
+
         // PSIRepository instance private members.
         std::multimap<TID, TableDescription>            _tables;                   // Description of all table ids, potential multiple entries per table idx
         std::map<EDID, DescriptorDescription>           _descriptors;              // Description of all descriptors, by extended id.
@@ -39,12 +39,191 @@
 #include "tsjsonNull.h"
 #include "tsFileUtils.h"
 #include "tsEIT.h"
+#include "tsThread.h"
+#include "tsGuardCondition.h"
+#include "tsNamesFile.h"
+#include "tsStartupProfile.h"
+#include <atomic>
+#include <thread>
 
 const ts::UChar* const ts::SectionFile::DEFAULT_BINARY_SECTION_FILE_SUFFIX = u".bin";
 const ts::UChar* const ts::SectionFile::DEFAULT_XML_SECTION_FILE_SUFFIX = u".xml";
 const ts::UChar* const ts::SectionFile::DEFAULT_JSON_SECTION_FILE_SUFFIX = u".json";
 const ts::UChar* const ts::SectionFile::XML_TABLES_MODEL = u"tsduck.tables.model.xml";
 
+// Minimum number of tables per compilation thread. Below this, it is not worth creating a thread.
+namespace {
+    constexpr size_t MIN_TABLES_PER_THREAD = 16;
+}
+
+
+//----------------------------------------------------------------------------
+// Internal classes to compile XML tables in several threads.
+//
+// Global state which is used by the compilation threads:
+// - The PSI repository and the character set repository are singletons which
+//   are built before the threads start and are only read by the threads.
+// - The predefined .names files are loaded before starting the threads (see
+//   compileTables()) and NamesFile instances are read-only after loading.
+// - Each thread uses its own DuckContext, a copy of the SectionFile context.
+// - Messages from a thread are stored in the log of the table which is compiled
+//   by this thread. The CompilationReport does not update its own state from a
+//   compilation thread. The messages are reported later by the main thread.
+// - The XML document is only read by the threads.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // Messages which are reported during the compilation of one table.
+    typedef std::list<std::pair<int, ts::UString>> MessageLog;
+
+    // Message log of the table which is compiled by the current thread, if any.
+    thread_local MessageLog* current_log = nullptr;
+
+    // Report for the XML documents which are loaded by a SectionFile.
+    // When a compilation thread is running, messages are stored in the log of
+    // the current table, to be reported later in the order of the tables.
+    // Otherwise, messages are directly passed to the SectionFile report.
+    class CompilationReport : public ts::Report
+    {
+        TS_NOBUILD_NOCOPY(CompilationReport);
+    public:
+        CompilationReport(ts::Report& report) : Report(report.maxSeverity()), _report(report) {}
+        using Report::log;
+        virtual void log(int severity, const ts::UString& msg) override;
+    protected:
+        virtual void writeLog(int severity, const ts::UString& msg) override;
+    private:
+        ts::Report& _report;
+    };
+
+    // In a compilation thread, do not update the error state of the shared report.
+    void CompilationReport::log(int severity, const ts::UString& msg)
+    {
+        if (current_log == nullptr) {
+            Report::log(severity, msg);
+        }
+        else if (severity <= maxSeverity()) {
+            current_log->push_back(std::make_pair(severity, msg));
+        }
+    }
+
+    void CompilationReport::writeLog(int severity, const ts::UString& msg)
+    {
+        _report.log(severity, msg);
+    }
+
+    // Description of one table to compile.
+    class CompiledTable
+    {
+    public:
+        CompiledTable() : node(nullptr), before(ts::Standards::NONE), after(ts::Standards::NONE), table(), success(false), log() {}
+        CompiledTable(const CompiledTable&) = default;
+        CompiledTable& operator=(const CompiledTable&) = default;
+        const ts::xml::Element* node;    // XML table to compile.
+        ts::Standards           before;  // Standards in the context before compilation (predicted).
+        ts::Standards           after;   // Standards in the context after compilation.
+        ts::BinaryTablePtr      table;   // Compiled table.
+        bool                    success; // Compilation status.
+        MessageLog              log;     // Messages during compilation.
+    };
+
+    // The list of tables to compile, shared by all compilation threads.
+    // Tables are picked in order by the threads. The main thread collects the
+    // compiled tables in the same order, as soon as they are available.
+    class CompilationQueue
+    {
+        TS_NOBUILD_NOCOPY(CompilationQueue);
+    public:
+        CompilationQueue(std::vector<CompiledTable>& tbl) : tables(tbl), _next(0), _stop(false), _mutex(), _completed(), _done(tbl.size(), false) {}
+        std::vector<CompiledTable>& tables;
+
+        // Get the index of the next table to compile. Return false when there is nothing more to compile.
+        bool next(size_t& index) { index = _next++; return !_stop && index < tables.size(); }
+
+        // Stop picking tables to compile.
+        void stop() { _stop = true; }
+
+        // Signal that a table is compiled.
+        void completed(size_t index);
+
+        // Wait until a table is compiled.
+        void waitCompleted(size_t index);
+
+    private:
+        std::atomic<size_t> _next;
+        std::atomic<bool>   _stop;
+        ts::Mutex           _mutex;
+        ts::Condition       _completed;
+        std::vector<bool>   _done;
+    };
+
+    void CompilationQueue::completed(size_t index)
+    {
+        ts::GuardCondition lock(_mutex, _completed);
+        _done[index] = true;
+        lock.signal();
+    }
+
+    void CompilationQueue::waitCompleted(size_t index)
+    {
+        ts::GuardCondition lock(_mutex, _completed);
+        while (!_done[index]) {
+            lock.waitCondition();
+        }
+    }
+
+    // A compilation thread.
+    class CompilationThread : public ts::Thread
+    {
+        TS_NOBUILD_NOCOPY(CompilationThread);
+    public:
+        CompilationThread(const ts::DuckContext& duck, ts::Report& report, CompilationQueue& queue);
+        virtual ~CompilationThread() override;
+    private:
+        ts::DuckContext   _duck;
+        CompilationQueue& _queue;
+        virtual void main() override;
+    };
+
+    // Build a private execution context, with the same options as the SectionFile one.
+    CompilationThread::CompilationThread(const ts::DuckContext& duck, ts::Report& report, CompilationQueue& queue) :
+        Thread(),
+        _duck(&report),
+        _queue(queue)
+    {
+        ts::DuckContext::SavedArgs args;
+        duck.saveArgs(args);
+        _duck.restoreArgs(args);
+        _duck.setDefaultCharsetIn(duck.charsetIn());
+        _duck.setDefaultCharsetOut(duck.charsetOut());
+        _duck.setDefaultCASId(duck.casId());
+        _duck.setTimeReferenceOffset(duck.timeReferenceOffset());
+    }
+
+    CompilationThread::~CompilationThread()
+    {
+        waitForTermination();
+    }
+
+    void CompilationThread::main()
+    {
+        size_t index = 0;
+        while (_queue.next(index)) {
+            CompiledTable& ct(_queue.tables[index]);
+            current_log = &ct.log;
+            if (_duck.standards() != ct.before) {
+                _duck.resetStandards(ct.before);
+            }
+            ct.table = new ts::BinaryTable;
+            ct.success = ct.table->fromXML(_duck, ct.node) && ct.table->isValid();
+            ct.after = _duck.standards();
+            current_log = nullptr;
+            _queue.completed(index);
+        }
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Constructors and destructors.
@@ -58,8 +237,19 @@ ts::SectionFile::SectionFile(DuckContext& duck) :
     _orphanSections(),
     _model(_report),
     _xmlTweaks(),
-    _crc_op(CRC32::IGNORE)
+    _crc_op(CRC32::IGNORE),
+    _max_threads(1)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Set the maximum number of threads to compile tables from XML or JSON files.
+//----------------------------------------------------------------------------
+
+void ts::SectionFile::setMaxThreads(size_t count)
 {
+    _max_threads = count > 0 ? count : std::max<size_t>(1, std::thread::hardware_concurrency());
 }
 
 
@@ -520,6 +710,8 @@ bool ts::SectionFile::loadThisModel()
 
 bool ts::SectionFile::LoadModel(xml::Document& doc, bool load_extensions)
 {
+    StartupProfile::Phase phase(u"XML tables model loading");
+
     // Load the main model. Use searching rules.
     if (!doc.load(XML_TABLES_MODEL, true)) {
         doc.report().error(u"Main model for TSDuck XML files not found: %s", {XML_TABLES_MODEL});
@@ -563,27 +755,44 @@ bool ts::SectionFile::LoadModel(xml::Document& doc, bool load_extensions)
 
 bool ts::SectionFile::loadXML(const UString& file_name)
 {
-    xml::Document doc(_report);
+    const Monotonic start(true);
+    CompilationReport report(_report);
+    xml::Document doc(report);
     doc.setTweaks(_xmlTweaks);
-    return doc.load(file_name, false) && parseDocument(doc);
+    return doc.load(file_name, false) && parseDocument(doc, start);
 }
 
 bool ts::SectionFile::loadXML(std::istream& strm)
 {
-    xml::Document doc(_report);
+    const Monotonic start(true);
+    CompilationReport report(_report);
+    xml::Document doc(report);
     doc.setTweaks(_xmlTweaks);
-    return doc.load(strm) && parseDocument(doc);
+    return doc.load(strm) && parseDocument(doc, start);
 }
 
 bool ts::SectionFile::parseXML(const UString& xml_content)
 {
-    xml::Document doc(_report);
+    const Monotonic start(true);
+    CompilationReport report(_report);
+    xml::Document doc(report);
     doc.setTweaks(_xmlTweaks);
-    return doc.parse(xml_content) && parseDocument(doc);
+    return doc.parse(xml_content) && parseDocument(doc, start);
 }
 
-bool ts::SectionFile::parseDocument(const xml::Document& doc)
+bool ts::SectionFile::parseDocument(const xml::Document& doc, const Monotonic& start)
 {
+    // Report the duration of each stage in debug mode.
+    Monotonic stage_start(start);
+    const auto end_of_stage = [this, &stage_start](const UChar* stage) {
+        if (_report.debug()) {
+            const Monotonic now(true);
+            _report.debug(u"%s: %'d ms", {stage, (now - stage_start) / NanoSecPerMilliSec});
+            stage_start = now;
+        }
+    };
+    end_of_stage(u"document loading");
+
     // Load the XML model for TSDuck files, if not already done.
     if (!loadThisModel()) {
         return false;
@@ -593,22 +802,122 @@ bool ts::SectionFile::parseDocument(const xml::Document& doc)
     if (!_model.validate(doc)) {
         return false;
     }
+    end_of_stage(u"document validation");
 
     // Get the root in the document. Should be ok since we validated the document.
     const xml::Element* root = doc.rootElement();
+    xml::ElementVector nodes;
+    for (const xml::Element* node = root == nullptr ? nullptr : root->firstChildElement(); node != nullptr; node = node->nextSiblingElement()) {
+        nodes.push_back(node);
+    }
+
+    // Use compilation threads only when there are enough tables.
+    const size_t threads = std::min(_max_threads, nodes.size() / MIN_TABLES_PER_THREAD);
     bool success = true;
 
-    // Analyze all tables in the document.
-    for (const xml::Element* node = root == nullptr ? nullptr : root->firstChildElement(); node != nullptr; node = node->nextSiblingElement()) {
-        BinaryTablePtr bin(new BinaryTable);
-        CheckNonNull(bin.pointer());
-        if (bin->fromXML(_duck, node) && bin->isValid()) {
-            add(bin);
+    if (threads > 1) {
+        success = compileTables(doc, nodes, threads);
+    }
+    else {
+        // Analyze all tables in the document.
+        for (const auto& node : nodes) {
+            BinaryTablePtr bin(new BinaryTable);
+            CheckNonNull(bin.pointer());
+            if (bin->fromXML(_duck, node) && bin->isValid()) {
+                add(bin);
+            }
+            else {
+                doc.report().error(u"Error in table <%s> at line %d", {node->name(), node->lineNumber()});
+                success = false;
+            }
+        }
+    }
+    end_of_stage(threads > 1 ? u"tables compilation (multi-threaded)" : u"tables compilation");
+    return success;
+}
+
+
+//----------------------------------------------------------------------------
+// Compile XML tables using several threads.
+//----------------------------------------------------------------------------
+
+bool ts::SectionFile::compileTables(const xml::Document& doc, const xml::ElementVector& nodes, size_t threads)
+{
+    _report.debug(u"compiling %d tables using %d threads", {nodes.size(), threads});
+
+    // When compiling the tables sequentially, each table is compiled with the standards
+    // from all previous tables in the context. The compilation threads cannot know these
+    // standards in advance. Compiling a table adds exactly the defining standards of the
+    // table class in the context (descriptors do not add standards), so the prediction
+    // is exact unless a table fails to compile. The tables which are compiled by the
+    // threads are used in order, as long as the prediction is correct. After the first
+    // incorrect prediction, the threads are stopped and the remaining tables are compiled
+    // sequentially in the context of the SectionFile.
+    const PSIRepository* repo = PSIRepository::Instance();
+    std::vector<CompiledTable> tables(nodes.size());
+    Standards standards = _duck.standards();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        tables[i].node = nodes[i];
+        tables[i].before = standards;
+        const PSIRepository::TableFactory fac = repo->getTableFactory(nodes[i]->name());
+        if (fac != nullptr) {
+            const AbstractTablePtr table(fac());
+            if (!table.isNull()) {
+                standards |= table->definingStandards();
+            }
+        }
+    }
+
+    // Load the .names files before starting the threads, they are read-only after loading.
+    NamesFile::Instance(NamesFile::Predefined::DTV);
+
+    bool success = true;
+    size_t index = 0;
+    const auto collect = [this, &doc, &success](CompiledTable& ct) {
+        if (ct.success) {
+            add(ct.table);
         }
         else {
-            doc.report().error(u"Error in table <%s> at line %d", {node->name(), node->lineNumber()});
+            doc.report().error(u"Error in table <%s> at line %d", {ct.node->name(), ct.node->lineNumber()});
             success = false;
         }
+    };
+
+    {
+        // Start all compilation threads. The destructor of each thread waits for its termination.
+        CompilationQueue queue(tables);
+        std::vector<SafePtr<CompilationThread>> pool;
+        for (size_t i = 0; i < threads; ++i) {
+            pool.push_back(new CompilationThread(_duck, doc.report(), queue));
+            pool.back()->start();
+        }
+
+        // Collect the compiled tables in the order of the document, as long as the prediction is correct.
+        for (; index < tables.size(); ++index) {
+            CompiledTable& ct(tables[index]);
+            queue.waitCompleted(index);
+            if (ct.before != _duck.standards()) {
+                queue.stop();
+                break;
+            }
+            // Report messages from the compilation thread and accumulate the same standards.
+            for (const auto& msg : ct.log) {
+                doc.report().log(msg.first, msg.second);
+            }
+            _duck.addStandards(ct.after);
+            collect(ct);
+        }
+    }
+
+    // Compile the remaining tables sequentially after an incorrect prediction.
+    if (index < tables.size()) {
+        _report.debug(u"incorrect standards prediction at table %d, %d tables compiled sequentially", {index, tables.size() - index});
+    }
+    for (; index < tables.size(); ++index) {
+        CompiledTable& ct(tables[index]);
+        ct.table = new BinaryTable;
+        ct.success = ct.table->fromXML(_duck, ct.node) && ct.table->isValid();
+        collect(ct);
     }
     return success;
 }
@@ -640,37 +949,43 @@ ts::UString ts::SectionFile::toXML() const
 bool ts::SectionFile::loadJSON(const UString& file_name)
 {
     json::ValuePtr root;
-    xml::Document doc(_report);
+    const Monotonic start(true);
+    CompilationReport report(_report);
+    xml::Document doc(report);
     doc.setTweaks(_xmlTweaks);
 
     return loadThisModel() &&
            json::LoadFile(root, file_name, _report) &&
            _model.convertToXML(*root, doc, true) &&
-           parseDocument(doc);
+           parseDocument(doc, start);
 }
 
 bool ts::SectionFile::loadJSON(std::istream& strm)
 {
     json::ValuePtr root;
-    xml::Document doc(_report);
+    const Monotonic start(true);
+    CompilationReport report(_report);
+    xml::Document doc(report);
     doc.setTweaks(_xmlTweaks);
 
     return loadThisModel() &&
            json::LoadStream(root, strm, _report) &&
            _model.convertToXML(*root, doc, true) &&
-           parseDocument(doc);
+           parseDocument(doc, start);
 }
 
 bool ts::SectionFile::parseJSON(const UString& json_content)
 {
     json::ValuePtr root;
-    xml::Document doc(_report);
+    const Monotonic start(true);
+    CompilationReport report(_report);
+    xml::Document doc(report);
     doc.setTweaks(_xmlTweaks);
 
     return loadThisModel() &&
            json::Parse(root, json_content, _report) &&
            _model.convertToXML(*root, doc, true) &&
-           parseDocument(doc);
+           parseDocument(doc, start);
 }
 
 
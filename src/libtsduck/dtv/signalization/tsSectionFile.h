@@ -44,6 +44,7 @@
 #include "tsEITOptions.h"
 #include "tsxmlTweaks.h"
 #include "tsTablesPtr.h"
+#include "tsMonotonic.h"
 
 namespace ts {
     //!
@@ -175,6 +176,17 @@ namespace ts {
         //!
         void setCRCValidation(CRC32::Validation crc_op) { _crc_op = crc_op; }
 
+        //!
+        //! Set the maximum number of threads to compile tables from XML or JSON files.
+        //! When loading large XML or JSON files, the tables are converted to binary sections
+        //! by a pool of compilation threads. The order of the tables and sections in the file
+        //! is preserved and the result is identical to a sequential compilation.
+        //! @param [in] count Maximum number of compilation threads. The default is 1, meaning
+        //! that the tables are compiled sequentially in the calling thread. Zero means the
+        //! number of processors in the system.
+        //!
+        void setMaxThreads(size_t count);
+
         //!
         //! Load a binary or XML file.
         //! The loaded sections are added to the content of this object.
@@ -505,6 +517,7 @@ namespace ts {
         xml::JSONConverter   _model;           // XML model for tables.
         xml::Tweaks          _xmlTweaks;       // XML formatting and parsing tweaks.
         CRC32::Validation    _crc_op;          // Processing of CRC32 when loading sections.
+        size_t               _max_threads;     // Maximum number of threads to compile XML tables.
 
         // Load the XML model in this instance, if not already done.
         bool loadThisModel();
@@ -516,8 +529,11 @@ namespace ts {
         // Rebuild _tables and _orphanSections from _sections.
         void rebuildTables();
 
-        // Parse an XML document.
-        bool parseDocument(const xml::Document& doc);
+        // Parse an XML document. The start time is used to report the duration of the loading stage.
+        bool parseDocument(const xml::Document& doc, const Monotonic& start);
+
+        // Compile XML tables using several threads, the number of tables and threads is at least 2.
+        bool compileTables(const xml::Document& doc, const xml::ElementVector& nodes, size_t threads);
 
         // Generate an XML document.
         bool generateDocument(xml::Document& doc) const;
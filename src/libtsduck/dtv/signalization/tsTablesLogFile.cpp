@@ -0,0 +1,416 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTablesLogFile.h"
+#include "tsDuckProtocol.h"
+#include "tsSimulCryptDate.h"
+#include "tsFileUtils.h"
+#include "tsMemory.h"
+#include "tsNullReport.h"
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::TablesLogFile::INDEX_HEADER_SIZE;
+constexpr size_t ts::TablesLogFile::INDEX_ENTRY_SIZE;
+#endif
+
+// Magic number and version at start of index files.
+namespace {
+    const char INDEX_MAGIC[8] = {'T', 'S', 'T', 'L', 'V', 'I', 'D', 'X'};
+    constexpr uint32_t INDEX_VERSION = 1;
+}
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::TablesLogFile::TablesLogFile() :
+    _name(),
+    _use_index(false),
+    _max_size(0),
+    _max_files(0),
+    _name_gen(),
+    _current_name(),
+    _current_files(),
+    _file(),
+    _index(),
+    _size(0)
+{
+}
+
+ts::TablesLogFile::~TablesLogFile()
+{
+    close(NULLREP);
+}
+
+ts::TablesLogFile::IndexEntry::IndexEntry() :
+    offset(0),
+    timestamp(),
+    pid(PID_NULL),
+    tid(TID_NULL),
+    tid_ext(0),
+    count(0)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Create the log file.
+//----------------------------------------------------------------------------
+
+bool ts::TablesLogFile::open(const UString& file_name, bool index, uint64_t max_size, size_t max_files, Report& report)
+{
+    close(report);
+    _name = file_name;
+    _use_index = index;
+    _max_size = max_size;
+    _max_files = max_files;
+    _current_files.clear();
+    if (_max_size > 0) {
+        _name_gen.initCounter(_name);
+    }
+    return openNext(report);
+}
+
+
+//----------------------------------------------------------------------------
+// Open the next log file (and index file).
+//----------------------------------------------------------------------------
+
+bool ts::TablesLogFile::openNext(Report& report)
+{
+    _current_name = _max_size > 0 ? _name_gen.newFileName() : _name;
+    _size = 0;
+
+    report.verbose(u"creating %s", {_current_name});
+    _file.open(_current_name.toUTF8().c_str(), std::ios::out | std::ios::binary);
+    if (!_file) {
+        report.error(u"error creating %s", {_current_name});
+        return false;
+    }
+    if (_max_size > 0 && _max_files > 0) {
+        _current_files.push_back(_current_name);
+    }
+
+    if (_use_index) {
+        const UString index_name(IndexFileName(_current_name));
+        _index.open(index_name.toUTF8().c_str(), std::ios::out | std::ios::binary);
+        uint8_t header[INDEX_HEADER_SIZE];
+        TS_ZERO(header);
+        ::memcpy(header, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        PutUInt32(header + 8, INDEX_VERSION);
+        PutUInt32(header + 12, uint32_t(INDEX_ENTRY_SIZE));
+        if (!_index || !_index.write(reinterpret_cast<const char*>(header), sizeof(header))) {
+            report.error(u"error creating %s", {index_name});
+            _file.close();
+            _index.close();
+            return false;
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Close the log file.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogFile::close(Report& report)
+{
+    closeCurrent(report);
+}
+
+void ts::TablesLogFile::closeCurrent(Report& report)
+{
+    if (_file.is_open()) {
+        _file.close();
+    }
+    if (_index.is_open()) {
+        _index.close();
+    }
+
+    // Purge obsolete files.
+    while (_max_files > 0 && _current_files.size() > _max_files) {
+        const UString name(_current_files.front());
+        _current_files.pop_front();
+        report.verbose(u"deleting obsolete file %s", {name});
+        DeleteFile(name, report);
+        if (_use_index) {
+            DeleteFile(IndexFileName(name), report);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Flush the log file and its index on disk.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogFile::flush()
+{
+    if (_file.is_open()) {
+        _file.flush();
+    }
+    if (_index.is_open()) {
+        _index.flush();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Save a table or a section in the log file.
+//----------------------------------------------------------------------------
+
+bool ts::TablesLogFile::write(const BinaryTable& table, const Time& timestamp, Report& report)
+{
+    if (table.sectionCount() == 0) {
+        return true;
+    }
+
+    std::vector<ByteBlockPtr> messages;
+    BuildMessages(table, timestamp, messages);
+
+    IndexEntry entry;
+    entry.timestamp = timestamp;
+    entry.pid = table.sourcePID();
+    entry.tid = table.tableId();
+    entry.tid_ext = table.isShortSection() ? 0 : table.tableIdExtension();
+    entry.count = messages.size() == 1 ? table.sectionCount() : 1;
+
+    bool success = true;
+    for (const auto& msg : messages) {
+        success = writeMessage(*msg, entry, report) && success;
+    }
+    return success;
+}
+
+bool ts::TablesLogFile::write(const Section& section, const Time& timestamp, Report& report)
+{
+    IndexEntry entry;
+    entry.timestamp = timestamp;
+    entry.pid = section.sourcePID();
+    entry.tid = section.tableId();
+    entry.tid_ext = section.isLongSection() ? section.tableIdExtension() : 0;
+    entry.count = 1;
+    return writeMessage(*BuildMessage(section, timestamp), entry, report);
+}
+
+
+//----------------------------------------------------------------------------
+// Write a TLV message and its index entry.
+//----------------------------------------------------------------------------
+
+bool ts::TablesLogFile::writeMessage(const ByteBlock& msg, const IndexEntry& entry, Report& report)
+{
+    if (!_file.is_open()) {
+        return false;
+    }
+
+    // Rotate the log file when it is full. A message is never split over two files.
+    if (_max_size > 0 && _size > 0 && _size + msg.size() > _max_size) {
+        closeCurrent(report);
+        if (!openNext(report)) {
+            return false;
+        }
+    }
+
+    if (_use_index) {
+        uint8_t data[INDEX_ENTRY_SIZE];
+        TS_ZERO(data);
+        PutUInt64(data, _size);
+        PutUInt64(data + 8, uint64_t(entry.timestamp - Time::Epoch));
+        PutUInt16(data + 16, entry.pid);
+        data[18] = entry.tid;
+        PutUInt16(data + 20, entry.tid_ext);
+        PutUInt16(data + 22, uint16_t(entry.count));
+        if (!_index.write(reinterpret_cast<const char*>(data), sizeof(data))) {
+            report.error(u"error writing index of %s", {_current_name});
+            return false;
+        }
+    }
+
+    if (!_file.write(reinterpret_cast<const char*>(msg.data()), std::streamsize(msg.size()))) {
+        report.error(u"error writing TLV message in %s", {_current_name});
+        return false;
+    }
+    _size += msg.size();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Build the TLV messages for a table or a section.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogFile::BuildMessages(const BinaryTable& table, const Time& timestamp, std::vector<ByteBlockPtr>& messages)
+{
+    messages.clear();
+
+    // Build one message for the complete table.
+    duck::LogTable msg;
+    msg.pid = table.sourcePID();
+    msg.timestamp = SimulCryptDate(timestamp);
+    for (size_t i = 0; i < table.sectionCount(); ++i) {
+        msg.sections.push_back(table.sectionAt(i));
+    }
+    ByteBlockPtr bin(new ByteBlock);
+    bin->reserve(table.totalSize() + 32 + 4 * table.sectionCount());
+    tlv::Serializer serial(bin);
+    msg.serialize(serial);
+
+    // The 16-bit length of the message value cannot exceed 0xFFFF.
+    // In that case, build one message per section (a section is always small enough).
+    if (MessageSize(bin->data(), bin->size()) == bin->size()) {
+        messages.push_back(bin);
+    }
+    else {
+        for (size_t i = 0; i < table.sectionCount(); ++i) {
+            if (!table.sectionAt(i).isNull()) {
+                messages.push_back(BuildMessage(*table.sectionAt(i), timestamp));
+            }
+        }
+    }
+}
+
+ts::ByteBlockPtr ts::TablesLogFile::BuildMessage(const Section& section, const Time& timestamp)
+{
+    duck::LogSection msg;
+    msg.pid = section.sourcePID();
+    msg.timestamp = SimulCryptDate(timestamp);
+    msg.section = new Section(section, ShareMode::SHARE);
+
+    ByteBlockPtr bin(new ByteBlock);
+    tlv::Serializer serial(bin);
+    msg.serialize(serial);
+    return bin;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the size of the next TLV message in a memory buffer.
+//----------------------------------------------------------------------------
+
+namespace {
+    // A message contains an optional protocol version, then a TLV structure for the command.
+    size_t MessageHeaderSize()
+    {
+        return (ts::duck::Protocol::Instance()->hasVersion() ? sizeof(ts::tlv::VERSION) : 0) + sizeof(ts::tlv::TAG) + sizeof(ts::tlv::LENGTH);
+    }
+}
+
+size_t ts::TablesLogFile::MessageSize(const uint8_t* data, size_t size)
+{
+    const size_t header_size = MessageHeaderSize();
+    if (data == nullptr || size < header_size) {
+        return 0;
+    }
+    const size_t msg_size = header_size + GetUInt16(data + header_size - sizeof(tlv::LENGTH));
+    return msg_size <= size ? msg_size : 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Read the next TLV message from a log file.
+//----------------------------------------------------------------------------
+
+size_t ts::TablesLogFile::ReadMessage(std::istream& strm, ByteBlock& msg, Report& report)
+{
+    // Read the message header.
+    const size_t header_size = MessageHeaderSize();
+    msg.resize(header_size);
+    strm.read(reinterpret_cast<char*>(msg.data()), std::streamsize(header_size));
+    const size_t got = size_t(strm.gcount());
+    if (got == 0 && strm.eof()) {
+        // Clean end of file.
+        msg.clear();
+        return 0;
+    }
+    if (got < header_size) {
+        report.error(u"truncated TLV message header");
+        msg.clear();
+        return 0;
+    }
+
+    // Read the message value.
+    const size_t value_size = GetUInt16(msg.data() + header_size - sizeof(tlv::LENGTH));
+    msg.resize(header_size + value_size);
+    strm.read(reinterpret_cast<char*>(msg.data() + header_size), std::streamsize(value_size));
+    if (size_t(strm.gcount()) < value_size) {
+        report.error(u"truncated TLV message, expected %d bytes, got %d", {header_size + value_size, header_size + size_t(strm.gcount())});
+        msg.clear();
+        return 0;
+    }
+    return msg.size();
+}
+
+
+//----------------------------------------------------------------------------
+// Index files.
+//----------------------------------------------------------------------------
+
+ts::UString ts::TablesLogFile::IndexFileName(const UString& file_name)
+{
+    return file_name + u".idx";
+}
+
+bool ts::TablesLogFile::LoadIndex(const UString& file_name, IndexEntryVector& entries, Report& report)
+{
+    entries.clear();
+
+    std::ifstream strm(file_name.toUTF8().c_str(), std::ios::in | std::ios::binary);
+    if (!strm) {
+        report.error(u"cannot open %s", {file_name});
+        return false;
+    }
+
+    // Check the header.
+    uint8_t header[INDEX_HEADER_SIZE];
+    if (!strm.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+        ::memcmp(header, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+        GetUInt32(header + 8) != INDEX_VERSION ||
+        GetUInt32(header + 12) != INDEX_ENTRY_SIZE)
+    {
+        report.error(u"%s is not a valid TLV index file", {file_name});
+        return false;
+    }
+
+    // Read all entries. A truncated last entry (application crash) is ignored.
+    uint8_t data[INDEX_ENTRY_SIZE];
+    while (strm.read(reinterpret_cast<char*>(data), sizeof(data))) {
+        IndexEntry entry;
+        entry.offset = GetUInt64(data);
+        entry.timestamp = Time::Epoch + MilliSecond(GetUInt64(data + 8));
+        entry.pid = GetUInt16(data + 16);
+        entry.tid = data[18];
+        entry.tid_ext = GetUInt16(data + 20);
+        entry.count = GetUInt16(data + 22);
+        entries.push_back(entry);
+    }
+    return true;
+}
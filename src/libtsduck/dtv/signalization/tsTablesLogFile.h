@@ -0,0 +1,222 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Binary log files of tables and sections as TLV messages.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsBinaryTable.h"
+#include "tsFileNameGenerator.h"
+#include "tsTime.h"
+#include "tsReport.h"
+
+namespace ts {
+    //!
+    //! Binary log files of tables and sections as TLV messages.
+    //! @ingroup mpeg
+    //!
+    //! A TLV log file is a sequence of TLV messages, using the same format as the UDP messages
+    //! which are sent by TablesLogger with option -\-ip-udp. Each message contains the source PID,
+    //! the collection time and the sections of one table (or one section with -\-all-sections).
+    //! The TLV length field is 16 bits. A table which does not fit in one message is split into
+    //! one message per section.
+    //!
+    //! An optional index file can be written next to each log file. The index file contains
+    //! one fixed-size entry per message: offset of the message in the log file, time stamp,
+    //! PID, table id, table id extension and number of sections. It allows direct access to
+    //! the messages of a PID or table id in a large archive.
+    //!
+    //! The log file can be rotated: when it grows beyond a maximum size, it is closed and the
+    //! next messages go into a new file. The oldest files can be automatically deleted.
+    //!
+    class TSDUCKDLL TablesLogFile
+    {
+        TS_NOCOPY(TablesLogFile);
+    public:
+        //!
+        //! Constructor.
+        //!
+        TablesLogFile();
+
+        //!
+        //! Destructor.
+        //!
+        ~TablesLogFile();
+
+        //!
+        //! Create the log file.
+        //! @param [in] file_name Name of the log file. With @a max_size, this is a template for
+        //! file names, see FileNameGenerator::initCounter().
+        //! @param [in] index If true, also create an index file for each log file.
+        //! @param [in] max_size Maximum size in bytes of a log file. Zero means unlimited.
+        //! @param [in] max_files With @a max_size, maximum number of log files to keep. Zero means unlimited.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool open(const UString& file_name, bool index, uint64_t max_size, size_t max_files, Report& report);
+
+        //!
+        //! Close the log file.
+        //! @param [in,out] report Where to report errors.
+        //!
+        void close(Report& report);
+
+        //!
+        //! Check if the log file is open.
+        //! @return True if the log file is open.
+        //!
+        bool isOpen() const { return _file.is_open(); }
+
+        //!
+        //! Save a table in the log file.
+        //! @param [in] table The table to save.
+        //! @param [in] timestamp Collection time of the table.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool write(const BinaryTable& table, const Time& timestamp, Report& report);
+
+        //!
+        //! Save a section in the log file.
+        //! @param [in] section The section to save.
+        //! @param [in] timestamp Collection time of the section.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool write(const Section& section, const Time& timestamp, Report& report);
+
+        //!
+        //! Flush the log file and its index on disk.
+        //!
+        void flush();
+
+        //!
+        //! Build the TLV messages for a table.
+        //! @param [in] table The table to log.
+        //! @param [in] timestamp Collection time of the table.
+        //! @param [out] messages The binary TLV messages. Usually one message for the
+        //! complete table, one message per section when the table is too large.
+        //!
+        static void BuildMessages(const BinaryTable& table, const Time& timestamp, std::vector<ByteBlockPtr>& messages);
+
+        //!
+        //! Build the TLV message for a section.
+        //! @param [in] section The section to log.
+        //! @param [in] timestamp Collection time of the section.
+        //! @return The binary TLV message.
+        //!
+        static ByteBlockPtr BuildMessage(const Section& section, const Time& timestamp);
+
+        //!
+        //! Get the size of the next TLV message in a memory buffer.
+        //! @param [in] data Address of the data, starting at a TLV message.
+        //! @param [in] size Size in bytes of the data.
+        //! @return Size in bytes of the next TLV message, which can be analyzed using
+        //! TablesLogger::AnalyzeUDPMessage(). Return zero if the data are too short to
+        //! contain a complete TLV message.
+        //!
+        static size_t MessageSize(const uint8_t* data, size_t size);
+
+        //!
+        //! Read the next TLV message from a log file.
+        //! @param [in,out] strm Binary input stream, positioned at the start of a TLV message.
+        //! @param [out] msg The binary TLV message.
+        //! @param [in,out] report Where to report errors.
+        //! @return Size in bytes of the message. Zero at end of file or on error.
+        //! A truncated message is reported as an error.
+        //!
+        static size_t ReadMessage(std::istream& strm, ByteBlock& msg, Report& report);
+
+        //!
+        //! Description of an entry in an index file.
+        //!
+        class TSDUCKDLL IndexEntry
+        {
+        public:
+            uint64_t offset;    //!< Offset of the TLV message in the log file.
+            Time     timestamp; //!< Collection time of the table or section.
+            PID      pid;       //!< Source PID.
+            TID      tid;       //!< Table id.
+            uint16_t tid_ext;   //!< Table id extension, zero for short sections.
+            size_t   count;     //!< Number of sections in the message.
+
+            //!
+            //! Default constructor.
+            //!
+            IndexEntry();
+        };
+
+        //!
+        //! A vector of index entries.
+        //!
+        typedef std::vector<IndexEntry> IndexEntryVector;
+
+        //!
+        //! Get the name of the index file for a log file.
+        //! @param [in] file_name Name of the log file.
+        //! @return Name of the index file.
+        //!
+        static UString IndexFileName(const UString& file_name);
+
+        //!
+        //! Load an index file.
+        //! @param [in] file_name Name of the index file.
+        //! @param [out] entries Entries in the index file, in file order.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        static bool LoadIndex(const UString& file_name, IndexEntryVector& entries, Report& report);
+
+        static constexpr size_t INDEX_HEADER_SIZE = 16;  //!< Size in bytes of the header of an index file.
+        static constexpr size_t INDEX_ENTRY_SIZE = 24;   //!< Size in bytes of an entry in an index file.
+
+    private:
+        UString           _name;         // Log file name or name template.
+        bool              _use_index;    // Create index files.
+        uint64_t          _max_size;     // Maximum size of a log file.
+        size_t            _max_files;    // Maximum number of log files.
+        FileNameGenerator _name_gen;     // Generate log file names with rotation.
+        UString           _current_name; // Current log file name.
+        UStringList       _current_files;// List of current log files, for deletion of oldest ones.
+        std::ofstream     _file;         // Current log file.
+        std::ofstream     _index;        // Current index file.
+        uint64_t          _size;         // Current size of the log file.
+
+        // Open the next log file (and index file).
+        bool openNext(Report& report);
+
+        // Close the current log file, delete obsolete files.
+        void closeCurrent(Report& report);
+
+        // Write a TLV message and its index entry.
+        bool writeMessage(const ByteBlock& msg, const IndexEntry& entry, Report& report);
+    };
+}
@@ -38,6 +38,7 @@
 #include "tsSimulCryptDate.h"
 #include "tsDuckProtocol.h"
 #include "tsxmlElement.h"
+#include "tsxmlJSONConverter.h"
 #include "tsjsonArray.h"
 #include "tsjsonObject.h"
 #include "tsMJD.h"
@@ -59,11 +60,16 @@ ts::TablesLogger::TablesLogger(TablesDisplay& display) :
     _use_json(false),
     _use_binary(false),
     _use_udp(false),
+    _use_tlv(false),
     _text_destination(),
     _xml_destination(),
     _json_destination(),
     _bin_destination(),
     _udp_destination(),
+    _tlv_destination(),
+    _tlv_index(false),
+    _tlv_max_size(0),
+    _tlv_max_files(0),
     _bin_multi_files(false),
     _bin_stdout(false),
     _flush(false),
@@ -114,6 +120,9 @@ ts::TablesLogger::TablesLogger(TablesDisplay& display) :
     _x2j_conv(_report),
     _json_doc(_report),
     _bin_file(),
+    _tlv_file(),
+    _offline_time(),
+    _offline_tables(),
     _sock(false, _report),
     _short_sections(),
     _last_sections(),
@@ -283,7 +292,7 @@ void ts::TablesLogger::defineArgs(Args& args)
               u"this option with \"-\" as output file name.\n\n"
               u"By default, the tables are interpreted and formatted as text on the standard "
               u"output. Several destinations can be specified at the same time: human-readable "
-              u"text output, binary output, UDP/IP messages.");
+              u"text output, binary output, TLV output, UDP/IP messages.");
 
     args.option(u"pack-all-sections");
     args.help(u"pack-all-sections",
@@ -326,6 +335,36 @@ void ts::TablesLogger::defineArgs(Args& args)
     args.option(u"time-stamp");
     args.help(u"time-stamp", u"Display a time stamp (current local time) with each table.");
 
+    args.option(u"tlv-index");
+    args.help(u"tlv-index",
+              u"With --tlv-output, create an index file next to each TLV file. "
+              u"The name of the index file is the name of the TLV file with an additional '.idx' suffix. "
+              u"The index contains the offset, time stamp, PID and table id of each TLV message. "
+              u"It is used by tstabdump to directly access the tables of a PID or table id.");
+
+    args.option(u"tlv-max-files", 0, Args::POSITIVE);
+    args.help(u"tlv-max-files",
+              u"With --tlv-max-size, specify a maximum number of TLV files. "
+              u"When the number of created files exceeds the specified number, the oldest files are deleted. "
+              u"By default, all created files are kept.");
+
+    args.option(u"tlv-max-size", 0, Args::POSITIVE);
+    args.help(u"tlv-max-size",
+              u"With --tlv-output, specify a maximum size in bytes for the TLV files. "
+              u"When a TLV file would grow beyond the specified limit, it is closed and another one is created. "
+              u"A number is automatically added to the name part so that successive files receive distinct names. "
+              u"Example: if the specified file name is foo.tlv, the various files are named foo-000000.tlv, foo-000001.tlv, etc.");
+
+    args.option(u"tlv-output", 0, Args::FILENAME);
+    args.help(u"tlv-output", u"filename",
+              u"Save the tables or sections (with --all-sections) in the specified binary file as TLV messages. "
+              u"Each TLV message contains the sections of a table, the source PID and a time stamp (current local time). "
+              u"The format of each message is the same as UDP messages with --ip-udp. "
+              u"A table which is too large for one TLV message (more than 64 kB) is saved as one message per section. "
+              u"The file is flushed after each message only with --flush. "
+              u"The file can be later analyzed using the command tstabdump with option --tlv-input "
+              u"or converted into XML or JSON using the command tstables with option --tlv-input.");
+
     args.option(u"ttl", 0, Args::POSITIVE);
     args.help(u"ttl",
               u"With --ip-udp, specifies the TTL (Time-To-Live) socket option. "
@@ -357,12 +396,13 @@ bool ts::TablesLogger::loadArgs(DuckContext& duck, Args& args)
     _use_json = args.present(u"json-output");
     _use_binary = args.present(u"binary-output");
     _use_udp = args.present(u"ip-udp");
+    _use_tlv = args.present(u"tlv-output");
     _log_xml_line = args.present(u"log-xml-line");
     _log_json_line = args.present(u"log-json-line");
     _log_hexa_line = args.present(u"log-hexa-line");
     _use_text = args.present(u"output-file") ||
                 args.present(u"text-output") ||
-                (!_use_xml && !_use_json && !_use_binary && !_use_udp &&
+                (!_use_xml && !_use_json && !_use_binary && !_use_udp && !_use_tlv &&
                  !_log_xml_line && !_log_json_line && !_log_hexa_line &&
                  _table_handler == nullptr && _section_handler == nullptr);
 
@@ -376,6 +416,10 @@ bool ts::TablesLogger::loadArgs(DuckContext& duck, Args& args)
     args.getValue(_json_destination, u"json-output");
     args.getValue(_bin_destination, u"binary-output");
     args.getValue(_udp_destination, u"ip-udp");
+    args.getValue(_tlv_destination, u"tlv-output");
+    _tlv_index = args.present(u"tlv-index");
+    args.getIntValue(_tlv_max_size, u"tlv-max-size", 0);
+    args.getIntValue(_tlv_max_files, u"tlv-max-files", 0);
     args.getValue(_text_destination, u"output-file", args.value(u"text-output").c_str());
 
     _bin_stdout = _use_binary && (_bin_destination.empty() || _bin_destination == u"-");
@@ -458,6 +502,8 @@ bool ts::TablesLogger::open()
     if (_bin_file.is_open()) {
         _bin_file.close();
     }
+    _tlv_file.close(_report);
+    _offline_tables.clear();
     if (_sock.isOpen()) {
         _sock.close(_report);
     }
@@ -522,6 +568,12 @@ bool ts::TablesLogger::open()
         return false;
     }
 
+    // Open/create the TLV output.
+    if (_use_tlv && !_tlv_file.open(_tlv_destination, _tlv_index, _tlv_max_size, _tlv_max_files, _report)) {
+        _abort = true;
+        return false;
+    }
+
     // Initialize UDP output.
     if (_use_udp) {
         // Create UDP socket.
@@ -562,6 +614,7 @@ void ts::TablesLogger::close()
         if (_bin_file.is_open()) {
             _bin_file.close();
         }
+        _tlv_file.close(_report);
         if (_sock.isOpen()) {
             _sock.close(_report);
         }
@@ -586,6 +639,60 @@ void ts::TablesLogger::feedPacket(const TSPacket& pkt)
 }
 
 
+//----------------------------------------------------------------------------
+// Feed the logger with sections from an offline archive.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogger::feedSections(const SectionPtrVector& sections, const Time& timestamp)
+{
+    if (completed() || sections.empty()) {
+        return;
+    }
+
+    // Use the collection time of the sections instead of the current time.
+    _offline_time = timestamp;
+    _xml_options.localTime = timestamp;
+
+    for (const auto& sect : sections) {
+        if (completed()) {
+            break;
+        }
+        if (sect.isNull() || !sect->isValid() || !_demux.hasPID(sect->sourcePID())) {
+            continue;
+        }
+        if (_all_sections) {
+            handleSection(_demux, *sect);
+        }
+        else {
+            // Accumulate sections of the same table. A new version restarts the table.
+            const uint64_t id = (uint64_t(sect->sourcePID()) << 32) | (uint64_t(sect->isLongSection()) << 24) | (uint64_t(sect->tableId()) << 16) | sect->tableIdExtension();
+            BinaryTablePtr& table(_offline_tables[id]);
+            if (table.isNull() || (table->sectionCount() > 0 && table->version() != sect->version())) {
+                table = new BinaryTable;
+            }
+            table->addSection(sect, true, true);
+            if (table->isValid()) {
+                handleTable(_demux, *table);
+                _offline_tables.erase(id);
+            }
+        }
+    }
+
+    _offline_time = Time::Epoch;
+    _xml_options.localTime = Time::Epoch;
+}
+
+
+//----------------------------------------------------------------------------
+// Collection time of the current table or section.
+//----------------------------------------------------------------------------
+
+ts::Time ts::TablesLogger::currentTime() const
+{
+    return _offline_time == Time::Epoch ? Time::CurrentLocalTime() : _offline_time;
+}
+
+
 //----------------------------------------------------------------------------
 // Detect and track duplicate section by PID.
 //----------------------------------------------------------------------------
@@ -681,38 +788,11 @@ void ts::TablesLogger::handleTable(SectionDemux& demux, const BinaryTable& table
         postDisplay();
     }
 
-    // Save table in XML format.
-    if (_use_xml) {
-        if (_rewrite_xml) {
-            // Build and save a new document each time.
-            xml::Document doc(_report);
-            doc.initialize(u"tsduck");
-            table.toXML(_duck, doc.rootElement(), _xml_options);
-            doc.save(_xml_destination, 2);
-        }
-        else {
-            // Just add the table in the running doc.
-            // Convert the table into an XML structure, print and delete the XML table.
-            table.toXML(_duck, _xml_doc.rootElement(), _xml_options);
-            _xml_doc.flush();
-        }
-    }
-
-    // Save table in JSON format.
-    if (_use_json) {
-        // First, build an XML document with the table.
-        xml::Document doc(_report);
-        doc.initialize(u"tsduck");
-        table.toXML(_duck, doc.rootElement(), _xml_options);
-        if (_rewrite_json) {
-            // Convert to JSON and save a new document each time.
-            _x2j_conv.convertToJSON(doc)->save(_json_destination, 2, true, _report);
-        }
-        else {
-            // Convert to JSON. Force "tsduck" root to appear so that the path to the first table is always the same.
-            // Query the first (and only) converted table and add it to the running document.
-            _json_doc.add(_x2j_conv.convertToJSON(doc, true)->query(u"#nodes[0]"));
-        }
+    // Save table in XML and/or JSON format, prepare one-liner XML and/or JSON.
+    UString xml_line;
+    UString json_line;
+    if (_use_xml || _use_json || _log_xml_line || _log_json_line) {
+        saveXMLJSON(table, xml_line, json_line);
     }
 
     // Save table in binary format.
@@ -731,8 +811,11 @@ void ts::TablesLogger::handleTable(SectionDemux& demux, const BinaryTable& table
     }
 
     // Log table as a one-liner XML and/or JSON.
-    if (_log_xml_line || _log_json_line) {
-        logXMLJSON(table);
+    if (!xml_line.empty()) {
+        _report.info(xml_line);
+    }
+    if (!json_line.empty()) {
+        _report.info(json_line);
     }
 
     // Log table as a one-liner hexadecimal.
@@ -745,6 +828,11 @@ void ts::TablesLogger::handleTable(SectionDemux& demux, const BinaryTable& table
         _report.info(_log_hexa_prefix + line);
     }
 
+    // Save table as a TLV message.
+    if (_use_tlv) {
+        saveTLV(table);
+    }
+
     // Send binary table in UDP message.
     if (_use_udp) {
         sendUDP(table);
@@ -861,6 +949,10 @@ void ts::TablesLogger::handleSection(SectionDemux& demux, const Section& sect)
         _report.info(_log_hexa_prefix + UString::Dump(sect.content(), sect.size(), UString::COMPACT));
     }
 
+    if (_use_tlv) {
+        saveTLV(sect);
+    }
+
     if (_use_udp) {
         sendUDP(sect);
     }
@@ -915,82 +1007,144 @@ void ts::TablesLogger::handleInvalidSection(SectionDemux& demux, const DemuxedDa
 
 
 //----------------------------------------------------------------------------
-// Log XML or JSON one-liners.
+// Save XML or JSON files, log XML or JSON one-liners.
 //----------------------------------------------------------------------------
 
-void ts::TablesLogger::logXMLJSON(const BinaryTable& table)
+void ts::TablesLogger::saveXMLJSON(const BinaryTable& table, UString& xml_line, UString& json_line)
 {
-    // Build an XML document.
-    xml::Document doc;
+    xml_line.clear();
+    json_line.clear();
+
+    // When the running XML document is the only output, the table is directly built in the
+    // running document, printed and deleted. Otherwise, the table is built only once in an
+    // intermediate XML document, for all outputs. It is finally moved into the running XML
+    // document, without copy.
+    if (_use_xml && !_rewrite_xml && !_use_json && !_log_xml_line && !_log_json_line) {
+        table.toXML(_duck, _xml_doc.rootElement(), _xml_options);
+        _xml_doc.flush();
+        return;
+    }
+
+    // Build an XML document with the table. On error, the error message is already printed.
+    xml::Document doc(_report);
     doc.initialize(u"tsduck");
     xml::Element* elem = table.toXML(_duck, doc.rootElement(), _xml_options);
-    if (elem == nullptr) {
-        // Error serializing the table, error message already printed.
-        return;
+
+    // Convert the XML document into JSON, also only once for all JSON outputs.
+    // Force "tsduck" root to appear so that the path to the first table is always the same.
+    json::ValuePtr jroot;
+    if (_use_json || _log_json_line) {
+        jroot = _x2j_conv.convertToJSON(doc, true);
     }
 
-    // Initialize a text formatter for one-liner.
-    TextFormatter text(_report);
-    text.setString();
-    text.setEndOfLineMode(TextFormatter::EndOfLineMode::SPACING);
+    // Save table in XML format, when a new document is saved each time.
+    if (_use_xml && _rewrite_xml) {
+        doc.save(_xml_destination, 2);
+    }
 
-    // Log the XML line.
-    if (_log_xml_line) {
-        doc.print(text);
-        _report.info(_log_xml_prefix + text.toString());
+    // Save table in JSON format.
+    if (_use_json) {
+        if (_rewrite_json) {
+            // Save a new document each time. Without "x2j-include-root", the document is the array of tables.
+            json::ValuePtr jdoc(jroot);
+            if (!_x2j_conv.tweaks().x2jIncludeRoot) {
+                jdoc = jroot->valuePtr(xml::JSONConverter::HashNodes);
+                if (jdoc.isNull()) {
+                    jdoc = new json::Array;
+                }
+            }
+            jdoc->save(_json_destination, 2, true, _report);
+        }
+        else {
+            // Query the first (and only) converted table and add it to the running document.
+            _json_doc.add(jroot->query(u"#nodes[0]"));
+        }
     }
 
-    // Log the JSON line.
-    if (_log_json_line) {
+    // Build the XML and/or JSON one-liners. They are logged later by the caller.
+    if (elem != nullptr && (_log_xml_line || _log_json_line)) {
 
-        // Convert the XML document into JSON.
-        // Force "tsduck" root to appear so that the path to the first table is always the same.
-        const json::ValuePtr root(_x2j_conv.convertToJSON(doc, true));
+        // Initialize a text formatter for one-liner.
+        TextFormatter text(_report);
+        text.setString();
+        text.setEndOfLineMode(TextFormatter::EndOfLineMode::SPACING);
 
-        // Reset the text formatter if already used for XML.
+        // Build the XML line.
         if (_log_xml_line) {
-            text.setString();
+            doc.print(text);
+            xml_line = _log_xml_prefix + text.toString();
         }
 
-        // Query the first (and only) converted table and log it as one line.
-        root->query(u"#nodes[0]").print(text);
-        _report.info(_log_json_prefix + text.toString());
+        // Build the JSON line.
+        if (_log_json_line) {
+            // Reset the text formatter if already used for XML.
+            if (_log_xml_line) {
+                text.setString();
+            }
+            // Query the first (and only) converted table and log it as one line.
+            jroot->query(u"#nodes[0]").print(text);
+            json_line = _log_json_prefix + text.toString();
+        }
+    }
+
+    // Save table in the running XML document. This must be done last: the XML table is
+    // moved into the running document, printed and deleted.
+    if (elem != nullptr && _use_xml && !_rewrite_xml) {
+        elem->reparent(_xml_doc.rootElement());
+        _xml_doc.flush();
     }
 }
 
 
 //----------------------------------------------------------------------------
-// Send UDP table and section.
+// Save a table or a section in the TLV output file.
 //----------------------------------------------------------------------------
 
-void ts::TablesLogger::sendUDP(const ts::BinaryTable& table)
+void ts::TablesLogger::saveTLV(const BinaryTable& table)
 {
-    ByteBlockPtr bin(new ByteBlock);
+    if (!_tlv_file.write(table, currentTime(), _report)) {
+        _abort = true;
+    }
+    else if (_flush) {
+        _tlv_file.flush();
+    }
+}
+
+void ts::TablesLogger::saveTLV(const Section& section)
+{
+    if (!_tlv_file.write(section, currentTime(), _report)) {
+        _abort = true;
+    }
+    else if (_flush) {
+        _tlv_file.flush();
+    }
+}
+
 
-    // Minimize allocation by reserving over size
-    bin->reserve(table.totalSize() + 32 + 4 * table.sectionCount());
+//----------------------------------------------------------------------------
+// Send UDP table and section.
+//----------------------------------------------------------------------------
 
+void ts::TablesLogger::sendUDP(const ts::BinaryTable& table)
+{
     if (_udp_raw) {
         // Add raw content of each section the message
+        ByteBlock bin;
+        bin.reserve(table.totalSize());
         for (size_t i = 0; i < table.sectionCount(); ++i) {
             const Section& sect(*table.sectionAt(i));
-            bin->append(sect.content(), sect.size());
+            bin.append(sect.content(), sect.size());
         }
+        _sock.send(bin.data(), bin.size(), _report);
     }
     else {
-        // Build a TLV message.
-        duck::LogTable msg;
-        msg.pid = table.sourcePID();
-        msg.timestamp = SimulCryptDate(Time::CurrentLocalTime());
-        for (size_t i = 0; i < table.sectionCount(); ++i) {
-            msg.sections.push_back(table.sectionAt(i));
+        // Send TLV message over UDP (one message per section if the table is too large).
+        std::vector<ByteBlockPtr> messages;
+        TablesLogFile::BuildMessages(table, currentTime(), messages);
+        for (const auto& bin : messages) {
+            _sock.send(bin->data(), bin->size(), _report);
         }
-        tlv::Serializer serial(bin);
-        msg.serialize(serial);
     }
-
-    // Send TLV message over UDP
-    _sock.send(bin->data(), bin->size(), _report);
 }
 
 void ts::TablesLogger::sendUDP(const ts::Section& section)
@@ -1000,18 +1154,8 @@ void ts::TablesLogger::sendUDP(const ts::Section& section)
         _sock.send(section.content(), section.size(), _report);
     }
     else {
-        // Build a TLV message.
-        duck::LogSection msg;
-        msg.pid = section.sourcePID();
-        msg.timestamp = SimulCryptDate(Time::CurrentLocalTime());
-        msg.section = new Section(section, ShareMode::SHARE);
-
-        // Serialize the message.
-        ByteBlockPtr bin(new ByteBlock);
-        tlv::Serializer serial(bin);
-        msg.serialize(serial);
-
         // Send TLV message over UDP
+        const ByteBlockPtr bin(TablesLogFile::BuildMessage(section, currentTime()));
         _sock.send(bin->data(), bin->size(), _report);
     }
 }
@@ -1171,7 +1315,7 @@ ts::UString ts::TablesLogger::logHeader(const DemuxedData& data)
 {
     UString header;
     if (_time_stamp) {
-        header.format(u"%s: ", {Time::CurrentLocalTime()});
+        header.format(u"%s: ", {currentTime()});
     }
     if (_packet_index) {
         header.format(u"Packet %'d to %'d, ", {data.firstTSPacketIndex(), data.lastTSPacketIndex()});
@@ -1258,7 +1402,7 @@ void ts::TablesLogger::preDisplay(PacketCounter first, PacketCounter last)
     if ((_time_stamp || _packet_index) && !_logger) {
         strm << "* ";
         if (_time_stamp) {
-            strm << "At " << Time::CurrentLocalTime();
+            strm << "At " << currentTime();
         }
         if (_packet_index && _time_stamp) {
             strm << ", ";
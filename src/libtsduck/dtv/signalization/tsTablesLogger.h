@@ -40,6 +40,7 @@
 #include "tsSectionDemux.h"
 #include "tsUDPSocket.h"
 #include "tsCASMapper.h"
+#include "tsTablesLogFile.h"
 #include "tsxmlTweaks.h"
 #include "tsxmlRunningDocument.h"
 #include "tsxmlJSONConverter.h"
@@ -119,6 +120,16 @@ namespace ts {
         //!
         void feedPacket(const TSPacket& pkt);
 
+        //!
+        //! Feed the logger with sections from an offline archive, typically a TLV log file (option -\-tlv-output).
+        //! The sections are filtered and logged as if they were extracted from a transport stream.
+        //! Incomplete tables are accumulated until all their sections are available.
+        //! @param [in] sections Sections from the same PID, typically the content of one TLV message.
+        //! @param [in] timestamp Collection time of the sections. It is used instead of the current
+        //! time with option -\-time-stamp and in the TLV messages. Ignored if Time::Epoch.
+        //!
+        void feedSections(const SectionPtrVector& sections, const Time& timestamp);
+
         //!
         //! Open files, start operations.
         //! The options must have been loaded first.
@@ -189,11 +200,16 @@ namespace ts {
         bool                     _use_json;          // Produce JSON tables.
         bool                     _use_binary;        // Save binary sections.
         bool                     _use_udp;           // Send sections using UDP/IP.
+        bool                     _use_tlv;           // Save tables or sections as TLV messages.
         UString                  _text_destination;  // Text output file name.
         UString                  _xml_destination;   // XML output file name.
         UString                  _json_destination;  // JSON output file name.
         UString                  _bin_destination;   // Binary output file name.
         UString                  _udp_destination;   // UDP/IP destination address:port.
+        UString                  _tlv_destination;   // TLV output file name.
+        bool                     _tlv_index;         // Create an index file for each TLV file.
+        uint64_t                 _tlv_max_size;      // Maximum size of TLV files before rotation.
+        size_t                   _tlv_max_files;     // Maximum number of TLV files with rotation.
         bool                     _bin_multi_files;   // Multiple binary output files (one per section).
         bool                     _bin_stdout;        // Output binary sections on stdout.
         bool                     _flush;             // Flush output file.
@@ -246,6 +262,9 @@ namespace ts {
         xml::JSONConverter       _x2j_conv;          // XML-to-JSON converter.
         json::RunningDocument    _json_doc;          // JSON document, built on-the-fly.
         std::ofstream            _bin_file;          // Binary output file.
+        TablesLogFile            _tlv_file;          // TLV output file.
+        Time                     _offline_time;      // Collection time of offline sections, Epoch when live.
+        std::map<uint64_t,BinaryTablePtr> _offline_tables; // Incomplete offline tables, indexed by PID and ETID.
         UDPSocket                _sock;              // Output socket.
         std::map<PID,ByteBlock>  _short_sections;    // Tracking duplicate short sections by PID with a section hash.
         std::map<PID,ByteBlock>  _last_sections;     // Tracking duplicate sections by PID with a section hash (with --all-sections).
@@ -259,13 +278,21 @@ namespace ts {
         // Save a section in a binary file
         void saveBinarySection(const Section&);
 
-        // Log XML and/or JSON one-liners.
-        void logXMLJSON(const BinaryTable& table);
+        // Save a table in XML and/or JSON files, build XML and/or JSON one-liners (empty if unused).
+        // The table is converted only once in XML and JSON for all outputs.
+        void saveXMLJSON(const BinaryTable& table, UString& xml_line, UString& json_line);
 
         // Send UDP table and section.
         void sendUDP(const BinaryTable& table);
         void sendUDP(const Section& section);
 
+        // Save a table or a section in the TLV output file.
+        void saveTLV(const BinaryTable& table);
+        void saveTLV(const Section& section);
+
+        // Collection time of the current table or section.
+        Time currentTime() const;
+
         // Pre/post-display of a table or section
         void preDisplay(PacketCounter first, PacketCounter last);
         void postDisplay();
@@ -0,0 +1,84 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsEITView.h"
+#include "tsMJD.h"
+#include "tsBCD.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors.
+//----------------------------------------------------------------------------
+
+ts::EITView::EITView(const Section& section) :
+    _valid(false),
+    _tid(section.tableId()),
+    _service_id(0),
+    _ts_id(0),
+    _onetw_id(0),
+    _events()
+{
+    if (section.isValid() && _tid >= TID_EIT_MIN && _tid <= TID_EIT_MAX && section.payloadSize() >= 6) {
+        const uint8_t* const data = section.payload();
+        _valid = true;
+        _service_id = section.tableIdExtension();
+        _ts_id = GetUInt16(data);
+        _onetw_id = GetUInt16(data + 2);
+        _events = EventListView(data + 6, section.payloadSize() - 6);
+    }
+}
+
+ts::EITView::Event::Event(const uint8_t* data, size_t size) :
+    _data(nullptr),
+    _size(0)
+{
+    if (data != nullptr && size >= 12 && 12 + size_t(GetUInt16(data + 10) & 0x0FFF) <= size) {
+        _data = data;
+        _size = 12 + size_t(GetUInt16(data + 10) & 0x0FFF);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Event start time and duration.
+//----------------------------------------------------------------------------
+
+ts::Time ts::EITView::Event::startTime() const
+{
+    Time start;
+    if (_data != nullptr) {
+        DecodeMJD(_data + 2, MJD_SIZE, start);
+    }
+    return start;
+}
+
+ts::Second ts::EITView::Event::duration() const
+{
+    return _data == nullptr ? 0 : (DecodeBCD(_data[7]) * 3600) + (DecodeBCD(_data[8]) * 60) + DecodeBCD(_data[9]);
+}
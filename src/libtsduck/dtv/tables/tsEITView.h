@@ -0,0 +1,155 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view of an Event Information Table (EIT) in a binary section.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsDescriptorView.h"
+#include "tsSection.h"
+#include "tsTime.h"
+
+namespace ts {
+    //!
+    //! Read-only view of an Event Information Table (EIT) in a binary section.
+    //! @ingroup table
+    //!
+    //! An EITView directly reads the binary content of one section. Nothing is
+    //! allocated or copied. This is faster than a full deserialization into an EIT
+    //! object when the application only needs to read a few fields. The section
+    //! must remain valid and unmodified as long as the view is used.
+    //!
+    //! @see EIT
+    //!
+    class TSDUCKDLL EITView
+    {
+    public:
+        //!
+        //! Read-only view of an event description in an EIT.
+        //!
+        class TSDUCKDLL Event
+        {
+        public:
+            //! Default constructor, an invalid event.
+            Event() : _data(nullptr), _size(0) {}
+            //! Constructor.
+            //! @param [in] data Address of the event description.
+            //! @param [in] size Size of the memory area, starting at @a data.
+            Event(const uint8_t* data, size_t size);
+            //! Copy constructor.
+            //! @param [in] other Other instance to copy.
+            Event(const Event& other) = default;
+            //! Assignment operator.
+            //! @param [in] other Other instance to copy.
+            //! @return A reference to this object.
+            Event& operator=(const Event& other) = default;
+            //! Get the event id.
+            //! @return The event id.
+            uint16_t eventId() const { return _data == nullptr ? 0 : GetUInt16(_data); }
+            //! Get the event start time.
+            //! @return The event start time (UTC, or JST in ISDB).
+            Time startTime() const;
+            //! Get the event duration.
+            //! @return The event duration in seconds.
+            Second duration() const;
+            //! Get the running status.
+            //! @return The running status.
+            uint8_t runningStatus() const { return _data == nullptr ? 0 : uint8_t(_data[10] >> 5); }
+            //! Check if the event is controlled by a CA system.
+            //! @return True if the event is controlled by a CA system.
+            bool CAControlled() const { return _data != nullptr && (_data[10] & 0x10) != 0; }
+            //! Get the list of descriptors for this event.
+            //! @return A view of the list of descriptors.
+            DescriptorListView descs() const { return _data == nullptr ? DescriptorListView() : DescriptorListView(_data + 12, _size - 12); }
+            //! Get the size of this entry in the list of events (for LoopView).
+            //! @return The size of the event description in bytes, zero if invalid.
+            size_t entrySize() const { return _size; }
+        private:
+            const uint8_t* _data;
+            size_t         _size;
+        };
+
+        //!
+        //! Read-only view of the list of events in an EIT.
+        //!
+        typedef LoopView<Event> EventListView;
+
+        //!
+        //! Constructor.
+        //! @param [in] section A binary EIT section.
+        //!
+        explicit EITView(const Section& section);
+
+        //!
+        //! Check if the section is a valid EIT section.
+        //! @return True if the section is a valid EIT section.
+        //!
+        bool isValid() const { return _valid; }
+
+        //!
+        //! Get the table id.
+        //! @return The table id.
+        //!
+        TID tableId() const { return _tid; }
+
+        //!
+        //! Get the service id.
+        //! @return The service id.
+        //!
+        uint16_t serviceId() const { return _service_id; }
+
+        //!
+        //! Get the transport stream id.
+        //! @return The transport stream id.
+        //!
+        uint16_t tsId() const { return _ts_id; }
+
+        //!
+        //! Get the original network id.
+        //! @return The original network id.
+        //!
+        uint16_t onetwId() const { return _onetw_id; }
+
+        //!
+        //! Get the list of events.
+        //! @return A view of the list of events in this section.
+        //!
+        const EventListView& events() const { return _events; }
+
+    private:
+        bool          _valid;
+        TID           _tid;
+        uint16_t      _service_id;
+        uint16_t      _ts_id;
+        uint16_t      _onetw_id;
+        EventListView _events;
+    };
+}
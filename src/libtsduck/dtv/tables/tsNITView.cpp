@@ -0,0 +1,67 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsNITView.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors.
+//----------------------------------------------------------------------------
+
+ts::NITView::NITView(const Section& section) :
+    _valid(false),
+    _tid(section.tableId()),
+    _id(0),
+    _descs(),
+    _transports()
+{
+    const uint8_t* const data = section.payload();
+    const size_t size = section.payloadSize();
+
+    if (section.isValid() && (_tid == TID_NIT_ACT || _tid == TID_NIT_OTH || _tid == TID_BAT) && size >= 4) {
+        const size_t desc_length = GetUInt16(data) & 0x0FFF;
+        if (4 + desc_length <= size) {
+            const size_t loop_length = std::min<size_t>(GetUInt16(data + 2 + desc_length) & 0x0FFF, size - 4 - desc_length);
+            _valid = true;
+            _id = section.tableIdExtension();
+            _descs = DescriptorListView(data + 2, desc_length);
+            _transports = TransportListView(data + 4 + desc_length, loop_length);
+        }
+    }
+}
+
+ts::NITView::Transport::Transport(const uint8_t* data, size_t size) :
+    _data(nullptr),
+    _size(0)
+{
+    if (data != nullptr && size >= 6 && 6 + size_t(GetUInt16(data + 4) & 0x0FFF) <= size) {
+        _data = data;
+        _size = 6 + size_t(GetUInt16(data + 4) & 0x0FFF);
+    }
+}
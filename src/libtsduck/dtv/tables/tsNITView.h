@@ -0,0 +1,138 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view of a Network Information Table (NIT) or a Bouquet Association Table (BAT) in a binary section.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsDescriptorView.h"
+#include "tsSection.h"
+
+namespace ts {
+    //!
+    //! Read-only view of a Network Information Table (NIT) or a Bouquet Association Table (BAT) in a binary section.
+    //! @ingroup table
+    //!
+    //! The NIT and the BAT share the same binary layout. A NITView directly reads
+    //! the binary content of one section. Nothing is allocated or copied. The section
+    //! must remain valid and unmodified as long as the view is used.
+    //!
+    //! @see NIT
+    //! @see BAT
+    //!
+    class TSDUCKDLL NITView
+    {
+    public:
+        //!
+        //! Read-only view of a transport stream description in a NIT or BAT.
+        //!
+        class TSDUCKDLL Transport
+        {
+        public:
+            //! Default constructor, an invalid transport stream.
+            Transport() : _data(nullptr), _size(0) {}
+            //! Constructor.
+            //! @param [in] data Address of the transport stream description.
+            //! @param [in] size Size of the memory area, starting at @a data.
+            Transport(const uint8_t* data, size_t size);
+            //! Copy constructor.
+            //! @param [in] other Other instance to copy.
+            Transport(const Transport& other) = default;
+            //! Assignment operator.
+            //! @param [in] other Other instance to copy.
+            //! @return A reference to this object.
+            Transport& operator=(const Transport& other) = default;
+            //! Get the transport stream id.
+            //! @return The transport stream id.
+            uint16_t tsId() const { return _data == nullptr ? 0 : GetUInt16(_data); }
+            //! Get the original network id.
+            //! @return The original network id.
+            uint16_t onetwId() const { return _data == nullptr ? 0 : GetUInt16(_data + 2); }
+            //! Get the list of descriptors for this transport stream.
+            //! @return A view of the list of descriptors.
+            DescriptorListView descs() const { return _data == nullptr ? DescriptorListView() : DescriptorListView(_data + 6, _size - 6); }
+            //! Get the size of this entry in the list of transport streams (for LoopView).
+            //! @return The size of the transport stream description in bytes, zero if invalid.
+            size_t entrySize() const { return _size; }
+        private:
+            const uint8_t* _data;
+            size_t         _size;
+        };
+
+        //!
+        //! Read-only view of the list of transport streams in a NIT or BAT.
+        //!
+        typedef LoopView<Transport> TransportListView;
+
+        //!
+        //! Constructor.
+        //! @param [in] section A binary NIT or BAT section.
+        //!
+        explicit NITView(const Section& section);
+
+        //!
+        //! Check if the section is a valid NIT or BAT section.
+        //! @return True if the section is a valid NIT or BAT section.
+        //!
+        bool isValid() const { return _valid; }
+
+        //!
+        //! Get the table id.
+        //! @return The table id (NIT Actual, NIT Other or BAT).
+        //!
+        TID tableId() const { return _tid; }
+
+        //!
+        //! Get the network id (NIT) or bouquet id (BAT).
+        //! @return The network id or bouquet id.
+        //!
+        uint16_t id() const { return _id; }
+
+        //!
+        //! Get the list of network or bouquet descriptors.
+        //! @return A view of the list of network or bouquet descriptors.
+        //!
+        const DescriptorListView& descs() const { return _descs; }
+
+        //!
+        //! Get the list of transport streams.
+        //! @return A view of the list of transport streams in this section.
+        //!
+        const TransportListView& transports() const { return _transports; }
+
+    private:
+        bool               _valid;
+        TID                _tid;
+        uint16_t           _id;
+        DescriptorListView _descs;
+        TransportListView  _transports;
+    };
+}
@@ -0,0 +1,67 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPMTView.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors.
+//----------------------------------------------------------------------------
+
+ts::PMTView::PMTView(const Section& section) :
+    _valid(false),
+    _service_id(0),
+    _pcr_pid(PID_NULL),
+    _descs(),
+    _streams()
+{
+    const uint8_t* const data = section.payload();
+    const size_t size = section.payloadSize();
+
+    if (section.isValid() && section.tableId() == TID_PMT && size >= 4) {
+        const size_t info_length = GetUInt16(data + 2) & 0x0FFF;
+        if (4 + info_length <= size) {
+            _valid = true;
+            _service_id = section.tableIdExtension();
+            _pcr_pid = GetUInt16(data) & 0x1FFF;
+            _descs = DescriptorListView(data + 4, info_length);
+            _streams = StreamListView(data + 4 + info_length, size - 4 - info_length);
+        }
+    }
+}
+
+ts::PMTView::Stream::Stream(const uint8_t* data, size_t size) :
+    _data(nullptr),
+    _size(0)
+{
+    if (data != nullptr && size >= 5 && 5 + size_t(GetUInt16(data + 3) & 0x0FFF) <= size) {
+        _data = data;
+        _size = 5 + size_t(GetUInt16(data + 3) & 0x0FFF);
+    }
+}
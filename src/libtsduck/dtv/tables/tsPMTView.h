@@ -0,0 +1,138 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view of a Program Map Table (PMT) in a binary section.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsDescriptorView.h"
+#include "tsSection.h"
+
+namespace ts {
+    //!
+    //! Read-only view of a Program Map Table (PMT) in a binary section.
+    //! @ingroup table
+    //!
+    //! A PMTView directly reads the binary content of the section. Nothing is
+    //! allocated or copied. This is faster than a full deserialization into a PMT
+    //! object when the application only needs to read a few fields. The section
+    //! must remain valid and unmodified as long as the view is used.
+    //!
+    //! @see PMT
+    //!
+    class TSDUCKDLL PMTView
+    {
+    public:
+        //!
+        //! Read-only view of an elementary stream description in a PMT.
+        //!
+        class TSDUCKDLL Stream
+        {
+        public:
+            //! Default constructor, an invalid stream.
+            Stream() : _data(nullptr), _size(0) {}
+            //! Constructor.
+            //! @param [in] data Address of the stream description.
+            //! @param [in] size Size of the memory area, starting at @a data.
+            Stream(const uint8_t* data, size_t size);
+            //! Copy constructor.
+            //! @param [in] other Other instance to copy.
+            Stream(const Stream& other) = default;
+            //! Assignment operator.
+            //! @param [in] other Other instance to copy.
+            //! @return A reference to this object.
+            Stream& operator=(const Stream& other) = default;
+            //! Get the stream type.
+            //! @return The stream type.
+            uint8_t streamType() const { return _data == nullptr ? 0 : _data[0]; }
+            //! Get the elementary stream PID.
+            //! @return The elementary stream PID.
+            PID pid() const { return _data == nullptr ? PID(PID_NULL) : PID(GetUInt16(_data + 1) & 0x1FFF); }
+            //! Get the list of descriptors for this stream.
+            //! @return A view of the list of descriptors.
+            DescriptorListView descs() const { return _data == nullptr ? DescriptorListView() : DescriptorListView(_data + 5, _size - 5); }
+            //! Get the size of this entry in the list of streams (for LoopView).
+            //! @return The size of the stream description in bytes, zero if invalid.
+            size_t entrySize() const { return _size; }
+        private:
+            const uint8_t* _data;
+            size_t         _size;
+        };
+
+        //!
+        //! Read-only view of the list of elementary streams in a PMT.
+        //!
+        typedef LoopView<Stream> StreamListView;
+
+        //!
+        //! Constructor.
+        //! @param [in] section A binary PMT section.
+        //!
+        explicit PMTView(const Section& section);
+
+        //!
+        //! Check if the section is a valid PMT.
+        //! @return True if the section is a valid PMT.
+        //!
+        bool isValid() const { return _valid; }
+
+        //!
+        //! Get the service id.
+        //! @return The service id.
+        //!
+        uint16_t serviceId() const { return _service_id; }
+
+        //!
+        //! Get the PCR PID.
+        //! @return The PCR PID.
+        //!
+        PID pcrPID() const { return _pcr_pid; }
+
+        //!
+        //! Get the list of program-level descriptors.
+        //! @return A view of the list of program-level descriptors.
+        //!
+        const DescriptorListView& descs() const { return _descs; }
+
+        //!
+        //! Get the list of elementary streams.
+        //! @return A view of the list of elementary streams.
+        //!
+        const StreamListView& streams() const { return _streams; }
+
+    private:
+        bool               _valid;
+        uint16_t           _service_id;
+        PID                _pcr_pid;
+        DescriptorListView _descs;
+        StreamListView     _streams;
+    };
+}
@@ -0,0 +1,95 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsSDTView.h"
+#include "tsServiceDescriptor.h"
+#include "tsService.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors.
+//----------------------------------------------------------------------------
+
+ts::SDTView::SDTView(const Section& section) :
+    _valid(false),
+    _actual(false),
+    _ts_id(0),
+    _onetw_id(0),
+    _services()
+{
+    const TID tid = section.tableId();
+    if (section.isValid() && (tid == TID_SDT_ACT || tid == TID_SDT_OTH) && section.payloadSize() >= 3) {
+        _valid = true;
+        _actual = tid == TID_SDT_ACT;
+        _ts_id = section.tableIdExtension();
+        _onetw_id = GetUInt16(section.payload());
+        _services = ServiceListView(section.payload() + 3, section.payloadSize() - 3);
+    }
+}
+
+ts::SDTView::Service::Service(const uint8_t* data, size_t size) :
+    _data(nullptr),
+    _size(0)
+{
+    if (data != nullptr && size >= 5 && 5 + size_t(GetUInt16(data + 3) & 0x0FFF) <= size) {
+        _data = data;
+        _size = 5 + size_t(GetUInt16(data + 3) & 0x0FFF);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Update a service description with the content of this entry.
+//----------------------------------------------------------------------------
+
+void ts::SDTView::Service::updateService(DuckContext& duck, ts::Service& service) const
+{
+    if (_data != nullptr) {
+        service.setRunningStatus(runningStatus());
+        service.setCAControlled(CAControlled());
+        service.setEITpfPresent(EITpfPresent());
+        service.setEITsPresent(EITsPresent());
+
+        // Only deserialize the first service_descriptor.
+        const DescriptorListView dlist(descs());
+        for (const auto& dv : dlist) {
+            if (dv.tag() == DID_SERVICE) {
+                Descriptor bin;
+                dv.toDescriptor(bin);
+                const ServiceDescriptor srv_desc(duck, bin);
+                if (srv_desc.isValid()) {
+                    service.setName(srv_desc.service_name);
+                    service.setProvider(srv_desc.provider_name);
+                    service.setTypeDVB(srv_desc.service_type);
+                }
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,157 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view of a Service Description Table (SDT) in a binary section.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsDescriptorView.h"
+#include "tsSection.h"
+
+namespace ts {
+
+    class DuckContext;
+    class Service;
+
+    //!
+    //! Read-only view of a Service Description Table (SDT) in a binary section.
+    //! @ingroup table
+    //!
+    //! An SDTView directly reads the binary content of one section. Nothing is
+    //! allocated or copied. This is faster than a full deserialization into an SDT
+    //! object when the application only needs to read a few fields. The section
+    //! must remain valid and unmodified as long as the view is used.
+    //!
+    //! @see SDT
+    //!
+    class TSDUCKDLL SDTView
+    {
+    public:
+        //!
+        //! Read-only view of a service description in an SDT.
+        //!
+        class TSDUCKDLL Service
+        {
+        public:
+            //! Default constructor, an invalid service.
+            Service() : _data(nullptr), _size(0) {}
+            //! Constructor.
+            //! @param [in] data Address of the service description.
+            //! @param [in] size Size of the memory area, starting at @a data.
+            Service(const uint8_t* data, size_t size);
+            //! Copy constructor.
+            //! @param [in] other Other instance to copy.
+            Service(const Service& other) = default;
+            //! Assignment operator.
+            //! @param [in] other Other instance to copy.
+            //! @return A reference to this object.
+            Service& operator=(const Service& other) = default;
+            //! Get the service id.
+            //! @return The service id.
+            uint16_t serviceId() const { return _data == nullptr ? 0 : GetUInt16(_data); }
+            //! Check if EIT schedule is present.
+            //! @return True if EIT schedule is present.
+            bool EITsPresent() const { return _data != nullptr && (_data[2] & 0x02) != 0; }
+            //! Check if EIT present/following is present.
+            //! @return True if EIT present/following is present.
+            bool EITpfPresent() const { return _data != nullptr && (_data[2] & 0x01) != 0; }
+            //! Get the running status.
+            //! @return The running status.
+            uint8_t runningStatus() const { return _data == nullptr ? 0 : uint8_t(_data[3] >> 5); }
+            //! Check if the service is controlled by a CA system.
+            //! @return True if the service is controlled by a CA system.
+            bool CAControlled() const { return _data != nullptr && (_data[3] & 0x10) != 0; }
+            //! Get the list of descriptors for this service.
+            //! @return A view of the list of descriptors.
+            DescriptorListView descs() const { return _data == nullptr ? DescriptorListView() : DescriptorListView(_data + 5, _size - 5); }
+            //! Update a service description with the content of this entry.
+            //! Only the service_descriptor is deserialized, if present.
+            //! @param [in,out] duck TSDuck execution context.
+            //! @param [in,out] service A service description to update.
+            //! @see SDT::ServiceEntry::updateService()
+            void updateService(DuckContext& duck, ts::Service& service) const;
+            //! Get the size of this entry in the list of services (for LoopView).
+            //! @return The size of the service description in bytes, zero if invalid.
+            size_t entrySize() const { return _size; }
+        private:
+            const uint8_t* _data;
+            size_t         _size;
+        };
+
+        //!
+        //! Read-only view of the list of services in an SDT.
+        //!
+        typedef LoopView<Service> ServiceListView;
+
+        //!
+        //! Constructor.
+        //! @param [in] section A binary SDT section.
+        //!
+        explicit SDTView(const Section& section);
+
+        //!
+        //! Check if the section is a valid SDT section.
+        //! @return True if the section is a valid SDT section.
+        //!
+        bool isValid() const { return _valid; }
+
+        //!
+        //! Check if this is an "actual" SDT.
+        //! @return True for SDT Actual TS, false for SDT Other TS.
+        //!
+        bool isActual() const { return _actual; }
+
+        //!
+        //! Get the transport stream id.
+        //! @return The transport stream id.
+        //!
+        uint16_t tsId() const { return _ts_id; }
+
+        //!
+        //! Get the original network id.
+        //! @return The original network id.
+        //!
+        uint16_t onetwId() const { return _onetw_id; }
+
+        //!
+        //! Get the list of services.
+        //! @return A view of the list of services in this section.
+        //!
+        const ServiceListView& services() const { return _services; }
+
+    private:
+        bool            _valid;
+        bool            _actual;
+        uint16_t        _ts_id;
+        uint16_t        _onetw_id;
+        ServiceListView _services;
+    };
+}
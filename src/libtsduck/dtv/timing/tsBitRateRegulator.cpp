@@ -30,6 +30,10 @@
 #include "tsBitRateRegulator.h"
 #include "tsNullReport.h"
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr ts::PacketCounter ts::BitRateRegulator::MAX_SEQUENCE_PACKETS;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructor
@@ -48,7 +52,11 @@ ts::BitRateRegulator::BitRateRegulator(Report* report, int log_level) :
     _burst_duration(0),
     _burst_end(),
     _bitrate_start(),
-    _bitrate_pkt_cnt(0)
+    _bitrate_pkt_cnt(0),
+    _spin(0),
+    _pkt_start(),
+    _pkt_count(0),
+    _last_wait()
 {
 }
 
@@ -87,6 +95,7 @@ void ts::BitRateRegulator::start()
     _burst_pkt_max = 0;
     _burst_pkt_cnt = 0;
     _burst_duration = 0;
+    _pkt_count = 0;
 }
 
 
@@ -141,7 +150,7 @@ void ts::BitRateRegulator::regulatePacket(bool& flush, bool smoothen)
     // Recheck end of burst, just in case we added some more packets to smoothen.
     if (_burst_pkt_cnt == 0) {
         // Wait until scheduled end of burst.
-        _burst_end.wait();
+        _burst_end.wait(_spin);
         // Restart a new burst, use monotonic time
         _burst_pkt_cnt = _burst_pkt_max;
         _burst_end += _burst_duration;
@@ -276,3 +285,71 @@ void ts::BitRateRegulator::regulate(const BitRate& current_bitrate, bool& flush,
         }
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Compute the due time of a packet, without waiting.
+//----------------------------------------------------------------------------
+
+bool ts::BitRateRegulator::packetTime(const BitRate& current_bitrate, Monotonic& due, bool& bitrate_changed)
+{
+    // Compute old and new bitrate (most often the same)
+    const BitRate old_bitrate = _cur_bitrate;
+    _cur_bitrate = _opt_bitrate != 0 ? _opt_bitrate : current_bitrate;
+    bitrate_changed = _cur_bitrate != old_bitrate || _state == INITIAL;
+
+    if (bitrate_changed) {
+        if (_cur_bitrate == 0) {
+            _report->log(_log_level, u"unknown bitrate, cannot regulate.");
+        }
+        else {
+            _report->log(_log_level, u"regulated at bitrate %'d b/s", {_cur_bitrate.toInt()});
+        }
+        // Start a new sequence at the due time of the next packet at the previous bitrate or now, whichever is later.
+        Monotonic now(true);
+        if (_state == REGULATED && old_bitrate != 0) {
+            _pkt_start += ((NanoSecPerSec * PKT_SIZE_BITS * _pkt_count) / old_bitrate).toInt();
+            if (_pkt_start < now) {
+                _pkt_start = now;
+            }
+        }
+        else {
+            _pkt_start = now;
+            _last_wait = now;
+        }
+        _pkt_count = 0;
+        _state = _cur_bitrate == 0 ? UNREGULATED : REGULATED;
+    }
+
+    if (_cur_bitrate == 0) {
+        return false;
+    }
+
+    // Periodically restart the sequence to avoid overflows.
+    if (_pkt_count >= MAX_SEQUENCE_PACKETS) {
+        _pkt_start += ((NanoSecPerSec * PKT_SIZE_BITS * _pkt_count) / _cur_bitrate).toInt();
+        _pkt_count = 0;
+    }
+
+    due = _pkt_start;
+    due += ((NanoSecPerSec * PKT_SIZE_BITS * _pkt_count) / _cur_bitrate).toInt();
+    _pkt_count++;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Wait until a due time, as returned by packetTime().
+//----------------------------------------------------------------------------
+
+bool ts::BitRateRegulator::waitUntil(const Monotonic& due)
+{
+    if (_state == REGULATED && due - _last_wait >= _burst_min) {
+        _last_wait = due;
+        _last_wait.wait(_spin);
+        return true;
+    }
+    else {
+        return false;
+    }
+}
@@ -79,6 +79,13 @@ namespace ts {
             _opt_bitrate = bitrate;
         }
 
+        //!
+        //! Set the duration of the final active wait when waiting for a due time.
+        //! @param [in] ns Duration in nano-seconds of the final active wait. Zero means passive wait only.
+        //! @see Monotonic::wait()
+        //!
+        void setSpinWait(NanoSecond ns) { _spin = ns; }
+
         //!
         //! Start regulation, initialize all timers.
         //!
@@ -100,6 +107,26 @@ namespace ts {
         //!
         void regulate();
 
+        //!
+        //! Compute the due time of a packet, without waiting, to be called at each packet.
+        //! The due time of each packet is computed from the bitrate, since the last bitrate change.
+        //! This method is typically used to regulate a window of packets: compute the due time of
+        //! all packets in the window, then call waitUntil() once for the first packet of the window.
+        //! @param [in] current_bitrate Current bitrate. Ignored if a fixed bitrate was set.
+        //! @param [out] due Due system time of the packet.
+        //! @param [out] bitrate_changed Set to true if the bitrate has changed.
+        //! @return True if @a due is valid, false if the bitrate is unknown.
+        //!
+        bool packetTime(const BitRate& current_bitrate, Monotonic& due, bool& bitrate_changed);
+
+        //!
+        //! Wait until a due time, as returned by packetTime().
+        //! Suspend the process only when the due time is at least the minimum burst duration after the last wait.
+        //! @param [in] due Due system time.
+        //! @return True if the process was suspended, false if there was nothing to wait for.
+        //!
+        bool waitUntil(const Monotonic& due);
+
     private:
         // Regulation state
         enum State {INITIAL, REGULATED, UNREGULATED};
@@ -118,6 +145,13 @@ namespace ts {
         Monotonic     _burst_end;       // End of current burst
         Monotonic     _bitrate_start;   // Time of last bitrate change
         PacketCounter _bitrate_pkt_cnt; // Passed packets since last bitrate change
+        NanoSecond    _spin;            // Final active wait (ns)
+        Monotonic     _pkt_start;       // Due time of first packet in sequence (packetTime() only).
+        PacketCounter _pkt_count;       // Number of packets in sequence (packetTime() only).
+        Monotonic     _last_wait;       // Due time of last wait (packetTime() only).
+
+        // Maximum number of packets in a sequence for packetTime(), avoid overflow in nano-seconds computation.
+        static constexpr PacketCounter MAX_SEQUENCE_PACKETS = 1000000;
 
         // Compute burst duration (_burst_duration and _burst_pkt_max), based on
         // required packets/burst (command line option) and current bitrate.
@@ -43,12 +43,17 @@ ts::PCRRegulator::PCRRegulator(Report* report, int log_level) :
     _opt_burst(0),
     _burst_pkt_cnt(0),
     _wait_min(0),
+    _spin(0),
     _started(false),
     _pcr_first(0),
     _pcr_last(0),
     _pcr_offset(0),
     _clock_first(),
-    _clock_last()
+    _clock_last(),
+    _pcr_due(),
+    _last_due(),
+    _pkt_duration(0),
+    _pkt_since_pcr(0)
 {
 }
 
@@ -105,6 +110,8 @@ void ts::PCRRegulator::reset()
     _pid = _user_pid;
     _burst_pkt_cnt = 0;
     _started = false;
+    _pkt_duration = 0;
+    _pkt_since_pcr = 0;
 }
 
 
@@ -126,72 +133,16 @@ bool ts::PCRRegulator::regulate(const TSPacket& pkt)
 
     // Do something only on PCR's from the reference PID.
     if (has_pcr && pid == _pid) {
-
-        // PCR value, this is the reference system clock.
-        const uint64_t pcr = pkt.getPCR();
-
-        // Check if the PCR sequence seems valid.
-        // We check that the difference between two PCR's is less than 2 seconds.
-        // Normally, adjacent PCR's are way much closer, but let's be tolerant.
-        constexpr uint64_t max_pcr_diff = 2 * SYSTEM_CLOCK_FREQ; // 2 seconds in PCR units
-        const bool valid_pcr_seq = _started &&
-            ((pcr < _pcr_last && pcr + PCR_SCALE < _pcr_last + max_pcr_diff) ||
-             (pcr > _pcr_last && pcr < _pcr_last + max_pcr_diff));
-
-        // Try to detect incorrect PCR sequences (such as cycling input).
-        if (_started && !valid_pcr_seq) {
-            _report->warning(u"out of sequence PCR, maybe source was cycling, restarting regulation");
-            _started = false;
-        }
-
-        if (!_started) {
-            // Initialize regulation at the first PCR.
-            _started = true;
-            _clock_first.getSystemTime();
-            _clock_last = _clock_first;
-            _pcr_first = pcr;
-            _pcr_offset = 0;
-
-            // Compute minimum wait is none is set.
-            if (_wait_min <= 0) {
-                setMinimimWait();
-            }
-        }
-        else {
-            // Got a PCR after start, need to regulate.
-
-            // Accumulate all PCR wrap-down sequences so that the distance with _pcr_first is a valid duration.
-            // One complete PCR round is only 26.5 hours. So, it it realistic to go through more than one round.
-            // In an uint64_t value, we can accumulate 21664 years in PCR units. So, we can safely assume that
-            // there will be no overflow when accumulating PCR's on 64 bits.
-            if (pcr < _pcr_last) {
-                _pcr_offset += PCR_SCALE;
-            }
-
-            // Compute the number of PCR units since the first PCR.
-            const uint64_t pcru = _pcr_offset + pcr - _pcr_first;
-
-            // Compute the number of nano-seconds since the first PCR.
-            // In an uint64_t value, we can accumulate 292 years in nano-seconds units.
-            // Coded to avoid arithmetic overflow, don't change without thinking twice.
-            const NanoSecond ns = (NanoSecPerMicroSec * pcru) / (SYSTEM_CLOCK_FREQ / MicroSecPerSec);
-
-            // Compute due system clock, the expected system time for this PCR.
-            Monotonic clock_due(_clock_first);
-            clock_due += ns;
-
-            // Do not wait less than the user-specified minimum.
-            if (clock_due - _clock_last >= _wait_min) {
-                // Wait until system time for current PCR.
-                _clock_last = clock_due;
-                _clock_last.wait();
-                // Always flush after wait.
-                flush = true;
-            }
+        // Compute due system clock, the expected system time for this PCR.
+        // Do not wait less than the user-specified minimum.
+        Monotonic clock_due;
+        if (handlePCR(pkt.getPCR(), clock_due) && clock_due - _clock_last >= _wait_min) {
+            // Wait until system time for current PCR.
+            _clock_last = clock_due;
+            _clock_last.wait(_spin);
+            // Always flush after wait.
+            flush = true;
         }
-
-        // Always keep last PCR value.
-        _pcr_last = pcr;
     }
 
     // One more packet in current burst.
@@ -207,3 +158,127 @@ bool ts::PCRRegulator::regulate(const TSPacket& pkt)
     // Return true when packets should be flushed to next plugin.
     return flush;
 }
+
+
+//----------------------------------------------------------------------------
+// Process a PCR from the reference PID, compute its due time.
+//----------------------------------------------------------------------------
+
+bool ts::PCRRegulator::handlePCR(uint64_t pcr, Monotonic& due)
+{
+    // Check if the PCR sequence seems valid.
+    // We check that the difference between two PCR's is less than 2 seconds.
+    // Normally, adjacent PCR's are way much closer, but let's be tolerant.
+    constexpr uint64_t max_pcr_diff = 2 * SYSTEM_CLOCK_FREQ; // 2 seconds in PCR units
+    const bool valid_pcr_seq = _started &&
+        ((pcr < _pcr_last && pcr + PCR_SCALE < _pcr_last + max_pcr_diff) ||
+         (pcr > _pcr_last && pcr < _pcr_last + max_pcr_diff));
+
+    // Try to detect incorrect PCR sequences (such as cycling input).
+    if (_started && !valid_pcr_seq) {
+        _report->warning(u"out of sequence PCR, maybe source was cycling, restarting regulation");
+        _started = false;
+    }
+
+    if (!_started) {
+        // Initialize regulation at the first PCR.
+        _started = true;
+        _clock_first.getSystemTime();
+        _clock_last = _clock_first;
+        _pcr_first = pcr;
+        _pcr_last = pcr;
+        _pcr_offset = 0;
+        due = _clock_first;
+
+        // Compute minimum wait is none is set.
+        if (_wait_min <= 0) {
+            setMinimimWait();
+        }
+        return false;
+    }
+
+    // Accumulate all PCR wrap-down sequences so that the distance with _pcr_first is a valid duration.
+    // One complete PCR round is only 26.5 hours. So, it it realistic to go through more than one round.
+    // In an uint64_t value, we can accumulate 21664 years in PCR units. So, we can safely assume that
+    // there will be no overflow when accumulating PCR's on 64 bits.
+    if (pcr < _pcr_last) {
+        _pcr_offset += PCR_SCALE;
+    }
+    _pcr_last = pcr;
+
+    // Compute the number of PCR units since the first PCR.
+    const uint64_t pcru = _pcr_offset + pcr - _pcr_first;
+
+    // Compute the number of nano-seconds since the first PCR.
+    // In an uint64_t value, we can accumulate 292 years in nano-seconds units.
+    // Coded to avoid arithmetic overflow, don't change without thinking twice.
+    const NanoSecond ns = (NanoSecPerMicroSec * pcru) / (SYSTEM_CLOCK_FREQ / MicroSecPerSec);
+
+    // Compute due system clock, the expected system time for this PCR.
+    due = _clock_first;
+    due += ns;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Compute the due time of a packet, without waiting.
+//----------------------------------------------------------------------------
+
+bool ts::PCRRegulator::packetTime(const TSPacket& pkt, Monotonic& due)
+{
+    const PID pid = pkt.getPID();
+    const bool has_pcr = pkt.hasPCR();
+
+    // Select first PID with PCR's when unspecified by user.
+    if (has_pcr && _pid == PID_NULL) {
+        _pid = pid;
+        _report->log(_log_level, u"using PID 0x%X (%d) for PCR reference", {pid, pid});
+    }
+
+    if (has_pcr && pid == _pid) {
+        if (handlePCR(pkt.getPCR(), due)) {
+            // Estimate the duration of one packet from the interval between the last two PCR's.
+            _pkt_duration = (due - _pcr_due) / NanoSecond(_pkt_since_pcr + 1);
+        }
+        else {
+            // Regulation (re)started, no packet duration yet.
+            _pkt_duration = 0;
+            _last_due = due;
+        }
+        _pcr_due = due;
+        _pkt_since_pcr = 0;
+    }
+    else if (_started) {
+        // Interpolate from last PCR.
+        due = _pcr_due;
+        due += _pkt_duration * NanoSecond(++_pkt_since_pcr);
+    }
+    else {
+        return false;
+    }
+
+    // Never go backward, when the PCR interval is shorter than the interpolation.
+    if (due < _last_due) {
+        due = _last_due;
+    }
+    _last_due = due;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Wait until a due time, as returned by packetTime().
+//----------------------------------------------------------------------------
+
+bool ts::PCRRegulator::waitUntil(const Monotonic& due)
+{
+    if (_started && due - _clock_last >= _wait_min) {
+        _clock_last = due;
+        _clock_last.wait(_spin);
+        return true;
+    }
+    else {
+        return false;
+    }
+}
@@ -93,6 +93,13 @@ namespace ts {
         //!
         void setMinimimWait(NanoSecond ns = DEFAULT_MIN_WAIT_NS);
 
+        //!
+        //! Set the duration of the final active wait when waiting for a due time.
+        //! @param [in] ns Duration in nano-seconds of the final active wait. Zero means passive wait only.
+        //! @see Monotonic::wait()
+        //!
+        void setSpinWait(NanoSecond ns) { _spin = ns; }
+
         //!
         //! Re-initialize state.
         //!
@@ -106,6 +113,27 @@ namespace ts {
         //!
         bool regulate(const TSPacket& pkt);
 
+        //!
+        //! Compute the due time of a packet, without waiting, to be called at each packet.
+        //! The due time of the packets from the reference PID which contain a PCR is computed from
+        //! the PCR value. The due time of the other packets is interpolated from the packet rate
+        //! between the two previous PCR's. Due times are never decreasing.
+        //! This method is typically used to regulate a window of packets: compute the due time of
+        //! all packets in the window, then call waitUntil() once for the first packet of the window.
+        //! @param [in] pkt TS packet from the stream.
+        //! @param [out] due Due system time of the packet.
+        //! @return True if @a due is valid, false if the regulation is not yet started (no PCR yet).
+        //!
+        bool packetTime(const TSPacket& pkt, Monotonic& due);
+
+        //!
+        //! Wait until a due time, as returned by packetTime().
+        //! Suspend the process only when the due time is at least the minimum wait interval after the last wait.
+        //! @param [in] due Due system time.
+        //! @return True if the process was suspended, false if there was nothing to wait for.
+        //!
+        bool waitUntil(const Monotonic& due);
+
     private:
         Report*       _report;
         int           _log_level;
@@ -114,11 +142,20 @@ namespace ts {
         PacketCounter _opt_burst;       // Number of packets to burst at a time
         PacketCounter _burst_pkt_cnt;   // Number of packets in current burst
         NanoSecond    _wait_min;        // Minimum delay between two waits (ns)
+        NanoSecond    _spin;            // Final active wait (ns)
         bool          _started;         // First PCR found, regulation started.
         uint64_t      _pcr_first;       // First PCR value.
         uint64_t      _pcr_last;        // Last PCR value.
         uint64_t      _pcr_offset;      // Offset to add to PCR value, accumulate all PCR wrap-down sequences.
         Monotonic     _clock_first;     // System time at first PCR.
         Monotonic     _clock_last;      // System time at last wait
+        Monotonic     _pcr_due;         // Due time of last PCR in reference PID (packetTime() only).
+        Monotonic     _last_due;        // Last returned due time (packetTime() only).
+        NanoSecond    _pkt_duration;    // Estimated duration of a packet (packetTime() only).
+        PacketCounter _pkt_since_pcr;   // Number of packets since last PCR (packetTime() only).
+
+        // Process a PCR from the reference PID, compute its due time.
+        // Return false when the regulation is (re)started at this PCR.
+        bool handlePCR(uint64_t pcr, Monotonic& due);
     };
 }
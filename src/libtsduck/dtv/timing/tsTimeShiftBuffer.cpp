@@ -30,6 +30,7 @@
 #include "tsTimeShiftBuffer.h"
 #include "tsNullReport.h"
 #include "tsFileUtils.h"
+#include "tsGuardCondition.h"
 
 #if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
 constexpr size_t ts::TimeShiftBuffer::MIN_TOTAL_PACKETS;
@@ -45,6 +46,7 @@ constexpr size_t ts::TimeShiftBuffer::DEFAULT_MEMORY_PACKETS;
 
 ts::TimeShiftBuffer::TimeShiftBuffer(size_t count) :
     _is_open(false),
+    _async_io(true),
     _cur_packets(0),
     _total_packets(std::max(count, MIN_TOTAL_PACKETS)),
     _mem_packets(DEFAULT_MEMORY_PACKETS),
@@ -52,13 +54,20 @@ ts::TimeShiftBuffer::TimeShiftBuffer(size_t count) :
     _file(),
     _next_read(0),
     _next_write(0),
-    _wcache_next(0),
-    _rcache_end(0),
-    _rcache_next(0),
-    _wcache(),
-    _rcache(),
-    _wmdata(),
-    _rmdata()
+    _buffer(),
+    _mdata(),
+    _chunk_size(0),
+    _wchunk(),
+    _rchunk(),
+    _wcur(0),
+    _rcur(0),
+    _io_report(nullptr),
+    _io_thread(nullptr),
+    _io_mutex(),
+    _io_request(),
+    _io_completed(),
+    _io_terminate(false),
+    _io_queue()
 {
 }
 
@@ -67,6 +76,11 @@ ts::TimeShiftBuffer::~TimeShiftBuffer()
     close(NULLREP);
 }
 
+ts::TimeShiftBuffer::IOThread::~IOThread()
+{
+    waitForTermination();
+}
+
 
 //----------------------------------------------------------------------------
 // Set various characteristics, must be called before open.
@@ -105,6 +119,17 @@ bool ts::TimeShiftBuffer::setBackupDirectory(const UString& directory)
     }
 }
 
+bool ts::TimeShiftBuffer::setAsynchronousIO(bool on)
+{
+    if (_is_open) {
+        return false;
+    }
+    else {
+        _async_io = on;
+        return true;
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Open the buffer.
@@ -118,11 +143,9 @@ bool ts::TimeShiftBuffer::open(Report& report)
     }
 
     if (memoryResident()) {
-        // The buffer is entirely memory-resident in _wcache.
-        _wcache.resize(_total_packets);
-        _wmdata.resize(_total_packets);
-        _rcache.clear();
-        _rmdata.clear();
+        // The buffer is entirely memory-resident.
+        _buffer.resize(_total_packets);
+        _mdata.resize(_total_packets);
     }
     else {
         // The buffer is backed up on disk.
@@ -144,18 +167,38 @@ bool ts::TimeShiftBuffer::open(Report& report)
             return false;
         }
 
-        // The read and write buffers use half of memory quota each.
-        // Since the size of the file is larger than the sum of the two,
-        // the read and write caches never overlap when the buffer is full.
-        _wcache.resize(_mem_packets / 2);
-        _wmdata.resize(_mem_packets / 2);
-        _rcache.resize(_mem_packets / 2);
-        _rmdata.resize(_mem_packets / 2);
+        // The two read and two write chunks use a quarter of the memory quota each.
+        // Since the size of the file is larger than the sum of the four, the packets
+        // which are read ahead are never in a write chunk which is not yet written.
+        _chunk_size = std::max<size_t>(1, _mem_packets / 4);
+        for (size_t i = 0; i < 2; ++i) {
+            for (Chunk* chunk : {&_wchunk[i], &_rchunk[i]}) {
+                chunk->packets.resize(_chunk_size);
+                chunk->mdata.resize(_chunk_size);
+                chunk->index = chunk->count = chunk->next = 0;
+                chunk->state = IOState::IDLE;
+            }
+        }
+        _wcur = _rcur = 0;
+
+        // Start the I/O thread.
+        _io_report = &report;
+        _io_terminate = false;
+        _io_queue.clear();
+        if (_async_io) {
+            _io_thread = new IOThread(*this);
+            if (!_io_thread->start()) {
+                report.error(u"cannot start time-shift I/O thread");
+                delete _io_thread;
+                _io_thread = nullptr;
+                _file.close(report);
+                return false;
+            }
+        }
     }
 
     _cur_packets = 0;
     _next_read = _next_write = 0;
-    _wcache_next = _rcache_end = _rcache_next = 0;
     _is_open = true;
     return true;
 }
@@ -171,117 +214,288 @@ bool ts::TimeShiftBuffer::close(Report& report)
         return false;
     }
 
+    // Terminate the I/O thread, pending requests are useless.
+    if (_io_thread != nullptr) {
+        {
+            GuardCondition lock(_io_mutex, _io_request);
+            _io_terminate = true;
+            lock.signal();
+        }
+        delete _io_thread;
+        _io_thread = nullptr;
+    }
+    _io_queue.clear();
+
     _is_open = false;
     _cur_packets = 0;
-    _wcache.clear();
-    _wmdata.clear();
-    _rcache.clear();
-    _rmdata.clear();
+    _buffer.clear();
+    _mdata.clear();
+    for (size_t i = 0; i < 2; ++i) {
+        for (Chunk* chunk : {&_wchunk[i], &_rchunk[i]}) {
+            chunk->packets.clear();
+            chunk->mdata.clear();
+            chunk->state = IOState::IDLE;
+        }
+    }
     return !_file.isOpen() || _file.close(report);
 }
 
 
 //----------------------------------------------------------------------------
-// Push a packet in the time-shift buffer and pull the oldest one.
+// Push packets in the time-shift buffer and pull the oldest ones.
 //----------------------------------------------------------------------------
 
-bool ts::TimeShiftBuffer::shift(TSPacket& packet, TSPacketMetadata& mdata, Report& report)
+bool ts::TimeShiftBuffer::shift(TSPacket* packets, TSPacketMetadata* mdata, size_t count, Report& report)
 {
     if (!_is_open) {
         report.error(u"time-shift buffer not open");
         return false;
     }
 
-    TSPacket ret_packet(NullPacket);
-    TSPacketMetadata ret_mdata;
-    const bool was_full = full();
-
-    assert(_cur_packets <= _total_packets);
-    assert(_next_read < _total_packets);
-    assert(_next_write < _total_packets);
-
-    if (memoryResident()) {
-        // The buffer is entirely memory-resident in _wcache.
-        assert(_wcache.size() == _total_packets);
-        if (was_full) {
-            // Buffer full: return oldest packet.
-            ret_packet = _wcache[_next_read];
-            ret_mdata = _wmdata[_next_read];
-            _next_read = (_next_read + 1) % _wcache.size();
-        }
-        else {
-            // Buffer not full, increase the packet count.
-            _cur_packets++;
-        }
-        _wcache[_next_write] = packet;
-        _wmdata[_next_write] = mdata;
-        _next_write = (_next_write + 1) % _wcache.size();
-    }
-    else {
-        // The buffer uses a backup file.
-        if (!was_full) {
-            // While the buffer is not full, simply write the packet in the file.
-            if (!_file.writePackets(&packet, &mdata, 1, report)) {
-                return false;
+    while (count > 0) {
+
+        assert(_cur_packets <= _total_packets);
+        assert(_next_read < _total_packets);
+        assert(_next_write < _total_packets);
+
+        // Number of packets to shift in this iteration.
+        size_t n = 1;
+
+        if (memoryResident()) {
+            // The buffer is entirely memory-resident, process one packet.
+            assert(_buffer.size() == _total_packets);
+            const TSPacket packet(*packets);
+            const TSPacketMetadata packet_mdata(*mdata);
+            if (full()) {
+                // Buffer full: return oldest packet.
+                *packets = _buffer[_next_read];
+                *mdata = _mdata[_next_read];
+                _next_read = (_next_read + 1) % _total_packets;
+            }
+            else {
+                // Buffer not full, return a null packet and increase the packet count.
+                *packets = NullPacket;
+                mdata->reset();
+                mdata->setInputStuffing(true);
+                _cur_packets++;
             }
-            _cur_packets++;
+            _buffer[_next_write] = packet;
+            _mdata[_next_write] = packet_mdata;
+            _next_write = (_next_write + 1) % _total_packets;
         }
         else {
-            // The buffer is full, now read and write in caches.
-            // First, make sure the read cache is filled.
-            if (_rcache_next >= _rcache_end) {
-                // Read cache is empty, load it.
-                const size_t count = std::min(_rcache.size(), _total_packets - _next_read);
-                _rcache_next = 0;
-                _rcache_end = readFile(_next_read, &_rcache[0], &_rmdata[0], count, report);
-                if (_rcache_end == 0) {
-                    report.error(u"error reading time-shift file");
-                    return false;
-                }
+            // The buffer uses a backup file. Incoming packets go into the current write chunk.
+            // A write chunk never crosses the end of the file.
+            Chunk& wchunk(_wchunk[_wcur]);
+            if (wchunk.count == 0) {
+                wchunk.index = _next_write;
             }
-            // Return oldest packet from memory cache.
-            ret_packet = _rcache[_rcache_next];
-            ret_mdata = _rmdata[_rcache_next++];
-            _next_read = (_next_read + 1) % _total_packets;
-            // Flush the write cache if necessary.
-            if (_wcache_next >= _wcache.size()) {
-                // Flush the entire write cache on disk.
-                // Split in two operations if exceeds the end of file.
-                // Write index in file of the start of the write cache:
-                const size_t file_index = _next_write >= _wcache.size() ? _next_write - _wcache.size() : _total_packets + _next_write - _wcache.size();
-                assert(file_index < _total_packets);
-                const size_t count = std::min(_wcache.size(), _total_packets - file_index);
-                if (!writeFile(file_index, &_wcache[0], &_wmdata[0], count, report)) {
-                    return false;
+            n = std::min(count, std::min(_chunk_size - wchunk.count, _total_packets - _next_write));
+
+            if (!full()) {
+                // While the buffer is not full, return null packets.
+                n = std::min(n, _total_packets - _cur_packets);
+                std::copy(packets, packets + n, &wchunk.packets[wchunk.count]);
+                std::copy(mdata, mdata + n, &wchunk.mdata[wchunk.count]);
+                for (size_t i = 0; i < n; ++i) {
+                    packets[i] = NullPacket;
+                    mdata[i].reset();
+                    mdata[i].setInputStuffing(true);
                 }
-                // Write second part at begining of file if required.
-                if (count < _wcache.size() && !writeFile(0, &_wcache[count], &_wmdata[count], _wcache.size() - count, report)) {
+                _cur_packets += n;
+            }
+            else {
+                // The buffer is full, return the oldest packets from the current read chunk.
+                if (!loadRead(report)) {
                     return false;
                 }
-                // Write cache is now empty.
-                _wcache_next = 0;
+                Chunk& rchunk(_rchunk[_rcur]);
+                n = std::min(n, rchunk.count - rchunk.next);
+                std::copy(packets, packets + n, &wchunk.packets[wchunk.count]);
+                std::copy(mdata, mdata + n, &wchunk.mdata[wchunk.count]);
+                std::copy(&rchunk.packets[rchunk.next], &rchunk.packets[rchunk.next] + n, packets);
+                std::copy(&rchunk.mdata[rchunk.next], &rchunk.mdata[rchunk.next] + n, mdata);
+                rchunk.next += n;
+                _next_read = (_next_read + n) % _total_packets;
+            }
+
+            wchunk.count += n;
+            _next_write = (_next_write + n) % _total_packets;
+
+            // Write the chunk when full or at end of file.
+            if ((wchunk.count >= _chunk_size || _next_write == 0) && !flushWrite(report)) {
+                return false;
+            }
+
+            // Start reading the oldest packets as soon as the buffer is full.
+            if (full()) {
+                readAhead(report);
             }
-            // Write the next packet in the write cache.
-            _wcache[_wcache_next] = packet;
-            _wmdata[_wcache_next++] = mdata;
         }
-        _next_write = (_next_write + 1) % _total_packets;
+
+        packets += n;
+        mdata += n;
+        count -= n;
     }
+    return true;
+}
 
-    // Returned packet. It is a null packet when the buffer was not yet full.
-    if (was_full) {
-        packet = ret_packet;
-        mdata = ret_mdata;
+
+//----------------------------------------------------------------------------
+// Flush the current write chunk and switch to the other one.
+//----------------------------------------------------------------------------
+
+bool ts::TimeShiftBuffer::flushWrite(Report& report)
+{
+    Chunk& current(_wchunk[_wcur]);
+    if (current.count > 0) {
+        submit(current, IOState::WRITING, report);
     }
-    else {
-        packet = NullPacket;
-        mdata.reset();
-        mdata.setInputStuffing(true);
+
+    // Wait until the previous write chunk is written.
+    _wcur ^= 1;
+    Chunk& next(_wchunk[_wcur]);
+    if (!wait(next, report)) {
+        report.error(u"error writing time-shift file");
+        return false;
     }
+    next.count = 0;
+    next.state = IOState::IDLE;
     return true;
 }
 
 
+//----------------------------------------------------------------------------
+// Make sure that the current read chunk contains packets to read.
+//----------------------------------------------------------------------------
+
+bool ts::TimeShiftBuffer::loadRead(Report& report)
+{
+    Chunk* chunk = &_rchunk[_rcur];
+    if (chunk->state == IOState::LOADED && chunk->next < chunk->count) {
+        return true;
+    }
+
+    // The current read chunk is exhausted, switch to the other one.
+    chunk->state = IOState::IDLE;
+    _rcur ^= 1;
+    chunk = &_rchunk[_rcur];
+    if (chunk->state == IOState::IDLE) {
+        // No read-ahead was requested, read now.
+        chunk->index = _next_read;
+        chunk->count = std::min(_chunk_size, _total_packets - _next_read);
+        submit(*chunk, IOState::READING, report);
+    }
+    if (!wait(*chunk, report) || chunk->index != _next_read) {
+        report.error(u"error reading time-shift file");
+        return false;
+    }
+
+    // Immediately read the next packets in the other chunk.
+    readAhead(report);
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Request the read-ahead of the chunk following the current read chunk.
+//----------------------------------------------------------------------------
+
+void ts::TimeShiftBuffer::readAhead(Report& report)
+{
+    const Chunk& current(_rchunk[_rcur]);
+    Chunk& next(_rchunk[_rcur ^ 1]);
+    if (next.state == IOState::IDLE) {
+        // A read chunk never crosses the end of the file.
+        next.index = current.state == IOState::LOADED ? (current.index + current.count) % _total_packets : _next_read;
+        next.count = std::min(_chunk_size, _total_packets - next.index);
+        submit(next, IOState::READING, report);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Submit an I/O request and wait for its completion.
+//----------------------------------------------------------------------------
+
+void ts::TimeShiftBuffer::submit(Chunk& chunk, IOState request, Report& report)
+{
+    chunk.state = request;
+    if (_io_thread == nullptr) {
+        // Synchronous I/O.
+        chunk.state = performIO(chunk, report);
+    }
+    else {
+        GuardCondition lock(_io_mutex, _io_request);
+        _io_queue.push_back(&chunk);
+        lock.signal();
+    }
+}
+
+bool ts::TimeShiftBuffer::wait(Chunk& chunk, Report& report)
+{
+    if (_io_thread != nullptr) {
+        GuardCondition lock(_io_mutex, _io_completed);
+        while (chunk.state == IOState::WRITING || chunk.state == IOState::READING) {
+            lock.waitCondition();
+        }
+    }
+    return chunk.state != IOState::FAILED;
+}
+
+
+//----------------------------------------------------------------------------
+// Background I/O thread.
+//----------------------------------------------------------------------------
+
+void ts::TimeShiftBuffer::IOThread::main()
+{
+    for (;;) {
+        // Wait for the next request.
+        Chunk* chunk = nullptr;
+        {
+            GuardCondition lock(_buffer._io_mutex, _buffer._io_request);
+            while (_buffer._io_queue.empty() && !_buffer._io_terminate) {
+                lock.waitCondition();
+            }
+            if (_buffer._io_terminate) {
+                break;
+            }
+            chunk = _buffer._io_queue.front();
+        }
+
+        // Perform the I/O without holding the mutex.
+        const IOState state = _buffer.performIO(*chunk, *_buffer._io_report);
+
+        // Notify the completion.
+        GuardCondition lock(_buffer._io_mutex, _buffer._io_completed);
+        _buffer._io_queue.pop_front();
+        chunk->state = state;
+        lock.signal();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Perform the I/O on a chunk, return the new state of the chunk.
+//----------------------------------------------------------------------------
+
+ts::TimeShiftBuffer::IOState ts::TimeShiftBuffer::performIO(Chunk& chunk, Report& report)
+{
+    if (chunk.state == IOState::WRITING) {
+        return writeFile(chunk.index, &chunk.packets[0], &chunk.mdata[0], chunk.count, report) ? IOState::IDLE : IOState::FAILED;
+    }
+    else if (chunk.state == IOState::READING) {
+        chunk.next = 0;
+        chunk.count = readFile(chunk.index, &chunk.packets[0], &chunk.mdata[0], chunk.count, report);
+        return chunk.count > 0 ? IOState::LOADED : IOState::FAILED;
+    }
+    else {
+        return chunk.state;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Seek in the backup file.
 //----------------------------------------------------------------------------
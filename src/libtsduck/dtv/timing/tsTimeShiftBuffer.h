@@ -37,6 +37,9 @@
 #include "tsTSFile.h"
 #include "tsTSPacketMetadata.h"
 #include "tsReport.h"
+#include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
 
 namespace ts {
 
@@ -45,6 +48,13 @@ namespace ts {
     //!
     //! A TS packet buffer for time shift.
     //! The buffer is partly implemented in virtual memory and partly on disk.
+    //!
+    //! When the buffer is backed up on disk, the memory is split in four chunks:
+    //! two for writing and two for reading. By default, the disk I/O are performed
+    //! by a background thread: a chunk of incoming packets is written while the
+    //! application fills the other one (write-behind) and the next chunk of outgoing
+    //! packets is read while the application empties the other one (read-ahead).
+    //! All disk accesses are large sequential transfers of complete chunks.
     //! @ingroup mpeg
     //!
     class TSDUCKDLL TimeShiftBuffer
@@ -107,6 +117,17 @@ namespace ts {
         //!
         bool setBackupDirectory(const UString& directory);
 
+        //!
+        //! Set asynchronous disk I/O for the backup file.
+        //! Must be called before open(). The default is asynchronous I/O.
+        //! With asynchronous I/O, the report which is passed to open() is also used
+        //! by the I/O thread and must be thread-safe.
+        //! @param [in] on If true, the backup file is read and written in a background thread.
+        //! If false, it is read and written in the context of shift().
+        //! @return True on success, false if already open.
+        //!
+        bool setAsynchronousIO(bool on);
+
         //!
         //! Open the buffer.
         //! @param [in,out] report Where to report errors.
@@ -173,10 +194,63 @@ namespace ts {
         //! @param [in,out] report Where to report errors.
         //! @return True on success, false on error.
         //!
-        bool shift(TSPacket& packet, TSPacketMetadata& metadata, Report& report);
+        bool shift(TSPacket& packet, TSPacketMetadata& metadata, Report& report)
+        {
+            return shift(&packet, &metadata, 1, report);
+        }
+
+        //!
+        //! Push a window of packets in the time-shift buffer and pull the same number of oldest ones.
+        //! This is equivalent to calling shift() on each packet but the packets are copied by
+        //! contiguous runs and the backup file is checked once per run.
+        //!
+        //! @param [in,out] packets Address of an array of @a count packets. On input, contains
+        //! the packets to push. On output, contains the time-shifted packets.
+        //! @param [in,out] metadata Address of an array of @a count packet metadata.
+        //! @param [in] count Number of packets in @a packets and @a metadata.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool shift(TSPacket* packets, TSPacketMetadata* metadata, size_t count, Report& report);
 
     private:
+        // State of a chunk of packets in the backup file.
+        enum class IOState {
+            IDLE,     // Unused or written.
+            WRITING,  // Write request pending.
+            READING,  // Read request pending.
+            LOADED,   // Read completed, packets are available.
+            FAILED,   // I/O error.
+        };
+
+        // A chunk of contiguous packets in the backup file.
+        // While an I/O request is pending, the chunk is owned by the I/O thread.
+        class Chunk
+        {
+        public:
+            Chunk() : packets(), mdata(), index(0), count(0), next(0), state(IOState::IDLE) {}
+            TSPacketVector         packets;  // Packet buffer.
+            TSPacketMetadataVector mdata;    // Packet metadata buffer.
+            size_t                 index;    // Index in backup file of first packet.
+            size_t                 count;    // Number of valid packets in chunk.
+            size_t                 next;     // Next packet to read in chunk (read chunks only).
+            volatile IOState       state;    // I/O state.
+        };
+
+        // Background I/O thread.
+        class IOThread : public Thread
+        {
+            TS_NOBUILD_NOCOPY(IOThread);
+        public:
+            IOThread(TimeShiftBuffer& buffer) : Thread(), _buffer(buffer) {}
+            virtual ~IOThread() override;
+        private:
+            TimeShiftBuffer& _buffer;
+            virtual void main() override;
+        };
+
         bool    _is_open;                // Buffer is open.
+        bool    _async_io;               // Use a background I/O thread.
         size_t  _cur_packets;            // Current number of packets in the buffer.
         size_t  _total_packets;          // Total capacity of the buffer.
         size_t  _mem_packets;            // Max packets in memory.
@@ -184,13 +258,37 @@ namespace ts {
         TSFile  _file;                   // Backup file on disk.
         size_t  _next_read;              // Index in buffer of next packet to read.
         size_t  _next_write;             // Index in buffer of next packet to write.
-        size_t  _wcache_next;            // Next index to write in _wcache (up to end of _wcache).
-        size_t  _rcache_end;             // End index in _rcache (after last loaded packet).
-        size_t  _rcache_next;            // Next index to read in _rcache.
-        TSPacketVector         _wcache;  // Write cache (or complete buffer if in memory).
-        TSPacketVector         _rcache;  // Read cache.
-        TSPacketMetadataVector _wmdata;  // Packet metadata for _wcache.
-        TSPacketMetadataVector _rmdata;  // Packet metadata for _rcache.
+        TSPacketVector         _buffer;  // Complete buffer when memory resident.
+        TSPacketMetadataVector _mdata;   // Packet metadata for _buffer.
+        size_t    _chunk_size;           // Size in packets of file chunks.
+        Chunk     _wchunk[2];            // Write chunks, one is filled while the other one is written.
+        Chunk     _rchunk[2];            // Read chunks, one is emptied while the other one is read.
+        size_t    _wcur;                 // Index of current write chunk.
+        size_t    _rcur;                 // Index of current read chunk.
+        Report*   _io_report;            // Report for the I/O thread.
+        IOThread* _io_thread;            // Background I/O thread, null if synchronous I/O.
+        Mutex     _io_mutex;             // Protect the I/O request queue.
+        Condition _io_request;           // Signaled when a request is queued.
+        Condition _io_completed;         // Signaled when a request is completed.
+        bool      _io_terminate;         // Request the I/O thread to terminate.
+        std::deque<Chunk*> _io_queue;    // Pending I/O requests, in order.
+
+        // Submit a write or read request for a chunk, wait for completion of a chunk.
+        void submit(Chunk& chunk, IOState request, Report& report);
+        bool wait(Chunk& chunk, Report& report);
+
+        // Flush the current write chunk and switch to the other one.
+        bool flushWrite(Report& report);
+
+        // Make sure that the current read chunk contains packets to read.
+        bool loadRead(Report& report);
+
+        // Request the read-ahead of the chunk following the current read chunk.
+        void readAhead(Report& report);
+
+        // Perform the I/O on a chunk, in the context of the I/O thread (if any).
+        // Return the new state of the chunk.
+        IOState performIO(Chunk& chunk, Report& report);
 
         // Seek, read, write in the backup file.
         bool seekFile(size_t index, Report& report);
@@ -0,0 +1,302 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSFileIndex.h"
+#include "tsReportWithPrefix.h"
+#include "tsByteBlock.h"
+#include "tsMemory.h"
+
+const ts::UChar* const ts::TSFileIndex::DEFAULT_SUFFIX = u".tsidx";
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr uint8_t ts::TSFileIndex::FORMAT_VERSION;
+constexpr size_t ts::TSFileIndex::HEADER_SIZE;
+constexpr size_t ts::TSFileIndex::ENTRY_SIZE;
+#endif
+
+// Magic string at start of index files.
+namespace {
+    const char IndexMagic[] = {'T', 'S', 'I', 'D', 'X'};
+}
+
+
+//----------------------------------------------------------------------------
+// Constructors.
+//----------------------------------------------------------------------------
+
+ts::TSFileIndex::Entry::Entry() :
+    packet(0),
+    pid(PID_NULL),
+    flags(0),
+    pcr(INVALID_PCR),
+    pts(INVALID_PTS),
+    dts(INVALID_DTS)
+{
+}
+
+ts::TSFileIndex::TSFileIndex() :
+    _entries()
+{
+}
+
+void ts::TSFileIndex::clear()
+{
+    _entries.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Add an entry in the index.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndex::add(const Entry& entry)
+{
+    // Most entries are added at the end. Random access points are known a bit later.
+    auto it = _entries.end();
+    if (!_entries.empty() && _entries.back().packet > entry.packet) {
+        it = std::upper_bound(_entries.begin(), _entries.end(), entry.packet, [](PacketCounter p, const Entry& e) { return p < e.packet; });
+    }
+
+    // Merge with an existing entry for the same packet.
+    if (it != _entries.begin() && (it - 1)->packet == entry.packet) {
+        Entry& prev(*(it - 1));
+        prev.flags |= entry.flags;
+        if ((entry.flags & HAS_PCR) != 0) {
+            prev.pcr = entry.pcr;
+        }
+        if ((entry.flags & HAS_PTS) != 0) {
+            prev.pts = entry.pts;
+        }
+        if ((entry.flags & HAS_DTS) != 0) {
+            prev.dts = entry.dts;
+        }
+    }
+    else {
+        _entries.insert(it, entry);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Compute the time of each PCR checkpoint of the reference PID.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndex::pcrTimes(std::vector<std::pair<MilliSecond, size_t>>& times) const
+{
+    times.clear();
+    PID ref_pid = PID_NULL;
+    uint64_t previous = INVALID_PCR;
+    uint64_t elapsed = 0;  // in PCR units, wrap-around is handled by DiffPCR()
+
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        const Entry& e(_entries[i]);
+        if ((e.flags & HAS_PCR) != 0 && (ref_pid == PID_NULL || e.pid == ref_pid)) {
+            ref_pid = e.pid;
+            if (previous != INVALID_PCR) {
+                elapsed += DiffPCR(previous, e.pcr);
+            }
+            previous = e.pcr;
+            times.push_back(std::make_pair(PCRToMilliSecond(elapsed), i));
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get the duration of the indexed file.
+//----------------------------------------------------------------------------
+
+ts::MilliSecond ts::TSFileIndex::duration() const
+{
+    std::vector<std::pair<MilliSecond, size_t>> times;
+    pcrTimes(times);
+    return times.empty() ? 0 : times.back().first;
+}
+
+
+//----------------------------------------------------------------------------
+// Find the packet where to start reading to play a file from a given time.
+//----------------------------------------------------------------------------
+
+ts::PacketCounter ts::TSFileIndex::seekTime(MilliSecond time, bool random_access) const
+{
+    std::vector<std::pair<MilliSecond, size_t>> times;
+    pcrTimes(times);
+
+    // Last PCR checkpoint at or before the requested time.
+    auto it = std::upper_bound(times.begin(), times.end(), time, [](MilliSecond t, const std::pair<MilliSecond, size_t>& p) { return t < p.first; });
+    if (it == times.begin()) {
+        return 0;
+    }
+    size_t index = (--it)->second;
+
+    // Move back to the previous random access point, if any.
+    if (random_access) {
+        for (size_t i = index + 1; i-- > 0; ) {
+            if ((_entries[i].flags & RANDOM_ACCESS) != 0) {
+                return _entries[i].packet;
+            }
+        }
+    }
+    return _entries[index].packet;
+}
+
+
+//----------------------------------------------------------------------------
+// Find the next random access point.
+//----------------------------------------------------------------------------
+
+ts::PacketCounter ts::TSFileIndex::nextRandomAccess(PacketCounter packet, PID pid) const
+{
+    auto it = std::lower_bound(_entries.begin(), _entries.end(), packet, [](const Entry& e, PacketCounter p) { return e.packet < p; });
+    for (; it != _entries.end(); ++it) {
+        if ((it->flags & RANDOM_ACCESS) != 0 && (pid == PID_NULL || it->pid == pid)) {
+            return it->packet;
+        }
+    }
+    return NPOS;
+}
+
+
+//----------------------------------------------------------------------------
+// Save the index in a binary file.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileIndex::save(const UString& file_name, Report& report) const
+{
+    std::ofstream strm(file_name.toUTF8().c_str(), std::ios::out | std::ios::binary);
+    if (!strm.is_open()) {
+        report.error(u"error creating %s", {file_name});
+        return false;
+    }
+    ReportWithPrefix report_internal(report, file_name + u": ");
+    const bool success = save(strm, report_internal);
+    strm.close();
+    return success;
+}
+
+bool ts::TSFileIndex::save(std::ostream& strm, Report& report) const
+{
+    uint8_t header[HEADER_SIZE];
+    ::memcpy(header, IndexMagic, sizeof(IndexMagic));
+    header[5] = FORMAT_VERSION;
+    header[6] = uint8_t(ENTRY_SIZE);
+    header[7] = 0xFF;
+    PutUInt64(header + 8, _entries.size());
+    strm.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    // Serialize entries by chunks to limit the number of I/O's.
+    ByteBlock data;
+    for (size_t i = 0; strm && i < _entries.size(); ) {
+        const size_t count = std::min<size_t>(_entries.size() - i, 4096);
+        data.resize(count * ENTRY_SIZE);
+        uint8_t* p = data.data();
+        for (size_t n = 0; n < count; ++n, ++i, p += ENTRY_SIZE) {
+            const Entry& e(_entries[i]);
+            PutUInt48(p, e.packet);
+            PutUInt16(p + 6, e.pid);
+            p[8] = e.flags;
+            p[9] = 0xFF;
+            PutUInt48(p + 10, (e.flags & HAS_PCR) != 0 ? e.pcr : 0);
+            PutUInt40(p + 16, (e.flags & HAS_PTS) != 0 ? e.pts : 0);
+            PutUInt40(p + 21, (e.flags & HAS_DTS) != 0 ? e.dts : 0);
+        }
+        strm.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+    }
+
+    if (!strm) {
+        report.error(u"error writing index");
+        return false;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Load the index from a binary file.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileIndex::load(const UString& file_name, Report& report)
+{
+    std::ifstream strm(file_name.toUTF8().c_str(), std::ios::in | std::ios::binary);
+    if (!strm.is_open()) {
+        report.error(u"cannot open %s", {file_name});
+        return false;
+    }
+    ReportWithPrefix report_internal(report, file_name + u": ");
+    const bool success = load(strm, report_internal);
+    strm.close();
+    return success;
+}
+
+bool ts::TSFileIndex::load(std::istream& strm, Report& report)
+{
+    _entries.clear();
+
+    uint8_t header[HEADER_SIZE];
+    if (!strm.read(reinterpret_cast<char*>(header), sizeof(header)) || ::memcmp(header, IndexMagic, sizeof(IndexMagic)) != 0) {
+        report.error(u"invalid index file");
+        return false;
+    }
+    if (header[5] != FORMAT_VERSION || header[6] != ENTRY_SIZE) {
+        report.error(u"unsupported index format version %d", {header[5]});
+        return false;
+    }
+
+    // Read entries by chunks.
+    const uint64_t total = GetUInt64(header + 8);
+    ByteBlock data;
+    while (_entries.size() < total) {
+        const size_t count = size_t(std::min<uint64_t>(total - _entries.size(), 4096));
+        data.resize(count * ENTRY_SIZE);
+        if (!strm.read(reinterpret_cast<char*>(data.data()), std::streamsize(data.size()))) {
+            report.error(u"truncated index file, %d entries out of %d", {_entries.size(), total});
+            _entries.clear();
+            return false;
+        }
+        const uint8_t* p = data.data();
+        for (size_t n = 0; n < count; ++n, p += ENTRY_SIZE) {
+            Entry e;
+            e.packet = GetUInt48(p);
+            e.pid = GetUInt16(p + 6) & 0x1FFF;
+            e.flags = p[8];
+            if ((e.flags & HAS_PCR) != 0) {
+                e.pcr = GetUInt48(p + 10);
+            }
+            if ((e.flags & HAS_PTS) != 0) {
+                e.pts = GetUInt40(p + 16) & PTS_DTS_MASK;
+            }
+            if ((e.flags & HAS_DTS) != 0) {
+                e.dts = GetUInt40(p + 21) & PTS_DTS_MASK;
+            }
+            _entries.push_back(e);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,192 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Index of random access points and time stamps in a transport stream file.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTS.h"
+#include "tsReport.h"
+
+namespace ts {
+    //!
+    //! Index of random access points and time stamps in a transport stream file.
+    //! @ingroup mpeg
+    //!
+    //! An index is a compact "sidecar" file which is built in one pass over a
+    //! recorded transport stream (see TSFileIndexer). It contains PCR checkpoints
+    //! and the random access points (start of intra-coded images) with their PTS
+    //! and DTS. It is later used to seek at a given time in the recording without
+    //! reading the file from the beginning.
+    //!
+    //! Binary format of an index file (all integers are big endian):
+    //! - Header (16 bytes): "TSIDX" (5 bytes), format version (1 byte),
+    //!   entry size (1 byte), reserved (1 byte), number of entries (8 bytes).
+    //! - Entries (26 bytes each): packet index (6 bytes), PID (2 bytes),
+    //!   flags (1 byte), reserved (1 byte), PCR (6 bytes), PTS (5 bytes), DTS (5 bytes).
+    //!
+    class TSDUCKDLL TSFileIndex
+    {
+    public:
+        //!
+        //! Default file name suffix of index files, appended to the transport stream file name.
+        //!
+        static const UChar* const DEFAULT_SUFFIX;
+
+        //!
+        //! Flags in an index entry.
+        //!
+        enum : uint8_t {
+            HAS_PCR       = 0x01,  //!< The packet contains a PCR.
+            HAS_PTS       = 0x02,  //!< The packet starts a PES packet with a PTS.
+            HAS_DTS       = 0x04,  //!< The packet starts a PES packet with a DTS.
+            RANDOM_ACCESS = 0x08,  //!< The packet starts a PES packet containing an intra-coded image.
+        };
+
+        //!
+        //! One entry in the index.
+        //!
+        class TSDUCKDLL Entry
+        {
+        public:
+            PacketCounter packet;  //!< Index of the TS packet in the file.
+            PID           pid;     //!< PID of the packet.
+            uint8_t       flags;   //!< Combination of HAS_PCR, HAS_PTS, HAS_DTS, RANDOM_ACCESS.
+            uint64_t      pcr;     //!< PCR value, valid when HAS_PCR is set.
+            uint64_t      pts;     //!< PTS value, valid when HAS_PTS is set.
+            uint64_t      dts;     //!< DTS value, valid when HAS_DTS is set.
+
+            //!
+            //! Default constructor.
+            //!
+            Entry();
+        };
+
+        //!
+        //! Vector of index entries, in increasing order of packet index.
+        //!
+        typedef std::vector<Entry> EntryVector;
+
+        //!
+        //! Default constructor.
+        //!
+        TSFileIndex();
+
+        //!
+        //! Clear the content of the index.
+        //!
+        void clear();
+
+        //!
+        //! Add an entry in the index.
+        //! The entries are kept sorted by packet index. Adding them in increasing order
+        //! of packet index is faster. When an entry already exists for the same packet,
+        //! the two entries are merged.
+        //! @param [in] entry The entry to add.
+        //!
+        void add(const Entry& entry);
+
+        //!
+        //! Get all entries in the index.
+        //! @return A constant reference to the entries.
+        //!
+        const EntryVector& entries() const { return _entries; }
+
+        //!
+        //! Get the duration of the indexed file.
+        //! @return The duration in milliseconds between the first and last PCR of the reference PID
+        //! (the first PID containing PCR's).
+        //!
+        MilliSecond duration() const;
+
+        //!
+        //! Find the packet where to start reading to play a file from a given time.
+        //! @param [in] time Time in milliseconds, relative to the first PCR in the file.
+        //! @param [in] random_access If true, return the last random access point before
+        //! the requested time, if there is one. Otherwise, return the last PCR checkpoint
+        //! before the requested time.
+        //! @return The index of the packet in the file. Zero if the index is empty.
+        //!
+        PacketCounter seekTime(MilliSecond time, bool random_access = true) const;
+
+        //!
+        //! Find the next random access point.
+        //! @param [in] packet Index of a packet in the file.
+        //! @param [in] pid Look for random access points in this PID only. With PID_NULL, use all PID's.
+        //! @return The index of the first random access point at or after @a packet or NPOS if there is none.
+        //!
+        PacketCounter nextRandomAccess(PacketCounter packet, PID pid = PID_NULL) const;
+
+        //!
+        //! Save the index in a binary file.
+        //! @param [in] file_name Name of the index file.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool save(const UString& file_name, Report& report) const;
+
+        //!
+        //! Load the index from a binary file.
+        //! @param [in] file_name Name of the index file.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool load(const UString& file_name, Report& report);
+
+        //!
+        //! Save the index to an output stream.
+        //! @param [in,out] strm A standard stream in output mode (binary mode).
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool save(std::ostream& strm, Report& report) const;
+
+        //!
+        //! Load the index from an input stream.
+        //! @param [in,out] strm A standard stream in input mode (binary mode).
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool load(std::istream& strm, Report& report);
+
+    private:
+        EntryVector _entries;
+
+        // Binary format.
+        static constexpr uint8_t FORMAT_VERSION = 1;
+        static constexpr size_t HEADER_SIZE = 16;
+        static constexpr size_t ENTRY_SIZE = 26;
+
+        // Compute the time of each PCR checkpoint of the reference PID, relative to the first one.
+        // The vector is a list of pairs (time, index in _entries).
+        void pcrTimes(std::vector<std::pair<MilliSecond, size_t>>& times) const;
+    };
+}
@@ -0,0 +1,142 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSFileIndexer.h"
+#include "tsTSPacket.h"
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr ts::MilliSecond ts::TSFileIndexer::DEFAULT_PCR_INTERVAL;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructors.
+//----------------------------------------------------------------------------
+
+ts::TSFileIndexer::TSFileIndexer(DuckContext& duck, TSFileIndex& index, MilliSecond pcr_interval) :
+    _index(index),
+    _pcr_interval(pcr_interval),
+    _packet_count(0),
+    _demux(duck, this),
+    _pids()
+{
+}
+
+ts::TSFileIndexer::PIDContext::PIDContext() :
+    last_pusi(),
+    last_pcr(),
+    indexed_pcr(INVALID_PCR)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Reset the indexer.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndexer::reset()
+{
+    _packet_count = 0;
+    _demux.reset();
+    _pids.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Feed the indexer with one TS packet.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndexer::feedPacket(const TSPacket& pkt)
+{
+    // The demux is fed first: the start of a new PES packet terminates the previous one,
+    // which may then be reported as an intra image, before the new start is recorded.
+    _demux.feedPacket(pkt);
+
+    const PID pid = pkt.getPID();
+    PIDContext& ctx(_pids[pid]);
+
+    if (pkt.hasPCR()) {
+        ctx.last_pcr.packet = _packet_count;
+        ctx.last_pcr.pid = pid;
+        ctx.last_pcr.flags = TSFileIndex::HAS_PCR;
+        ctx.last_pcr.pcr = pkt.getPCR();
+
+        // Record a PCR checkpoint every _pcr_interval milliseconds.
+        if (ctx.indexed_pcr == INVALID_PCR || PCRToMilliSecond(DiffPCR(ctx.indexed_pcr, ctx.last_pcr.pcr)) >= _pcr_interval) {
+            _index.add(ctx.last_pcr);
+            ctx.indexed_pcr = ctx.last_pcr.pcr;
+        }
+    }
+
+    if (pkt.getPUSI()) {
+        ctx.last_pusi = TSFileIndex::Entry();
+        ctx.last_pusi.packet = _packet_count;
+        ctx.last_pusi.pid = pid;
+        if (pkt.hasPTS()) {
+            ctx.last_pusi.flags |= TSFileIndex::HAS_PTS;
+            ctx.last_pusi.pts = pkt.getPTS();
+        }
+        if (pkt.hasDTS()) {
+            ctx.last_pusi.flags |= TSFileIndex::HAS_DTS;
+            ctx.last_pusi.dts = pkt.getDTS();
+        }
+    }
+
+    _packet_count++;
+}
+
+
+//----------------------------------------------------------------------------
+// Invoked by the demux when an intra-coded image is found in a PES packet.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndexer::handleIntraImage(PESDemux&, const PESPacket& packet, size_t)
+{
+    const auto it = _pids.find(packet.sourcePID());
+    if (it != _pids.end() && it->second.last_pusi.packet == packet.firstTSPacketIndex() && it->second.last_pusi.pid == packet.sourcePID()) {
+        TSFileIndex::Entry entry(it->second.last_pusi);
+        entry.flags |= TSFileIndex::RANDOM_ACCESS;
+        _index.add(entry);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Terminate the index after the last packet.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndexer::finish()
+{
+    // Add the last PCR of each PID.
+    for (const auto& it : _pids) {
+        if (it.second.last_pcr.pcr != INVALID_PCR && it.second.last_pcr.pcr != it.second.indexed_pcr) {
+            _index.add(it.second.last_pcr);
+        }
+    }
+}
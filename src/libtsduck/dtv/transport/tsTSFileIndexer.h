@@ -0,0 +1,108 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Build an index of random access points and time stamps in a transport stream.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSFileIndex.h"
+#include "tsPESDemux.h"
+
+namespace ts {
+    //!
+    //! Build an index of random access points and time stamps in a transport stream.
+    //! @ingroup mpeg
+    //!
+    //! The index is built in one single pass over the transport stream. The random
+    //! access points are the starts of PES packets containing intra-coded images,
+    //! as found by PESDemux and the video codec parsers.
+    //!
+    class TSDUCKDLL TSFileIndexer: private PESHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(TSFileIndexer);
+    public:
+        //!
+        //! Default interval between two PCR checkpoints in the index.
+        //!
+        static constexpr MilliSecond DEFAULT_PCR_INTERVAL = 1000;
+
+        //!
+        //! Constructor.
+        //! @param [in,out] duck TSDuck execution context.
+        //! @param [in,out] index The index to build. It is not cleared, new entries are added.
+        //! @param [in] pcr_interval Interval between two PCR checkpoints in the index.
+        //!
+        TSFileIndexer(DuckContext& duck, TSFileIndex& index, MilliSecond pcr_interval = DEFAULT_PCR_INTERVAL);
+
+        //!
+        //! Set the interval between two PCR checkpoints in the index.
+        //! @param [in] pcr_interval Interval between two PCR checkpoints in the index.
+        //!
+        void setPCRInterval(MilliSecond pcr_interval) { _pcr_interval = pcr_interval; }
+
+        //!
+        //! Reset the indexer, restart from the first packet.
+        //!
+        void reset();
+
+        //!
+        //! Feed the indexer with one TS packet.
+        //! @param [in] pkt The TS packet.
+        //!
+        void feedPacket(const TSPacket& pkt);
+
+        //!
+        //! Terminate the index after the last packet.
+        //! The last PCR of each PID is added so that the index covers the complete duration.
+        //!
+        void finish();
+
+    private:
+        // Context of a PID.
+        class PIDContext
+        {
+        public:
+            PIDContext();
+            TSFileIndex::Entry last_pusi;     // Start of last PES packet.
+            TSFileIndex::Entry last_pcr;      // Last PCR in this PID.
+            uint64_t           indexed_pcr;   // Last PCR in the index.
+        };
+
+        TSFileIndex&                   _index;
+        MilliSecond                    _pcr_interval;
+        PacketCounter                  _packet_count;
+        PESDemux                       _demux;
+        std::map<PID, PIDContext>      _pids;
+
+        // Implementation of PESHandlerInterface.
+        virtual void handleIntraImage(PESDemux& demux, const PESPacket& packet, size_t offset) override;
+    };
+}
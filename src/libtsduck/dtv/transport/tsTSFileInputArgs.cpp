@@ -28,6 +28,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsTSFileInputArgs.h"
+#include "tsTSFileIndex.h"
 #include "tsAlgorithm.h"
 
 
@@ -45,6 +46,8 @@ ts::TSFileInputArgs::TSFileInputArgs() :
     _current_file(0),
     _repeat_count(1),
     _start_offset(0),
+    _start_time(-1),
+    _index_file(),
     _base_label(0),
     _file_format(TSPacketFormat::AUTODETECT),
     _filenames(),
@@ -116,11 +119,25 @@ void ts::TSFileInputArgs::defineArgs(Args& args)
               u"For a given file, if the computed label is above the maximum (" +
               UString::Decimal(TSPacketLabelSet::MAX) + u"), its packets are not labelled.");
 
+    args.option(u"index-file", 0, Args::FILENAME);
+    args.help(u"index-file",
+              u"With --start-time, specify the name of the index file. "
+              u"By default, the name of the index is the name of the input file, "
+              u"followed by \"" + UString(TSFileIndex::DEFAULT_SUFFIX) + u"\". "
+              u"This option is allowed only with one input file.");
+
     args.option(u"packet-offset", 'p', Args::UNSIGNED);
     args.help(u"packet-offset",
               u"Start reading each file at the specified TS packet (default: 0). "
               u"This option is allowed only if all input files are regular files.");
 
+    args.option(u"start-time", 0, Args::UNSIGNED);
+    args.help(u"start-time", u"milliseconds",
+              u"Start reading each file at the specified time, relative to its first PCR. "
+              u"Reading starts at the last random access point (intra-coded image) before that time. "
+              u"The seek position is found in an index file which was previously built using the plugin \"index\". "
+              u"This option is allowed only if all input files are regular files.");
+
     args.option(u"repeat", 'r', Args::POSITIVE);
     args.help(u"repeat",
               u"Repeat the playout of each file the specified number of times (default: only once). "
@@ -137,6 +154,8 @@ bool ts::TSFileInputArgs::loadArgs(DuckContext& duck, Args& args)
     args.getValues(_filenames);
     _repeat_count = args.present(u"infinite") ? 0 : args.intValue<size_t>(u"repeat", 1);
     _start_offset = args.intValue<uint64_t>(u"byte-offset", args.intValue<uint64_t>(u"packet-offset", 0) * PKT_SIZE);
+    _start_time = args.intValue<MilliSecond>(u"start-time", -1);
+    args.getValue(_index_file, u"index-file");
     _interleave = args.present(u"interleave");
     _first_terminate = args.present(u"first-terminate");
     args.getIntValue(_interleave_chunk, u"interleave", 1);
@@ -162,6 +181,14 @@ bool ts::TSFileInputArgs::loadArgs(DuckContext& duck, Args& args)
         args.error(u"specifying --infinite is meaningless with more than one file");
         return false;
     }
+    if (_filenames.size() > 1 && !_index_file.empty()) {
+        args.error(u"specifying --index-file is meaningless with more than one file");
+        return false;
+    }
+    if (_start_time >= 0 && (args.present(u"byte-offset") || args.present(u"packet-offset"))) {
+        args.error(u"--start-time, --byte-offset and --packet-offset are mutually exclusive");
+        return false;
+    }
 
     // Make sure start and stop stuffing vectors have the same size as the file vector.
     // If the vectors must be enlarged, repeat the last value in the array.
@@ -191,8 +218,24 @@ bool ts::TSFileInputArgs::openFile(size_t name_index, size_t file_index, Report&
     // Preset artificial stuffing.
     _files[file_index].setStuffing(_start_stuffing[name_index], _stop_stuffing[name_index]);
 
+    // With --start-time, compute the start offset from the index of the file.
+    uint64_t start_offset = _start_offset;
+    if (_start_time >= 0) {
+        if (name.empty()) {
+            report.error(u"--start-time cannot be used with the standard input");
+            return false;
+        }
+        TSFileIndex index;
+        if (!index.load(_index_file.empty() ? name + TSFileIndex::DEFAULT_SUFFIX : _index_file, report)) {
+            return false;
+        }
+        const PacketCounter packet = index.seekTime(_start_time);
+        report.debug(u"start time %'d ms in %s, starting at packet %'d", {_start_time, name, packet});
+        start_offset = packet * PKT_SIZE;
+    }
+
     // Actually open the file.
-    return _files[file_index].openRead(name, _repeat_count, _start_offset, report, _file_format);
+    return _files[file_index].openRead(name, _repeat_count, start_offset, report, _file_format);
 }
 
 
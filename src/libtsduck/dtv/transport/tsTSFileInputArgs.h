@@ -111,6 +111,8 @@ namespace ts {
         size_t              _current_file;       // Current file index in _files. Depends on _interleave.
         size_t              _repeat_count;
         uint64_t            _start_offset;
+        MilliSecond         _start_time;         // Start time in each file, using its index, negative if unused.
+        UString             _index_file;         // Index file name with --start-time, default is input name + suffix.
         size_t              _base_label;
         TSPacketFormat      _file_format;
         UStringVector       _filenames;
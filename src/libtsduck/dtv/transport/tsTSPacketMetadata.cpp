@@ -42,6 +42,7 @@ constexpr uint8_t ts::TSPacketMetadata::SERIALIZATION_MAGIC;
 
 ts::TSPacketMetadata::TSPacketMetadata() :
     _input_time(INVALID_PCR),
+    _output_time(-1),
     _labels(),
     _time_source(TimeSource::UNDEFINED),
     _flush(false),
@@ -61,6 +62,7 @@ ts::TSPacketMetadata::TSPacketMetadata() :
 void ts::TSPacketMetadata::reset()
 {
     _input_time = INVALID_PCR;
+    _output_time = -1;
     _labels.reset();
     _flush = false;
     _bitrate_changed = false;
@@ -177,6 +179,7 @@ bool ts::TSPacketMetadata::deserialize(const void* bin, size_t size)
     }
 
     _input_time = size >= 9 ? GetUInt64(data + 1) : INVALID_PCR;
+    _output_time = -1;
     if (size >= 13) {
         _labels = TSPacketLabelSet(GetUInt32(data + 9));
     }
@@ -229,5 +232,6 @@ void ts::TSPacketMetadata::DisplayLayout(std::ostream& out, const char* prefix)
         << prefix << "sizeof(var): " << sizeof(var) << " bytes" << std::endl
         << prefix << "_time_source: offset: " << offsetof(TSPacketMetadata, _time_source) << " bytes, size: " << sizeof(var._time_source) << " bytes" << std::endl
         << prefix << "_labels: offset: " << offsetof(TSPacketMetadata, _labels) << " bytes, size: " << sizeof(var._labels) << " bytes" << std::endl
-        << prefix << "_input_time: offset: " << offsetof(TSPacketMetadata, _input_time) << " bytes, size: " << sizeof(var._input_time) << " bytes" << std::endl;
+        << prefix << "_input_time: offset: " << offsetof(TSPacketMetadata, _input_time) << " bytes, size: " << sizeof(var._input_time) << " bytes" << std::endl
+        << prefix << "_output_time: offset: " << offsetof(TSPacketMetadata, _output_time) << " bytes, size: " << sizeof(var._output_time) << " bytes" << std::endl;
 }
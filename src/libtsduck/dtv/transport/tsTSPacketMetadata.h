@@ -252,6 +252,33 @@ namespace ts {
         //!
         UString inputTimeStampString(const UString& none = u"none") const;
 
+        //!
+        //! Get the optional output time stamp of the packet.
+        //! The output time stamp is the time at which the packet should be sent. It is typically
+        //! set by a regulation plugin. Output plugins which support paced transmission may use it.
+        //! It is not serialized since it depends on a local clock.
+        //! @return The output time stamp in nanoseconds on the ts::Monotonic clock (see
+        //! ts::Monotonic::nanoSeconds()) or a negative value if there is none.
+        //!
+        NanoSecond getOutputTimeStamp() const { return _output_time; }
+
+        //!
+        //! Check if the packet has an output time stamp.
+        //! @return True if the packet has an output time stamp.
+        //!
+        bool hasOutputTimeStamp() const { return _output_time >= 0; }
+
+        //!
+        //! Set the output time stamp of the packet.
+        //! @param [in] ns Output time stamp in nanoseconds on the ts::Monotonic clock.
+        //!
+        void setOutputTimeStamp(NanoSecond ns) { _output_time = ns; }
+
+        //!
+        //! Clear the output time stamp.
+        //!
+        void clearOutputTimeStamp() { _output_time = -1; }
+
         //!
         //! Copy contiguous TS packet metadata.
         //! @param [out] dest Address of the first contiguous TS packet metadata to write.
@@ -320,6 +347,7 @@ namespace ts {
 
     private:
         uint64_t         _input_time;           // 64 bits: Input timestamp in PCR units, INVALID_PCR if unknown.
+        NanoSecond       _output_time;          // 64 bits: Output timestamp on the monotonic clock, negative if unknown.
         TSPacketLabelSet _labels;               // 32 bits: Bit mask of labels.
         TimeSource       _time_source;          // 8 bits: Source for time stamps.
         bool             _flush : 1;            // Flush the packet buffer asap.
@@ -56,6 +56,27 @@ ts::TSPControlCommand::TSPControlCommand(Report& report) :
 
     arg = command(u"list", u"List all running plugins", u"[options]", flags);
 
+    arg = command(u"stats", u"Display performance statistics of the plugins", u"[options] [plugin-index]", flags | Args::NO_VERBOSE);
+    arg->setIntro(u"Display performance statistics of the plugins since their start or since the last reset: "
+                  u"number of processed packets, processing time per packet and per window of packets, "
+                  u"waiting time for packets from the previous plugin and number of packets which were "
+                  u"waiting in the buffer for the plugin. The durations are displayed as percentiles.");
+    arg->option(u"", 0, Args::UNSIGNED, 0, 1);
+    arg->help(u"", u"Index of the plugin to display. By default, display all plugins.");
+    arg->option(u"json", 'j');
+    arg->help(u"json", u"Display the statistics in JSON format. All durations are in nanoseconds.");
+    arg->option(u"reset", 'r');
+    arg->help(u"reset", u"Reset the statistics after displaying them.");
+
+    arg = command(u"allocations", u"Display memory allocation counters", u"[options]", flags | Args::NO_VERBOSE);
+    arg->setIntro(u"Display the number of memory allocations and allocated bytes per thread and per subsystem. "
+                  u"The counters are available only when tsp runs with option --allocation-tracking "
+                  u"and TSDuck was compiled with allocation tracking.");
+    arg->option(u"json", 'j');
+    arg->help(u"json", u"Display the counters in JSON format.");
+    arg->option(u"reset", 'r');
+    arg->help(u"reset", u"Reset the counters after displaying them.");
+
     arg = command(u"suspend", u"Suspend a plugin", u"[options] plugin-index", flags);
     arg->setIntro(u"Suspend a plugin. When a packet processing plugin is suspended, "
                   u"the TS packets are directly passed from the previous to the next plugin, "
@@ -32,8 +32,10 @@
 #include "tstspOutputExecutor.h"
 #include "tstspProcessorExecutor.h"
 #include "tstspControlServer.h"
+#include "tstspMetricsExporter.h"
 #include "tsMonotonic.h"
 #include "tsGuardMutex.h"
+#include "tsAllocationTracker.h"
 
 
 //----------------------------------------------------------------------------
@@ -49,8 +51,21 @@ ts::TSProcessor::TSProcessor(Report& report) :
     _input(nullptr),
     _output(nullptr),
     _control(nullptr),
+    _metrics(nullptr),
     _packet_buffer(nullptr),
-    _metadata_buffer(nullptr)
+    _metadata_buffer(nullptr),
+    _final_stats()
+{
+}
+
+ts::TSProcessor::PluginStatistics::PluginStatistics() :
+    name(),
+    type(PluginType::PROCESSOR),
+    packets(0),
+    work_ns(0),
+    wait_ns(0),
+    packet_p50_ns(0),
+    packet_p99_ns(0)
 {
 }
 
@@ -67,13 +82,17 @@ ts::TSProcessor::~TSProcessor()
 
 void ts::TSProcessor::cleanupInternal()
 {
-    // Terminate and delete the control server.
-    // This must be done first since the control server accesses the plugin executors.
+    // Terminate and delete the control server and the metrics exporter.
+    // This must be done first since they access the plugin executors.
     if (_control != nullptr) {
         // Deleting the object terminates the server thread.
         delete _control;
         _control = nullptr;
     }
+    if (_metrics != nullptr) {
+        delete _metrics;
+        _metrics = nullptr;
+    }
 
     // Abort and wait for threads to terminate
     tsp::PluginExecutor* proc = _input;
@@ -133,6 +152,16 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         // Clear errors on the report, used to check further initialisation errors.
         _report.resetErrors();
 
+        // Start counting allocations when requested.
+        if (_args.alloc_tracking) {
+            if (AllocationTracker::Enable()) {
+                AllocationTracker::Reset();
+            }
+            else {
+                _report.warning(u"allocation tracking is not supported, rebuild TSDuck with ALLOCTRACKING=1");
+            }
+        }
+
         // Load all plugins and analyze their command line arguments.
         // The first plugin is always the input and the last one is the output.
         // The input thread has the highest priority to be always ready to load
@@ -241,6 +270,11 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
     CheckNonNull(_control);
     _control->open();
 
+    // Same thing for the metrics exporter.
+    _metrics = new tsp::MetricsExporter(_args, _report, _input);
+    CheckNonNull(_metrics);
+    _metrics->open();
+
     return true;
 }
 
@@ -293,6 +327,30 @@ void ts::TSProcessor::waitForTermination()
 
         // Make sure the control server thread is terminated before deleting plugins.
         _control->close();
+        _metrics->close();
+
+        // Keep the final statistics of all plugins.
+        _final_stats.clear();
+        proc = _input;
+        do {
+            tsp::PluginExecutor::Statistics stats;
+            proc->getStatistics(stats, false);
+            _final_stats.resize(_final_stats.size() + 1);
+            PluginStatistics& ps(_final_stats.back());
+            ps.name = proc->pluginName();
+            ps.type = proc == _input ? PluginType::INPUT : (proc == _output ? PluginType::OUTPUT : PluginType::PROCESSOR);
+            ps.packets = stats.packets;
+            ps.work_ns = stats.work_ns;
+            ps.wait_ns = stats.wait_ns;
+            ps.packet_p50_ns = stats.packet.percentile(50.0);
+            ps.packet_p99_ns = stats.packet.percentile(99.0);
+        } while ((proc = proc->ringNext<tsp::PluginExecutor>()) != _input);
+
+        // Report allocations before deallocating the plugins.
+        if (_args.alloc_tracking && AllocationTracker::IsEnabled()) {
+            AllocationTracker::Enable(false);
+            AllocationTracker::Display(_report);
+        }
 
         // Deallocate all plugins and plugin executor
         cleanupInternal();
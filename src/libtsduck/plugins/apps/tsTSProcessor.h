@@ -46,6 +46,7 @@ namespace ts {
         class InputExecutor;
         class OutputExecutor;
         class ControlServer;
+        class MetricsExporter;
     }
     //! @endcond
 
@@ -104,6 +105,30 @@ namespace ts {
         //!
         void waitForTermination();
 
+        //!
+        //! Final performance statistics of one plugin.
+        //!
+        class TSDUCKDLL PluginStatistics
+        {
+        public:
+            PluginStatistics();                //!< Constructor.
+            UString       name;                //!< Plugin name.
+            PluginType    type;                //!< Plugin type.
+            PacketCounter packets;             //!< Number of processed packets.
+            NanoSecond    work_ns;             //!< Total processing time.
+            NanoSecond    wait_ns;             //!< Total waiting time for packets.
+            NanoSecond    packet_p50_ns;       //!< Median processing time per packet (per window of packets).
+            NanoSecond    packet_p99_ns;       //!< 99th percentile processing time per packet (per window of packets).
+        };
+
+        //!
+        //! Get the performance statistics of all plugins after the end of the processing.
+        //! The statistics are collected by waitForTermination().
+        //! @param [out] stats Statistics of all plugins, input, packet processors, output.
+        //! Empty if the processing was never started or is not yet terminated.
+        //!
+        void getPluginStatistics(std::vector<PluginStatistics>& stats) const { stats = _final_stats; }
+
     private:
         // There is one global mutex for protected operations.
         // The resulting bottleneck of this single mutex is acceptable as long
@@ -116,8 +141,10 @@ namespace ts {
         tsp::InputExecutor*   _input;            // Input processor execution thread.
         tsp::OutputExecutor*  _output;           // Output processor execution thread.
         tsp::ControlServer*   _control;          // TSP control command server thread.
+        tsp::MetricsExporter* _metrics;          // TSP metrics HTTP server.
         PacketBuffer*         _packet_buffer;    // Global TS packet buffer.
         PacketMetadataBuffer* _metadata_buffer;  // Global packet metabata buffer.
+        std::vector<PluginStatistics> _final_stats;  // Statistics of all plugins after termination.
 
         // Deallocate and cleanup internal resources.
         void cleanupInternal();
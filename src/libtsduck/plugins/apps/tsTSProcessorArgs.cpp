@@ -43,6 +43,7 @@ constexpr size_t ts::TSProcessorArgs::MIN_BUFFER_SIZE;
 #define DEF_MAX_INPUT_PKT_OFL              0  // packets
 #define DEF_MAX_INPUT_PKT_RT            1000  // packets
 #define DEF_CONTROL_TIMEOUT             5000  // milliseconds
+#define DEF_METRICS_INTERVAL            5000  // milliseconds
 
 
 //----------------------------------------------------------------------------
@@ -53,6 +54,7 @@ ts::TSProcessorArgs::TSProcessorArgs() :
     app_name(),
     ignore_jt(false),
     log_plugin_index(false),
+    alloc_tracking(false),
     ts_buffer_size(DEFAULT_BUFFER_SIZE),
     max_flush_pkt(0),
     max_input_pkt(0),
@@ -73,6 +75,9 @@ ts::TSProcessorArgs::TSProcessorArgs() :
     control_reuse(false),
     control_sources(),
     control_timeout(DEF_CONTROL_TIMEOUT),
+    metrics_port(0),
+    metrics_local(),
+    metrics_interval(DEF_METRICS_INTERVAL),
     duck_args(),
     input(),
     plugins(),
@@ -112,6 +117,12 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"Specify the input bitrate, in bits/seconds. By default, the input "
               u"bitrate is provided by the input plugin or by analysis of the PCR.");
 
+    args.option(u"allocation-tracking");
+    args.help(u"allocation-tracking",
+              u"Count the memory allocations per thread and per subsystem and report them at the end of the processing. "
+              u"The counters can also be displayed at any time using the control command 'allocations'. "
+              u"This option is effective only when TSDuck was compiled with allocation tracking (make ALLOCTRACKING=1).");
+
     args.option(u"bitrate-adjust-interval", 0, Args::POSITIVE);
     args.help(u"bitrate-adjust-interval",
               u"Specify the interval in seconds between bitrate adjustments, "
@@ -214,6 +225,24 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"This option is useful only when an output plugin or device has problems with large output requests. "
               u"This option forces multiple smaller send operations.");
 
+    args.option(u"metrics-interval", 0, Args::POSITIVE);
+    args.help(u"metrics-interval", u"milliseconds",
+              u"With --metrics-port, specify the interval in milliseconds between two snapshots of the metrics. "
+              u"The metrics are not computed when they are requested, the last snapshot is returned. "
+              u"The default interval is " TS_STRINGIFY(DEF_METRICS_INTERVAL) u" ms.");
+
+    args.option(u"metrics-local", 0, Args::STRING);
+    args.help(u"metrics-local", u"address",
+              u"With --metrics-port, specify the IP address of the local interface on which to listen for metrics requests. "
+              u"It can be also a host name that translates to a local address. "
+              u"By default, listen on all local interfaces.");
+
+    args.option(u"metrics-port", 0, Args::UINT16);
+    args.help(u"metrics-port",
+              u"Specify the TCP port on which tsp serves operational metrics over HTTP, "
+              u"in Prometheus text format, on the path /metrics. "
+              u"If unspecified, no metrics are exported.");
+
     args.option(u"realtime", 'r', Args::TRISTATE, 0, 1, -255, 256, true);
     args.help(u"realtime",
               u"Specifies if tsp and all plugins should use default values for real-time "
@@ -234,6 +263,7 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
 {
     app_name = args.appName();
     log_plugin_index = args.present(u"log-plugin-index");
+    alloc_tracking = args.present(u"allocation-tracking");
     ts_buffer_size = args.intValue<size_t>(u"buffer-size-mb", DEFAULT_BUFFER_SIZE);
     args.getValue(fixed_bitrate, u"bitrate", 0);
     bitrate_adj = MilliSecPerSec * args.intValue(u"bitrate-adjust-interval", DEF_BITRATE_INTERVAL);
@@ -250,6 +280,8 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(control_port, u"control-port", 0);
     args.getIntValue(control_timeout, u"control-timeout", DEF_CONTROL_TIMEOUT);
     control_reuse = args.present(u"control-reuse-port");
+    args.getIntValue(metrics_port, u"metrics-port", 0);
+    args.getIntValue(metrics_interval, u"metrics-interval", DEF_METRICS_INTERVAL);
 
     // Convert MB in MiB for buffer size for compatibility with original versions.
     ts_buffer_size = size_t((uint64_t(ts_buffer_size) * 1024 * 1024) / 1000000);
@@ -262,6 +294,13 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
         control_local.resolve(args.value(u"control-local"), args);
     }
 
+    if (!args.present(u"metrics-local")) {
+        metrics_local.clear();
+    }
+    else {
+        metrics_local.resolve(args.value(u"metrics-local"), args);
+    }
+
     // Get and resolve optional allowed remote addresses.
     control_sources.clear();
     if (!args.present(u"control-source")) {
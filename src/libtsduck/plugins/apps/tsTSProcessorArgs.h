@@ -51,6 +51,7 @@ namespace ts {
         UString           app_name;         //!< Application name, for help messages.
         bool              ignore_jt;        //!< Ignore "joint termination" options in plugins.
         bool              log_plugin_index; //!< Log plugin index with plugin name.
+        bool              alloc_tracking;   //!< Count memory allocations and report them at end of processing.
         size_t            ts_buffer_size;   //!< Size in bytes of the global TS packet buffer.
         size_t            max_flush_pkt;    //!< Max processed packets before flush.
         size_t            max_input_pkt;    //!< Max packets per input operation.
@@ -71,6 +72,9 @@ namespace ts {
         bool              control_reuse;    //!< Set the 'reuse port' socket option on the control TCP server port.
         IPv4AddressVector control_sources;  //!< Remote IP addresses which are allowed to send control commands.
         MilliSecond       control_timeout;  //!< Reception timeout in milliseconds for control commands.
+        uint16_t          metrics_port;     //!< TCP server port for the HTTP metrics exporter.
+        IPv4Address       metrics_local;    //!< Local interface on which to listen for metrics requests.
+        MilliSecond       metrics_interval; //!< Interval in milliseconds between two snapshots of the metrics.
         DuckContext::SavedArgs duck_args;   //!< Default TSDuck context options for all plugins. Each plugin can override them in its context.
         PluginOptions          input;       //!< Input plugin description.
         PluginOptionsVector    plugins;     //!< Packet processor plugins descriptions.
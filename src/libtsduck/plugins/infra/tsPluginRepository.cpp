@@ -32,6 +32,7 @@
 #include "tsAlgorithm.h"
 #include "tsCerrReport.h"
 #include "tsFileUtils.h"
+#include "tsStartupProfile.h"
 
 TS_DEFINE_SINGLETON(ts::PluginRepository);
 
@@ -135,6 +136,7 @@ FACTORY ts::PluginRepository::getFactory(const UString& plugin_name, const UStri
         // the shareable image in memory after returning from this function. Also make
         // sure to include the plugin's directory in the shared library search path:
         // an extension may install a library in the same directory as the plugin.
+        StartupProfile::Phase phase(u"plugin shared library loading");
         ApplicationSharedLibrary shlib(plugin_name, u"tsplugin_", TS_PLUGINS_PATH, SharedLibraryFlags::PERMANENT, report);
         if (shlib.isLoaded()) {
             // Search again if the shareable library was loaded.
@@ -235,6 +237,8 @@ void ts::PluginRepository::loadAllPlugins(Report& report)
         return;
     }
 
+    StartupProfile::Phase phase(u"all plugins loading");
+
     // Get list of shared library files
     UStringVector files;
     ApplicationSharedLibrary::GetPluginList(files, u"tsplugin_", TS_PLUGINS_PATH);
@@ -85,6 +85,12 @@ namespace ts {
         //!
         void setLogName(const UString& name) { _logname = name; }
 
+        //!
+        //! Get the plugin name as displayed in log messages.
+        //! @return The plugin name as displayed in log messages.
+        //!
+        UString logName() const { return _logname.empty() ? _name : _logname; }
+
         // Implementation of TSP virtual methods.
         virtual UString pluginName() const override;
         virtual Plugin* plugin() const override;
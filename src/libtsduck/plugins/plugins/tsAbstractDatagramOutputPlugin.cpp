@@ -63,7 +63,8 @@ ts::AbstractDatagramOutputPlugin::AbstractDatagramOutputPlugin(TSP* tsp_, const
     _rtp_pcr_offset(0),
     _pkt_count(0),
     _out_count(0),
-    _out_buffer()
+    _out_buffer(),
+    _out_time(-1)
 {
     option(u"enforce-burst", 'e');
     help(u"enforce-burst",
@@ -181,7 +182,7 @@ bool ts::AbstractDatagramOutputPlugin::stop()
     // Flush incomplete datagram, if any.
     bool success = true;
     if (_out_count > 0) {
-        success = sendPackets(_out_buffer.data(), _out_count);
+        success = sendPackets(_out_buffer.data(), _out_count, _out_time);
         _out_count = 0;
     }
     return success;
@@ -208,12 +209,13 @@ bool ts::AbstractDatagramOutputPlugin::send(const TSPacket* pkt, const TSPacketM
         const size_t count = std::min(packet_count, _pkt_burst - _out_count);
         TSPacket::Copy(&_out_buffer[_out_count], pkt, count);
         pkt += count;
+        pkt_data += count;
         packet_count -= count;
         _out_count += count;
 
         // Send the output buffer when full.
         if (_out_count == _pkt_burst) {
-            if (!sendPackets(_out_buffer.data(), _out_count)) {
+            if (!sendPackets(_out_buffer.data(), _out_count, _out_time)) {
                 return false;
             }
             _out_count = 0;
@@ -223,10 +225,11 @@ bool ts::AbstractDatagramOutputPlugin::send(const TSPacket* pkt, const TSPacketM
     // Send subsequent packets from the global buffer.
     while (packet_count >= min_burst) {
         size_t count = std::min(packet_count, _pkt_burst);
-        if (!sendPackets(pkt, count)) {
+        if (!sendPackets(pkt, count, pkt_data->getOutputTimeStamp())) {
             return false;
         }
         pkt += count;
+        pkt_data += count;
         packet_count -= count;
     }
 
@@ -237,6 +240,7 @@ bool ts::AbstractDatagramOutputPlugin::send(const TSPacket* pkt, const TSPacketM
         assert(packet_count < _pkt_burst);
         TSPacket::Copy(_out_buffer.data(), pkt, packet_count);
         _out_count = packet_count;
+        _out_time = pkt_data->getOutputTimeStamp();
     }
     return true;
 }
@@ -246,7 +250,7 @@ bool ts::AbstractDatagramOutputPlugin::send(const TSPacket* pkt, const TSPacketM
 // Send contiguous packets in one single datagram.
 //----------------------------------------------------------------------------
 
-bool ts::AbstractDatagramOutputPlugin::sendPackets(const TSPacket* pkt, size_t packet_count)
+bool ts::AbstractDatagramOutputPlugin::sendPackets(const TSPacket* pkt, size_t packet_count, NanoSecond due)
 {
     bool status = true;
 
@@ -351,7 +355,7 @@ bool ts::AbstractDatagramOutputPlugin::sendPackets(const TSPacket* pkt, size_t p
             ::memcpy(buf, pkt, packet_count * PKT_SIZE);
             buffer.resize(RTP_HEADER_SIZE + packet_count * PKT_SIZE);
         }
-        status = sendDatagram(buffer.data(), buffer.size());
+        status = sendTimedDatagram(buffer.data(), buffer.size(), due);
     }
     else if (_rs204_format) {
         // No RTP header, add TS trailer after each packet. Since the default initial value
@@ -362,11 +366,11 @@ bool ts::AbstractDatagramOutputPlugin::sendPackets(const TSPacket* pkt, size_t p
             ::memcpy(buf, pkt++, PKT_SIZE);
             buf += PKT_SIZE + RS_SIZE;
         }
-        status = sendDatagram(buffer.data(), buffer.size());
+        status = sendTimedDatagram(buffer.data(), buffer.size(), due);
     }
     else {
         // No RTP, send TS packets directly as datagram.
-        status = sendDatagram(pkt, packet_count * PKT_SIZE);
+        status = sendTimedDatagram(pkt, packet_count * PKT_SIZE, due);
     }
 
     // Count packets datagram per datagram.
@@ -374,3 +378,13 @@ bool ts::AbstractDatagramOutputPlugin::sendPackets(const TSPacket* pkt, size_t p
 
     return status;
 }
+
+
+//----------------------------------------------------------------------------
+// Send a datagram message with a transmission time, default implementation.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDatagramOutputPlugin::sendTimedDatagram(const void* address, size_t size, NanoSecond due)
+{
+    return sendDatagram(address, size);
+}
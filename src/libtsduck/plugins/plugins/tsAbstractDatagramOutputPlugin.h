@@ -98,6 +98,18 @@ namespace ts {
         //!
         virtual bool sendDatagram(const void* address, size_t size) = 0;
 
+        //!
+        //! Send a datagram message with a transmission time.
+        //! The default implementation ignores the transmission time and invokes sendDatagram().
+        //! Subclasses which can defer the transmission (kernel pacing for instance) override it.
+        //! @param [in] address Address of datagram.
+        //! @param [in] size Size in bytes of datagram.
+        //! @param [in] due Output time stamp of the first packet in the datagram, in nanoseconds
+        //! on the monotonic clock (see TSPacketMetadata::getOutputTimeStamp()). Negative if none.
+        //! @return True on success, false on error.
+        //!
+        virtual bool sendTimedDatagram(const void* address, size_t size, NanoSecond due);
+
     private:
         // Configuration and command line options.
         const Options  _flags;              // Configuration flags.
@@ -123,8 +135,9 @@ namespace ts {
         PacketCounter  _pkt_count;          // Total packet counter for output packets
         size_t         _out_count;          // Number of packets in _out_buffer
         TSPacketVector _out_buffer;         // Buffered packets for output with --enforce-burst
+        NanoSecond     _out_time;           // Output time stamp of first packet in _out_buffer
 
-        // Send a buffer of TS packets.
-        bool sendPackets(const TSPacket* packet, size_t count);
+        // Send a buffer of TS packets. The due time is the output time stamp of the first packet.
+        bool sendPackets(const TSPacket* packet, size_t count, NanoSecond due);
     };
 }
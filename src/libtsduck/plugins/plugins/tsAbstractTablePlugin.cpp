@@ -60,6 +60,9 @@ ts::AbstractTablePlugin::AbstractTablePlugin(TSP* tsp_,
     _pzer(duck, pid),
     _patch_xml(duck)
 {
+    // The same tables are repeatedly sent, packetize them only once.
+    _pzer.setPacketCache(true);
+
     _patch_xml.defineArgs(*this);
 
     option<BitRate>(u"bitrate", 'b');
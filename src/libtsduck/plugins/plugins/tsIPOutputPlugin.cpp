@@ -47,6 +47,7 @@ ts::IPOutputPlugin::IPOutputPlugin(TSP* tsp_) :
     _tos(-1),
     _mc_loopback(true),
     _force_mc_local(false),
+    _pacing(false),
     _sock(false, *tsp_)
 {
     option(u"", 0, STRING, 1, 1);
@@ -84,6 +85,14 @@ ts::IPOutputPlugin::IPOutputPlugin(TSP* tsp_) :
          u"Specify the local UDP source port for outgoing packets. "
          u"By default, a random source port is used.");
 
+    option(u"pacing");
+    help(u"pacing",
+         u"Let the kernel send each datagram at the output time stamp of its first TS packet. "
+         u"The output time stamps are set by a previous plugin such as 'regulate'. "
+         u"Datagrams without output time stamp are sent immediately. "
+         u"This option is currently supported on Linux only (socket option SO_TXTIME) "
+         u"and requires the 'fq' queuing discipline on the output interface.");
+
     option(u"rs204");
     help(u"rs204",
          u"Use 204-byte format for TS packets in UDP datagrams. "
@@ -131,6 +140,7 @@ bool ts::IPOutputPlugin::getOptions()
     getIntValue(_tos, u"tos", -1);
     _mc_loopback = !present(u"disable-multicast-loop");
     _force_mc_local = present(u"force-local-multicast-outgoing");
+    _pacing = present(u"pacing");
     setRS204Format(present(u"rs204"));
 
     return success;
@@ -156,7 +166,8 @@ bool ts::IPOutputPlugin::start()
         !_sock.setMulticastLoop(_mc_loopback, *tsp) ||
         (_force_mc_local && _destination.isMulticast() && _local_addr.hasAddress() && !_sock.setOutgoingMulticast(_local_addr, *tsp)) ||
         (_tos >= 0 && !_sock.setTOS(_tos, *tsp)) ||
-        (_ttl > 0 && !_sock.setTTL(_ttl, *tsp)))
+        (_ttl > 0 && !_sock.setTTL(_ttl, *tsp)) ||
+        (_pacing && !_sock.setTransmitTime(true, *tsp)))
     {
         _sock.close(*tsp);
         return false;
@@ -186,3 +197,8 @@ bool ts::IPOutputPlugin::sendDatagram(const void* address, size_t size)
 {
     return _sock.send(address, size, *tsp);
 }
+
+bool ts::IPOutputPlugin::sendTimedDatagram(const void* address, size_t size, NanoSecond due)
+{
+    return _sock.sendAt(address, size, due, *tsp);
+}
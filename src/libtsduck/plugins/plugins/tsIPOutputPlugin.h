@@ -60,6 +60,7 @@ namespace ts {
     protected:
         // Implementation of AbstractDatagramOutputPlugin
         virtual bool sendDatagram(const void* address, size_t size) override;
+        virtual bool sendTimedDatagram(const void* address, size_t size, NanoSecond due) override;
 
     private:
         IPv4SocketAddress _destination;     // Destination address/port.
@@ -69,6 +70,7 @@ namespace ts {
         int               _tos;             // Type of service option.
         bool              _mc_loopback;     // Multicast loopback option
         bool              _force_mc_local;  // Force multicast outgoing local interface
+        bool              _pacing;          // Kernel pacing using output time stamps
         UDPSocket         _sock;            // Outgoing socket
     };
 }
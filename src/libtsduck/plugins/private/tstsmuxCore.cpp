@@ -478,7 +478,7 @@ bool ts::tsmux::Core::Input::getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data
     if (_next_insertion > 0) {
         if (_next_insertion <= _core._output_packets) {
             // It is now time to return that packet.
-            _core._log.debug(u"input #%d, PID 0x%X (%<d), output packet %'d, restarting insertion", {_plugin_index, _next_packet.getPID(), _core._output_packets});
+            TS_DEBUG(_core._log, u"input #%d, PID 0x%X (%<d), output packet %'d, restarting insertion", {_plugin_index, _next_packet.getPID(), _core._output_packets});
             _next_insertion = 0;
             pkt = _next_packet;
             pkt_data = _next_metadata;
@@ -538,7 +538,7 @@ bool ts::tsmux::Core::Input::getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data
                     const PacketCounter target_packet = clock->second.pcr_packet + PacketDistanceFromPCR(_core._bitrate, DiffPCR(clock->second.pcr_value, packet_pcr));
                     if (target_packet > _core._output_packets) {
                         // This packet will be inserted later.
-                        _core._log.debug(u"input #%d, PID 0x%X (%<d), output packet %'d, delay packet by %'d packets", {_plugin_index, pid, _core._output_packets, target_packet - _core._output_packets});
+                        TS_DEBUG(_core._log, u"input #%d, PID 0x%X (%<d), output packet %'d, delay packet by %'d packets", {_plugin_index, pid, _core._output_packets, target_packet - _core._output_packets});
                         _next_insertion = target_packet;
                         _next_packet = pkt;
                         _next_metadata = pkt_data;
@@ -35,6 +35,8 @@
 #include "tsTelnetConnection.h"
 #include "tsGuardMutex.h"
 #include "tsSysUtils.h"
+#include "tsjsonObject.h"
+#include "tsAllocationTracker.h"
 
 
 //----------------------------------------------------------------------------
@@ -75,6 +77,8 @@ ts::tsp::ControlServer::ControlServer(TSProcessorArgs& options, Report& log, Mut
     _reference.setCommandLineHandler(this, &ControlServer::executeExit, u"exit");
     _reference.setCommandLineHandler(this, &ControlServer::executeSetLog, u"set-log");
     _reference.setCommandLineHandler(this, &ControlServer::executeList, u"list");
+    _reference.setCommandLineHandler(this, &ControlServer::executeStats, u"stats");
+    _reference.setCommandLineHandler(this, &ControlServer::executeAllocations, u"allocations");
     _reference.setCommandLineHandler(this, &ControlServer::executeSuspend, u"suspend");
     _reference.setCommandLineHandler(this, &ControlServer::executeResume, u"resume");
     _reference.setCommandLineHandler(this, &ControlServer::executeRestart, u"restart");
@@ -269,6 +273,100 @@ void ts::tsp::ControlServer::listOnePlugin(size_t index, UChar type, PluginExecu
 }
 
 
+//----------------------------------------------------------------------------
+// Stats command.
+//----------------------------------------------------------------------------
+
+ts::CommandStatus ts::tsp::ControlServer::executeStats(const UString& command, Args& args)
+{
+    const bool reset = args.present(u"reset");
+    const size_t index = args.intValue<size_t>(u"", NPOS);
+    SafePtr<json::Array> json(args.present(u"json") ? new json::Array : nullptr);
+
+    if (index != NPOS && index > _plugins.size() + 1) {
+        args.error(u"invalid plugin index %d, specify 0 to %d", {index, _plugins.size() + 1});
+        return CommandStatus::ERROR;
+    }
+    if (index == NPOS || index == 0) {
+        statsOnePlugin(0, u'I', _input, reset, args, json.pointer());
+    }
+    for (size_t i = 0; i < _plugins.size(); ++i) {
+        if (index == NPOS || index == i + 1) {
+            statsOnePlugin(i + 1, u'P', _plugins[i], reset, args, json.pointer());
+        }
+    }
+    if (index == NPOS || index == _plugins.size() + 1) {
+        statsOnePlugin(_plugins.size() + 1, u'O', _output, reset, args, json.pointer());
+    }
+    if (!json.isNull()) {
+        args.info(json->printed());
+    }
+    return CommandStatus::SUCCESS;
+}
+
+void ts::tsp::ControlServer::statsOnePlugin(size_t index, UChar type, PluginExecutor* plugin, bool reset, Report& report, json::Array* json)
+{
+    PluginExecutor::Statistics stats;
+    plugin->getStatistics(stats, reset);
+    const NanoSecond duration = Monotonic(true) - stats.start;
+    const PacketCounter rate = duration <= 0 ? 0 : PacketCounter((stats.packets * NanoSecPerSec) / duration);
+    const NanoSecond per_packet = stats.packets == 0 ? 0 : stats.work_ns / NanoSecond(stats.packets);
+
+    if (json != nullptr) {
+        json::ValuePtr jplugin(new json::Object);
+        jplugin->add(u"index", int64_t(index));
+        jplugin->add(u"type", UString(1, type));
+        jplugin->add(u"name", plugin->pluginName());
+        jplugin->add(u"duration", duration);
+        jplugin->add(u"packets", int64_t(stats.packets));
+        jplugin->add(u"packets-per-second", int64_t(rate));
+        jplugin->add(u"work", stats.work_ns);
+        jplugin->add(u"wait", stats.wait_ns);
+        jplugin->add(u"ns-per-packet", per_packet);
+        jplugin->query(u"queue", true).add(u"mean", int64_t(stats.queue.meanRound()));
+        jplugin->query(u"queue").add(u"max", int64_t(stats.queue.maximum()));
+        stats.window.toJSON(jplugin->query(u"window-time", true));
+        stats.packet.toJSON(jplugin->query(u"packet-time", true));
+        stats.wait.toJSON(jplugin->query(u"wait-time", true));
+        json->set(jplugin);
+    }
+    else {
+        const NanoSecond total = stats.work_ns + stats.wait_ns;
+        report.info(u"%2d: %c-%s: %'d packets, %'d packets/s, %s/packet, busy: %d%%, queue: %s packets (max: %'d)",
+                    {index, type, plugin->pluginName(), stats.packets, rate, LatencyHistogram::DurationString(per_packet),
+                     total <= 0 ? 0 : (100 * stats.work_ns) / total, stats.queue.meanString(0, 1), stats.queue.maximum()});
+        report.info(u"    window time: %s", {stats.window.summary()});
+        report.info(u"    packet time: %s", {stats.packet.summary()});
+        report.info(u"    wait time:   %s", {stats.wait.summary()});
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Allocations command.
+//----------------------------------------------------------------------------
+
+ts::CommandStatus ts::tsp::ControlServer::executeAllocations(const UString& command, Args& args)
+{
+    if (!AllocationTracker::IsEnabled()) {
+        args.error(u"allocation tracking is not enabled, use tsp option --allocation-tracking");
+        return CommandStatus::ERROR;
+    }
+    if (args.present(u"json")) {
+        json::ValuePtr json;
+        AllocationTracker::ToJSON(json);
+        args.info(json->printed());
+    }
+    else {
+        AllocationTracker::Display(args);
+    }
+    if (args.present(u"reset")) {
+        AllocationTracker::Reset();
+    }
+    return CommandStatus::SUCCESS;
+}
+
+
 //----------------------------------------------------------------------------
 // Suspend/resume commands.
 //----------------------------------------------------------------------------
@@ -42,6 +42,7 @@
 #include "tsMutex.h"
 #include "tsTCPServer.h"
 #include "tsReportWithPrefix.h"
+#include "tsjsonArray.h"
 
 namespace ts {
     namespace tsp {
@@ -99,6 +100,9 @@ namespace ts {
             CommandStatus executeSetLog(const UString&, Args&);
             CommandStatus executeList(const UString&, Args&);
             void listOnePlugin(size_t index, UChar type, PluginExecutor* plugin, Report& report);
+            CommandStatus executeStats(const UString&, Args&);
+            void statsOnePlugin(size_t index, UChar type, PluginExecutor* plugin, bool reset, Report& report, json::Array* json);
+            CommandStatus executeAllocations(const UString&, Args&);
             CommandStatus executeSuspend(const UString&, Args&);
             CommandStatus executeResume(const UString&, Args&);
             CommandStatus executeSuspendResume(bool state, Args&);
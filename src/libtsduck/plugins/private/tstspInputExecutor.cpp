@@ -29,6 +29,7 @@
 
 #include "tstspInputExecutor.h"
 #include "tsTime.h"
+#include "tsAllocationTracker.h"
 
 // Minimum number of PID's and PCR/DTS to analyze before getting a valid bitrate.
 #define MIN_ANALYZE_PID   1
@@ -422,6 +423,7 @@ void ts::tsp::InputExecutor::passInputPackets(size_t pkt_count, bool input_end)
 void ts::tsp::InputExecutor::main()
 {
     debug(u"input thread started");
+    AllocationTracker::SetThreadTag(logName());
 
     Time current_time(Time::CurrentUTC());
     Time bitrate_due_time(current_time + _options.bitrate_adj);
@@ -508,7 +510,7 @@ void ts::tsp::InputExecutor::main()
                 // Keep this bitrate
                 _tsp_bitrate = bitrate;
                 _tsp_bitrate_confidence = br_confidence;
-                debug(u"input: got bitrate %'d b/s", {bitrate});
+                TS_DEBUG(*this, u"input: got bitrate %'d b/s", {bitrate});
             }
         }
 
@@ -0,0 +1,130 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tstspMetricsExporter.h"
+#include "tstspProcessorExecutor.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::tsp::MetricsExporter::MetricsExporter(TSProcessorArgs& options, Report& log, InputExecutor* input) :
+    _options(options),
+    _server(log),
+    _input(input),
+    _bitrate(_server.addMetric(u"tsp_input_bitrate_bits_per_second", MetricsServer::Type::GAUGE, u"Input bitrate of the transport stream")),
+    _buffer_size(_server.addMetric(u"tsp_buffer_size_packets", MetricsServer::Type::GAUGE, u"Size of the global packet buffer")),
+    _plugins()
+{
+    _buffer_size.set(int64_t(_options.ts_buffer_size / PKT_SIZE));
+
+    // Register the metrics of all plugins, from input to output.
+    if (_input != nullptr) {
+        size_t index = 0;
+        PluginExecutor* proc = _input;
+        do {
+            const UChar type = proc == _input ? u'I' : (proc->ringNext<PluginExecutor>() == _input ? u'O' : u'P');
+            _plugins.emplace_back(_server, index++, type, proc);
+        } while ((proc = proc->ringNext<PluginExecutor>()) != _input);
+    }
+    _server.setCollector(this);
+}
+
+ts::tsp::MetricsExporter::~MetricsExporter()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Metrics of one plugin.
+//----------------------------------------------------------------------------
+
+ts::tsp::MetricsExporter::PluginMetrics::PluginMetrics(MetricsServer& server, size_t index, UChar type, PluginExecutor* plugin) :
+    _plugin(plugin),
+    _labels(UString::Format(u"index=\"%d\",type=\"%c\",plugin=\"%s\"", {index, type, plugin->pluginName()})),
+    _packets(server.addMetric(u"tsp_plugin_packets_total", MetricsServer::Type::COUNTER, u"Number of packets processed by the plugin", _labels)),
+    _thread_packets(server.addMetric(u"tsp_plugin_thread_packets_total", MetricsServer::Type::COUNTER, u"Number of packets passed through the plugin thread, including dropped and excluded ones", _labels)),
+    _work(server.addMetric(u"tsp_plugin_work_seconds_total", MetricsServer::Type::COUNTER, u"Time spent processing packets in the plugin", _labels, NanoSecPerSec)),
+    _wait(server.addMetric(u"tsp_plugin_wait_seconds_total", MetricsServer::Type::COUNTER, u"Time spent waiting for packets from the previous plugin", _labels, NanoSecPerSec)),
+    _buffer(server.addMetric(u"tsp_plugin_buffer_packets", MetricsServer::Type::GAUGE, u"Average number of packets available to the plugin", _labels)),
+    _window_p50(server.addMetric(u"tsp_plugin_window_seconds", MetricsServer::Type::GAUGE, u"Processing time of a window of packets", _labels + u",quantile=\"0.5\"", NanoSecPerSec)),
+    _window_p99(server.addMetric(u"tsp_plugin_window_seconds", MetricsServer::Type::GAUGE, u"Processing time of a window of packets", _labels + u",quantile=\"0.99\"", NanoSecPerSec))
+{
+}
+
+void ts::tsp::MetricsExporter::PluginMetrics::collect()
+{
+    PluginExecutor::Statistics stats;
+    _plugin->getStatistics(stats, false);
+    _packets.set(int64_t(_plugin->pluginPackets()));
+    _thread_packets.set(int64_t(_plugin->totalPacketsInThread()));
+    _work.set(stats.work_ns);
+    _wait.set(stats.wait_ns);
+    _buffer.set(int64_t(stats.queue.meanRound()));
+    _window_p50.set(stats.window.percentile(50.0));
+    _window_p99.set(stats.window.percentile(99.0));
+}
+
+
+//----------------------------------------------------------------------------
+// Start/stop the metrics server.
+//----------------------------------------------------------------------------
+
+bool ts::tsp::MetricsExporter::open()
+{
+    if (_options.metrics_port == 0) {
+        // No metrics server, do nothing.
+        return true;
+    }
+    else {
+        return _server.open(IPv4SocketAddress(_options.metrics_local, _options.metrics_port), _options.metrics_interval);
+    }
+}
+
+void ts::tsp::MetricsExporter::close()
+{
+    _server.close();
+}
+
+
+//----------------------------------------------------------------------------
+// Invoked in the context of the snapshot thread of the metrics server.
+//----------------------------------------------------------------------------
+
+void ts::tsp::MetricsExporter::collectMetrics(MetricsServer&)
+{
+    if (_input != nullptr) {
+        _bitrate.set(_input->bitrate().toInt());
+    }
+    for (auto& plugin : _plugins) {
+        plugin.collect();
+    }
+}
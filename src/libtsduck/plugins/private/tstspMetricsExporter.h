@@ -0,0 +1,107 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Transport stream processor metrics exporter.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSProcessorArgs.h"
+#include "tstspInputExecutor.h"
+#include "tstspOutputExecutor.h"
+#include "tsMetricsServer.h"
+
+namespace ts {
+    namespace tsp {
+        //!
+        //! Transport stream processor metrics exporter.
+        //! This class is internal to the TSDuck library and cannot be called by applications.
+        //! @ingroup plugin
+        //!
+        class MetricsExporter : private MetricsCollectorInterface
+        {
+            TS_NOBUILD_NOCOPY(MetricsExporter);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in,out] options Command line options for tsp.
+            //! @param [in,out] log Log report.
+            //! @param [in] input Input plugin executor (start of plugin chain).
+            //!
+            MetricsExporter(TSProcessorArgs& options, Report& log, InputExecutor* input);
+
+            //!
+            //! Destructor.
+            //!
+            virtual ~MetricsExporter() override;
+
+            //!
+            //! Open and start the metrics server.
+            //! @return True on success, false on error.
+            //!
+            bool open();
+
+            //!
+            //! Stop and close the metrics server.
+            //!
+            void close();
+
+        private:
+            // Metrics of one plugin.
+            class PluginMetrics
+            {
+                TS_NOBUILD_NOCOPY(PluginMetrics);
+            public:
+                PluginMetrics(MetricsServer& server, size_t index, UChar type, PluginExecutor* plugin);
+                void collect();
+            private:
+                PluginExecutor*        _plugin;
+                const UString          _labels;
+                MetricsServer::Metric& _packets;
+                MetricsServer::Metric& _thread_packets;
+                MetricsServer::Metric& _work;
+                MetricsServer::Metric& _wait;
+                MetricsServer::Metric& _buffer;
+                MetricsServer::Metric& _window_p50;
+                MetricsServer::Metric& _window_p99;
+            };
+
+            TSProcessorArgs&       _options;
+            MetricsServer          _server;
+            InputExecutor*         _input;
+            MetricsServer::Metric& _bitrate;
+            MetricsServer::Metric& _buffer_size;
+            std::list<PluginMetrics> _plugins;
+
+            // Implementation of MetricsCollectorInterface.
+            virtual void collectMetrics(MetricsServer&) override;
+        };
+    }
+}
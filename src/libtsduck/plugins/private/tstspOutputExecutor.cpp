@@ -28,6 +28,7 @@
 //----------------------------------------------------------------------------
 
 #include "tstspOutputExecutor.h"
+#include "tsAllocationTracker.h"
 
 
 //----------------------------------------------------------------------------
@@ -74,6 +75,7 @@ size_t ts::tsp::OutputExecutor::pluginIndex() const
 void ts::tsp::OutputExecutor::main()
 {
     debug(u"output thread started");
+    AllocationTracker::SetThreadTag(logName());
 
     PacketCounter output_packets = 0;
     bool aborted = false;
@@ -58,7 +58,10 @@ ts::tsp::PluginExecutor::PluginExecutor(const TSProcessorArgs& options,
     _bitrate(0),
     _br_confidence(BitRateConfidence::LOW),
     _restart(false),
-    _restart_data()
+    _restart_data(),
+    _stats(),
+    _work_start(),
+    _work_packets(0)
 {
     // Preset common default options.
     if (plugin() != nullptr) {
@@ -130,7 +133,7 @@ void ts::tsp::PluginExecutor::initBuffer(PacketBuffer*         buffer,
                                          const BitRate&        bitrate,
                                          BitRateConfidence     br_confidence)
 {
-    log(10, u"initBuffer(..., pkt_first = %'d, pkt_cnt = %'d, input_end = %s, aborted = %s, bitrate = %'d)", {pkt_first, pkt_cnt, input_end, aborted, bitrate});
+    TS_LOG(*this, 10, u"initBuffer(..., pkt_first = %'d, pkt_cnt = %'d, input_end = %s, aborted = %s, bitrate = %'d)", {pkt_first, pkt_cnt, input_end, aborted, bitrate});
 
     _buffer = buffer;
     _metadata = metadata;
@@ -153,7 +156,7 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 {
     assert(count <= _pkt_cnt);
 
-    log(10, u"passPackets(count = %'d, bitrate = %'d, input_end = %s, aborted = %s)", {count, bitrate, input_end, aborted});
+    TS_LOG(*this, 10, u"passPackets(count = %'d, bitrate = %'d, input_end = %s, aborted = %s)", {count, bitrate, input_end, aborted});
 
     // We access data under the protection of the global mutex.
     GuardMutex lock(_global_mutex);
@@ -201,7 +204,7 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
                                        BitRate& bitrate, BitRateConfidence& br_confidence,
                                        bool& input_end, bool& aborted, bool &timeout)
 {
-    log(10, u"waitWork(min_pkt_cnt = %'d, ...)", {min_pkt_cnt});
+    TS_LOG(*this, 10, u"waitWork(min_pkt_cnt = %'d, ...)", {min_pkt_cnt});
 
     // Cannot allocate more than the buffer size.
     if (min_pkt_cnt > _buffer->count()) {
@@ -209,9 +212,20 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
         min_pkt_cnt = _buffer->count();
     }
 
+    // The time since the previous call was spent processing the previously returned packets.
+    const Monotonic wait_start(true);
+
     // We access data under the protection of the global mutex.
     GuardCondition lock(_global_mutex, _to_do);
 
+    if (_work_packets > 0) {
+        const NanoSecond work = wait_start - _work_start;
+        _stats.packets += _work_packets;
+        _stats.work_ns += work;
+        _stats.window.add(work);
+        _stats.packet.add(work / NanoSecond(_work_packets));
+    }
+
     PluginExecutor* next = ringNext<PluginExecutor>();
     timeout = false;
 
@@ -250,11 +264,55 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
     // there is no propagation of packets from output back to input.
     aborted = plugin()->type() != PluginType::OUTPUT && next->_tsp_aborting;
 
-    log(10, u"waitWork(min_pkt_cnt = %'d, pkt_first = %'d, pkt_cnt = %'d, bitrate = %'d, input_end = %s, aborted = %s, timeout = %s)",
+    // Collect the waiting time and the number of packets which are queued for this plugin.
+    _work_start.getSystemTime();
+    _work_packets = pkt_cnt;
+    _stats.wait_ns += _work_start - wait_start;
+    _stats.wait.add(_work_start - wait_start);
+    _stats.queue.feed(_pkt_cnt);
+
+    TS_LOG(*this, 10, u"waitWork(min_pkt_cnt = %'d, pkt_first = %'d, pkt_cnt = %'d, bitrate = %'d, input_end = %s, aborted = %s, timeout = %s)",
         {min_pkt_cnt, pkt_first, pkt_cnt, bitrate, input_end, aborted, timeout});
 }
 
 
+//----------------------------------------------------------------------------
+// Performance statistics.
+//----------------------------------------------------------------------------
+
+ts::tsp::PluginExecutor::Statistics::Statistics() :
+    start(true),
+    packets(0),
+    work_ns(0),
+    wait_ns(0),
+    window(),
+    packet(),
+    wait(),
+    queue()
+{
+}
+
+void ts::tsp::PluginExecutor::Statistics::reset()
+{
+    start.getSystemTime();
+    packets = 0;
+    work_ns = wait_ns = 0;
+    window.reset();
+    packet.reset();
+    wait.reset();
+    queue.reset();
+}
+
+void ts::tsp::PluginExecutor::getStatistics(Statistics& stats, bool reset)
+{
+    GuardMutex lock(_global_mutex);
+    stats = _stats;
+    if (reset) {
+        _stats.reset();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Description of a restart operation (constructor).
 //----------------------------------------------------------------------------
@@ -42,6 +42,9 @@
 #include "tsCondition.h"
 #include "tsMutex.h"
 #include "tsThread.h"
+#include "tsMonotonic.h"
+#include "tsLatencyHistogram.h"
+#include "tsSingleDataStatistics.h"
 
 namespace ts {
     namespace tsp {
@@ -130,6 +133,41 @@ namespace ts {
             //!
             bool getSuspended() const { return _suspended; }
 
+            //!
+            //! Performance statistics of a plugin thread.
+            //! The statistics are collected in waitWork(): the time between two calls is
+            //! the processing time of the packets which were returned by the previous call.
+            //!
+            class Statistics
+            {
+            public:
+                //!
+                //! Constructor.
+                //!
+                Statistics();
+                //!
+                //! Reset all statistics, start a new measurement period.
+                //!
+                void reset();
+
+                Monotonic        start;      //!< Start of the measurement period.
+                PacketCounter    packets;    //!< Number of processed packets.
+                NanoSecond       work_ns;    //!< Total processing time.
+                NanoSecond       wait_ns;    //!< Total waiting time for packets.
+                LatencyHistogram window;     //!< Processing time of each window of packets.
+                LatencyHistogram packet;     //!< Mean processing time per packet in each window.
+                LatencyHistogram wait;       //!< Waiting time in each call to waitWork().
+                SingleDataStatistics<size_t> queue;  //!< Number of packets available to the plugin after each wait.
+            };
+
+            //!
+            //! Get a copy of the performance statistics of the plugin thread.
+            //! This method is called from another thread, not the plugin thread.
+            //! @param [out] stats Statistics since the start of the plugin or the last reset.
+            //! @param [in] reset If true, reset the statistics after returning them.
+            //!
+            void getStatistics(Statistics& stats, bool reset);
+
             //!
             //! Restart the plugin with new parameters.
             //! This method is called from another thread, not the plugin thread.
@@ -236,6 +274,9 @@ namespace ts {
             BitRateConfidence _br_confidence;  // Input bitrate confidence (set by previous plugin) [*]
             bool              _restart;        // Restart the plugin asap using _restart_data
             RestartDataPtr    _restart_data;   // How to restart the plugin
+            Statistics        _stats;          // Performance statistics [*]
+            Monotonic         _work_start;     // Start of processing of the last returned packets [*]
+            size_t            _work_packets;   // Number of packets which were returned by the last waitWork() [*]
 
             // Description of a restart operation.
             class RestartData
@@ -28,6 +28,7 @@
 //----------------------------------------------------------------------------
 
 #include "tstspProcessorExecutor.h"
+#include "tsAllocationTracker.h"
 
 
 //----------------------------------------------------------------------------
@@ -74,6 +75,7 @@ size_t ts::tsp::ProcessorExecutor::pluginIndex() const
 void ts::tsp::ProcessorExecutor::main()
 {
     debug(u"packet processing thread started");
+    AllocationTracker::SetThreadTag(logName());
 
     // Debug feature: if the environment variable TSP_FORCED_WINDOW_SIZE is
     // defined to some non-zero integer value, force all plugins to use the
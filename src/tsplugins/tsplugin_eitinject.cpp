@@ -50,6 +50,9 @@ namespace {
 
     // Stack size of listener threads.
     constexpr size_t SERVER_THREAD_STACK_SIZE = 128 * 1024;
+
+    // Maximum number of EIT sections to load in the EPG per TS packet.
+    constexpr size_t MAX_SECTIONS_PER_PACKET = 16;
 }
 
 
@@ -82,6 +85,7 @@ namespace ts {
         private:
             EITInjectPlugin* const _plugin;
             TSP* const             _tsp;
+            DuckContext            _duck;    // Private context, files are loaded in the listener thread.
             PollFiles              _poller;
             volatile bool          _terminate;
 
@@ -107,19 +111,26 @@ namespace ts {
         EITRepetitionProfile _eit_profile;
 
         // Working data.
+        // Event files are loaded and converted into EIT sections in the context of the file listener thread.
+        // The EIT sections are then passed to the plugin thread. The plugin thread never waits for the
+        // file listener thread and loads a limited number of sections per packet in the EPG.
         FileListener  _file_listener;
         EITGenerator  _eit_gen;
-        volatile bool _check_files;         // there are files in _polled_files
-        Mutex         _polled_files_mutex;  // exclusive access to _polled_files
-        UStringList   _polled_files;        // accessed by two threads, protected by mutex above.
+        DuckContext::SavedArgs _duck_args;  // Copy of the plugin context settings for the file listener.
+        volatile bool _check_sections;      // there are sections in _loaded_sections
+        Mutex         _loaded_mutex;        // exclusive access to _loaded_sections
+        SectionPtrVector _loaded_sections;  // accessed by two threads, protected by mutex above.
+        SectionPtrVector _pending_sections; // sections to load in the EPG, plugin thread only.
+        size_t        _pending_next;        // index of next section to load in _pending_sections.
 
         // Specific support for deterministic start (wfb = wait first batch, non-regression testing).
         volatile bool _wfb_received;     // First batch was received.
         Mutex         _wfb_mutex;        // Mutex waiting for _wfb_received.
         Condition     _wfb_condition;    // Condition waiting for _wfb_received.
 
-        // Load files in the context of the plugin thread.
-        void loadFiles();
+        // Load sections from the file listener thread into the EPG, in the context of the plugin thread.
+        // When all is false, do not wait for the file listener thread and load a limited number of sections.
+        void loadSections(bool all);
 
         // Read an integer option, using its current version as default value.
         template <typename INT>
@@ -151,9 +162,12 @@ ts::EITInjectPlugin::EITInjectPlugin(TSP* tsp_) :
     _eit_profile(),
     _file_listener(this),
     _eit_gen(duck, PID_EIT),
-    _check_files(false),
-    _polled_files_mutex(),
-    _polled_files(),
+    _duck_args(),
+    _check_sections(false),
+    _loaded_mutex(),
+    _loaded_sections(),
+    _pending_sections(),
+    _pending_next(0),
     _wfb_received(false),
     _wfb_mutex(),
     _wfb_condition()
@@ -422,13 +436,16 @@ bool ts::EITInjectPlugin::start()
 
     // Start the file polling.
     {
-        GuardMutex lock(_polled_files_mutex);
-        _check_files = false;
-        _polled_files.clear();
+        GuardMutex lock(_loaded_mutex);
+        _check_sections = false;
+        _loaded_sections.clear();
     }
+    _pending_sections.clear();
+    _pending_next = 0;
     if (!_files.empty()) {
 
-        // Start the file listener thread.
+        // Start the file listener thread, using the same context settings as the plugin.
+        duck.saveArgs(_duck_args);
         _file_listener.start();
 
         // If --wait-first-batch was specified, suspend until a first batch of events is loaded.
@@ -441,7 +458,7 @@ bool ts::EITInjectPlugin::start()
                 }
             }
             tsp->verbose(u"received first batch of events");
-            loadFiles();
+            loadSections(true);
         }
     }
 
@@ -469,9 +486,9 @@ bool ts::EITInjectPlugin::stop()
 
 ts::ProcessorPlugin::Status ts::EITInjectPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
-    // If the file listener thread signaled the volatile bool, process files.
-    if (_check_files) {
-        loadFiles();
+    // If the file listener thread signaled the volatile bool or some sections are not yet loaded, load them.
+    if (_check_sections || _pending_next < _pending_sections.size()) {
+        loadSections(false);
     }
 
     // Let the EIT generator process the packet.
@@ -490,6 +507,7 @@ ts::EITInjectPlugin::FileListener::FileListener(EITInjectPlugin* plugin) :
     Thread(ThreadAttributes().setStackSize(SERVER_THREAD_STACK_SIZE)),
     _plugin(plugin),
     _tsp(plugin->tsp),
+    _duck(_tsp),
     _poller(UString(), this, PollFiles::DEFAULT_POLL_INTERVAL, PollFiles::DEFAULT_MIN_STABLE_DELAY, *_tsp),
     _terminate(false)
 {
@@ -516,6 +534,7 @@ void ts::EITInjectPlugin::FileListener::stop()
 void ts::EITInjectPlugin::FileListener::main()
 {
     _tsp->debug(u"file listener thread started");
+    _duck.restoreArgs(_plugin->_duck_args);
     _poller.setFileWildcard(_plugin->_files);
     _poller.setPollInterval(_plugin->_poll_interval);
     _poller.setMinStableDelay(_plugin->_min_stable_delay);
@@ -532,15 +551,22 @@ bool ts::EITInjectPlugin::FileListener::updatePollFiles(UString& wildcard, Milli
 // Invoked with modified files.
 bool ts::EITInjectPlugin::FileListener::handlePolledFiles(const PolledFileList& files)
 {
-    // Add the polled files to the list to be processed by the plugin thread.
-    {
-        GuardMutex lock(_plugin->_polled_files_mutex);
-        // Insert one by one, avoiding duplicates.
-        for (const auto& it : files) {
-            // If file was updated (ie. not deleted) and not already present in _polled_files.
-            if (it->updated() && std::find(_plugin->_polled_files.begin(), _plugin->_polled_files.end(), it->getFileName()) == _plugin->_polled_files.end()) {
-                _plugin->_polled_files.push_back(it->getFileName());
-                _plugin->_check_files = true;
+    // Load the updated (ie. not deleted) files in this thread. Parsing large XML or JSON
+    // files may take time, this shall not delay the packet processing in the plugin thread.
+    for (const auto& it : files) {
+        if (it->updated()) {
+            const UString& name(it->getFileName());
+            _tsp->verbose(u"loading events from file %s", {name});
+            SectionFile secfile(_duck);
+            if (secfile.load(name)) {
+                // Pass the EIT sections to the plugin thread.
+                GuardMutex lock(_plugin->_loaded_mutex);
+                _plugin->_loaded_sections.insert(_plugin->_loaded_sections.end(), secfile.sections().begin(), secfile.sections().end());
+                _plugin->_check_sections = true;
+            }
+            // Delete file after successful load when required.
+            if (_plugin->_delete_files) {
+                DeleteFile(name, *_tsp);
             }
         }
     }
@@ -557,29 +583,32 @@ bool ts::EITInjectPlugin::FileListener::handlePolledFiles(const PolledFileList&
 
 
 //----------------------------------------------------------------------------
-// Load files in the context of the plugin thread.
+// Load sections into the EPG in the context of the plugin thread.
 //----------------------------------------------------------------------------
 
-void ts::EITInjectPlugin::loadFiles()
+void ts::EITInjectPlugin::loadSections(bool all)
 {
-    GuardMutex lock(_polled_files_mutex);
-
-    for (const auto& it : _polled_files) {
-
-        // Load events from the file into the EPG database
-        tsp->verbose(u"loading events from file %s", {it});
-        SectionFile secfile(duck);
-        if (secfile.load(it)) {
-            _eit_gen.loadEvents(secfile);
+    // Get new sections from the file listener thread when the previous ones are all loaded.
+    // When processing packets, do not wait if the file listener thread holds the mutex, retry on next packet.
+    if (_check_sections && _pending_next >= _pending_sections.size()) {
+        GuardMutex lock(_loaded_mutex, all ? Infinite : 0);
+        if (lock.isLocked()) {
+            _pending_sections.clear();
+            _pending_sections.swap(_loaded_sections);
+            _pending_next = 0;
+            _check_sections = false;
         }
+    }
 
-        // Delete file after successful load when required.
-        if (_delete_files) {
-            DeleteFile(it, *tsp);
+    // Load sections into the EPG. Each section creates or updates a few events only.
+    for (size_t count = 0; _pending_next < _pending_sections.size() && (all || count < MAX_SECTIONS_PER_PACKET); ++count) {
+        const SectionPtr& section(_pending_sections[_pending_next++]);
+        if (!section.isNull()) {
+            _eit_gen.loadEvents(*section);
         }
     }
-
-    // Reset polled files.
-    _polled_files.clear();
-    _check_files = false;
+    if (_pending_next >= _pending_sections.size()) {
+        _pending_sections.clear();
+        _pending_next = 0;
+    }
 }
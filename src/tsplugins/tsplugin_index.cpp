@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Transport stream processor shared library:
+//  Build an index of random access points and time stamps
+//
+//----------------------------------------------------------------------------
+
+#include "tsPluginRepository.h"
+#include "tsTSFileIndexer.h"
+
+
+//----------------------------------------------------------------------------
+// Plugin definition
+//----------------------------------------------------------------------------
+
+namespace ts {
+    class IndexPlugin: public ProcessorPlugin
+    {
+        TS_NOBUILD_NOCOPY(IndexPlugin);
+    public:
+        // Implementation of plugin API
+        IndexPlugin(TSP*);
+        virtual bool getOptions() override;
+        virtual bool start() override;
+        virtual bool stop() override;
+        virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+
+    private:
+        UString       _file_name;  // Output index file name
+        TSFileIndex   _index;      // Index being built
+        TSFileIndexer _indexer;    // Index builder
+    };
+}
+
+TS_REGISTER_PROCESSOR_PLUGIN(u"index", ts::IndexPlugin);
+
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+ts::IndexPlugin::IndexPlugin(TSP* tsp_) :
+    ProcessorPlugin(tsp_, u"Build an index of random access points and time stamps for fast seeking", u"[options] file-name"),
+    _file_name(),
+    _index(),
+    _indexer(duck, _index)
+{
+    option(u"", 0, FILENAME, 1, 1);
+    help(u"",
+         u"Name of the index file to create. "
+         u"By convention, the name of the index of a transport stream file is the name of the file, "
+         u"followed by \"" + UString(TSFileIndex::DEFAULT_SUFFIX) + u"\". "
+         u"The index contains the packet index in the stream of the PCR checkpoints and the random access points. "
+         u"Therefore, this plugin shall be placed before any plugin which adds or removes packets. "
+         u"The index is used by the file input plugin with option --start-time.");
+
+    option(u"pcr-interval", 0, POSITIVE);
+    help(u"pcr-interval", u"milliseconds",
+         u"Interval between two PCR checkpoints in the index. "
+         u"The default is " + UString::Decimal(TSFileIndexer::DEFAULT_PCR_INTERVAL) + u" milliseconds.");
+}
+
+
+//----------------------------------------------------------------------------
+// Get options method
+//----------------------------------------------------------------------------
+
+bool ts::IndexPlugin::getOptions()
+{
+    getValue(_file_name, u"");
+    _indexer.setPCRInterval(intValue<MilliSecond>(u"pcr-interval", TSFileIndexer::DEFAULT_PCR_INTERVAL));
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Start method
+//----------------------------------------------------------------------------
+
+bool ts::IndexPlugin::start()
+{
+    _index.clear();
+    _indexer.reset();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Stop method
+//----------------------------------------------------------------------------
+
+bool ts::IndexPlugin::stop()
+{
+    _indexer.finish();
+    tsp->verbose(u"%'d entries in index, duration: %'d ms", {_index.entries().size(), _index.duration()});
+    return _index.save(_file_name, *tsp);
+}
+
+
+//----------------------------------------------------------------------------
+// Packet processing method
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::IndexPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    _indexer.feedPacket(pkt);
+    return TSP_OK;
+}
@@ -350,6 +350,7 @@ bool ts::InjectPlugin::reloadFiles()
     _pzer.reset();
     _pzer.setPID(_inject_pid);
     _pzer.setStuffingPolicy(_stuffing_policy);
+    _pzer.setPacketCache(true);
 
     // Load sections from input files
     bool success = true;
@@ -486,7 +487,7 @@ ts::ProcessorPlugin::Status ts::InjectPlugin::processPacket(TSPacket& pkt, TSPac
         }
         else {
             _pzer.setBitRate(_pid_bitrate);
-            tsp->debug(u"transport bitrate: %'d b/s, new PID bitrate: %'d b/s", {ts_bitrate, _pid_bitrate});
+            TS_DEBUG(*tsp, u"transport bitrate: %'d b/s, new PID bitrate: %'d b/s", {ts_bitrate, _pid_bitrate});
         }
         _pid_packet_count = 0;
         _packet_count = 0;
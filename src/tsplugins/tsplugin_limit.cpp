@@ -401,7 +401,7 @@ ts::ProcessorPlugin::Status ts::LimitPlugin::processPacket(TSPacket& pkt, TSPack
             }
             else if (_curBitrate != newBitrate && (_curBitrate > newBitrate ? _curBitrate - newBitrate : newBitrate - _curBitrate) > _curBitrate / 20) {
                 // Report new bitrate when more than 5% change.
-                tsp->debug(u"new bitrate: %'d b/s", {newBitrate});
+                TS_DEBUG(*tsp, u"new bitrate: %'d b/s", {newBitrate});
             }
 
             // Save current bitrate.
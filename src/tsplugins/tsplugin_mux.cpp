@@ -324,7 +324,7 @@ ts::ProcessorPlugin::Status ts::MuxPlugin::processPacket(TSPacket& pkt, TSPacket
         if (_min_pts != 0) {
             if (_pts_pid == 0 || pid == _pts_pid) {
                 if (currentpts > _min_pts  && (currentpts < _max_pts || _max_pts == 0)) {
-                    tsp->debug(u"Found minmaxpts range OK at PTS: %'d, enabling packet insertion", { currentpts });
+                    TS_DEBUG(*tsp, u"Found minmaxpts range OK at PTS: %'d, enabling packet insertion", { currentpts });
                     _pts_range_ok = true;
                 }
             }
@@ -334,7 +334,7 @@ ts::ProcessorPlugin::Status ts::MuxPlugin::processPacket(TSPacket& pkt, TSPacket
         if (_inter_time != 0 && _pts_last_inserted != 0) {
             uint64_t calculated = _pts_last_inserted + _inter_time;
             if (_youngest_pts > calculated) {
-                tsp->debug(u"Detected waiting time %d has passed, pts_last_insert: %d, youngest pts: %d, enabling packet insertion", { _inter_time, _pts_last_inserted, _youngest_pts});
+                TS_DEBUG(*tsp, u"Detected waiting time %d has passed, pts_last_insert: %d, youngest pts: %d, enabling packet insertion", { _inter_time, _pts_last_inserted, _youngest_pts});
                 _pts_range_ok = true;
             }
             else {
@@ -344,7 +344,7 @@ ts::ProcessorPlugin::Status ts::MuxPlugin::processPacket(TSPacket& pkt, TSPacket
 
         // check if max-pts is reached
         if (_max_pts != 0 && _max_pts < currentpts && (pid == _pts_pid || _pts_pid == 0)) {
-            tsp->debug(u"max-pts %d reached, disabling packet insertion at PTS: %'d", { _max_pts,currentpts });
+            TS_DEBUG(*tsp, u"max-pts %d reached, disabling packet insertion at PTS: %'d", { _max_pts,currentpts });
             _pts_range_ok = false;
         }
     }
@@ -383,7 +383,7 @@ ts::ProcessorPlugin::Status ts::MuxPlugin::processPacket(TSPacket& pkt, TSPacket
 
     _inserted_packet_count++;
     _pts_last_inserted = _youngest_pts;   // store pts of last insertion
-    tsp->debug(u"[%d:%d] Inserting Packet at PTS: %'d (pos: %'d), file: %s (pos: %'d)", { _inter_pkt,_pid_next_pkt,_pts_last_inserted,_packet_count,_file.getFileName(),_inserted_packet_count });
+    TS_DEBUG(*tsp, u"[%d:%d] Inserting Packet at PTS: %'d (pos: %'d), file: %s (pos: %'d)", { _inter_pkt,_pid_next_pkt,_pts_last_inserted,_packet_count,_file.getFileName(),_inserted_packet_count });
 
     if (_inter_time != 0) {
         _pts_range_ok = false; // reset _pts_range_ok signal if inter_time is specified
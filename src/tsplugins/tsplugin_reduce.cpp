@@ -378,7 +378,7 @@ size_t ts::ReducePlugin::processPacketWindow(TSPacketWindow& win)
             bool slice_done = false;
             // Count passes.
             pass_count++;
-            tsp->log(3, u"pass #%d, packets to remove: %'d, slice size: %'d packets", {pass_count, pkt_count, slice_size});
+            TS_LOG(*tsp, 3, u"pass #%d, packets to remove: %'d, slice size: %'d packets", {pass_count, pkt_count, slice_size});
             // Perform the pass over the packet window.
             for (size_t i = 0; i < subwin_size && pkt_count > 0; ++i) {
                 // Reset at start of slice.
@@ -400,7 +400,7 @@ size_t ts::ReducePlugin::processPacketWindow(TSPacketWindow& win)
                 }
             }
         }
-        tsp->log(2, u"subwindow size: %'d packets, number of passes: %d, remaining null: %'d, remaining bits: %'d", {subwin_size, pass_count, null_count, _bits_to_remove});
+        TS_LOG(*tsp, 2, u"subwindow size: %'d packets, number of passes: %d, remaining null: %'d, remaining bits: %'d", {subwin_size, pass_count, null_count, _bits_to_remove});
 
         // Iterate to next sub-window.
         subwin_start += subwin_size;
@@ -53,7 +53,8 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool isRealTime() override {return true;}
-        virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         // Command line options:
@@ -61,6 +62,7 @@ namespace ts {
         BitRate       _bitrate;
         PacketCounter _burst;
         MilliSecond   _wait_min;
+        MicroSecond   _spin_wait;
         PID           _pid_pcr;
 
         // Working data:
@@ -82,6 +84,7 @@ ts::RegulatePlugin::RegulatePlugin(TSP* tsp_) :
     _bitrate(),
     _burst(0),
     _wait_min(0),
+    _spin_wait(0),
     _pid_pcr(PID_NULL),
     _bitrate_regulator(tsp, Severity::Verbose),
     _pcr_regulator(tsp, Severity::Verbose)
@@ -96,7 +99,10 @@ ts::RegulatePlugin::RegulatePlugin(TSP* tsp_) :
     help(u"packet-burst",
          u"Number of packets to burst at a time. Does not modify the average "
          u"output bitrate but influence smoothing and CPU load. The default "
-         u"is " TS_STRINGIFY(DEF_PACKET_BURST) u" packets.");
+         u"is " TS_STRINGIFY(DEF_PACKET_BURST) u" packets.\n\n"
+         u"The packets are processed by windows of that size. Each packet is marked with its "
+         u"individual output time stamp. An output plugin such as 'ip --pacing' can use these "
+         u"time stamps to precisely schedule the transmission of each packet inside a burst.");
 
     option(u"pcr-synchronous");
     help(u"pcr-synchronous",
@@ -108,6 +114,13 @@ ts::RegulatePlugin::RegulatePlugin(TSP* tsp_) :
          u"With --pcr-synchronous, specify the reference PID for PCR's. By default, "
          u"use the first PID containing PCR's.");
 
+    option(u"spin-wait", 0, UNSIGNED);
+    help(u"spin-wait",
+         u"Specify the duration in micro-seconds of the final active wait before each burst. "
+         u"The process sleeps until the specified duration before the due time of the burst "
+         u"and then actively polls the system clock. This improves the precision of the "
+         u"regulation at the expense of CPU load. The default is zero (passive wait only).");
+
     option(u"wait-min", 'w', POSITIVE);
     help(u"wait-min",
          u"With --pcr-synchronous, specify the minimum wait time in milli-seconds. "
@@ -124,6 +137,7 @@ bool ts::RegulatePlugin::getOptions()
     getValue(_bitrate, u"bitrate", 0);
     getIntValue(_burst, u"packet-burst", DEF_PACKET_BURST);
     getIntValue(_wait_min, u"wait-min", PCRRegulator::DEFAULT_MIN_WAIT_NS / NanoSecPerMilliSec);
+    getIntValue(_spin_wait, u"spin-wait", 0);
     getIntValue(_pid_pcr, u"pid-pcr", PID_NULL);
     _pcr_synchronous = present(u"pcr-synchronous");
 
@@ -151,9 +165,11 @@ bool ts::RegulatePlugin::start()
         _pcr_regulator.setBurstPacketCount(_burst);
         _pcr_regulator.setReferencePID(_pid_pcr);
         _pcr_regulator.setMinimimWait(_wait_min * NanoSecPerMilliSec);
+        _pcr_regulator.setSpinWait(_spin_wait * NanoSecPerMicroSec);
     }
     else {
         _bitrate_regulator.setBurstPacketCount(_burst);
+        _bitrate_regulator.setSpinWait(_spin_wait * NanoSecPerMicroSec);
         _bitrate_regulator.setFixedBitRate(_bitrate);
         _bitrate_regulator.start();
     }
@@ -162,22 +178,61 @@ bool ts::RegulatePlugin::start()
 
 
 //----------------------------------------------------------------------------
-// Packet processing method
+// Get the packet window size: one burst.
 //----------------------------------------------------------------------------
 
-ts::ProcessorPlugin::Status ts::RegulatePlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+size_t ts::RegulatePlugin::getPacketWindowSize()
 {
-    bool flush = false;
-    bool bitrate_changed = false;
+    return size_t(_burst);
+}
 
-    if (_pcr_synchronous) {
-        flush = _pcr_regulator.regulate(pkt);
-    }
-    else {
-        _bitrate_regulator.regulate(tsp->bitrate(), flush, bitrate_changed);
+
+//----------------------------------------------------------------------------
+// Packet window processing method
+//----------------------------------------------------------------------------
+
+size_t ts::RegulatePlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // Compute the due time of all packets in the window.
+    bool wait = false;
+    Monotonic first_due;
+    TSPacket* pkt = nullptr;
+    TSPacketMetadata* pkt_data = nullptr;
+    TSPacketMetadata* last_data = nullptr;
+
+    for (size_t i = 0; i < win.size(); ++i) {
+        if (win.get(i, pkt, pkt_data)) {
+            Monotonic due;
+            bool valid = false;
+            bool bitrate_changed = false;
+            if (_pcr_synchronous) {
+                valid = _pcr_regulator.packetTime(*pkt, due);
+            }
+            else {
+                valid = _bitrate_regulator.packetTime(tsp->bitrate(), due, bitrate_changed);
+            }
+            if (valid) {
+                pkt_data->setOutputTimeStamp(due.nanoSeconds());
+                if (!wait) {
+                    wait = true;
+                    first_due = due;
+                }
+            }
+            else {
+                pkt_data->clearOutputTimeStamp();
+            }
+            pkt_data->setBitrateChanged(bitrate_changed);
+            last_data = pkt_data;
+        }
     }
 
-    pkt_data.setFlush(flush);
-    pkt_data.setBitrateChanged(bitrate_changed);
-    return TSP_OK;
+    // Wait once for the first packet of the window, then pass the complete window.
+    // The output plugin may use the individual output time stamps to pace the packets.
+    if (wait) {
+        const bool suspended = _pcr_synchronous ? _pcr_regulator.waitUntil(first_due) : _bitrate_regulator.waitUntil(first_due);
+        if (suspended && last_data != nullptr) {
+            last_data->setFlush(true);
+        }
+    }
+    return win.size();
 }
@@ -46,6 +46,7 @@
 
 #define DEFAULT_ECM_BITRATE 30000
 #define DEFAULT_ECM_INTER_PACKET  7000  // When bitrate is unknown, use 10 ECM/s for TS @10Mb/s
+#define MAX_LOOK_AHEAD 100
 #define ASYNC_HANDLER_EXTRA_STACK_SIZE (1024 * 1024)
 
 
@@ -68,8 +69,18 @@
 //
 // So, during cp(N), we need cp(N-1)/cp(N), then cp(N)/cp(N+1). On a dynamic
 // standpoint, as soon as ECM(N-1) is no longer needed, we generate cp(N+1).
-// In asynchronous mode, there is enough time to generate ECM(N+1) while
-// cp(N) is finishing.
+// In asynchronous mode, there is usually enough time to generate ECM(N+1)
+// while cp(N) is finishing.
+//
+// Look-ahead:
+// An ECMG round trip which is slow near a crypto-period boundary delays the
+// transition (see degraded mode below). To avoid this, the ECM's of the next
+// K crypto-periods can be requested in advance (option --look-ahead). The
+// CryptoPeriod objects are then a ring of K+1 elements. When cp(N) starts
+// (CW and ECM both in cp(N)), cp(N+K) is generated in the slot of cp(N-1).
+// Each ECM is packetized as soon as it is received so that the insertion
+// of ECM packets never waits for the ECMG. The default K=1 is the original
+// behaviour with two CryptoPeriod objects.
 //
 // The transition points in the TS are:
 // - CW change (start a new crypto-period)
@@ -170,6 +181,7 @@ namespace ts {
         BitRate           _ecm_bitrate;         // ECM PID's bitrate
         PID               _ecm_pid;             // PID for ECM
         PacketCounter     _partial_scrambling;  // Do not scramble all packets if > 1
+        size_t            _look_ahead;          // Number of crypto-periods for which ECM's are generated in advance
         ECMGClientArgs    _ecmg_args;           // Parameters for ECMG client
         tlv::Logger       _logger;              // Message logger for ECMG <=> SCS protocol
         ecmgscs::ChannelStatus _channel_status; // Initial response to ECMG channel_setup
@@ -191,7 +203,7 @@ namespace ts {
         PIDSet            _scrambled_pids;      // List of pids to scramble
         PIDSet            _conflict_pids;       // List of pids to scramble with scrambled input packets
         PIDSet            _input_pids;          // List of input pids
-        CryptoPeriod      _cp[2];               // Previous/current or current/next crypto-periods
+        std::vector<CryptoPeriod> _cp;          // Ring of crypto-periods, current and next ones (see look-ahead above)
         size_t            _current_cw;          // Index to current CW (current crypto period)
         size_t            _current_ecm;         // Index to current ECM (ECM being broadcast)
         TSScrambling      _scrambling;          // Scrambler
@@ -202,14 +214,16 @@ namespace ts {
 
         // Return current/next CryptoPeriod for CW or ECM
         CryptoPeriod& currentCW()  { return _cp[_current_cw]; }
-        CryptoPeriod& nextCW()     { return _cp[(_current_cw + 1) & 0x01]; }
         CryptoPeriod& currentECM() { return _cp[_current_ecm]; }
-        CryptoPeriod& nextECM()    { return _cp[(_current_ecm + 1) & 0x01]; }
+        CryptoPeriod& nextECM()    { return _cp[(_current_ecm + 1) % _cp.size()]; }
 
         // Perform CW and ECM transition
         bool changeCW();
         void changeECM();
 
+        // Generate (or start generating) the last look-ahead crypto-period when the oldest one is no longer used.
+        void generateLookAhead();
+
         // Check if we are in degraded mode or if we enter degraded mode
         bool inDegradedMode();
 
@@ -246,6 +260,7 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
     _ecm_bitrate(0),
     _ecm_pid(PID_NULL),
     _partial_scrambling(0),
+    _look_ahead(0),
     _ecmg_args(),
     _logger(Severity::Debug, tsp_),
     _channel_status(),
@@ -303,6 +318,13 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
          u"are likely scrambled with a different control word, descrambling "
          u"will not be possible the usual way.");
 
+    option(u"look-ahead", 0, INTEGER, 0, 1, 1, MAX_LOOK_AHEAD);
+    help(u"look-ahead", u"count",
+         u"Number of future crypto-periods for which the ECM's are requested in advance to the ECMG. "
+         u"With a larger value, a slow response from the ECMG near the end of a crypto-period "
+         u"no longer delays the crypto-period transition. "
+         u"The default is 1, the ECM of the next crypto-period only.");
+
     option(u"no-audio");
     help(u"no-audio",
          u"Do not scramble audio components in the selected service. By default, "
@@ -372,6 +394,7 @@ bool ts::ScramblerPlugin::getOptions()
     _scramble_subtitles = present(u"subtitles");
     _ignore_scrambled = present(u"ignore-scrambled");
     getIntValue(_partial_scrambling, u"partial-scrambling", 1);
+    getIntValue(_look_ahead, u"look-ahead", 1);
     getIntValue(_ecm_pid, u"pid-ecm", PID_NULL);
     getValue(_ecm_bitrate, u"bitrate-ecm", DEFAULT_ECM_BITRATE);
     getHexaValue(_ca_desc_private, u"private-data");
@@ -402,6 +425,9 @@ bool ts::ScramblerPlugin::getOptions()
     _need_cp = _scrambling.fixedCWCount() != 1;
     _need_ecm = _use_service && !_scrambling.hasFixedCW();
 
+    // Ring of crypto-periods: the current one and the look-ahead ones.
+    _cp = std::vector<CryptoPeriod>(_look_ahead + 1);
+
     // Specify which ECMG <=> SCS version to use.
     ecmgscs::Protocol::Instance()->setVersion(_ecmg_args.dvbsim_version);
     return true;
@@ -462,12 +488,14 @@ bool ts::ScramblerPlugin::start()
             }
             tsp->debug(u"crypto-period duration: %'d ms, delay start: %'d ms", {_ecmg_args.cp_duration, _delay_start});
 
-            // Create first and second crypto-periods
+            // Create first crypto-period and the look-ahead ones.
             _cp[0].initCycle(this, 0);
             if (!_cp[0].initScramblerKey()) {
                 return false;
             }
-            _cp[1].initNext(_cp[0]);
+            for (size_t i = 1; i < _cp.size(); ++i) {
+                _cp[i].initNext(_cp[i - 1]);
+            }
         }
     }
 
@@ -723,7 +751,7 @@ bool ts::ScramblerPlugin::changeCW()
         // Allowed to change CW only if not in degraded mode.
 
         // Point to next crypto-period
-        _current_cw = (_current_cw + 1) & 0x01;
+        _current_cw = (_current_cw + 1) % _cp.size();
 
         // Use new control word
         if (!currentCW().initScramblerKey()) {
@@ -736,9 +764,7 @@ bool ts::ScramblerPlugin::changeCW()
         }
 
         // Generate (or start generating) next ECM when using ECM(N) in cp(N)
-        if (_need_ecm && _current_ecm == _current_cw) {
-            nextCW().initNext(currentCW());
-        }
+        generateLookAhead();
     }
     return true;
 }
@@ -749,15 +775,23 @@ void ts::ScramblerPlugin::changeECM()
     if (_need_ecm && _ts_bitrate != 0 && !inDegradedMode()) {
 
         // Point to next crypto-period
-        _current_ecm = (_current_ecm + 1) & 0x01;
+        _current_ecm = (_current_ecm + 1) % _cp.size();
 
         // Determine new transition point
         _pkt_change_ecm = _packet_count + PacketDistance(_ts_bitrate, _ecmg_args.cp_duration);
 
         // Generate (or start generating) next ECM when using ECM(N) in cp(N)
-        if (_current_ecm == _current_cw) {
-            nextCW().initNext(currentCW());
-        }
+        generateLookAhead();
+    }
+}
+
+void ts::ScramblerPlugin::generateLookAhead()
+{
+    // When using ECM(N) in cp(N), cp(N-1) is no longer used. Its slot in the ring receives cp(N+K).
+    // The ring is never empty, its size is _look_ahead + 1.
+    if (_need_ecm && _current_ecm == _current_cw) {
+        const size_t count = _cp.size();
+        _cp[(_current_cw + count - 1) % count].initNext(_cp[(_current_cw + count - 2) % count]);
     }
 }
 
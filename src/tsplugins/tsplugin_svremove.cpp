@@ -39,9 +39,8 @@
 #include "tsAlgorithm.h"
 #include "tsNames.h"
 #include "tsEITProcessor.h"
-#include "tsCADescriptor.h"
 #include "tsPAT.h"
-#include "tsPMT.h"
+#include "tsPMTView.h"
 #include "tsSDT.h"
 #include "tsBAT.h"
 #include "tsNIT.h"
@@ -85,12 +84,12 @@ namespace ts {
         // Process specific tables and descriptors
         void processPAT(PAT&);
         void processSDT(SDT&);
-        void processPMT(PMT&);
+        void processPMT(const PMTView&);
         void processNITBAT(AbstractTransportListTable&);
         void processNITBATDescriptorList(DescriptorList&);
 
         // Mark all ECM PIDs from the specified descriptor list in the specified PID set
-        void addECMPID(const DescriptorList&, PIDSet&);
+        void addECMPID(const DescriptorListView&, PIDSet&);
     };
 }
 
@@ -243,9 +242,12 @@ void ts::SVRemovePlugin::handleTable(SectionDemux& demux, const BinaryTable& tab
         }
 
         case TID_PMT: {
-            PMT pmt(duck, table);
-            if (pmt.isValid()) {
-                processPMT(pmt);
+            // The PMT is never modified, directly read the binary section.
+            if (table.sectionCount() > 0) {
+                const PMTView pmt(*table.sectionAt(0));
+                if (pmt.isValid()) {
+                    processPMT(pmt);
+                }
             }
             break;
         }
@@ -448,26 +450,26 @@ void ts::SVRemovePlugin::processPAT(PAT& pat)
 //  This method processes a Program Map Table (PMT).
 //----------------------------------------------------------------------------
 
-void ts::SVRemovePlugin::processPMT(PMT& pmt)
+void ts::SVRemovePlugin::processPMT(const PMTView& pmt)
 {
     // Is this the PMT of the service to remove?
-    const bool removed_service = pmt.service_id == _service.getId();
+    const bool removed_service = pmt.serviceId() == _service.getId();
 
     // Mark PIDs as dropped or referenced.
     PIDSet& pid_set(removed_service ? _drop_pids : _ref_pids);
 
     // Mark all program-level ECM PID's
-    addECMPID(pmt.descs, pid_set);
+    addECMPID(pmt.descs(), pid_set);
 
     // Mark service's PCR PID (usually a referenced component or null PID)
-    pid_set.set(pmt.pcr_pid);
+    pid_set.set(pmt.pcrPID());
 
     // Loop on all elementary streams
-    for (const auto& it : pmt.streams) {
+    for (const auto& stream : pmt.streams()) {
         // Mark component's PID
-        pid_set.set(it.first);
+        pid_set.set(stream.pid());
         // Mark all component-level ECM PID's
-        addECMPID(it.second.descs, pid_set);
+        addECMPID(stream.descs(), pid_set);
     }
 
     // When the service to remove has been analyzed, we are ready to filter PIDs
@@ -479,17 +481,13 @@ void ts::SVRemovePlugin::processPMT(PMT& pmt)
 // Mark all ECM PIDs from the descriptor list in the PID set
 //----------------------------------------------------------------------------
 
-void ts::SVRemovePlugin::addECMPID(const DescriptorList& dlist, PIDSet& pid_set)
+void ts::SVRemovePlugin::addECMPID(const DescriptorListView& dlist, PIDSet& pid_set)
 {
     // Loop on all CA descriptors
-    for (size_t index = dlist.search(DID_CA); index < dlist.count(); index = dlist.search(DID_CA, index + 1)) {
-        CADescriptor ca(duck, *dlist[index]);
-        if (!ca.isValid()) {
-            // Cannot deserialize a valid CA descriptor, ignore it
-        }
-        else {
-            // Standard CAS, only one PID in CA descriptor
-            pid_set.set(ca.ca_pid);
+    for (const auto& desc : dlist) {
+        // Ignore truncated CA descriptors. Standard CAS, only one PID in CA descriptor.
+        if (desc.tag() == DID_CA && desc.payloadSize() >= 4) {
+            pid_set.set(GetUInt16(desc.payload() + 2) & 0x1FFF);
         }
     }
 }
@@ -268,7 +268,7 @@ ts::ProcessorPlugin::Status ts::SVResyncPlugin::processPacket(TSPacket& pkt, TSP
             _delta_pts = ref_pcr >= pcr ?
                 (ref_pcr - pcr) / SYSTEM_CLOCK_SUBFACTOR :
                 PTS_DTS_SCALE - (pcr - ref_pcr) / SYSTEM_CLOCK_SUBFACTOR;
-            tsp->debug(u"new delta PTS/DTS: 0x%09X (%'<d)", {_delta_pts});
+            TS_DEBUG(*tsp, u"new delta PTS/DTS: 0x%09X (%'<d)", {_delta_pts});
 
             // Replace PCR with extrapolated reference PCR.
             pkt.setPCR(ref_pcr);
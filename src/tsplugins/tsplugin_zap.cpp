@@ -130,6 +130,9 @@ namespace ts {
         void handleSDT(SDT&);
         void handleVCT(VCT&);
 
+        // Get the context of a selected service with known service id, null if not selected.
+        ServiceContextPtr getSelectedService(uint16_t service_id) const;
+
         // Send a new PAT.
         void sendNewPAT();
 
@@ -535,9 +538,12 @@ void ts::ZapPlugin::handleTable(SectionDemux& demux, const BinaryTable& table)
             break;
         }
         case TID_PMT: {
-            PMT pmt(duck, table);
-            if (pmt.isValid()) {
-                handlePMT(pmt, pid);
+            // Don't deserialize PMT's of non-selected services, they are ignored.
+            if (!getSelectedService(table.tableIdExtension()).isNull()) {
+                PMT pmt(duck, table);
+                if (pmt.isValid()) {
+                    handlePMT(pmt, pid);
+                }
             }
             break;
         }
@@ -685,6 +691,21 @@ void ts::ZapPlugin::handleVCT(VCT& vct)
 }
 
 
+//----------------------------------------------------------------------------
+// Get the context of a selected service with known service id.
+//----------------------------------------------------------------------------
+
+ts::ZapPlugin::ServiceContextPtr ts::ZapPlugin::getSelectedService(uint16_t service_id) const
+{
+    for (const auto& ctx : _services) {
+        if (ctx->id_known && ctx->service_id == service_id) {
+            return ctx;
+        }
+    }
+    return ServiceContextPtr();
+}
+
+
 //----------------------------------------------------------------------------
 // This method processes a Program Map Table (PMT).
 //----------------------------------------------------------------------------
@@ -692,13 +713,7 @@ void ts::ZapPlugin::handleVCT(VCT& vct)
 void ts::ZapPlugin::handlePMT(PMT& pmt, PID pid)
 {
     // Filter out any unexpected PMT.
-    ServiceContextPtr ctx;
-    for (size_t i = 0; ctx.isNull() && i < _services.size(); ++i) {
-        const ServiceContextPtr& ci(_services[i]);
-        if (ci->id_known && ci->service_id == pmt.service_id) {
-            ctx = ci;
-        }
-    }
+    const ServiceContextPtr ctx(getSelectedService(pmt.service_id));
     if (ctx.isNull()) {
         // Not a selected service.
         return;
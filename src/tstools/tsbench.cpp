@@ -0,0 +1,900 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Deterministic offline benchmark of plugin chains.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsTSProcessor.h"
+#include "tsArgsWithPlugins.h"
+#include "tsDuckContext.h"
+#include "tsPluginRepository.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsAsyncReport.h"
+#include "tsOneShotPacketizer.h"
+#include "tsPES.h"
+#include "tsLatencyHistogram.h"
+#include "tsVersionInfo.h"
+#include "tsMonotonic.h"
+#include "tsAllocationTracker.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsSDT.h"
+#include "tsEIT.h"
+#include "tsShortEventDescriptor.h"
+#include "tsjsonObject.h"
+#include "tsjsonArray.h"
+
+#include "tsBeforeStandardHeaders.h"
+#if defined(TS_LINUX)
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+    #include <sys/ioctl.h>
+#endif
+#include <atomic>
+#include "tsAfterStandardHeaders.h"
+TS_MAIN(MainCode);
+
+
+//----------------------------------------------------------------------------
+//  Memory allocation counters.
+//----------------------------------------------------------------------------
+
+// When TSDuck is compiled with allocation tracking, the counters of the library
+// are used. Otherwise, the global allocation operators are replaced in this
+// executable to count the allocations during each run. On Windows, a DLL does
+// not use the allocation operators of the executable, the counters are not
+// significant.
+
+#if defined(TS_ALLOCATION_TRACKING)
+
+namespace {
+    void GetAllocations(uint64_t& count, uint64_t& bytes)
+    {
+        ts::AllocationTracker::GetTotal(count, bytes);
+    }
+}
+
+#else
+
+namespace {
+    std::atomic<uint64_t> alloc_count(0);
+    std::atomic<uint64_t> alloc_bytes(0);
+
+    void GetAllocations(uint64_t& count, uint64_t& bytes)
+    {
+        count = alloc_count;
+        bytes = alloc_bytes;
+    }
+}
+
+#endif
+
+#if !defined(TS_WINDOWS) && !defined(TS_ALLOCATION_TRACKING)
+
+void* operator new(size_t size)
+{
+    alloc_count++;
+    alloc_bytes += size;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+#endif
+
+
+//----------------------------------------------------------------------------
+//  Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class BenchOptions: public ts::ArgsWithPlugins
+    {
+        TS_NOBUILD_NOCOPY(BenchOptions);
+    public:
+        BenchOptions(int argc, char *argv[]);
+
+        // Option values
+        ts::DuckContext     duck;        // TSDuck context
+        size_t              packets;     // Number of packets in the synthetic stream.
+        size_t              repeat;      // Number of runs per scenario.
+        ts::BitRate         bitrate;     // Bitrate of the synthetic stream.
+        size_t              eit_rate;    // Number of EIT schedule sections per second.
+        ts::UStringVector   scenarios;   // Scenarios to run.
+        bool                list;        // List scenarios and exit.
+        bool                json;        // JSON output.
+        ts::UString         output;      // Output file name.
+        ts::TSProcessorArgs tsp_args;    // TS processing arguments, for custom plugin chain.
+    };
+}
+
+BenchOptions::BenchOptions(int argc, char *argv[]) :
+    ts::ArgsWithPlugins(0, 0, 0, UNLIMITED_COUNT, 0, 0, u"Deterministic offline benchmark of plugin chains", u"[options] [-P plugin ...]"),
+    duck(this),
+    packets(0),
+    repeat(0),
+    bitrate(0),
+    eit_rate(0),
+    scenarios(),
+    list(false),
+    json(false),
+    output(),
+    tsp_args()
+{
+    tsp_args.defineArgs(*this);
+
+    option<ts::BitRate>(u"bitrate", 'b');
+    help(u"bitrate",
+         u"Bitrate of the synthetic transport stream. The bitrate drives the PCR values, "
+         u"the proportion of null packets and the cycles of the PSI/SI. "
+         u"The default is 20 Mb/s.");
+
+    option(u"eit-rate", 'e', UNSIGNED);
+    help(u"eit-rate",
+         u"Number of EIT schedule sections per second in the synthetic transport stream. "
+         u"The default is 50.");
+
+    option(u"json", 'j');
+    help(u"json", u"Report the results in JSON format, for regression tracking.");
+
+    option(u"list-scenarios", 'l');
+    help(u"list-scenarios", u"List the predefined scenarios and exit.");
+
+    option(u"output-file", 'o', FILENAME);
+    help(u"output-file", u"filename", u"Save the results in the specified file. By default, the results are displayed on standard output.");
+
+    option(u"packets", 'n', POSITIVE);
+    help(u"packets",
+         u"Number of TS packets in the synthetic transport stream. "
+         u"The stream is generated in memory once and used by all runs. "
+         u"The default is 500,000 packets.");
+
+    option(u"repeat", 'r', POSITIVE);
+    help(u"repeat",
+         u"Number of runs per scenario. The reported results are those of the run with the median duration. "
+         u"The default is 3.");
+
+    option(u"scenario", 's', STRING, 0, UNLIMITED_COUNT);
+    help(u"scenario", u"name",
+         u"Name of a predefined scenario to run. Several --scenario options may be specified. "
+         u"By default, all predefined scenarios are run. "
+         u"When packet processing plugins are specified using -P options, the plugin chain is run "
+         u"as one single scenario named \"custom\", instead of the predefined ones.");
+
+    // Analyze the command.
+    analyze(argc, argv);
+
+    // Load option values.
+    getIntValue(packets, u"packets", 500000);
+    getIntValue(repeat, u"repeat", 3);
+    getValue(bitrate, u"bitrate", 20000000);
+    getIntValue(eit_rate, u"eit-rate", 50);
+    getValues(scenarios, u"scenario");
+    list = present(u"list-scenarios");
+    json = present(u"json");
+    getValue(output, u"output-file");
+    duck.loadArgs(*this);
+    tsp_args.loadArgs(duck, *this);
+
+    // Final checking
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+//  Predefined scenarios.
+//----------------------------------------------------------------------------
+
+namespace {
+#if defined(TS_WINDOWS)
+    const ts::UChar* const NULL_FILE = u"NUL";
+#else
+    const ts::UChar* const NULL_FILE = u"/dev/null";
+#endif
+
+    struct Scenario
+    {
+        const ts::UChar* name;
+        const ts::UChar* description;
+        ts::PluginOptionsVector plugins;
+    };
+
+    const std::vector<Scenario> PredefinedScenarios {
+        {u"passthrough", u"No packet processing, measures the tsp framework overhead", {}},
+        {u"continuity", u"Fix continuity counters", {{u"continuity", {u"--fix"}}}},
+        {u"filter", u"Keep audio and video PID's only", {{u"filter", {u"--pid", u"0x101", u"--pid", u"0x102"}}}},
+        {u"remap", u"Remap audio and video PID's", {{u"remap", {u"0x101=0x201", u"0x102=0x202"}}}},
+        {u"pcrverify", u"Verify PCR values", {{u"pcrverify", {}}}},
+        {u"pes", u"Video and audio attributes, intra images", {{u"pes", {u"--video-attributes", u"--audio-attributes", u"--intra-image", u"--output-file", NULL_FILE}}}},
+        {u"analyze", u"Full transport stream analysis", {{u"analyze", {u"--output-file", NULL_FILE}}}},
+        {u"chain", u"A typical chain of several plugins", {{u"continuity", {u"--fix"}}, {u"pcrverify", {}}, {u"remap", {u"0x101=0x201"}}, {u"analyze", {u"--output-file", NULL_FILE}}}},
+    };
+}
+
+
+//----------------------------------------------------------------------------
+//  Synthetic transport stream generator.
+//----------------------------------------------------------------------------
+
+// One service (id 1), PMT PID 0x100, AVC video PID 0x101 with PCR at 75% of
+// the bitrate, MPEG audio PID 0x102 at 192 kb/s, PAT, PMT, SDT, EIT p/f and
+// EIT schedule, null packets. The content is pseudo-random with a fixed seed.
+
+namespace {
+    class Generator
+    {
+        TS_NOBUILD_NOCOPY(Generator);
+    public:
+        Generator(ts::DuckContext& duck, const ts::BitRate& bitrate, size_t eit_rate);
+        void generate(ts::TSPacketVector& packets, size_t count);
+
+    private:
+        static constexpr ts::PID PMT_PID = 0x100;
+        static constexpr ts::PID VIDEO_PID = 0x101;
+        static constexpr ts::PID AUDIO_PID = 0x102;
+        static constexpr uint16_t SERVICE_ID = 1;
+        static constexpr uint16_t TS_ID = 1;
+        static constexpr uint16_t NETWORK_ID = 1;
+        static constexpr ts::MilliSecond VIDEO_FRAME = 40;
+        static constexpr ts::MilliSecond AUDIO_FRAME = 24;
+        static constexpr size_t AUDIO_FRAME_SIZE = 576;
+        static constexpr size_t GOP_SIZE = 25;
+
+        // A source of packets, in a queue.
+        struct Source
+        {
+            Source(ts::PID pid, ts::MilliSecond period);
+            ts::PID pid;
+            ts::MilliSecond period;
+            ts::MilliSecond next;
+            uint8_t cc;
+            size_t count;
+            std::deque<std::pair<ts::TSPacket, bool>> queue;  // packet, need PCR
+        };
+
+        ts::DuckContext& _duck;
+        ts::BitRate      _bitrate;
+        size_t           _eit_rate;
+        uint32_t         _random;
+        Source           _pat;
+        Source           _pmt;
+        Source           _sdt;
+        Source           _eit_pf;
+        Source           _eit_sched;
+        Source           _video;
+        Source           _audio;
+        ts::OneShotPacketizer _psi_pzer;
+        ts::OneShotPacketizer _eit_pzer;
+
+        uint8_t random();
+        void packetizeTable(Source& src, ts::OneShotPacketizer& pzer, const ts::AbstractTable& table);
+        void packetizePES(Source& src, const ts::ByteBlock& pes, bool pcr);
+        void buildPES(ts::ByteBlock& pes, uint8_t stream_id, uint64_t pts, uint64_t dts, const ts::ByteBlock& payload);
+        void produce(Source& src, ts::MilliSecond now);
+    };
+}
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr ts::PID Generator::PMT_PID;
+constexpr ts::PID Generator::VIDEO_PID;
+constexpr ts::PID Generator::AUDIO_PID;
+constexpr uint16_t Generator::SERVICE_ID;
+constexpr uint16_t Generator::TS_ID;
+constexpr uint16_t Generator::NETWORK_ID;
+constexpr ts::MilliSecond Generator::VIDEO_FRAME;
+constexpr ts::MilliSecond Generator::AUDIO_FRAME;
+constexpr size_t Generator::AUDIO_FRAME_SIZE;
+constexpr size_t Generator::GOP_SIZE;
+#endif
+
+Generator::Source::Source(ts::PID pid_, ts::MilliSecond period_) :
+    pid(pid_),
+    period(period_),
+    next(0),
+    cc(0),
+    count(0),
+    queue()
+{
+}
+
+Generator::Generator(ts::DuckContext& duck, const ts::BitRate& bitrate, size_t eit_rate) :
+    _duck(duck),
+    _bitrate(bitrate),
+    _eit_rate(eit_rate),
+    _random(0x12345678),
+    _pat(ts::PID_PAT, 100),
+    _pmt(PMT_PID, 100),
+    _sdt(ts::PID_SDT, 1000),
+    _eit_pf(ts::PID_EIT, 500),
+    _eit_sched(ts::PID_EIT, eit_rate == 0 ? 0 : std::max<ts::MilliSecond>(1, 1000 / ts::MilliSecond(eit_rate))),
+    _video(VIDEO_PID, VIDEO_FRAME),
+    _audio(AUDIO_PID, AUDIO_FRAME),
+    _psi_pzer(duck),
+    _eit_pzer(duck, ts::PID_EIT)
+{
+}
+
+// Deterministic pseudo-random generator (xorshift), never returns zero
+// to avoid creating start code sequences in video payloads.
+uint8_t Generator::random()
+{
+    _random ^= _random << 13;
+    _random ^= _random >> 17;
+    _random ^= _random << 5;
+    const uint8_t b = uint8_t(_random >> 7);
+    return b == 0 ? 0x80 : b;
+}
+
+// Serialize and packetize a table.
+void Generator::packetizeTable(Source& src, ts::OneShotPacketizer& pzer, const ts::AbstractTable& table)
+{
+    ts::TSPacketVector packets;
+    pzer.setPID(src.pid);
+    pzer.addTable(_duck, table);
+    pzer.getPackets(packets);
+    for (const auto& pkt : packets) {
+        src.queue.push_back(std::make_pair(pkt, false));
+    }
+}
+
+// Build a PES packet.
+void Generator::buildPES(ts::ByteBlock& pes, uint8_t stream_id, uint64_t pts, uint64_t dts, const ts::ByteBlock& payload)
+{
+    const bool has_dts = dts != ts::INVALID_DTS;
+    const size_t header_size = has_dts ? 19 : 14;
+    pes.resize(header_size);
+    pes[0] = pes[1] = 0x00;
+    pes[2] = 0x01;
+    pes[3] = stream_id;
+    // Unbounded video PES, bounded audio PES.
+    ts::PutUInt16(&pes[4], ts::IsVideoSID(stream_id) ? 0 : uint16_t(header_size - 6 + payload.size()));
+    pes[6] = 0x80;
+    pes[7] = has_dts ? 0xC0 : 0x80;
+    pes[8] = uint8_t(header_size - 9);
+    const auto put_ts = [](uint8_t* p, uint8_t prefix, uint64_t value) {
+        p[0] = uint8_t(prefix << 4) | uint8_t((value >> 29) & 0x0E) | 0x01;
+        ts::PutUInt16(p + 1, uint16_t(((value >> 14) & 0xFFFE) | 0x0001));
+        ts::PutUInt16(p + 3, uint16_t(((value << 1) & 0xFFFE) | 0x0001));
+    };
+    put_ts(&pes[9], has_dts ? 0x03 : 0x02, pts);
+    if (has_dts) {
+        put_ts(&pes[14], 0x01, dts);
+    }
+    pes.append(payload);
+}
+
+// Packetize a PES packet, with room for a PCR in the first packet.
+void Generator::packetizePES(Source& src, const ts::ByteBlock& pes, bool pcr)
+{
+    size_t offset = 0;
+    bool first = true;
+    while (offset < pes.size()) {
+        ts::TSPacket pkt;
+        pkt.init(src.pid, src.cc, 0xFF);
+        src.cc = (src.cc + 1) & 0x0F;
+        const bool with_pcr = first && pcr;
+        size_t af_size = with_pcr ? 8 : 0;  // including length field
+        const size_t remain = pes.size() - offset;
+        if (remain < ts::PKT_SIZE - 4 - af_size) {
+            af_size = ts::PKT_SIZE - 4 - remain;
+        }
+        pkt.b[1] = uint8_t((pkt.b[1] & 0x1F) | (first ? 0x40 : 0x00));
+        if (af_size > 0) {
+            pkt.b[3] |= 0x20;
+            pkt.b[4] = uint8_t(af_size - 1);
+            if (af_size > 1) {
+                pkt.b[5] = with_pcr ? 0x10 : 0x00;
+            }
+            if (with_pcr) {
+                ::memset(pkt.b + 6, 0, 6);
+            }
+        }
+        const size_t size = ts::PKT_SIZE - 4 - af_size;
+        ::memcpy(pkt.b + 4 + af_size, pes.data() + offset, size);
+        offset += size;
+        src.queue.push_back(std::make_pair(pkt, with_pcr));
+        first = false;
+    }
+}
+
+// Produce the next content of a source.
+void Generator::produce(Source& src, ts::MilliSecond now)
+{
+    // PTS/DTS are 600 ms ahead of PCR.
+    const uint64_t dts = uint64_t(now + 600) * (ts::SYSTEM_CLOCK_SUBFREQ / 1000);
+
+    if (&src == &_pat) {
+        ts::PAT pat(0, true, TS_ID);
+        pat.pmts[SERVICE_ID] = PMT_PID;
+        packetizeTable(src, _psi_pzer, pat);
+    }
+    else if (&src == &_pmt) {
+        ts::PMT pmt(0, true, SERVICE_ID, VIDEO_PID);
+        pmt.streams[VIDEO_PID].stream_type = ts::ST_AVC_VIDEO;
+        pmt.streams[AUDIO_PID].stream_type = ts::ST_MPEG1_AUDIO;
+        packetizeTable(src, _psi_pzer, pmt);
+    }
+    else if (&src == &_sdt) {
+        ts::SDT sdt(true, 0, true, TS_ID, NETWORK_ID);
+        sdt.services[SERVICE_ID].setName(_duck, u"Benchmark");
+        sdt.services[SERVICE_ID].running_status = 4;
+        packetizeTable(src, _psi_pzer, sdt);
+    }
+    else if (&src == &_eit_pf || &src == &_eit_sched) {
+        // EIT schedule sections cycle over 4 days, with 4 events per section.
+        const bool pf = &src == &_eit_pf;
+        ts::EIT eit(true, pf, 0, 0, true, SERVICE_ID, TS_ID, NETWORK_ID);
+        const ts::Time base(2023, 1, 1, 0, 0, 0);
+        const size_t segment = pf ? 0 : src.count % 32;
+        for (size_t i = 0; i < (pf ? 2 : 4); ++i) {
+            ts::EIT::Event& ev(eit.events.newEntry());
+            ev.event_id = uint16_t(segment * 4 + i);
+            ev.start_time = base + ts::MilliSecond(segment) * ts::EIT::SEGMENT_DURATION + ts::MilliSecond(i) * 45 * ts::MilliSecPerMin;
+            ev.duration = 45 * 60;
+            ev.running_status = pf && i == 0 ? 4 : 1;
+            ev.descs.add(_duck, ts::ShortEventDescriptor(u"eng", ts::UString::Format(u"Event %d", {ev.event_id}), u"Synthetic event for benchmark"));
+        }
+        packetizeTable(src, _eit_pzer, eit);
+    }
+    else if (&src == &_video) {
+        // One AVC access unit: AUD, SPS at each GOP, IDR or non-IDR slice.
+        static const uint8_t aud[] = {0x00, 0x00, 0x00, 0x01, 0x09, 0xF0};
+        static const uint8_t sps[] = {0x00, 0x00, 0x00, 0x01, 0x67, 0x64, 0x00, 0x28, 0xAC, 0xD9, 0x40, 0x78, 0x02, 0x27, 0xE5, 0xC0,
+                                      0x44, 0x00, 0x00, 0x03, 0x00, 0x04, 0x00, 0x00, 0x03, 0x00, 0xC8, 0x3C, 0x60, 0xC6, 0x58};
+        const bool idr = src.count % GOP_SIZE == 0;
+        const size_t frame_size = size_t(((_bitrate * 3) / 4).toInt() * VIDEO_FRAME / (8 * ts::MilliSecPerSec));
+        ts::ByteBlock payload(aud, sizeof(aud));
+        if (idr) {
+            payload.append(sps, sizeof(sps));
+        }
+        payload.appendUInt32(idr ? 0x00000165 : 0x00000141);
+        while (payload.size() < frame_size) {
+            payload.push_back(random());
+        }
+        ts::ByteBlock pes;
+        buildPES(pes, 0xE0, dts + 3600, dts, payload);
+        packetizePES(src, pes, true);
+    }
+    else if (&src == &_audio) {
+        ts::ByteBlock payload(AUDIO_FRAME_SIZE);
+        payload[0] = 0xFF;
+        payload[1] = 0xFD;
+        payload[2] = 0xA4;
+        payload[3] = 0x04;
+        for (size_t i = 4; i < payload.size(); ++i) {
+            payload[i] = random();
+        }
+        ts::ByteBlock pes;
+        buildPES(pes, 0xC0, dts, ts::INVALID_DTS, payload);
+        packetizePES(src, pes, false);
+    }
+    src.count++;
+}
+
+// Generate the synthetic transport stream.
+void Generator::generate(ts::TSPacketVector& packets, size_t count)
+{
+    // Sources by order of priority.
+    Source* const sources[] = {&_pat, &_pmt, &_sdt, &_eit_pf, &_eit_sched, &_audio, &_video};
+    const ts::BitRate::int_t bitrate = _bitrate.toInt();
+
+    packets.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        // Current time in PCR units.
+        const uint64_t pcr = uint64_t(i) * ts::PKT_SIZE_BITS * ts::SYSTEM_CLOCK_FREQ / uint64_t(bitrate);
+        const ts::MilliSecond now = ts::MilliSecond(pcr / (ts::SYSTEM_CLOCK_FREQ / ts::MilliSecPerSec));
+
+        // Produce content for all sources which are due.
+        for (auto src : sources) {
+            while (src->period > 0 && src->next <= now) {
+                produce(*src, src->next);
+                src->next += src->period;
+            }
+        }
+
+        // Take the first available packet.
+        packets[i] = ts::NullPacket;
+        for (auto src : sources) {
+            if (!src->queue.empty()) {
+                packets[i] = src->queue.front().first;
+                if (src->queue.front().second) {
+                    packets[i].setPCR(pcr);
+                }
+                src->queue.pop_front();
+                break;
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Hardware performance counters (Linux only).
+//----------------------------------------------------------------------------
+
+namespace {
+    class PerfCounters
+    {
+        TS_NOCOPY(PerfCounters);
+    public:
+        static constexpr size_t COUNT = 3;
+        static const ts::UChar* const NAMES[COUNT];
+
+        PerfCounters();
+        ~PerfCounters();
+        bool isAvailable() const;
+        void start();
+        void stop();
+        int64_t value(size_t index) const { return index < COUNT ? _values[index] : -1; }
+
+    private:
+        int     _fd[COUNT];
+        int64_t _values[COUNT];
+    };
+}
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t PerfCounters::COUNT;
+#endif
+
+const ts::UChar* const PerfCounters::NAMES[COUNT] = {u"cycles", u"instructions", u"cache-misses"};
+
+PerfCounters::PerfCounters() :
+    _fd{-1, -1, -1},
+    _values{-1, -1, -1}
+{
+#if defined(TS_LINUX)
+    // Count in all threads which are created after opening the counters (plugin threads).
+    static const uint64_t configs[COUNT] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+    for (size_t i = 0; i < COUNT; ++i) {
+        ::perf_event_attr attr;
+        TS_ZERO(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        _fd[i] = int(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#if defined(TS_LINUX)
+    for (size_t i = 0; i < COUNT; ++i) {
+        if (_fd[i] >= 0) {
+            ::close(_fd[i]);
+        }
+    }
+#endif
+}
+
+bool PerfCounters::isAvailable() const
+{
+    for (size_t i = 0; i < COUNT; ++i) {
+        if (_fd[i] >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PerfCounters::start()
+{
+#if defined(TS_LINUX)
+    for (size_t i = 0; i < COUNT; ++i) {
+        if (_fd[i] >= 0) {
+            ::ioctl(_fd[i], PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+void PerfCounters::stop()
+{
+    for (size_t i = 0; i < COUNT; ++i) {
+        _values[i] = -1;
+#if defined(TS_LINUX)
+        uint64_t val = 0;
+        if (_fd[i] >= 0 && ::ioctl(_fd[i], PERF_EVENT_IOC_DISABLE, 0) == 0 && ::read(_fd[i], &val, sizeof(val)) == ssize_t(sizeof(val))) {
+            _values[i] = int64_t(val);
+        }
+#endif
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Event handlers for memory input and output plugins.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Input: send all packets of the synthetic stream, as fast as possible.
+    class Input : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Input);
+    public:
+        Input(const ts::TSPacketVector& packets) : _packets(packets), _next(0) {}
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        const ts::TSPacketVector& _packets;
+        size_t _next;
+    };
+
+    void Input::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr && _next < _packets.size()) {
+            const size_t count = std::min(_packets.size() - _next, data->maxSize() / ts::PKT_SIZE);
+            data->append(&_packets[_next], count * ts::PKT_SIZE);
+            _next += count;
+        }
+    }
+
+    // Output: count packets.
+    class Output : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Output);
+    public:
+        Output(ts::PacketCounter& count) : _count(count) {}
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        ts::PacketCounter& _count;
+    };
+
+    void Output::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        const ts::PluginEventData* data = dynamic_cast<const ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr) {
+            _count += data->size() / ts::PKT_SIZE;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Run one scenario.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Result of one run.
+    struct RunResult
+    {
+        ts::NanoSecond duration = 0;
+        ts::PacketCounter output_packets = 0;
+        uint64_t allocs = 0;
+        uint64_t alloc_bytes = 0;
+        int64_t perf[PerfCounters::COUNT] = {-1, -1, -1};
+        std::vector<ts::TSProcessor::PluginStatistics> plugins {};
+    };
+
+    // Run a scenario several times, return the run with median duration.
+    bool RunScenario(BenchOptions& opt, ts::Report& report, const ts::PluginOptionsVector& plugins, const ts::TSPacketVector& packets, PerfCounters& perf, RunResult& result)
+    {
+        std::vector<RunResult> runs(opt.repeat);
+
+        for (auto& run : runs) {
+            ts::TSProcessorArgs args(opt.tsp_args);
+            args.input = {u"memory", {}};
+            args.output = {u"memory", {}};
+            args.plugins = plugins;
+
+            Input input(packets);
+            Output output(run.output_packets);
+            ts::TSProcessor tsproc(report);
+            tsproc.registerEventHandler(&input, ts::PluginType::INPUT);
+            tsproc.registerEventHandler(&output, ts::PluginType::OUTPUT);
+
+            uint64_t allocs = 0;
+            uint64_t bytes = 0;
+            GetAllocations(allocs, bytes);
+            perf.start();
+            const ts::Monotonic start(true);
+
+            if (!tsproc.start(args)) {
+                return false;
+            }
+            tsproc.waitForTermination();
+
+            run.duration = ts::Monotonic(true) - start;
+            perf.stop();
+            GetAllocations(run.allocs, run.alloc_bytes);
+            run.allocs -= allocs;
+            run.alloc_bytes -= bytes;
+            for (size_t i = 0; i < PerfCounters::COUNT; ++i) {
+                run.perf[i] = perf.value(i);
+            }
+            tsproc.getPluginStatistics(run.plugins);
+        }
+
+        std::sort(runs.begin(), runs.end(), [](const RunResult& r1, const RunResult& r2) { return r1.duration < r2.duration; });
+        result = runs[runs.size() / 2];
+        return true;
+    }
+
+    // Format a per-packet value.
+    ts::UString PerPacket(int64_t value, ts::PacketCounter packets)
+    {
+        return value < 0 || packets == 0 ? ts::UString(u"n/a") : ts::UString::Format(u"%.2f", {double(value) / double(packets)});
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Program main code.
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    // Get command line options.
+    BenchOptions opt(argc, argv);
+    CERR.setMaxSeverity(opt.maxSeverity());
+
+    // Just list the predefined scenarios.
+    if (opt.list) {
+        for (const auto& sc : PredefinedScenarios) {
+            std::cout << ts::UString::Format(u"%-12s %s", {sc.name, sc.description}) << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Build the list of scenarios to run.
+    std::vector<Scenario> scenarios;
+    if (!opt.tsp_args.plugins.empty()) {
+        scenarios.push_back({u"custom", u"Plugin chain from the command line", opt.tsp_args.plugins});
+    }
+    else if (opt.scenarios.empty()) {
+        scenarios = PredefinedScenarios;
+    }
+    else {
+        for (const auto& name : opt.scenarios) {
+            const auto it = std::find_if(PredefinedScenarios.begin(), PredefinedScenarios.end(), [&name](const Scenario& sc) { return name == sc.name; });
+            if (it == PredefinedScenarios.end()) {
+                opt.error(u"unknown scenario %s, use --list-scenarios", {name});
+                return EXIT_FAILURE;
+            }
+            scenarios.push_back(*it);
+        }
+    }
+
+    // Generate the synthetic transport stream once.
+    ts::TSPacketVector packets;
+    Generator gen(opt.duck, opt.bitrate, opt.eit_rate);
+    gen.generate(packets, opt.packets);
+    opt.verbose(u"generated %'d packets, %'d b/s", {packets.size(), opt.bitrate});
+
+    // With allocation tracking in the library, count all allocations.
+    ts::AllocationTracker::Enable();
+
+    // Logs from plugins during the runs: warnings and errors only.
+    ts::AsyncReport report(std::min<int>(opt.maxSeverity(), ts::Severity::Warning));
+    PerfCounters perf;
+    if (!perf.isAvailable()) {
+        opt.verbose(u"hardware performance counters are not available");
+    }
+
+    // Results.
+    ts::json::Object jroot;
+    jroot.add(u"version", ts::VersionInfo::GetVersion());
+    jroot.add(u"packets", int64_t(packets.size()));
+    jroot.add(u"bitrate", int64_t(opt.bitrate.toInt()));
+    jroot.add(u"runs", int64_t(opt.repeat));
+    ts::json::ValuePtr jscenarios(new ts::json::Array);
+    ts::UStringList lines;
+    lines.push_back(ts::UString::Format(u"%-12s %12s %10s %10s %12s %12s", {u"Scenario", u"Packets/s", u"ns/packet", u"Alloc/pkt", u"Instr/pkt", u"CMiss/pkt"}));
+
+    int status = EXIT_SUCCESS;
+    for (const auto& sc : scenarios) {
+        RunResult res;
+        if (!RunScenario(opt, report, sc.plugins, packets, perf, res)) {
+            opt.error(u"error running scenario %s", {sc.name});
+            status = EXIT_FAILURE;
+            continue;
+        }
+        const ts::PacketCounter count = packets.size();
+        const int64_t rate = res.duration <= 0 ? 0 : int64_t(count * ts::NanoSecPerSec / res.duration);
+
+        ts::json::ValuePtr jsc(new ts::json::Object);
+        jsc->add(u"name", sc.name);
+        jsc->add(u"duration-ns", res.duration);
+        jsc->add(u"output-packets", int64_t(res.output_packets));
+        jsc->add(u"packets-per-second", rate);
+        jsc->add(u"ns-per-packet", res.duration / ts::NanoSecond(count));
+        jsc->add(u"allocations", int64_t(res.allocs));
+        jsc->add(u"allocated-bytes", int64_t(res.alloc_bytes));
+        for (size_t i = 0; i < PerfCounters::COUNT; ++i) {
+            if (res.perf[i] >= 0) {
+                jsc->query(u"perf", true).add(PerfCounters::NAMES[i], res.perf[i]);
+            }
+        }
+        ts::json::ValuePtr jplugins(new ts::json::Array);
+        for (const auto& ps : res.plugins) {
+            ts::json::ValuePtr jp(new ts::json::Object);
+            jp->add(u"name", ps.name);
+            jp->add(u"type", ts::PluginTypeNames.name(ps.type));
+            jp->add(u"packets", int64_t(ps.packets));
+            jp->add(u"ns-per-packet", ps.packets == 0 ? 0 : ps.work_ns / ts::NanoSecond(ps.packets));
+            jp->add(u"packet-p50-ns", ps.packet_p50_ns);
+            jp->add(u"packet-p99-ns", ps.packet_p99_ns);
+            jplugins->set(jp);
+        }
+        jsc->add(u"plugins", jplugins);
+        jscenarios->set(jsc);
+
+        lines.push_back(ts::UString::Format(u"%-12s %12'd %10d %10s %12s %12s",
+                                            {sc.name, rate, res.duration / ts::NanoSecond(count), PerPacket(int64_t(res.allocs), count),
+                                             PerPacket(res.perf[1], count), PerPacket(res.perf[2], count)}));
+        for (const auto& ps : res.plugins) {
+            lines.push_back(ts::UString::Format(u"    %-20s %10d ns/packet, p50: %s, p99: %s",
+                                                {ps.name, ps.packets == 0 ? 0 : ps.work_ns / ts::NanoSecond(ps.packets),
+                                                 ts::LatencyHistogram::DurationString(ps.packet_p50_ns),
+                                                 ts::LatencyHistogram::DurationString(ps.packet_p99_ns)}));
+        }
+    }
+    jroot.add(u"scenarios", jscenarios);
+
+    // Output the results.
+    std::ofstream file;
+    if (!opt.output.empty()) {
+        file.open(opt.output.toUTF8().c_str());
+        if (!file) {
+            opt.error(u"error creating %s", {opt.output});
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream& out(opt.output.empty() ? std::cout : file);
+    if (opt.json) {
+        out << jroot.printed() << std::endl;
+    }
+    else {
+        for (const auto& line : lines) {
+            out << line << std::endl;
+        }
+    }
+    return status;
+}
@@ -64,6 +64,7 @@ namespace {
         bool                toJSON;          // Decompile to JSON.
         bool                xmlModel;        // Display XML model instead of compilation.
         bool                withExtensions;  // XML model with extensions.
+        size_t              maxThreads;      // Maximum number of compilation threads.
         ts::SectionFileArgs sectionOptions;  // Section file processing options.
         ts::xml::Tweaks     xmlTweaks;       // XML formatting options.
     };
@@ -83,6 +84,7 @@ Options::Options(int argc, char *argv[]) :
     toJSON(false),
     xmlModel(false),
     withExtensions(false),
+    maxThreads(0),
     sectionOptions(),
     xmlTweaks()
 {
@@ -140,6 +142,13 @@ Options::Options(int argc, char *argv[]) :
          u"The default output file for the standard input (\"-\") is the standard output (\"-\"). "
          u"If more than one input file is specified, the output path, if present, must be either a directory name or \"-\".");
 
+    option(u"threads", 0, UNSIGNED);
+    help(u"threads", u"count",
+         u"Maximum number of threads to compile large XML or JSON files. "
+         u"The tables are compiled in parallel but the order of the tables in the binary file is preserved. "
+         u"The default is the number of processors in the system. "
+         u"With --threads 1, the tables are compiled sequentially.");
+
     option(u"xml-model", 'x');
     help(u"xml-model",
          u"Display the XML model of the table files. This model is not a full "
@@ -161,6 +170,7 @@ Options::Options(int argc, char *argv[]) :
     toJSON = present(u"json") || outFile.endWith(ts::SectionFile::DEFAULT_JSON_SECTION_FILE_SUFFIX);
     xmlModel = present(u"xml-model");
     withExtensions = present(u"extensions");
+    getIntValue(maxThreads, u"threads", 0);
     useStdIn = ts::UString(u"-").isContainedSimilarIn(inFiles);
     useStdOut = outFile == u"-";
     outIsDir = !useStdOut && !outFile.empty() && ts::IsDirectory(outFile);
@@ -248,6 +258,7 @@ namespace {
         ts::SectionFile file(opt.duck);
         file.setTweaks(opt.xmlTweaks);
         file.setCRCValidation(ts::CRC32::CHECK);
+        file.setMaxThreads(opt.maxThreads);
 
         ts::ReportWithPrefix report(opt, (useStdIn ? u"stdin" : ts::BaseName(infile)) + u": ");
 
@@ -38,6 +38,8 @@
 #include "tsTablesDisplay.h"
 #include "tsUDPReceiver.h"
 #include "tsTablesLogger.h"
+#include "tsTablesLogFile.h"
+#include "tsFileUtils.h"
 #include "tsSection.h"
 #include "tsIPProtocols.h"
 #include "tsSysUtils.h"
@@ -65,6 +67,9 @@ namespace {
         size_t                max_tables;        // Max number of tables to dump.
         size_t                max_invalid_udp;   // Max number of invalid UDP messages before giving up.
         bool                  no_encapsulation;  // Raw sections in UDP messages.
+        bool                  tlv_input;         // Input files contain TLV messages.
+        ts::PIDSet            pids;              // With --tlv-input, filter PID's.
+        std::set<ts::TID>     tids;              // With --tlv-input, filter table ids.
     };
 }
 
@@ -78,7 +83,10 @@ Options::Options(int argc, char *argv[]) :
     crc_validation(ts::CRC32::CHECK),
     max_tables(0),
     max_invalid_udp(16),
-    no_encapsulation(false)
+    no_encapsulation(false),
+    tlv_input(false),
+    pids(),
+    tids()
 {
     duck.defineArgsForCAS(*this);
     duck.defineArgsForPDS(*this);
@@ -111,6 +119,27 @@ Options::Options(int argc, char *argv[]) :
          u"With --ip-udp, receive the tables as raw binary messages in UDP packets. "
          u"By default, the tables are formatted into TLV messages.");
 
+    option(u"pid", 'p', PIDVAL, 0, UNLIMITED_COUNT);
+    help(u"pid", u"pid1[-pid2]",
+         u"With --tlv-input, dump only the tables from the specified PID's. "
+         u"Several --pid options may be specified. "
+         u"When the TLV file has an index file (see option --tlv-index in tstables), "
+         u"only the selected messages are read.");
+
+    option(u"tid", 't', UINT8, 0, UNLIMITED_COUNT);
+    help(u"tid", u"tid1[-tid2]",
+         u"With --tlv-input, dump only the tables with the specified table id's. "
+         u"Several --tid options may be specified. "
+         u"When the TLV file has an index file (see option --tlv-index in tstables), "
+         u"only the selected messages are read.");
+
+    option(u"tlv-input");
+    help(u"tlv-input",
+         u"The input files contain TLV messages, as saved by the utility 'tstables' or "
+         u"the plugin 'tables' with option --tlv-output. "
+         u"The source PID and the collection time of each table are displayed before the table. "
+         u"By default, the input files contain binary sections.");
+
     analyze(argc, argv);
 
     duck.loadArgs(*this);
@@ -121,16 +150,54 @@ Options::Options(int argc, char *argv[]) :
     getValues(infiles, u"");
     max_tables = intValue<size_t>(u"max-tables", std::numeric_limits<size_t>::max());
     no_encapsulation = present(u"no-encapsulation");
+    tlv_input = present(u"tlv-input");
+    getIntValues(pids, u"pid", !present(u"pid"));
+    getIntValues(tids, u"tid");
     crc_validation = present(u"ignore-crc32") ? ts::CRC32::IGNORE : ts::CRC32::CHECK;
 
     if (!infiles.empty() && udp.receiverSpecified()) {
         error(u"specify input files or --ip-udp, but not both");
     }
+    if (tlv_input && udp.receiverSpecified()) {
+        error(u"--tlv-input and --ip-udp are mutually exclusive");
+    }
+    if ((present(u"pid") || present(u"tid")) && !tlv_input) {
+        error(u"--pid and --tid can be used only with --tlv-input");
+    }
 
     exitOnError();
 }
 
 
+//----------------------------------------------------------------------------
+//  Dump the sections from one UDP or TLV message.
+//----------------------------------------------------------------------------
+
+namespace {
+    void DumpMessage(Options& opt, const ts::SectionPtrVector& sections)
+    {
+        // Check if a complete table is available.
+        ts::BinaryTable table(sections, false, false);
+        if (table.isValid()) {
+            // Complete table available, dump as a table.
+            opt.display.displayTable(table);
+            opt.display.out() << std::endl;
+            opt.max_tables--;
+        }
+        else {
+            // Complete table not available, dump as individual sections.
+            for (auto it = sections.begin(); opt.max_tables > 0 && it != sections.end(); ++it) {
+                if (!it->isNull()) {
+                    opt.display.displaySection(**it);
+                    opt.display.out() << std::endl;
+                    opt.max_tables--;
+                }
+            }
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 //  Dump sections from UDP. Return true on success.
 //----------------------------------------------------------------------------
@@ -169,25 +236,7 @@ namespace {
 
                     // Valid message, reset the number of consecutive invalid messages.
                     invalid_msg = 0;
-
-                    // Check if a complete table is available.
-                    ts::BinaryTable table(sections, false, false);
-                    if (table.isValid()) {
-                        // Complete table available, dump as a table.
-                        opt.display.displayTable(table);
-                        opt.display.out() << std::endl;
-                        opt.max_tables--;
-                    }
-                    else {
-                        // Complete table not available, dump as individual sections.
-                        for (auto it = sections.begin(); opt.max_tables > 0 && it != sections.end(); ++it) {
-                            if (!it->isNull()) {
-                                opt.display.displaySection(**it);
-                                opt.display.out() << std::endl;
-                                opt.max_tables--;
-                            }
-                        }
-                    }
+                    DumpMessage(opt, sections);
                 }
                 else {
                     // Cannot analyze UDP message, invalid message.
@@ -207,6 +256,94 @@ namespace {
 }
 
 
+//----------------------------------------------------------------------------
+//  Dump TLV messages in a file. Return true on success.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Check if a table is selected by --pid and --tid.
+    bool SelectedTable(const Options& opt, ts::PID pid, ts::TID tid)
+    {
+        return opt.pids.test(pid) && (opt.tids.empty() || opt.tids.count(tid) != 0);
+    }
+
+    // Analyze and dump one TLV message.
+    bool DumpTLVMessage(Options& opt, const ts::ByteBlock& msg, uint64_t offset, const ts::UString& display_name)
+    {
+        ts::SectionPtrVector sections;
+        ts::Time timestamp;
+        if (!ts::TablesLogger::AnalyzeUDPMessage(msg.data(), msg.size(), false, sections, timestamp) || sections.empty() || sections[0].isNull()) {
+            opt.error(u"invalid TLV message at offset %'d in %s", {offset, display_name});
+            return false;
+        }
+        const ts::PID pid = sections[0]->sourcePID();
+        if (SelectedTable(opt, pid, sections[0]->tableId())) {
+            opt.display.out() << ts::UString::Format(u"* PID 0x%X (%d)", {pid, pid});
+            if (timestamp != ts::Time::Epoch) {
+                opt.display.out() << ", at " << timestamp;
+            }
+            opt.display.out() << std::endl;
+            DumpMessage(opt, sections);
+        }
+        return true;
+    }
+
+    bool DumpTLVFile(Options& opt, const ts::UString& file_name)
+    {
+        const ts::UString display_name(file_name.empty() ? u"standard input" : file_name);
+        opt.duck.setOutput(&opt.pager.output(opt), false);
+
+        // Open the input file. The messages are read one by one, the file is never loaded in memory.
+        std::ifstream file;
+        if (file_name.empty()) {
+            // no input file specified, use standard input
+            SetBinaryModeStdin(opt);
+        }
+        else {
+            file.open(file_name.toUTF8().c_str(), std::ios::in | std::ios::binary);
+            if (!file) {
+                opt.error(u"cannot open %s", {file_name});
+                return false;
+            }
+        }
+        std::istream& strm(file_name.empty() ? std::cin : file);
+        ts::ByteBlock msg;
+
+        // With a PID or TID selection, use the index file when there is one to read the selected messages only.
+        const ts::UString index_name(file_name.empty() ? ts::UString() : ts::TablesLogFile::IndexFileName(file_name));
+        if ((opt.pids.count() < opt.pids.size() || !opt.tids.empty()) && !index_name.empty() && ts::FileExists(index_name)) {
+            ts::TablesLogFile::IndexEntryVector index;
+            if (!ts::TablesLogFile::LoadIndex(index_name, index, opt)) {
+                return false;
+            }
+            opt.debug(u"using index file %s, %d entries", {index_name, index.size()});
+            for (auto it = index.begin(); opt.max_tables > 0 && it != index.end(); ++it) {
+                if (SelectedTable(opt, it->pid, it->tid)) {
+                    if (!strm.seekg(std::streamoff(it->offset)) || ts::TablesLogFile::ReadMessage(strm, msg, opt) == 0) {
+                        opt.error(u"cannot read TLV message at offset %'d in %s", {it->offset, display_name});
+                        return false;
+                    }
+                    if (!DumpTLVMessage(opt, msg, it->offset, display_name)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Read all TLV messages sequentially.
+        uint64_t offset = 0;
+        while (opt.max_tables > 0 && ts::TablesLogFile::ReadMessage(strm, msg, opt) > 0) {
+            if (!DumpTLVMessage(opt, msg, offset, display_name)) {
+                return false;
+            }
+            offset += msg.size();
+        }
+        return !opt.gotErrors();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 //  Dump sections in a file. Return true on success.
 //----------------------------------------------------------------------------
@@ -219,6 +356,11 @@ namespace {
             opt.pager.output(opt) << "* File: " << file_name << std::endl << std::endl;
         }
 
+        // Files of TLV messages are separately processed.
+        if (opt.tlv_input) {
+            return DumpTLVFile(opt, file_name);
+        }
+
         // Load all sections
         bool ok = false;
         ts::SectionFile file(opt.duck);
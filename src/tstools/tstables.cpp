@@ -36,6 +36,8 @@
 #include "tsTSFile.h"
 #include "tsTablesDisplay.h"
 #include "tsTablesLogger.h"
+#include "tsTablesLogFile.h"
+#include "tsSysUtils.h"
 #include "tsPagerArgs.h"
 TS_MAIN(MainCode);
 
@@ -57,6 +59,7 @@ namespace {
         ts::PagerArgs      pager;    // Output paging options.
         ts::UString        infile;   // Input file name.
         ts::TSPacketFormat format;   // Input file format.
+        bool               tlv_input; // Input file contains TLV messages.
     };
 }
 
@@ -67,7 +70,8 @@ Options::Options(int argc, char *argv[]) :
     logger(display),
     pager(true, true),
     infile(),
-    format(ts::TSPacketFormat::AUTODETECT)
+    format(ts::TSPacketFormat::AUTODETECT),
+    tlv_input(false)
 {
     duck.defineArgsForCAS(*this);
     duck.defineArgsForPDS(*this);
@@ -82,6 +86,14 @@ Options::Options(int argc, char *argv[]) :
     option(u"", 0, FILENAME, 0, 1);
     help(u"", u"Input transport stream file (standard input if omitted).");
 
+    option(u"tlv-input");
+    help(u"tlv-input",
+         u"The input file is not a transport stream. It contains TLV messages, as saved by "
+         u"the option --tlv-output. The tables from the file are filtered and logged as if they "
+         u"were extracted from a transport stream. This is typically used to convert a TLV archive "
+         u"into XML or JSON files. The collection time of each table is preserved in the output "
+         u"with option --time-stamp.");
+
     analyze(argc, argv);
 
     duck.loadArgs(*this);
@@ -91,6 +103,7 @@ Options::Options(int argc, char *argv[]) :
 
     getValue(infile, u"");
     format = ts::LoadTSPacketFormatInputOption(*this);
+    tlv_input = present(u"tlv-input");
 
     exitOnError();
 }
@@ -113,6 +126,36 @@ int MainCode(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
+    if (opt.tlv_input) {
+        // Read all TLV messages in the file and pass their sections to the logger.
+        std::ifstream file;
+        if (opt.infile.empty()) {
+            SetBinaryModeStdin(opt);
+        }
+        else {
+            file.open(opt.infile.toUTF8().c_str(), std::ios::in | std::ios::binary);
+            if (!file) {
+                opt.error(u"cannot open %s", {opt.infile});
+                return EXIT_FAILURE;
+            }
+        }
+        std::istream& strm(opt.infile.empty() ? std::cin : file);
+        ts::ByteBlock msg;
+        ts::SectionPtrVector sections;
+        ts::Time timestamp;
+        while (!opt.logger.completed() && ts::TablesLogFile::ReadMessage(strm, msg, opt) > 0) {
+            if (ts::TablesLogger::AnalyzeUDPMessage(msg.data(), msg.size(), false, sections, timestamp)) {
+                opt.logger.feedSections(sections, timestamp);
+            }
+            else {
+                opt.error(u"invalid TLV message in %s", {opt.infile.empty() ? u"standard input" : opt.infile});
+                break;
+            }
+        }
+        opt.logger.close();
+        return opt.logger.hasErrors() || opt.gotErrors() ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
     // Open the TS file.
     ts::TSFile file;
     if (!file.openRead(opt.infile, 1, 0, opt, opt.format)) {
@@ -38,14 +38,12 @@
 #include "tsIPv4SocketAddress.h"
 #include "tstlvLogger.h"
 #include "tstlvConnection.h"
+#include "tsSocketPoller.h"
 #include "tsAsyncReport.h"
 #include "tsNullReport.h"
 #include "tsSingleDataStatistics.h"
-#include "tsMutex.h"
-#include "tsGuardMutex.h"
-#include "tsCondition.h"
-#include "tsGuardCondition.h"
-#include <atomic>
+#include "tsLatencyHistogram.h"
+#include "tsMonotonic.h"
 TS_MAIN(MainCode);
 
 
@@ -75,6 +73,7 @@ namespace {
         uint16_t              first_ecm_id;
         size_t                cw_size;
         size_t                max_ecm;
+        size_t                pipeline;
         ts::Second            max_seconds;
         int                   log_protocol;
         int                   log_data;
@@ -98,6 +97,7 @@ CmdOptions::CmdOptions(int argc, char *argv[]) :
     first_ecm_id(0),
     cw_size(0),
     max_ecm(0),
+    pipeline(0),
     max_seconds(0),
     log_protocol(0),
     log_data(0)
@@ -119,6 +119,7 @@ CmdOptions::CmdOptions(int argc, char *argv[]) :
     help(u"channels",
          u"Specify the number of channels to open. "
          u"There is one TCP connection to the ECMG per channel. "
+         u"All connections are handled in one single thread. "
          u"The default is 10.");
 
     option(u"cp-duration", 0, Args::POSITIVE);
@@ -176,6 +177,12 @@ CmdOptions::CmdOptions(int argc, char *argv[]) :
          u"Stop the test after the specified number of seconds. "
          u"By default, the test endlessly runs.");
 
+    option(u"pipeline", 'p', Args::POSITIVE);
+    help(u"pipeline", u"count",
+         u"Specify the number of CW_provision requests which are sent in advance for each stream, "
+         u"without waiting for the ECM_response of the previous ones. "
+         u"The default is 1, one request per crypto-period, after the response to the previous one.");
+
     option(u"streams-per-channel", 's', Args::UINT16);
     help(u"streams-per-channel",
          u"Specify the number of streams to open in each channel. "
@@ -210,6 +217,7 @@ CmdOptions::CmdOptions(int argc, char *argv[]) :
     getIntValue(stat_interval, u"statistics-interval", 10);
     getIntValue(max_ecm, u"max-ecm");
     getIntValue(max_seconds, u"max-seconds");
+    getIntValue(pipeline, u"pipeline", 1);
     log_protocol = present(u"log-protocol") ? intValue<int>(u"log-protocol", ts::Severity::Info) : ts::Severity::Debug;
     log_data = present(u"log-data") ? intValue<int>(u"log-data", ts::Severity::Info) : log_protocol;
 
@@ -231,164 +239,43 @@ CmdOptions::CmdOptions(int argc, char *argv[]) :
 }
 
 
-//----------------------------------------------------------------------------
-// A class to store due events. All times are UTC times.
-//----------------------------------------------------------------------------
-
-namespace {
-    class EventQueue
-    {
-        TS_NOBUILD_NOCOPY(EventQueue);
-    public:
-        // Constructor.
-        EventQueue(const CmdOptions& opt, ts::Report& report);
-
-        // Post a termination request at the due date..
-        void postTermination(ts::Time due)
-        {
-            enqueue(Event(due));
-        }
-
-        // Post an ECM request at the due date..
-        void postRequest(ts::Time due, uint16_t channel_id, uint16_t stream_id)
-        {
-            enqueue(Event(due, channel_id, stream_id));
-        }
-
-        // Wait until next event. Return false on termination request.
-        bool waitEvent(uint16_t& channel_id, uint16_t& stream_id);
-
-    private:
-        // Description of one queued event.
-        class Event
-        {
-        public:
-            ts::Time due;
-            bool     terminate;
-            uint16_t channel_id;
-            uint16_t stream_id;
-
-            // Constructors, termination or request:
-            Event(ts::Time d = ts::Time::Epoch) : due(d), terminate(true), channel_id(0), stream_id(0) {}
-            Event(ts::Time d, uint16_t ch, uint16_t st) : due(d), terminate(false), channel_id(ch), stream_id(st) {}
-        };
-
-        // EventScheduler private fields.
-        const CmdOptions& _opt;
-        ts::Report&       _report;
-        ts::Mutex         _mutex;
-        ts::Condition     _condition;
-        std::list<Event>  _events;
-        size_t            _request_count;
-
-        // Enqueue an event.
-        void enqueue(const Event& event);
-    };
-}
-
-// Constructor.
-EventQueue::EventQueue(const CmdOptions& opt, ts::Report& report) :
-    _opt(opt),
-    _report(report),
-    _mutex(),
-    _condition(),
-    _events(),
-    _request_count(0)
-{
-    // If a max duration is specified, pre-enqueue a termination event.
-    if (_opt.max_seconds > 0) {
-        postTermination(ts::Time::CurrentUTC() + _opt.max_seconds * ts::MilliSecPerSec);
-    }
-}
-
-// Enqueue an event.
-void EventQueue::enqueue(const Event& event)
-{
-    ts::GuardCondition lock(_mutex, _condition);
-
-    // Keep an ordered list of events by due time, most future first.
-    auto iter = _events.begin();
-    while (iter != _events.end() && iter->due > event.due) {
-        ++iter;
-    }
-    const bool at_end = iter == _events.end();
-    _events.insert(iter, event);
-
-    // If event was inserted at end, maybe we need to wake up.
-    if (at_end) {
-        lock.signal();
-    }
-}
-
-// Wait until next event. Return false on termination request.
-bool EventQueue::waitEvent(uint16_t& channel_id, uint16_t& stream_id)
-{
-    if (_opt.max_ecm > 0 && ++_request_count > _opt.max_ecm) {
-        // Exceeded the maximum number of requests, terminate.
-        _report.debug(u"reached maximum number of requests");
-        return false;
-    }
-
-    ts::GuardCondition lock(_mutex, _condition);
-    for (;;) {
-        const ts::Time now(ts::Time::CurrentUTC());
-        if (_events.empty()) {
-            // Wait until explicitly signalled.
-            lock.waitCondition();
-        }
-        else if (_events.back().due <= now) {
-            // Last event is ready.
-            channel_id = _events.back().channel_id;
-            stream_id = _events.back().stream_id;
-            const bool terminate = _events.back().terminate;
-            _events.pop_back();
-            return !terminate;
-        }
-        else {
-            // Wait until last event time (or explicitly signalled).
-            lock.waitCondition(_events.back().due - now);
-        }
-    }
-}
-
-
 //----------------------------------------------------------------------------
 // A class reporting statistics.
 //----------------------------------------------------------------------------
 
 namespace {
-    class CmdStatistics: public ts::Thread
+    class CmdStatistics
     {
         TS_NOBUILD_NOCOPY(CmdStatistics);
     public:
-        // Constructor / Destructor.
+        // Constructor.
         CmdStatistics(const CmdOptions& opt, ts::Report& report);
-        virtual ~CmdStatistics() override;
 
         // Provide statistics.
-        void oneRequest() { _request_count.fetch_add(1); }
-        void oneResponse(ts::MilliSecond time);
+        void oneRequest() { _request_count++; }
+        void oneResponse(ts::NanoSecond time);
+        size_t requestCount() const { return _request_count; }
 
-        // Thread main code.
-        virtual void main() override;
+        // Report instant statistics when the interval is elapsed, return the time of the next report.
+        ts::Monotonic periodic(const ts::Monotonic& now);
 
-        // Terminate the thread.
-        void terminate();
+        // Report final statistics.
+        void final() { reportStatistics(_global_response, _global_histogram); }
 
-      private:
+    private:
         typedef ts::SingleDataStatistics<ts::MilliSecond> ResponseStat;
 
-        const CmdOptions& _opt;
-        ts::Report&       _report;
-        std::atomic<std::uint32_t> _request_count; // same as std::atomic_uint32_t, missing in old GCC
-        volatile bool     _terminate;
-        ts::Mutex         _mutex;     // Exclusive access to subsequent fields.
-        ts::Condition     _condition;
-        ResponseStat      _instant_response;
-        ResponseStat      _global_response;
-
-        // Report statistics. Must be called with mutex held.
-        void reportStatistics(const ResponseStat& stat);
+        const CmdOptions&    _opt;
+        ts::Report&          _report;
+        size_t               _request_count;
+        ts::Monotonic        _next_report;
+        ResponseStat         _instant_response;
+        ResponseStat         _global_response;
+        ts::LatencyHistogram _instant_histogram;
+        ts::LatencyHistogram _global_histogram;
+
+        // Report statistics.
+        void reportStatistics(const ResponseStat& stat, const ts::LatencyHistogram& hist);
     };
 }
 
@@ -397,98 +284,71 @@ CmdStatistics::CmdStatistics(const CmdOptions& opt, ts::Report& report) :
     _opt(opt),
     _report(report),
     _request_count(0),
-    _terminate(false),
-    _mutex(),
-    _condition(),
+    _next_report(true),
     _instant_response(),
-    _global_response()
-{
-    start();
-}
-
-// Destructor.
-CmdStatistics::~CmdStatistics()
+    _global_response(),
+    _instant_histogram(),
+    _global_histogram()
 {
-    terminate();
+    _next_report += _opt.stat_interval * ts::NanoSecPerSec;
 }
 
 // Provide statistics.
-void CmdStatistics::oneResponse(ts::MilliSecond time)
+void CmdStatistics::oneResponse(ts::NanoSecond time)
 {
-    ts::GuardMutex lock(_mutex);
-    _instant_response.feed(time);
-    _global_response.feed(time);
+    _instant_response.feed(time / ts::NanoSecPerMilliSec);
+    _global_response.feed(time / ts::NanoSecPerMilliSec);
+    _instant_histogram.add(time);
+    _global_histogram.add(time);
 }
 
-// Report statistics. Must be called with mutex held.
-void CmdStatistics::reportStatistics(const ResponseStat& stat)
+// Report statistics.
+void CmdStatistics::reportStatistics(const ResponseStat& stat, const ts::LatencyHistogram& hist)
 {
-    _report.info(u"req: %'d, ecm: %'d, response mean: %s ms, min: %d, max: %d, dev: %s",
-                 {_request_count.load(), _global_response.count(),
+    _report.info(u"req: %'d, ecm: %'d, response mean: %s ms, min: %d, max: %d, dev: %s, p99: %s",
+                 {_request_count, _global_response.count(),
                   stat.meanString(0, 3), stat.minimum(), stat.maximum(),
-                  stat.standardDeviationString(0, 3)});
+                  stat.standardDeviationString(0, 3),
+                  ts::LatencyHistogram::DurationString(hist.percentile(99.0))});
 }
 
-// Thread code.
-void CmdStatistics::main()
+// Report instant statistics when the interval is elapsed.
+ts::Monotonic CmdStatistics::periodic(const ts::Monotonic& now)
 {
-    while (!_terminate) {
-        ts::GuardCondition lock(_mutex, _condition);
-        lock.waitCondition(_opt.stat_interval == 0 ? ts::Infinite : _opt.stat_interval * ts::MilliSecPerSec);
-        if (!_terminate) {
-            reportStatistics(_instant_response);
-            _instant_response.reset();
+    if (_opt.stat_interval > 0 && now >= _next_report) {
+        reportStatistics(_instant_response, _instant_histogram);
+        _instant_response.reset();
+        _instant_histogram.reset();
+        while (_next_report <= now) {
+            _next_report += _opt.stat_interval * ts::NanoSecPerSec;
         }
     }
-    {
-        ts::GuardMutex lock(_mutex);
-        reportStatistics(_global_response);
-    }
-}
-
-// Terminate the thread.
-void CmdStatistics::terminate()
-{
-    {
-        ts::GuardCondition lock(_mutex, _condition);
-        _terminate = true;
-        lock.signal();
-    }
-    waitForTermination();
+    return _next_report;
 }
 
 
 //----------------------------------------------------------------------------
-// A class representing one connection to an ECMG.
+// The event-driven engine: all connections to the ECMG in one thread.
 //----------------------------------------------------------------------------
 
 namespace {
 
-    class ECMGConnection;
-    typedef ts::SafePtr<ECMGConnection, ts::Mutex> ECMGConnectionPtr;
-    typedef ts::tlv::Connection<ts::Mutex> Connection;
+    typedef ts::tlv::Connection<ts::NullMutex> Connection;
 
-    class ECMGConnection: public ts::Thread
+    class Engine
     {
-        TS_NOBUILD_NOCOPY(ECMGConnection);
+        TS_NOBUILD_NOCOPY(Engine);
     public:
-        // Constructor / Destructor.
-        ECMGConnection(const CmdOptions& opt, CmdStatistics& stat, EventQueue& events, ts::Report& report, uint16_t index);
-        virtual ~ECMGConnection() override;
-
-        // Send an ECM request.
-        bool sendRequest(uint16_t stream_id);
-
-        // The internal thread is the receive thread.
-        virtual void main() override;
-
-        // Terminate the session and wait for termination.
-        void terminate();
+        // Constructor.
+        Engine(const CmdOptions& opt, ts::Report& report);
 
-        // Abort connection.
-        void abort();
+        // Run the test until termination.
+        void run();
 
     private:
+        // Maximum time to wait for the ECMG to close all streams on termination.
+        static constexpr ts::NanoSecond CLOSE_TIMEOUT = 5 * ts::NanoSecPerSec;
+
         // Description of one stream.
         class Stream
         {
@@ -496,336 +356,445 @@ namespace {
             bool     ready;
             bool     closing;
             uint16_t cp_number;
-            ts::Time start_request;
+            std::map<uint16_t, ts::Monotonic> pending;  // CP_number -> request time, for outstanding requests.
 
-            Stream() : ready(false), closing(false), cp_number(0), start_request() {}
+            Stream() : ready(false), closing(false), cp_number(0), pending() {}
         };
 
-        // ECMGConnection private fields.
-        const CmdOptions&    _opt;
-        CmdStatistics&       _stat;
-        EventQueue&          _events;
-        ts::tlv::Logger      _logger;
-        Connection           _conn;
-        const uint16_t       _channel_id;
-        const uint16_t       _first_ecm_id;
-        const uint16_t       _first_stream_id;
-        const uint16_t       _end_stream_id;
-        std::atomic<std::uint8_t> _cw_per_msg;  // as returned by ECMG, same as std::atomic_uint8_t, missing in old GCC
-        ts::Mutex                 _mutex;       // protect subsequent fields
-        ts::Condition             _completed;   // signalled by reception thread when all streams are closed.
-        std::vector<Stream>       _streams;
-
-        // Check the validity of a received message.
-        bool checkChannelMessage(const ts::tlv::ChannelMessage* mp, const ts::UChar* message_name);
-        bool checkStreamMessage(const ts::tlv::StreamMessage* mp, const ts::UChar* message_name);
-
-        // Send a stream_setup command.
-        bool sendStreamSetup(uint16_t stream_id);
+        // Description of one channel, one TCP connection.
+        class Channel
+        {
+            TS_NOBUILD_NOCOPY(Channel);
+        public:
+            Channel(const CmdOptions& opt, ts::Report& report, uint16_t index);
+
+            const uint16_t           channel_id;
+            const uint16_t           first_ecm_id;
+            ts::tlv::Logger          logger;
+            Connection               conn;
+            bool                     active;      // Connected and not yet closed.
+            bool                     finishing;   // Close the connection after sending pending messages.
+            size_t                   next_setup;  // Index of next stream to setup.
+            ts::ecmgscs::ChannelStatus        status;     // Last channel_status from the ECMG.
+            std::vector<Stream>               streams;
+            std::vector<ts::tlv::MessagePtr>  outgoing;   // Pending messages, sent in one batch.
+        };
+        typedef ts::SafePtr<Channel, ts::NullMutex> ChannelPtr;
+
+        // Scheduled requests: due time -> (channel index, stream index).
+        typedef std::multimap<ts::Monotonic, std::pair<size_t, size_t>> Timeline;
+
+        const CmdOptions&       _opt;
+        ts::Report&             _report;
+        CmdStatistics           _stat;
+        ts::SocketPoller        _poller;
+        std::vector<ChannelPtr> _channels;
+        Timeline                _timeline;
+        size_t                  _active_count;
+        bool                    _terminating;
+        ts::Monotonic           _close_deadline;
+
+        // Process incoming messages on a channel.
+        void receive(Channel& chan);
+        void handleMessage(Channel& chan, const ts::tlv::MessagePtr& msg);
+        bool checkStreamId(Channel& chan, uint16_t stream_id, const ts::UChar* name);
+
+        // Queue messages to send on a channel. All pending messages are sent by flush().
+        void post(Channel& chan, ts::tlv::Message* msg) { chan.outgoing.push_back(ts::tlv::MessagePtr(msg)); }
+        void postStreamSetup(Channel& chan);
+        void postRequest(Channel& chan, size_t stream_index, const ts::Monotonic& now);
+        void flush();
+
+        // Termination.
+        void startTermination(const ts::Monotonic& now);
+        void checkChannelCompletion(Channel& chan);
+        void closeChannel(Channel& chan);
     };
 }
 
-// Constructor.
-ECMGConnection::ECMGConnection(const CmdOptions& opt, CmdStatistics& stat, EventQueue& events, ts::Report& report, uint16_t index) :
-    _opt(opt),
-    _stat(stat),
-    _events(events),
-    _logger(_opt.log_protocol, &report),
-    _conn(ts::ecmgscs::Protocol::Instance(), true, 3),
-    _channel_id(_opt.first_ecm_channel_id + index),
-    _first_ecm_id(_opt.first_ecm_id + index * _opt.streams_per_channel),
-    _first_stream_id(_opt.first_ecm_stream_id),
-    _end_stream_id(_opt.first_ecm_stream_id + _opt.streams_per_channel),
-    _cw_per_msg(0),
-    _mutex(),
-    _completed(),
-    _streams(_opt.streams_per_channel)
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr ts::NanoSecond Engine::CLOSE_TIMEOUT;
+#endif
+
+// Channel constructor.
+Engine::Channel::Channel(const CmdOptions& opt, ts::Report& report, uint16_t index) :
+    channel_id(opt.first_ecm_channel_id + index),
+    first_ecm_id(opt.first_ecm_id + index * opt.streams_per_channel),
+    logger(opt.log_protocol, &report),
+    conn(ts::ecmgscs::Protocol::Instance(), true, 3),
+    active(false),
+    finishing(false),
+    next_setup(0),
+    status(),
+    streams(opt.streams_per_channel),
+    outgoing()
 {
     // Set logging levels for ECM messages.
-    _logger.setSeverity(ts::ecmgscs::Tags::CW_provision, _opt.log_data);
-    _logger.setSeverity(ts::ecmgscs::Tags::ECM_response, _opt.log_data);
+    logger.setSeverity(ts::ecmgscs::Tags::CW_provision, opt.log_data);
+    logger.setSeverity(ts::ecmgscs::Tags::ECM_response, opt.log_data);
+    status.channel_id = channel_id;
+}
 
-    // Perform TCP connection to ECMG server
-    if (!_conn.open(_logger.report())) {
-        return;
-    }
-    if (!_conn.connect(_opt.ecmg_address, _logger.report())) {
-        _conn.close(_logger.report());
-        return;
+// Engine constructor.
+Engine::Engine(const CmdOptions& opt, ts::Report& report) :
+    _opt(opt),
+    _report(report),
+    _stat(opt, report),
+    _poller(),
+    _channels(),
+    _timeline(),
+    _active_count(0),
+    _terminating(false),
+    _close_deadline()
+{
+    // Create all channels, connect to the ECMG, send channel_setup.
+    _channels.reserve(_opt.channel_count);
+    for (uint16_t index = 0; index < _opt.channel_count; ++index) {
+        ChannelPtr chan(new Channel(_opt, _report, index));
+        _channels.push_back(chan);
+        if (chan->conn.open(chan->logger.report())) {
+            if (!chan->conn.connect(_opt.ecmg_address, chan->logger.report()) || !_poller.add(chan->conn, chan.pointer(), false, _report)) {
+                chan->conn.close(NULLREP);
+            }
+            else {
+                chan->active = true;
+                _active_count++;
+                ts::ecmgscs::ChannelSetup* msg = new ts::ecmgscs::ChannelSetup;
+                msg->channel_id = chan->channel_id;
+                msg->Super_CAS_id = _opt.super_cas_id;
+                post(*chan, msg);
+            }
+        }
     }
+    flush();
+}
 
-    // Send a channel_setup message to ECMG
-    ts::ecmgscs::ChannelSetup channel_setup;
-    channel_setup.channel_id = _channel_id;
-    channel_setup.Super_CAS_id = _opt.super_cas_id;
-    if (!_conn.send(channel_setup, _logger)) {
-        abort();
-        return;
-    }
 
-    // Start the message reception thread.
-    start();
-}
+//----------------------------------------------------------------------------
+// Main event loop.
+//----------------------------------------------------------------------------
 
-// Destructor.
-ECMGConnection::~ECMGConnection()
+void Engine::run()
 {
-    // Wait for the internal task to terminate. Mute disconnection errors.
-    abort();
-    waitForTermination();
-}
+    ts::Monotonic end_time(true);
+    end_time += (_opt.max_seconds > 0 ? _opt.max_seconds : 1000000000) * ts::NanoSecPerSec;
+    std::vector<ts::SocketPoller::Event> events;
 
-// Check the validity of a received channel message.
-bool ECMGConnection::checkChannelMessage(const ts::tlv::ChannelMessage* mp, const ts::UChar* name)
-{
-    if (mp == nullptr) {
-        return false;
-    }
-    else if (mp->channel_id != _channel_id) {
-        _logger.report().error(u"received invalid channel_id %d (should be %d) in %s", {mp->channel_id, _channel_id, name});
-        return false;
-    }
-    else {
-        return true;
-    }
-}
+    while (_active_count > 0) {
+        ts::Monotonic now(true);
 
-// Check the validity of a received stream message.
-bool ECMGConnection::checkStreamMessage(const ts::tlv::StreamMessage* mp, const ts::UChar* name)
-{
-    if (!checkChannelMessage(mp, name)) {
-        return false;
-    }
-    else if (mp->stream_id < _first_stream_id || mp->stream_id >= _end_stream_id) {
-        _logger.report().error(u"received invalid stream_id %d (should be %d to %d) in %s", {mp->channel_id, _first_stream_id, _end_stream_id - 1, name});
-        return false;
-    }
-    else {
-        return true;
-    }
-}
+        // Check termination conditions.
+        if (!_terminating && now >= end_time) {
+            _report.debug(u"reached maximum test duration");
+            startTermination(now);
+        }
+        if (_terminating && now >= _close_deadline) {
+            _report.warning(u"%d channels not properly closed by the ECMG", {_active_count});
+            break;
+        }
 
-// Terminate the session and wait for termination.
-void ECMGConnection::terminate()
-{
-    // Close all sessions.
-    if (_conn.isConnected()) {
-
-        // Send a stream_close_request per active stream.
-        for (size_t i = 0; i < _streams.size(); ++i) {
-            ts::GuardMutex lock(_mutex);
-            if (_streams[i].ready) {
-                ts::ecmgscs::StreamCloseRequest msg;
-                msg.channel_id = _channel_id;
-                msg.stream_id = uint16_t(_first_stream_id + i);
-                _conn.send(msg, _logger);
-                _streams[i].ready = false;
-                _streams[i].closing = true;
+        // Send all due requests.
+        while (!_terminating && !_timeline.empty() && _timeline.begin()->first <= now) {
+            const auto req = _timeline.begin()->second;
+            _timeline.erase(_timeline.begin());
+            Channel& chan(*_channels[req.first]);
+            if (chan.active && chan.streams[req.second].ready) {
+                postRequest(chan, req.second, now);
             }
         }
+        if (!_terminating && _opt.max_ecm > 0 && _stat.requestCount() >= _opt.max_ecm) {
+            _report.debug(u"reached maximum number of requests");
+            startTermination(now);
+        }
+        flush();
 
-        // Wait for all stream close requests to complete (response from ECMG).
-        {
-            ts::GuardCondition lock(_mutex, _completed);
-            for (;;) {
-                bool completed = true;
-                for (const auto& stream : _streams) {
-                    if (stream.ready || stream.closing) {
-                        completed = false;
-                        break;
-                    }
-                }
-                if (completed) {
-                    break;
-                }
-                lock.waitCondition();
-            }
+        // Compute the time of the next event.
+        ts::Monotonic next(_terminating ? _close_deadline : end_time);
+        if (!_timeline.empty() && _timeline.begin()->first < next) {
+            next = _timeline.begin()->first;
+        }
+        const ts::Monotonic next_stat(_stat.periodic(now));
+        if (_opt.stat_interval > 0 && next_stat < next) {
+            next = next_stat;
         }
+        const ts::NanoSecond wait = std::max<ts::NanoSecond>(0, next - now);
 
-        // Send a final channel_close.
-        ts::ecmgscs::ChannelClose msg;
-        msg.channel_id = _channel_id;
-        _conn.send(msg, _logger);
+        // Wait for incoming messages or next due event.
+        if (!_poller.wait(events, (wait + ts::NanoSecPerMilliSec - 1) / ts::NanoSecPerMilliSec, _report)) {
+            break;
+        }
+        for (const auto& ev : events) {
+            Channel* chan = reinterpret_cast<Channel*>(ev.context);
+            if (chan != nullptr && chan->active && (ev.readable || ev.error)) {
+                receive(*chan);
+            }
+        }
     }
 
-    // Close the session.
-    abort();
-    waitForTermination();
+    // Close remaining connections.
+    for (auto& chan : _channels) {
+        if (chan->active) {
+            closeChannel(*chan);
+        }
+    }
+    _stat.final();
 }
 
-// Abort connection with the ECMG.
-void ECMGConnection::abort()
+
+//----------------------------------------------------------------------------
+// Send all pending messages, one batch per channel.
+//----------------------------------------------------------------------------
+
+void Engine::flush()
 {
-    _logger.setReport(ts::NullReport::Instance());
-    _conn.disconnect(_logger.report());
-    _conn.close(_logger.report());
+    std::vector<const ts::tlv::Message*> batch;
+    for (auto& chan : _channels) {
+        if (chan->active && !chan->outgoing.empty()) {
+            batch.clear();
+            for (const auto& msg : chan->outgoing) {
+                batch.push_back(msg.pointer());
+            }
+            const bool ok = chan->conn.send(batch, chan->logger);
+            chan->outgoing.clear();
+            if (!ok || chan->finishing) {
+                closeChannel(*chan);
+            }
+        }
+    }
 }
 
-// Send a stream_setup command.
-bool ECMGConnection::sendStreamSetup(uint16_t stream_id)
+
+//----------------------------------------------------------------------------
+// Queue stream_setup and CW_provision messages.
+//----------------------------------------------------------------------------
+
+void Engine::postStreamSetup(Channel& chan)
 {
-    ts::GuardMutex lock(_mutex);
-    const size_t index = stream_id - _opt.first_ecm_stream_id;
-    if (stream_id < _opt.first_ecm_stream_id || index >= _streams.size() || _streams[index].ready) {
-        _logger.report().error(u"invalid stream id: %d", {stream_id});
-        return false;
-    }
-    else {
-        ts::ecmgscs::StreamSetup msg;
-        msg.channel_id = _channel_id;
-        msg.stream_id = stream_id;
-        msg.ECM_id = uint16_t(_first_ecm_id + index);
-        msg.nominal_CP_duration = uint16_t(_opt.cp_duration * 10); // unit is 100 ms
-        return _conn.send(msg, _logger);
+    // Setup all streams at once, the ECMG processes them in sequence.
+    while (chan.next_setup < chan.streams.size()) {
+        ts::ecmgscs::StreamSetup* msg = new ts::ecmgscs::StreamSetup;
+        msg->channel_id = chan.channel_id;
+        msg->stream_id = uint16_t(_opt.first_ecm_stream_id + chan.next_setup);
+        msg->ECM_id = uint16_t(chan.first_ecm_id + chan.next_setup);
+        msg->nominal_CP_duration = uint16_t(_opt.cp_duration * 10); // unit is 100 ms
+        post(chan, msg);
+        chan.next_setup++;
     }
 }
 
-// Send an ECM request.
-bool ECMGConnection::sendRequest(uint16_t stream_id)
+void Engine::postRequest(Channel& chan, size_t stream_index, const ts::Monotonic& now)
 {
-    ts::GuardMutex lock(_mutex);
-    const size_t index = stream_id - _opt.first_ecm_stream_id;
-    if (stream_id < _opt.first_ecm_stream_id || index >= _streams.size() || !_streams[index].ready) {
-        _logger.report().error(u"invalid stream id: %d", {stream_id});
-        return false;
+    Stream& stream(chan.streams[stream_index]);
+
+    ts::ecmgscs::CWProvision* msg = new ts::ecmgscs::CWProvision;
+    msg->channel_id = chan.channel_id;
+    msg->stream_id = uint16_t(_opt.first_ecm_stream_id + stream_index);
+    msg->CP_number = stream.cp_number++;
+    msg->has_access_criteria = !_opt.access_criteria.empty();
+    msg->access_criteria = _opt.access_criteria;
+    const size_t cw_count = chan.status.CW_per_msg;
+    msg->CP_CW_combination.resize(cw_count);
+    for (size_t i = 0; i < cw_count; ++i) {
+        msg->CP_CW_combination[i].CP = uint16_t(msg->CP_number + i);
+        msg->CP_CW_combination[i].CW.resize(_opt.cw_size);
     }
-    else {
-        // Build the request message.
-        ts::ecmgscs::CWProvision msg;
-        msg.channel_id = _channel_id;
-        msg.stream_id = stream_id;
-        msg.CP_number = _streams[index].cp_number++;
-        msg.has_access_criteria = !_opt.access_criteria.empty();
-        msg.access_criteria = _opt.access_criteria;
-        const size_t cw_count = _cw_per_msg.load();
-        msg.CP_CW_combination.resize(cw_count);
-        for (size_t i = 0; i < cw_count; ++i) {
-            msg.CP_CW_combination[i].CP = uint16_t(msg.CP_number + i);
-            msg.CP_CW_combination[i].CW.resize(_opt.cw_size);
-        }
-
-        // Register the message.
-        _streams[index].start_request = ts::Time::CurrentUTC();
-        _stat.oneRequest();
 
-        // Send the message.
-        return _conn.send(msg, _logger);
-    }
+    stream.pending[msg->CP_number] = now;
+    _stat.oneRequest();
+    post(chan, msg);
 }
 
 
 //----------------------------------------------------------------------------
-// Receiver thread for one connection to an ECMG.
+// Process incoming messages on a channel.
 //----------------------------------------------------------------------------
 
-void ECMGConnection::main()
+void Engine::receive(Channel& chan)
 {
-    ts::tlv::MessagePtr msg;
-    bool ok = true;
-    size_t next_stream_index = 0; // next stream to setup
-
-    ts::ecmgscs::ChannelStatus channel_status;
-    channel_status.channel_id = _channel_id;
-
-    while (ok && _conn.receive(msg, nullptr, _logger)) {
-        switch (msg->tag()) {
-
-            case ts::ecmgscs::Tags::channel_status: {
-                ts::ecmgscs::ChannelStatus* const mp = dynamic_cast<ts::ecmgscs::ChannelStatus*>(msg.pointer());
-                if (checkChannelMessage(mp, u"channel_status")) {
-                    // Received a valid channel_status, keep it for reference.
-                    channel_status = *mp;
-                    _cw_per_msg.store(channel_status.CW_per_msg);
-                    if (next_stream_index == 0) {
-                        // This is a response to channel_setup. Setup the first stream.
-                        ok = sendStreamSetup(uint16_t(_first_stream_id + next_stream_index++));
-                    }
-                }
-                break;
-            }
+    std::vector<ts::tlv::MessagePtr> msgs;
+    const bool ok = chan.conn.receiveAvailable(msgs, chan.logger);
+    for (const auto& msg : msgs) {
+        handleMessage(chan, msg);
+    }
+    if (!ok) {
+        // Disconnection or error. Mute errors if we were waiting for the closure.
+        if (!_terminating) {
+            _report.error(u"channel %d disconnected by ECMG", {chan.channel_id});
+        }
+        chan.outgoing.clear();
+        closeChannel(chan);
+    }
+}
+
+bool Engine::checkStreamId(Channel& chan, uint16_t stream_id, const ts::UChar* name)
+{
+    if (stream_id < _opt.first_ecm_stream_id || size_t(stream_id - _opt.first_ecm_stream_id) >= chan.streams.size()) {
+        chan.logger.report().error(u"received invalid stream_id %d (should be %d to %d) in %s",
+                                   {stream_id, _opt.first_ecm_stream_id, _opt.first_ecm_stream_id + chan.streams.size() - 1, name});
+        return false;
+    }
+    return true;
+}
 
-            case ts::ecmgscs::Tags::channel_test: {
-                ts::ecmgscs::ChannelTest* const mp = dynamic_cast<ts::ecmgscs::ChannelTest*>(msg.pointer());
-                if (checkChannelMessage(mp, u"channel_test")) {
-                    // Automatic reply to channel_test
-                    ok = _conn.send(channel_status, _logger);
+void Engine::handleMessage(Channel& chan, const ts::tlv::MessagePtr& msg)
+{
+    // All ECMG <=> SCS messages are channel messages.
+    const ts::tlv::ChannelMessage* cmsg = dynamic_cast<const ts::tlv::ChannelMessage*>(msg.pointer());
+    if (cmsg != nullptr && cmsg->channel_id != chan.channel_id) {
+        chan.logger.report().error(u"received invalid channel_id %d (should be %d)", {cmsg->channel_id, chan.channel_id});
+        return;
+    }
+    const ts::tlv::StreamMessage* smsg = dynamic_cast<const ts::tlv::StreamMessage*>(msg.pointer());
+    const size_t sindex = smsg == nullptr ? 0 : size_t(smsg->stream_id - _opt.first_ecm_stream_id);
+
+    switch (msg->tag()) {
+
+        case ts::ecmgscs::Tags::channel_status: {
+            const ts::ecmgscs::ChannelStatus* const mp = dynamic_cast<const ts::ecmgscs::ChannelStatus*>(msg.pointer());
+            if (mp != nullptr) {
+                // Received a valid channel_status, keep it for reference.
+                chan.status = *mp;
+                if (!_terminating) {
+                    // This is a response to channel_setup. Setup all streams.
+                    postStreamSetup(chan);
                 }
-                break;
             }
+            break;
+        }
 
-            case ts::ecmgscs::Tags::stream_status: {
-                ts::ecmgscs::StreamStatus* const mp = dynamic_cast<ts::ecmgscs::StreamStatus*>(msg.pointer());
-                if (checkStreamMessage(mp, u"stream_status")) {
-                    ts::GuardMutex lock(_mutex);
-                    Stream& stream(_streams[mp->stream_id - _first_stream_id]);
-                    if (!stream.ready) {
-                        // This is a response to stream_setup.
-                        stream.ready = true;
-                        // Start sending requests to this stream.
-                        ok = sendRequest(mp->stream_id);
-                        // Setup the next stream.
-                        if (ok && next_stream_index < _streams.size()) {
-                            ok = sendStreamSetup(uint16_t(_first_stream_id + next_stream_index++));
-                        }
+        case ts::ecmgscs::Tags::channel_test: {
+            // Automatic reply to channel_test
+            post(chan, new ts::ecmgscs::ChannelStatus(chan.status));
+            break;
+        }
+
+        case ts::ecmgscs::Tags::stream_status: {
+            if (smsg != nullptr && checkStreamId(chan, smsg->stream_id, u"stream_status")) {
+                Stream& stream(chan.streams[sindex]);
+                if (!stream.ready && !stream.closing && !_terminating) {
+                    // This is a response to stream_setup. Send the first requests on this stream.
+                    stream.ready = true;
+                    const ts::Monotonic now(true);
+                    for (size_t i = 0; i < _opt.pipeline; ++i) {
+                        postRequest(chan, sindex, now);
                     }
                 }
-                break;
             }
+            break;
+        }
 
-            case ts::ecmgscs::Tags::stream_test: {
-                ts::ecmgscs::StreamTest* const mp = dynamic_cast<ts::ecmgscs::StreamTest*>(msg.pointer());
-                if (checkStreamMessage(mp, u"stream_test")) {
-                    // Automatic reply to stream_test
-                    ts::ecmgscs::StreamStatus resp;
-                    resp.channel_id = _channel_id;
-                    resp.stream_id = mp->stream_id;
-                    resp.ECM_id = _first_ecm_id + mp->stream_id - _first_stream_id;
-                    ok = _conn.send(resp, _logger);
-                }
-                break;
+        case ts::ecmgscs::Tags::stream_test: {
+            if (smsg != nullptr && checkStreamId(chan, smsg->stream_id, u"stream_test")) {
+                // Automatic reply to stream_test
+                ts::ecmgscs::StreamStatus* resp = new ts::ecmgscs::StreamStatus;
+                resp->channel_id = chan.channel_id;
+                resp->stream_id = smsg->stream_id;
+                resp->ECM_id = uint16_t(chan.first_ecm_id + sindex);
+                post(chan, resp);
             }
+            break;
+        }
 
-            case ts::ecmgscs::Tags::channel_error:
-            case ts::ecmgscs::Tags::stream_error: {
-                _logger.report().error(u"received error:\n%s", {msg->dump(2)});
-                break;
-            }
+        case ts::ecmgscs::Tags::channel_error:
+        case ts::ecmgscs::Tags::stream_error: {
+            chan.logger.report().error(u"received error:\n%s", {msg->dump(2)});
+            break;
+        }
 
-            case ts::ecmgscs::Tags::ECM_response: {
-                ts::ecmgscs::ECMResponse* const mp = dynamic_cast<ts::ecmgscs::ECMResponse*>(msg.pointer());
-                if (checkStreamMessage(mp, u"ECM_response")) {
-                    ts::GuardMutex lock(_mutex);
-                    Stream& stream(_streams[mp->stream_id - _first_stream_id]);
-                    if (!stream.ready || stream.start_request == ts::Time::Epoch) {
-                        _logger.report().error(u"unexpected ECM response, channel_id %d, stream id %d", {mp->channel_id, mp->stream_id});
-                    }
-                    else {
-                        // Log current request response time.
-                        _stat.oneResponse(ts::Time::CurrentUTC() - stream.start_request);
-                        // Schedule next request.
-                        _events.postRequest(stream.start_request + _opt.cp_duration * ts::MilliSecPerSec, mp->channel_id, mp->stream_id);
-                        stream.start_request = ts::Time::Epoch;
+        case ts::ecmgscs::Tags::ECM_response: {
+            const ts::ecmgscs::ECMResponse* const mp = dynamic_cast<const ts::ecmgscs::ECMResponse*>(msg.pointer());
+            if (mp != nullptr && checkStreamId(chan, mp->stream_id, u"ECM_response")) {
+                Stream& stream(chan.streams[sindex]);
+                const auto req = stream.pending.find(mp->CP_number);
+                if (req == stream.pending.end()) {
+                    chan.logger.report().error(u"unexpected ECM response, channel_id %d, stream id %d, CP %d", {mp->channel_id, mp->stream_id, mp->CP_number});
+                }
+                else {
+                    // Log current request response time.
+                    _stat.oneResponse(ts::Monotonic(true) - req->second);
+                    // Schedule next request, one crypto-period after this one.
+                    if (stream.ready && !_terminating) {
+                        ts::Monotonic due(req->second);
+                        due += _opt.cp_duration * ts::NanoSecPerSec;
+                        _timeline.insert(std::make_pair(due, std::make_pair(size_t(chan.channel_id - _opt.first_ecm_channel_id), sindex)));
                     }
+                    stream.pending.erase(req);
                 }
-                break;
             }
+            break;
+        }
 
-            case ts::ecmgscs::Tags::stream_close_response: {
-                ts::ecmgscs::StreamCloseResponse* const mp = dynamic_cast<ts::ecmgscs::StreamCloseResponse*>(msg.pointer());
-                if (checkStreamMessage(mp, u"stream_close_response")) {
-                    ts::GuardCondition lock(_mutex, _completed);
-                    Stream& stream(_streams[mp->stream_id - _first_stream_id]);
-                    stream.ready = stream.closing = false;
-                    lock.signal();
+        case ts::ecmgscs::Tags::stream_close_response: {
+            if (smsg != nullptr && checkStreamId(chan, smsg->stream_id, u"stream_close_response")) {
+                Stream& stream(chan.streams[sindex]);
+                stream.ready = stream.closing = false;
+                checkChannelCompletion(chan);
+            }
+            break;
+        }
+
+        default: {
+            chan.logger.report().error(u"Unexpected message:\n%s", {msg->dump(2)});
+            break;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Termination.
+//----------------------------------------------------------------------------
+
+void Engine::startTermination(const ts::Monotonic& now)
+{
+    _terminating = true;
+    _timeline.clear();
+    _close_deadline = now;
+    _close_deadline += CLOSE_TIMEOUT;
+
+    // Send a stream_close_request per active stream.
+    for (auto& chan : _channels) {
+        if (chan->active) {
+            for (size_t i = 0; i < chan->streams.size(); ++i) {
+                if (chan->streams[i].ready) {
+                    ts::ecmgscs::StreamCloseRequest* msg = new ts::ecmgscs::StreamCloseRequest;
+                    msg->channel_id = chan->channel_id;
+                    msg->stream_id = uint16_t(_opt.first_ecm_stream_id + i);
+                    post(*chan, msg);
+                    chan->streams[i].ready = false;
+                    chan->streams[i].closing = true;
                 }
-                break;
             }
+            checkChannelCompletion(*chan);
+        }
+    }
+}
 
-            default: {
-                _logger.report().error(u"Unexpected message:\n%s", {msg->dump(2)});
-                break;
+void Engine::checkChannelCompletion(Channel& chan)
+{
+    // When all streams are closed during termination, send a final channel_close.
+    if (_terminating && chan.active && !chan.finishing) {
+        for (const auto& stream : chan.streams) {
+            if (stream.ready || stream.closing) {
+                return;
             }
         }
+        ts::ecmgscs::ChannelClose* msg = new ts::ecmgscs::ChannelClose;
+        msg->channel_id = chan.channel_id;
+        post(chan, msg);
+        chan.finishing = true;
+    }
+}
+
+void Engine::closeChannel(Channel& chan)
+{
+    if (chan.active) {
+        chan.active = false;
+        _active_count--;
+        _poller.remove(chan.conn, NULLREP);
+        chan.logger.setReport(ts::NullReport::Instance());
+        chan.conn.disconnect(NULLREP);
+        chan.conn.close(NULLREP);
     }
 }
 
@@ -838,28 +807,7 @@ int MainCode(int argc, char *argv[])
 {
     CmdOptions opt(argc, argv);
     ts::AsyncReport report(opt.maxSeverity(), opt.log_args);
-    CmdStatistics stat(opt, report);
-    EventQueue events(opt, report);
-
-    // Initialize all channels, create the connections to the ECMG.
-    std::vector<ECMGConnectionPtr> connections;
-    connections.reserve(opt.channel_count);
-    for (uint16_t index = 0; index < opt.channel_count; ++index) {
-        connections.push_back(ECMGConnectionPtr(new ECMGConnection(opt, stat, events, report, index)));
-    }
-
-    // Send ECM requests based on scheduled dates.
-    uint16_t channel_id = 0;
-    uint16_t stream_id = 0;
-    while (events.waitEvent(channel_id, stream_id)) {
-        assert(channel_id >= opt.first_ecm_channel_id);
-        assert(size_t(channel_id - opt.first_ecm_channel_id) < connections.size());
-        connections[channel_id - opt.first_ecm_channel_id]->sendRequest(stream_id);
-    }
-
-    // Terminate all connections and wait for termination.
-    for (auto& conn : connections) {
-        conn->terminate();
-    }
+    Engine engine(opt, report);
+    engine.run();
     return EXIT_SUCCESS;
 }
@@ -41,9 +41,13 @@
 //----------------------------------------------------------------------------
 
 #include "tsunit.h"
+#include "tsSysUtils.h"
 
 int main(int argc, char* argv[])
 {
+    // The unit tests never use or update the cache of ".names" files of the user.
+    ts::DeleteEnvironment(u"TSDUCK_CACHE_DIR");
+
     tsunit::Main test(argc, argv);
     return test.run();
 }
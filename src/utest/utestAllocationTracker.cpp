@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::AllocationTracker
+//
+//----------------------------------------------------------------------------
+
+#include "tsAllocationTracker.h"
+#include "tsThread.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class AllocationTrackerTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testSubsystem();
+    void testCount();
+
+    TSUNIT_TEST_BEGIN(AllocationTrackerTest);
+    TSUNIT_TEST(testSubsystem);
+    TSUNIT_TEST(testCount);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(AllocationTrackerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void AllocationTrackerTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void AllocationTrackerTest::afterTest()
+{
+    ts::AllocationTracker::Enable(false);
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void AllocationTrackerTest::testSubsystem()
+{
+    const size_t index = ts::AllocationTracker::Subsystem(u"UTestSubsystem");
+    TSUNIT_ASSERT(index > 0);
+    TSUNIT_ASSERT(index < ts::AllocationTracker::MAX_SUBSYSTEMS);
+    TSUNIT_EQUAL(index, ts::AllocationTracker::Subsystem(u"UTestSubsystem"));
+    TSUNIT_ASSERT(ts::AllocationTracker::Subsystem(u"UTestOtherSubsystem") != index);
+}
+
+namespace {
+    // A thread which allocates blocks inside a subsystem.
+    class AllocThread : public ts::Thread
+    {
+        TS_NOCOPY(AllocThread);
+    public:
+        AllocThread() : ts::Thread(ts::ThreadAttributes().setName(u"UTestAllocThread")) {}
+        virtual ~AllocThread() override { waitForTermination(); }
+    protected:
+        virtual void main() override
+        {
+            TS_ALLOCATION_SCOPE(u"UTestThreadSubsystem");
+            for (size_t i = 0; i < 10; ++i) {
+                char* volatile p = new char[100];
+                delete[] p;
+            }
+        }
+    };
+}
+
+void AllocationTrackerTest::testCount()
+{
+    if (!ts::AllocationTracker::IsSupported()) {
+        TSUNIT_ASSERT(!ts::AllocationTracker::Enable());
+        TSUNIT_ASSERT(!ts::AllocationTracker::IsEnabled());
+        debug() << "AllocationTrackerTest: allocation tracking not compiled in, skipped" << std::endl;
+        return;
+    }
+
+    TSUNIT_ASSERT(ts::AllocationTracker::Enable());
+    TSUNIT_ASSERT(ts::AllocationTracker::IsEnabled());
+    ts::AllocationTracker::Reset();
+
+    AllocThread thread;
+    TSUNIT_ASSERT(thread.start());
+    TSUNIT_ASSERT(thread.waitForTermination());
+    ts::AllocationTracker::Enable(false);
+
+    std::vector<ts::AllocationTracker::Counters> counters;
+    ts::AllocationTracker::GetCounters(counters);
+    bool found = false;
+    for (const auto& c : counters) {
+        debug() << "AllocationTrackerTest: " << c.thread << " / " << c.subsystem << ": " << c.count << " allocations, " << c.bytes << " bytes" << std::endl;
+        if (c.thread == u"UTestAllocThread" && c.subsystem == u"UTestThreadSubsystem") {
+            found = true;
+            TSUNIT_EQUAL(10, c.count);
+            TSUNIT_EQUAL(1000, c.bytes);
+        }
+    }
+    TSUNIT_ASSERT(found);
+
+    ts::AllocationTracker::Reset();
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+    ts::AllocationTracker::GetTotal(count, bytes);
+    TSUNIT_EQUAL(0, count);
+    TSUNIT_EQUAL(0, bytes);
+}
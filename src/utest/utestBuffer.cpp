@@ -115,6 +115,8 @@ public:
     void testPutFloat64BE();
     void testGetVluimsbf5();
     void testPutVluimsbf5();
+    void testFastBits();
+    void testFastReservedBits();
 
     TSUNIT_TEST_BEGIN(BufferTest);
     TSUNIT_TEST(testConstructors);
@@ -181,6 +183,8 @@ public:
     TSUNIT_TEST(testPutFloat64BE);
     TSUNIT_TEST(testGetVluimsbf5);
     TSUNIT_TEST(testPutVluimsbf5);
+    TSUNIT_TEST(testFastBits);
+    TSUNIT_TEST(testFastReservedBits);
     TSUNIT_TEST_END();
 
 private:
@@ -2145,3 +2149,82 @@ void BufferTest::testPutVluimsbf5()
     mem.resize(4);
     TSUNIT_EQUAL((tsunit::Bytes{0xF0, 0xD5, 0xE6, 0x80}), mem);
 }
+
+void BufferTest::testFastBits()
+{
+    // Reference bit pattern, MSB first.
+    static const uint8_t pattern[16] = {0xA5, 0x3C, 0x0F, 0xF0, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF1, 0x5A, 0xC3, 0x69, 0x96};
+    const auto bit_at = [](const uint8_t* data, size_t index) { return (data[index / 8] >> (7 - index % 8)) & 1; };
+
+    // Read and write all field sizes at all bit offsets, including near the end
+    // of the buffer where the 64-bit memory access cannot be used.
+    for (size_t bits = 1; bits <= 64; ++bits) {
+        for (size_t start = 0; start + bits <= 8 * sizeof(pattern); ++start) {
+
+            // Expected value, computed bit by bit.
+            uint64_t expected = 0;
+            for (size_t i = 0; i < bits; ++i) {
+                expected = (expected << 1) | bit_at(pattern, start + i);
+            }
+
+            ts::Buffer rb(pattern, sizeof(pattern));
+            TSUNIT_ASSERT(rb.skipBits(start));
+            TSUNIT_EQUAL(expected, rb.getBits<uint64_t>(bits));
+            TSUNIT_ASSERT(!rb.readError());
+            TSUNIT_EQUAL(start + bits, rb.currentReadBitOffset());
+
+            // Write the complement of the field over the pattern, surrounding bits are preserved.
+            uint8_t mem[sizeof(pattern)];
+            ::memcpy(mem, pattern, sizeof(mem));
+            ts::Buffer wb(mem, sizeof(mem));
+            TSUNIT_ASSERT(wb.writeSeek(start / 8, start % 8));
+            TSUNIT_ASSERT(wb.putBits(~expected, bits));
+            TSUNIT_EQUAL(start + bits, wb.currentWriteBitOffset());
+            for (size_t i = 0; i < 8 * sizeof(mem); ++i) {
+                const bool in_field = i >= start && i < start + bits;
+                TSUNIT_EQUAL(in_field ? 1 - bit_at(pattern, i) : bit_at(pattern, i), bit_at(mem, i));
+            }
+        }
+    }
+
+    // Compile-time field sizes.
+    ts::Buffer b(pattern, sizeof(pattern));
+    TSUNIT_ASSERT(b.skipBits(3));
+    TSUNIT_EQUAL(0x053C, b.getBits<13>());
+    TSUNIT_EQUAL(0x0F, b.getBits<8>());
+    TSUNIT_EQUAL(0xF01234567, b.getBits<36>());
+    TSUNIT_EQUAL(0x89ABCDEF15AC369, (b.getBits<60, uint64_t>()));
+    TSUNIT_EQUAL(0x96, b.getBits<8>());
+    TSUNIT_ASSERT(!b.readError());
+    TSUNIT_EQUAL(0, b.getBits<8>());
+    TSUNIT_ASSERT(b.readError());
+
+    uint8_t mem[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    ts::Buffer wb(mem, sizeof(mem));
+    TSUNIT_ASSERT(wb.putBits<3>(0));
+    TSUNIT_ASSERT(wb.putBits<13>(0x1234));
+    TSUNIT_ASSERT(wb.putBits<12>(0xABC));
+    TSUNIT_ASSERT(!wb.putBits<5>(0));
+    TSUNIT_ASSERT(wb.writeError());
+    TSUNIT_EQUAL(0x12, mem[0]);
+    TSUNIT_EQUAL(0x34, mem[1]);
+    TSUNIT_EQUAL(0xAB, mem[2]);
+    TSUNIT_EQUAL(0xCF, mem[3]);
+}
+
+void BufferTest::testFastReservedBits()
+{
+    static const uint8_t data[10] = {0xE1, 0x23, 0xEF, 0x45, 0, 0, 0, 0, 0, 0};
+    ts::DuckContext duck;
+    ts::PSIBuffer b(duck, data, sizeof(data));
+
+    TSUNIT_EQUAL(0x0123, b.getPID());
+    TSUNIT_ASSERT(!b.reservedBitsError());
+
+    // 0xEF = 1110 1111: the fourth reserved bit is invalid.
+    TSUNIT_ASSERT(b.skipReservedBits(5));
+    TSUNIT_ASSERT(b.reservedBitsError());
+    TSUNIT_EQUAL(u"Byte 2, bit #4 should be '1'", b.reservedBitsErrorString());
+    TSUNIT_EQUAL(0x0745, b.getBits<11>());
+    TSUNIT_ASSERT(!b.readError());
+}
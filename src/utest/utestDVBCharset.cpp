@@ -32,6 +32,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsDVBCharset.h"
+#include "tsDVBCharTableSingleByte.h"
 #include "tsByteBlock.h"
 #include "tsunit.h"
 
@@ -47,10 +48,12 @@ public:
 
     void testRepository();
     void testDVB();
+    void testLongRuns();
 
     TSUNIT_TEST_BEGIN(DVBCharsetTest);
     TSUNIT_TEST(testRepository);
     TSUNIT_TEST(testDVB);
+    TSUNIT_TEST(testLongRuns);
     TSUNIT_TEST_END();
 };
 
@@ -102,3 +105,50 @@ void DVBCharsetTest::testDVB()
     TSUNIT_EQUAL(str1, ts::DVBCharset::DVB.decoded(dvb1, sizeof(dvb1)));
     TSUNIT_ASSERT(ts::ByteBlock(dvb1, sizeof(dvb1)) == ts::DVBCharset::DVB.encoded(str1.toDecomposedDiacritical()));
 }
+
+void DVBCharsetTest::testLongRuns()
+{
+    // Long ASCII runs, bulk-converted, mixed with special characters at various positions.
+    static const char s1[] = "The quick brown fox jumps over the lazy dog. 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    TSUNIT_EQUAL(u"The quick brown fox jumps over the lazy dog. 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+                 ts::DVBCharset::DVB.decoded(reinterpret_cast<const uint8_t*>(s1), ::strlen(s1)));
+
+    // ISO 6937: reversed diacritical mark in the middle of long runs, CR/LF and untranslatable control character.
+    static const uint8_t dvb2[] = {
+        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R',
+        0xC2, 'e',
+        'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't',
+        0x8A,
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
+    };
+    const ts::UString str2(ts::UString(u"ABCDEFGHIJKLMNOPQR") + ts::LATIN_SMALL_LETTER_E_WITH_ACUTE +
+                           u"abcdefghijklmnopqrst\n01234567890123456789");
+    TSUNIT_EQUAL(str2, ts::DVBCharset::DVB.decoded(dvb2, sizeof(dvb2)));
+
+    static const uint8_t dvb3[] = {
+        0x10, 0x00, 0x0F,  // ISO-8859-15
+        'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 0xA4,
+        'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 0x7F, 'z',
+    };
+    const ts::UString str3(ts::UString(u"abcdefghijklmnopq") + ts::EURO_SIGN + u"abcdefghijklmnopqz");
+    // The table reports the untranslatable character, the DVB charset keeps the rest of the string.
+    ts::UString res3;
+    TSUNIT_ASSERT(!ts::DVBCharTableSingleByte::RAW_ISO_8859_15.decode(res3, dvb3 + 3, sizeof(dvb3) - 3));
+    TSUNIT_EQUAL(str3, res3);
+    TSUNIT_ASSERT(ts::DVBCharset::DVB.decode(res3, dvb3, sizeof(dvb3)));
+    TSUNIT_EQUAL(str3, res3);
+
+    // UTF-8 with multi-byte sequences between long ASCII runs.
+    static const uint8_t dvb4[] = {
+        0x15,  // UTF-8
+        'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r',
+        0xC3, 0xA9,
+        'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r',
+        0xE2, 0x82, 0xAC,
+        'z',
+    };
+    const ts::UString str4(ts::UString(u"abcdefghijklmnopqr") + ts::LATIN_SMALL_LETTER_E_WITH_ACUTE +
+                           u"abcdefghijklmnopqr" + ts::EURO_SIGN + u"z");
+    TSUNIT_EQUAL(str4, ts::DVBCharset::DVB.decoded(dvb4, sizeof(dvb4)));
+    TSUNIT_EQUAL(str4, ts::UString::FromUTF8(reinterpret_cast<const char*>(dvb4 + 1), sizeof(dvb4) - 1));
+}
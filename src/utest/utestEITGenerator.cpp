@@ -0,0 +1,192 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::EITGenerator
+//
+//----------------------------------------------------------------------------
+
+#include "tsEITGenerator.h"
+#include "tsEIT.h"
+#include "tsSectionDemux.h"
+#include "tsDuckContext.h"
+#include "tsTSPacket.h"
+#include "tsMJD.h"
+#include "tsBCD.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class EITGeneratorTest: public tsunit::Test, private ts::SectionHandlerInterface
+{
+public:
+    EITGeneratorTest();
+
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testUpdateTime();
+
+    TSUNIT_TEST_BEGIN(EITGeneratorTest);
+    TSUNIT_TEST(testUpdateTime);
+    TSUNIT_TEST_END();
+
+private:
+    // Packet index of each EIT p/f actual "present" section and its event id (0 if none).
+    std::map<ts::PacketCounter, uint16_t> _present;
+    ts::PacketCounter _packet_index;
+
+    // Build the binary description of an event without descriptor.
+    static void AddEvent(ts::ByteBlock& data, uint16_t event_id, const ts::Time& start, ts::Second duration);
+
+    // Get the "present" event id at a given packet index.
+    uint16_t presentAt(ts::PacketCounter index) const;
+
+    // Implementation of SectionHandlerInterface.
+    virtual void handleSection(ts::SectionDemux& demux, const ts::Section& section) override;
+};
+
+TSUNIT_REGISTER(EITGeneratorTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Constructor.
+EITGeneratorTest::EITGeneratorTest() :
+    _present(),
+    _packet_index(0)
+{
+}
+
+// Test suite initialization method.
+void EITGeneratorTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void EITGeneratorTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Helpers.
+//----------------------------------------------------------------------------
+
+void EITGeneratorTest::AddEvent(ts::ByteBlock& data, uint16_t event_id, const ts::Time& start, ts::Second duration)
+{
+    uint8_t ev[12];
+    ts::PutUInt16(ev, event_id);
+    ts::EncodeMJD(start, ev + 2, 5);
+    ev[7] = ts::EncodeBCD(int(duration / 3600));
+    ev[8] = ts::EncodeBCD(int(duration / 60 % 60));
+    ev[9] = ts::EncodeBCD(int(duration % 60));
+    ts::PutUInt16(ev + 10, 0x0000);  // running status, free CA, no descriptor
+    data.append(ev, sizeof(ev));
+}
+
+uint16_t EITGeneratorTest::presentAt(ts::PacketCounter index) const
+{
+    auto it = _present.upper_bound(index);
+    TSUNIT_ASSERT(it != _present.begin());
+    return (--it)->second;
+}
+
+void EITGeneratorTest::handleSection(ts::SectionDemux& demux, const ts::Section& section)
+{
+    if (section.tableId() == ts::TID_EIT_PF_ACT && section.sectionNumber() == 0) {
+        _present[_packet_index] = section.payloadSize() > ts::EIT::EIT_PAYLOAD_FIXED_SIZE ? ts::GetUInt16(section.payload() + ts::EIT::EIT_PAYLOAD_FIXED_SIZE) : 0;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+// The EPG database is inspected only when some event starts or ends. Check that the generated
+// EIT's are identical to those of a generator which is forced to inspect its database for each
+// packet (setCurrentTime() invalidates the next update time).
+void EITGeneratorTest::testUpdateTime()
+{
+    // With 1,504,000 b/s, each TS packet lasts exactly one millisecond.
+    const ts::BitRate bitrate(ts::PKT_SIZE_BITS * ts::MilliSecPerSec);
+    const ts::PacketCounter packet_count = 30000;
+
+    // Start 10 seconds before a new 3-hour segment.
+    const ts::Time start(2023, 6, 12, 11, 59, 50);
+    const ts::ServiceIdTriplet service(0x0010, 0x0001, 0x0002);
+
+    // Event 2 overlaps event 1 and ends before it. Event 3 crosses the segment boundary.
+    ts::ByteBlock events;
+    AddEvent(events, 0x0101, start + 1 * ts::MilliSecPerSec, 5);
+    AddEvent(events, 0x0102, start + 3 * ts::MilliSecPerSec, 1);
+    AddEvent(events, 0x0103, start + 6 * ts::MilliSecPerSec, 8);
+    AddEvent(events, 0x0104, start + 3 * ts::MilliSecPerHour, 3600);
+
+    ts::DuckContext duck;
+    ts::EITGenerator gen1(duck, ts::PID_EIT);
+    ts::EITGenerator gen2(duck, ts::PID_EIT);
+    for (auto gen : {&gen1, &gen2}) {
+        gen->setTransportStreamId(service.transport_stream_id);
+        gen->setTransportStreamBitRate(bitrate);
+        gen->setCurrentTime(start);
+        TSUNIT_ASSERT(gen->loadEvents(service, events.data(), events.size()));
+    }
+
+    _present.clear();
+    ts::SectionDemux demux(duck, nullptr, this);
+    demux.addPID(ts::PID_EIT);
+
+    size_t eit_count = 0;
+    for (_packet_index = 0; _packet_index < packet_count; ++_packet_index) {
+        ts::TSPacket pkt1(ts::NullPacket);
+        ts::TSPacket pkt2(ts::NullPacket);
+        gen1.processPacket(pkt1);
+        gen2.setCurrentTime(start + ts::MilliSecond(_packet_index));
+        gen2.processPacket(pkt2);
+        TSUNIT_ASSERT(pkt1 == pkt2);
+        if (pkt1.getPID() == ts::PID_EIT) {
+            eit_count++;
+            demux.feedPacket(pkt1);
+        }
+    }
+    debug() << "EITGeneratorTest::testUpdateTime: " << eit_count << " EIT packets, " << _present.size() << " EIT p/f actual present" << std::endl;
+    TSUNIT_ASSERT(eit_count > 0);
+
+    // EIT p/f actual are repeated every 2 seconds. Check the "present" event at various times.
+    TSUNIT_EQUAL(0, presentAt(900));
+    TSUNIT_EQUAL(0x0101, presentAt(5900));
+    TSUNIT_EQUAL(0x0103, presentAt(13900));
+    TSUNIT_EQUAL(0, presentAt(29900));
+}
@@ -0,0 +1,183 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::LatencyHistogram
+//
+//----------------------------------------------------------------------------
+
+#include "tsLatencyHistogram.h"
+#include "tsjsonObject.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class LatencyHistogramTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testEmpty();
+    void testLinear();
+    void testPrecision();
+    void testMerge();
+    void testJSON();
+
+    TSUNIT_TEST_BEGIN(LatencyHistogramTest);
+    TSUNIT_TEST(testEmpty);
+    TSUNIT_TEST(testLinear);
+    TSUNIT_TEST(testPrecision);
+    TSUNIT_TEST(testMerge);
+    TSUNIT_TEST(testJSON);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(LatencyHistogramTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void LatencyHistogramTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void LatencyHistogramTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void LatencyHistogramTest::testEmpty()
+{
+    ts::LatencyHistogram hist;
+    TSUNIT_EQUAL(0, hist.count());
+    TSUNIT_EQUAL(0, hist.minimum());
+    TSUNIT_EQUAL(0, hist.maximum());
+    TSUNIT_EQUAL(0, hist.mean());
+    TSUNIT_EQUAL(0, hist.percentile(50.0));
+    TSUNIT_EQUAL(0, hist.percentile(100.0));
+}
+
+void LatencyHistogramTest::testLinear()
+{
+    // Small values are exactly recorded.
+    ts::LatencyHistogram hist;
+    for (ts::NanoSecond i = 1; i <= 10; ++i) {
+        hist.add(i);
+    }
+    TSUNIT_EQUAL(10, hist.count());
+    TSUNIT_EQUAL(1, hist.minimum());
+    TSUNIT_EQUAL(10, hist.maximum());
+    TSUNIT_EQUAL(55, hist.sum());
+    TSUNIT_EQUAL(5, hist.mean());
+    TSUNIT_EQUAL(1, hist.percentile(0.0));
+    TSUNIT_EQUAL(1, hist.percentile(10.0));
+    TSUNIT_EQUAL(5, hist.percentile(50.0));
+    TSUNIT_EQUAL(9, hist.percentile(90.0));
+    TSUNIT_EQUAL(10, hist.percentile(99.0));
+    TSUNIT_EQUAL(10, hist.percentile(100.0));
+
+    // Negative values are recorded as zero.
+    hist.add(-5);
+    TSUNIT_EQUAL(11, hist.count());
+    TSUNIT_EQUAL(0, hist.minimum());
+
+    hist.reset();
+    TSUNIT_EQUAL(0, hist.count());
+    TSUNIT_EQUAL(0, hist.maximum());
+}
+
+void LatencyHistogramTest::testPrecision()
+{
+    // Large values have a relative error of 1/8 at most.
+    ts::LatencyHistogram hist;
+    for (ts::NanoSecond i = 1; i <= 1000; ++i) {
+        hist.add(i * ts::NanoSecPerMicroSec);
+    }
+    TSUNIT_EQUAL(1000, hist.count());
+    TSUNIT_EQUAL(ts::NanoSecPerMicroSec, hist.minimum());
+    TSUNIT_EQUAL(ts::NanoSecPerMilliSec, hist.maximum());
+
+    const double percents[] = {10.0, 25.0, 50.0, 75.0, 90.0, 99.0};
+    for (double pc : percents) {
+        const double expected = pc * 10 * ts::NanoSecPerMicroSec;
+        const double actual = double(hist.percentile(pc));
+        debug() << "LatencyHistogramTest::testPrecision: p" << pc << ": expected " << expected << ", actual " << actual << std::endl;
+        TSUNIT_ASSERT(actual >= expected);
+        TSUNIT_ASSERT(actual <= expected * 1.125);
+    }
+    TSUNIT_EQUAL(ts::NanoSecPerMilliSec, hist.percentile(100.0));
+
+    // Extreme value in last bucket.
+    hist.add(std::numeric_limits<ts::NanoSecond>::max());
+    TSUNIT_EQUAL(std::numeric_limits<ts::NanoSecond>::max(), hist.maximum());
+    TSUNIT_EQUAL(std::numeric_limits<ts::NanoSecond>::max(), hist.percentile(100.0));
+}
+
+void LatencyHistogramTest::testMerge()
+{
+    ts::LatencyHistogram h1, h2;
+    for (ts::NanoSecond i = 0; i < 100; ++i) {
+        h1.add(i + 10);
+        h2.add(i + 1000);
+    }
+    h1.add(h2);
+    TSUNIT_EQUAL(200, h1.count());
+    TSUNIT_EQUAL(10, h1.minimum());
+    TSUNIT_EQUAL(1099, h1.maximum());
+    TSUNIT_ASSERT(h1.percentile(50.0) < 1000);
+    TSUNIT_ASSERT(h1.percentile(51.0) >= 1000);
+}
+
+void LatencyHistogramTest::testJSON()
+{
+    ts::LatencyHistogram hist;
+    hist.add(2 * ts::NanoSecPerMicroSec);
+    hist.add(4 * ts::NanoSecPerMicroSec);
+
+    ts::json::Object obj;
+    hist.toJSON(obj);
+    TSUNIT_EQUAL(2, obj.value(u"count").toInteger());
+    TSUNIT_EQUAL(2000, obj.value(u"min").toInteger());
+    TSUNIT_EQUAL(3000, obj.value(u"mean").toInteger());
+    TSUNIT_EQUAL(4000, obj.value(u"max").toInteger());
+    TSUNIT_EQUAL(u"min: 2000 ns, p50: 2047 ns, p90: 4000 ns, p99: 4000 ns, p99.9: 4000 ns, max: 4000 ns", hist.summary());
+    TSUNIT_EQUAL(u"15 us", ts::LatencyHistogram::DurationString(15 * ts::NanoSecPerMicroSec));
+    TSUNIT_EQUAL(u"1,234 s", ts::LatencyHistogram::DurationString(1234 * ts::NanoSecPerSec));
+}
@@ -96,6 +96,7 @@ public:
     void testGetIntVarLE();
     void testPutIntVarBE();
     void testPutIntVarLE();
+    void testLocateZeroZero();
 
     TSUNIT_TEST_BEGIN(MemoryTest);
     TSUNIT_TEST(testMemoryBarrier);
@@ -149,6 +150,7 @@ public:
     TSUNIT_TEST(testGetIntVarLE);
     TSUNIT_TEST(testPutIntVarBE);
     TSUNIT_TEST(testPutIntVarLE);
+    TSUNIT_TEST(testLocateZeroZero);
     TSUNIT_TEST_END();
 };
 
@@ -544,3 +546,42 @@ void MemoryTest::testPutIntVarLE()
     ts::PutIntVarLE(out, 8, TS_UCONST64(0x908F8E8D8C8B8A89));
     TSUNIT_EQUAL(0, ::memcmp(out, _bytes + 0x89, 8));
 }
+
+void MemoryTest::testLocateZeroZero()
+{
+    uint8_t buf[200];
+    ::memset(buf, 0xAB, sizeof(buf));
+
+    TSUNIT_ASSERT(ts::LocateZeroZero(buf, sizeof(buf), 0x01) == nullptr);
+    TSUNIT_ASSERT(ts::LocateZeroZero(buf, 0, 0x01) == nullptr);
+
+    // Check all positions and all area sizes around SIMD block boundaries, compare with LocatePattern().
+    static const uint8_t pattern[] = {0x00, 0x00, 0x01};
+    for (size_t pos = 0; pos + 3 <= 100; ++pos) {
+        ::memset(buf, 0xAB, sizeof(buf));
+        ::memcpy(buf + pos, pattern, sizeof(pattern));
+        for (size_t size = 0; size <= 100; ++size) {
+            TSUNIT_ASSERT(ts::LocateZeroZero(buf, size, 0x01) == ts::LocatePattern(buf, size, pattern, sizeof(pattern)));
+        }
+        // Area starting after the pattern.
+        TSUNIT_ASSERT(ts::LocateZeroZero(buf + pos + 1, 100, 0x01) == nullptr);
+    }
+
+    // Sequences of zeroes: 00 00 00 00 01.
+    ::memset(buf, 0xAB, sizeof(buf));
+    ::memset(buf + 30, 0x00, 4);
+    buf[34] = 0x01;
+    TSUNIT_ASSERT(ts::LocateZeroZero(buf, sizeof(buf), 0x01) == buf + 32);
+    TSUNIT_ASSERT(ts::LocateZeroZero(buf, sizeof(buf), 0x00) == buf + 30);
+    TSUNIT_ASSERT(ts::LocateZeroZero(buf, sizeof(buf), 0x03) == nullptr);
+
+    // Zero bytes which are not part of a pattern.
+    ::memset(buf, 0xAB, sizeof(buf));
+    for (size_t i = 0; i < sizeof(buf); i += 2) {
+        buf[i] = 0x00;
+    }
+    buf[150] = buf[151] = 0x00;
+    buf[152] = 0x03;
+    TSUNIT_ASSERT(ts::LocateZeroZero(buf, sizeof(buf), 0x03) == buf + 150);
+    TSUNIT_ASSERT(ts::LocateZeroZero(buf, sizeof(buf), 0x01) == nullptr);
+}
@@ -0,0 +1,211 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::MetricsServer
+//
+//----------------------------------------------------------------------------
+
+#include "tsMetricsServer.h"
+#include "tsTCPConnection.h"
+#include "tsIPUtils.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class MetricsServerTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testSnapshot();
+    void testHTTP();
+
+    TSUNIT_TEST_BEGIN(MetricsServerTest);
+    TSUNIT_TEST(testSnapshot);
+    TSUNIT_TEST(testHTTP);
+    TSUNIT_TEST_END();
+
+private:
+    // Send an HTTP request to the server, return the complete response.
+    static std::string Request(const ts::IPv4SocketAddress& server, const std::string& request);
+
+    // A collector which counts its invocations.
+    class Collector : public ts::MetricsCollectorInterface
+    {
+    public:
+        int count = 0;
+        ts::MetricsServer::Metric* metric = nullptr;
+        virtual void collectMetrics(ts::MetricsServer&) override { metric->set(++count); }
+    };
+};
+
+TSUNIT_REGISTER(MetricsServerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void MetricsServerTest::beforeTest()
+{
+    ts::IPInitialize();
+}
+
+// Test suite cleanup method.
+void MetricsServerTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Send an HTTP request to the server.
+//----------------------------------------------------------------------------
+
+std::string MetricsServerTest::Request(const ts::IPv4SocketAddress& server, const std::string& request)
+{
+    ts::TCPConnection session;
+    TSUNIT_ASSERT(session.open(CERR));
+    TSUNIT_ASSERT(session.connect(server, CERR));
+    TSUNIT_ASSERT(session.send(request.data(), request.size(), CERR));
+
+    // Read the response until the server closes the connection.
+    std::string response;
+    char buf[1024];
+    size_t size = 0;
+    while (session.receive(buf, sizeof(buf), size, nullptr, NULLREP)) {
+        response.append(buf, size);
+    }
+    session.close(NULLREP);
+    return response;
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void MetricsServerTest::testSnapshot()
+{
+    ts::MetricsServer server(CERR);
+    ts::MetricsServer::Metric& m1(server.addMetric(u"test_packets_total", ts::MetricsServer::Type::COUNTER, u"Number of packets", u"plugin=\"a\""));
+    ts::MetricsServer::Metric& m2(server.addMetric(u"test_bitrate", ts::MetricsServer::Type::GAUGE, u"Bitrate\nin b/s"));
+    ts::MetricsServer::Metric& m3(server.addMetric(u"test_packets_total", ts::MetricsServer::Type::COUNTER, u"ignored", u"plugin=\"b\""));
+    ts::MetricsServer::Metric& m4(server.addMetric(u"test_work_seconds_total", ts::MetricsServer::Type::COUNTER, u"Time", u"", ts::NanoSecPerSec));
+
+    m1.add(12);
+    m1.add();
+    m2.set(1000000);
+    m3.set(7);
+    m4.set(1500000000);
+
+    // No snapshot yet.
+    TSUNIT_EQUAL("", server.snapshot());
+
+    server.updateSnapshot();
+    TSUNIT_EQUAL(13, m1.value());
+    TSUNIT_EQUAL(
+        "# HELP test_packets_total Number of packets\n"
+        "# TYPE test_packets_total counter\n"
+        "test_packets_total{plugin=\"a\"} 13\n"
+        "test_packets_total{plugin=\"b\"} 7\n"
+        "# HELP test_bitrate Bitrate\\nin b/s\n"
+        "# TYPE test_bitrate gauge\n"
+        "test_bitrate 1000000\n"
+        "# HELP test_work_seconds_total Time\n"
+        "# TYPE test_work_seconds_total counter\n"
+        "test_work_seconds_total 1.5\n",
+        server.snapshot());
+
+    // Updates are visible at next snapshot only.
+    m2.set(-3);
+    TSUNIT_ASSERT(server.snapshot().find("test_bitrate 1000000\n") != std::string::npos);
+    server.updateSnapshot();
+    TSUNIT_ASSERT(server.snapshot().find("test_bitrate -3\n") != std::string::npos);
+
+    // Collector is invoked before each snapshot.
+    Collector coll;
+    coll.metric = &m2;
+    server.setCollector(&coll);
+    server.updateSnapshot();
+    server.updateSnapshot();
+    TSUNIT_EQUAL(2, coll.count);
+    TSUNIT_ASSERT(server.snapshot().find("test_bitrate 2\n") != std::string::npos);
+}
+
+void MetricsServerTest::testHTTP()
+{
+    ts::MetricsServer server(CERR);
+    ts::MetricsServer::Metric& m1(server.addMetric(u"test_counter", ts::MetricsServer::Type::COUNTER, u"Test counter"));
+    m1.set(42);
+
+    // Open on a dynamic port on the loopback interface.
+    TSUNIT_ASSERT(server.open(ts::IPv4SocketAddress(ts::IPv4Address::LocalHost, ts::IPv4SocketAddress::AnyPort), 60 * ts::MilliSecPerSec));
+    TSUNIT_ASSERT(server.isOpen());
+    ts::IPv4SocketAddress addr;
+    TSUNIT_ASSERT(server.getLocalAddress(addr));
+    TSUNIT_ASSERT(addr.port() != 0);
+    addr.setAddress(ts::IPv4Address::LocalHost);
+    debug() << "MetricsServerTest::testHTTP: server address: " << addr << std::endl;
+
+    const std::string body("# HELP test_counter Test counter\n# TYPE test_counter counter\ntest_counter 42\n");
+    std::string resp(Request(addr, "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n"));
+    debug() << "MetricsServerTest::testHTTP: response: " << resp << std::endl;
+    TSUNIT_ASSERT(resp.find("HTTP/1.1 200 OK\r\n") == 0);
+    TSUNIT_ASSERT(resp.find("Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n") != std::string::npos);
+    TSUNIT_ASSERT(resp.find("Content-Length: " + std::to_string(body.size()) + "\r\n") != std::string::npos);
+    TSUNIT_ASSERT(resp.size() > body.size());
+    TSUNIT_EQUAL(body, resp.substr(resp.size() - body.size()));
+
+    // The value is not computed on scrape, only on snapshot.
+    m1.set(43);
+    resp = Request(addr, "GET /metrics HTTP/1.0\r\n\r\n");
+    TSUNIT_ASSERT(resp.find("test_counter 42\n") != std::string::npos);
+    server.updateSnapshot();
+    resp = Request(addr, "GET /metrics?name[]=test HTTP/1.0\r\n\r\n");
+    TSUNIT_ASSERT(resp.find("test_counter 43\n") != std::string::npos);
+
+    // Errors.
+    resp = Request(addr, "GET /foo HTTP/1.1\r\n\r\n");
+    TSUNIT_ASSERT(resp.find("HTTP/1.1 404 Not Found\r\n") == 0);
+    resp = Request(addr, "POST /metrics HTTP/1.1\r\n\r\n");
+    TSUNIT_ASSERT(resp.find("HTTP/1.1 405 Method Not Allowed\r\n") == 0);
+
+    // HEAD returns no body.
+    resp = Request(addr, "HEAD /metrics HTTP/1.1\r\n\r\n");
+    TSUNIT_ASSERT(resp.find("HTTP/1.1 200 OK\r\n") == 0);
+    TSUNIT_ASSERT(resp.find("test_counter") == std::string::npos);
+
+    server.close();
+    TSUNIT_ASSERT(!server.isOpen());
+}
@@ -52,11 +52,13 @@ public:
     void testArithmetic();
     void testSysWait();
     void testWait();
+    void testSpinWait();
 
     TSUNIT_TEST_BEGIN(MonotonicTest);
     TSUNIT_TEST(testArithmetic);
     TSUNIT_TEST(testSysWait);
     TSUNIT_TEST(testWait);
+    TSUNIT_TEST(testSpinWait);
     TSUNIT_TEST_END();
 private:
     ts::NanoSecond  _nsPrecision;
@@ -153,3 +155,18 @@ void MonotonicTest::testWait()
     TSUNIT_ASSERT(end >= start + 100 - _msPrecision);
     TSUNIT_ASSUME(end < start + 150);
 }
+
+void MonotonicTest::testSpinWait()
+{
+    ts::Monotonic due(true);
+    due += 20 * ts::NanoSecPerMilliSec;
+    const ts::NanoSecond ns = due.nanoSeconds();
+    due.wait(5 * ts::NanoSecPerMilliSec);
+
+    // With an active wait, the due time is never missed on the early side.
+    const ts::Monotonic end(true);
+    debug() << "MonotonicTest::testSpinWait: late by " << (end.nanoSeconds() - ns) << " ns" << std::endl;
+    TSUNIT_ASSERT(end >= due);
+    TSUNIT_ASSERT(end.nanoSeconds() >= ns);
+    TSUNIT_ASSUME(end.nanoSeconds() < ns + 20 * ts::NanoSecPerMilliSec);
+}
@@ -35,6 +35,7 @@
 #include "tsNames.h"
 #include "tsNullReport.h"
 #include "tsFileUtils.h"
+#include "tsSysUtils.h"
 #include "tsDuckContext.h"
 #include "tsCASFamily.h"
 #include "tsMPEG2.h"
@@ -99,6 +100,7 @@ public:
     void testIP();
     void testExtension();
     void testInheritance();
+    void testCache();
 
     TSUNIT_TEST_BEGIN(NamesTest);
     TSUNIT_TEST(testConfigFile);
@@ -142,6 +144,7 @@ public:
     TSUNIT_TEST(testIP);
     TSUNIT_TEST(testExtension);
     TSUNIT_TEST(testInheritance);
+    TSUNIT_TEST(testCache);
     TSUNIT_TEST_END();
 
 private:
@@ -550,3 +553,100 @@ void NamesTest::testInheritance()
     TSUNIT_EQUAL(u"value1", file.nameFromSection(u"level1", 1));
     TSUNIT_EQUAL(u"unknown (0x00)", file.nameFromSection(u"level1", 0));
 }
+
+namespace {
+    // Use a temporary cache directory during the lifetime of the object.
+    // The directory is deleted and the environment is restored, even when an assertion fails.
+    class TempCacheDirectory
+    {
+        TS_NOCOPY(TempCacheDirectory);
+    public:
+        const ts::UString dir;
+        TempCacheDirectory() :
+            dir(ts::TempFile(u".cache")),
+            _previous(ts::GetEnvironment(u"TSDUCK_CACHE_DIR")),
+            _defined(ts::EnvironmentExists(u"TSDUCK_CACHE_DIR"))
+        {
+            ts::SetEnvironment(u"TSDUCK_CACHE_DIR", dir);
+        }
+        ~TempCacheDirectory()
+        {
+            ts::UStringVector files;
+            ts::ExpandWildcard(files, dir + ts::PathSeparator + u"*");
+            for (const auto& name : files) {
+                ts::DeleteFile(name, NULLREP);
+            }
+            ts::DeleteFile(dir, NULLREP);
+            if (_defined) {
+                ts::SetEnvironment(u"TSDUCK_CACHE_DIR", _previous);
+            }
+            else {
+                ts::DeleteEnvironment(u"TSDUCK_CACHE_DIR");
+            }
+        }
+    private:
+        const ts::UString _previous;
+        const bool _defined;
+    };
+}
+
+void NamesTest::testCache()
+{
+    // Without TSDUCK_CACHE_DIR, there is no cache (this is the case in unit tests, see utest.cpp).
+    TSUNIT_ASSERT(ts::NamesFile::CacheDirectory().empty());
+
+    // Use a temporary cache directory.
+    const TempCacheDirectory cache;
+    TSUNIT_EQUAL(cache.dir, ts::NamesFile::CacheDirectory());
+
+    // Create a temporary names file.
+    TSUNIT_ASSERT(ts::UString::Save(ts::UStringVector({
+        u"[Section1]",
+        u"Bits = 16",
+        u"0x0001 = value1",
+        u"0x0010-0x001F = range1",
+        u"[section2]",
+        u"Inherit = section1",
+        u"0x0002 = value2",
+    }), _tempFileName));
+
+    {
+        // First load: parse the text file and create the cache.
+        ts::NamesFile file(_tempFileName);
+        TSUNIT_ASSERT(!file.loadedFromCache());
+        TSUNIT_EQUAL(0, file.errorCount());
+        TSUNIT_EQUAL(u"value1", file.nameFromSection(u"section1", 1));
+    }
+    {
+        // Second load: use the cache.
+        ts::NamesFile file(_tempFileName);
+        TSUNIT_ASSERT(file.loadedFromCache());
+        TSUNIT_EQUAL(u"value1", file.nameFromSection(u"Section1", 1));
+        TSUNIT_EQUAL(u"range1", file.nameFromSection(u"section1", 0x15));
+        TSUNIT_EQUAL(u"unknown (0x0020)", file.nameFromSection(u"section1", 0x20));
+        TSUNIT_EQUAL(u"value2", file.nameFromSection(u"section2", 2));
+        TSUNIT_EQUAL(u"range1", file.nameFromSection(u"section2", 0x10));
+        TSUNIT_ASSERT(!file.nameExists(u"section2", 3));
+    }
+
+    // Modify the text file, the cache is obsolete.
+    TSUNIT_ASSERT(ts::UString::Save(ts::UStringVector({
+        u"[section1]",
+        u"Bits = 16",
+        u"0x0001 = newvalue1",
+        u"0x0003 = value3",
+    }), _tempFileName));
+    {
+        ts::NamesFile file(_tempFileName);
+        TSUNIT_ASSERT(!file.loadedFromCache());
+        TSUNIT_EQUAL(u"newvalue1", file.nameFromSection(u"section1", 1));
+        TSUNIT_EQUAL(u"value3", file.nameFromSection(u"section1", 3));
+        TSUNIT_ASSERT(!file.nameExists(u"section2", 2));
+    }
+    {
+        // The cache of the modified file was recreated.
+        ts::NamesFile file(_tempFileName);
+        TSUNIT_ASSERT(file.loadedFromCache());
+        TSUNIT_EQUAL(u"newvalue1", file.nameFromSection(u"section1", 1));
+    }
+}
@@ -58,14 +58,19 @@ public:
     virtual void afterTest() override;
 
     void testPacketizer();
+    void testPacketCache();
 
     TSUNIT_TEST_BEGIN(PacketizerTest);
     TSUNIT_TEST(testPacketizer);
+    TSUNIT_TEST(testPacketCache);
     TSUNIT_TEST_END();
 
 private:
     // Demux one table from a list of packets
     static void DemuxTable(ts::BinaryTablePtr& binTable, const char* name, const uint8_t* packets, size_t packets_size);
+
+    // Check that the cache of pre-packetized sections produces identical packets.
+    static void CheckPacketCache(ts::CyclingPacketizer::StuffingPolicy policy, const ts::BitRate& bitrate);
 };
 
 TSUNIT_REGISTER(PacketizerTest);
@@ -177,3 +182,43 @@ void PacketizerTest::testPacketizer()
     TSUNIT_ASSERT(pmt_count == 4);
     TSUNIT_ASSERT(sdt_count >= 12 && sdt_count <= 18);
 }
+
+void PacketizerTest::CheckPacketCache(ts::CyclingPacketizer::StuffingPolicy policy, const ts::BitRate& bitrate)
+{
+    ts::DuckContext duck;
+    ts::CyclingPacketizer pzer1(duck, 100, policy, bitrate);
+    ts::CyclingPacketizer pzer2(duck, 100, policy, bitrate);
+    pzer2.setPacketCache(true);
+    TSUNIT_ASSERT(!pzer1.packetCache());
+    TSUNIT_ASSERT(pzer2.packetCache());
+
+    // Sections of various sizes, some of them using several packets.
+    const size_t sizes[] = {10, 170, 175, 180, 183, 184, 300, 367, 1000, 4000};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        ts::ByteBlock payload(sizes[i], uint8_t(i));
+        ts::SectionPtr sec(new ts::Section(ts::TID(0x80 + i), true, 0x1234, 0, true, 0, 0, payload.data(), payload.size()));
+        TSUNIT_ASSERT(sec->isValid());
+        pzer1.addSection(sec, i % 3 == 0 ? 0 : ts::MilliSecond(50 * i));
+        pzer2.addSection(sec, i % 3 == 0 ? 0 : ts::MilliSecond(50 * i));
+    }
+
+    for (size_t pi = 0; pi < 1000; ++pi) {
+        ts::TSPacket pkt1;
+        ts::TSPacket pkt2;
+        const bool ok1 = pzer1.getNextPacket(pkt1);
+        const bool ok2 = pzer2.getNextPacket(pkt2);
+        TSUNIT_EQUAL(ok1, ok2);
+        TSUNIT_EQUAL(0, ::memcmp(pkt1.b, pkt2.b, ts::PKT_SIZE));
+        TSUNIT_EQUAL(pzer1.atCycleBoundary(), pzer2.atCycleBoundary());
+        TSUNIT_EQUAL(pzer1.sectionCount(), pzer2.sectionCount());
+    }
+}
+
+void PacketizerTest::testPacketCache()
+{
+    CheckPacketCache(ts::CyclingPacketizer::StuffingPolicy::ALWAYS, 0);
+    CheckPacketCache(ts::CyclingPacketizer::StuffingPolicy::ALWAYS, 1000000);
+    CheckPacketCache(ts::CyclingPacketizer::StuffingPolicy::AT_END, 0);
+    CheckPacketCache(ts::CyclingPacketizer::StuffingPolicy::AT_END, 1000000);
+    CheckPacketCache(ts::CyclingPacketizer::StuffingPolicy::NEVER, 0);
+}
@@ -31,10 +31,14 @@
 //
 //----------------------------------------------------------------------------
 
+#include "tsAsyncReport.h"
 #include "tsReportBuffer.h"
 #include "tsReportFile.h"
 #include "tsFileUtils.h"
 #include "tsNullReport.h"
+#include "tsGuardMutex.h"
+#include "tsSysUtils.h"
+#include "tsThread.h"
 #include "tsunit.h"
 
 
@@ -55,6 +59,9 @@ public:
     void testPrintf();
     void testByName();
     void testByStream();
+    void testLazyLog();
+    void testAsyncSynchronous();
+    void testAsyncOverflow();
 
     TSUNIT_TEST_BEGIN(ReportTest);
     TSUNIT_TEST(testSeverity);
@@ -62,6 +69,9 @@ public:
     TSUNIT_TEST(testPrintf);
     TSUNIT_TEST(testByName);
     TSUNIT_TEST(testByStream);
+    TSUNIT_TEST(testLazyLog);
+    TSUNIT_TEST(testAsyncSynchronous);
+    TSUNIT_TEST(testAsyncOverflow);
     TSUNIT_TEST_END();
 
 private:
@@ -326,3 +336,137 @@ void ReportTest::testByStream()
     ts::UString::Load(value, _fileName);
     TSUNIT_ASSERT(value == ref);
 }
+
+// Test case: arguments are not evaluated below the severity.
+namespace {
+    int _lazyCount = 0;
+    int _lazyValue()
+    {
+        return ++_lazyCount;
+    }
+}
+
+void ReportTest::testLazyLog()
+{
+    ts::ReportBuffer<> log(ts::Severity::Info);
+    _lazyCount = 0;
+
+    TS_DEBUG(log, u"value: %d", {_lazyValue()});
+    TS_VERBOSE(log, u"value: %d", {_lazyValue()});
+    TS_LOG(log, 3, u"value: %d", {_lazyValue()});
+    TSUNIT_EQUAL(0, _lazyCount);
+    TSUNIT_ASSERT(log.emptyMessages());
+
+    TS_LOG(log, ts::Severity::Info, u"value: %d, %s, %5d|%-5d|%'d", {_lazyValue(), u"foo", -12, 34, -1234567});
+    TS_LOG(log, ts::Severity::Warning, u"message");
+    TSUNIT_EQUAL(1, _lazyCount);
+    TSUNIT_EQUAL(u"value: 1, foo,   -12|34   |-1,234,567\n"
+                 u"Warning: message",
+                 log.getMessages());
+
+    log.setMaxSeverity(ts::Severity::Debug);
+    log.resetMessages();
+    TS_DEBUG(log, u"value: %d", {_lazyValue()});
+    TSUNIT_EQUAL(2, _lazyCount);
+    TSUNIT_EQUAL(u"Debug: value: 2", log.getMessages());
+}
+
+// An asynchronous report which collects messages and can be paused.
+namespace {
+    class CollectReport : public ts::AsyncReport
+    {
+        TS_NOBUILD_NOCOPY(CollectReport);
+    public:
+        CollectReport(const ts::AsyncReportArgs& args) : ts::AsyncReport(ts::Severity::Info, args), mutex(), paused(false), messages() {}
+        virtual ~CollectReport() override { terminate(); }
+        ts::Mutex mutex;
+        volatile bool paused;
+        ts::UStringVector messages;
+    private:
+        virtual void asyncThreadLog(int severity, const ts::UString& message) override
+        {
+            while (paused) {
+                ts::SleepThread(1);
+            }
+            ts::GuardMutex lock(mutex);
+            messages.push_back(message);
+        }
+    };
+
+    class LogThread : public ts::Thread
+    {
+        TS_NOBUILD_NOCOPY(LogThread);
+    public:
+        LogThread(ts::Report& report, int id, int count) : ts::Thread(), _report(report), _id(id), _count(count) {}
+        virtual ~LogThread() override { waitForTermination(); }
+    private:
+        ts::Report& _report;
+        int _id;
+        int _count;
+        virtual void main() override
+        {
+            for (int i = 0; i < _count; ++i) {
+                _report.info(u"thread %d, message %d", {_id, i});
+            }
+        }
+    };
+}
+
+// Test case: multiple producers in synchronous mode, no message is lost.
+void ReportTest::testAsyncSynchronous()
+{
+    ts::AsyncReportArgs args;
+    args.sync_log = true;
+    args.log_msg_count = 16;
+    CollectReport log(args);
+
+    constexpr int thread_count = 4;
+    constexpr int msg_count = 500;
+    {
+        LogThread t1(log, 1, msg_count);
+        LogThread t2(log, 2, msg_count);
+        LogThread t3(log, 3, msg_count);
+        LogThread t4(log, 4, msg_count);
+        TSUNIT_ASSERT(t1.start());
+        TSUNIT_ASSERT(t2.start());
+        TSUNIT_ASSERT(t3.start());
+        TSUNIT_ASSERT(t4.start());
+    }
+    log.terminate();
+
+    TSUNIT_EQUAL(0, log.droppedMessages());
+    TSUNIT_EQUAL(size_t(thread_count * msg_count), log.messages.size());
+
+    // Messages from the same thread are delivered in order.
+    int next[thread_count + 1] = {0, 0, 0, 0, 0};
+    for (const auto& msg : log.messages) {
+        int id = 0, index = 0;
+        TSUNIT_ASSERT(msg.scan(u"thread %d, message %d", {&id, &index}));
+        TSUNIT_ASSERT(id >= 1 && id <= thread_count);
+        TSUNIT_EQUAL(next[id], index);
+        next[id] = index + 1;
+    }
+}
+
+// Test case: messages are dropped and counted when the queue is full.
+void ReportTest::testAsyncOverflow()
+{
+    ts::AsyncReportArgs args;
+    args.log_msg_count = 8;
+    CollectReport log(args);
+
+    // Block the logging thread after its first message.
+    log.paused = true;
+    for (int i = 0; i < 100; ++i) {
+        log.info(u"message %d", {i});
+    }
+    TSUNIT_ASSERT(log.droppedMessages() > 0);
+    const uint64_t dropped = log.droppedMessages();
+    log.paused = false;
+    log.terminate();
+
+    TSUNIT_ASSERT(log.messages.size() >= 2);
+    TSUNIT_EQUAL(100 - dropped + 1, log.messages.size());
+    TSUNIT_EQUAL(u"message 0", log.messages.front());
+    TSUNIT_EQUAL(ts::UString::Format(u"%'d log messages dropped, queue overflow", {dropped}), log.messages.back());
+}
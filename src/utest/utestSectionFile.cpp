@@ -72,6 +72,7 @@ public:
     void testMultiSectionsCAT();
     void testMultiSectionsAtProgramLevelPMT();
     void testMultiSectionsAtStreamLevelPMT();
+    void testMultiThreads();
 
     TSUNIT_TEST_BEGIN(SectionFileTest);
     TSUNIT_TEST(testConfigurationFile);
@@ -85,11 +86,14 @@ public:
     TSUNIT_TEST(testMultiSectionsCAT);
     TSUNIT_TEST(testMultiSectionsAtProgramLevelPMT);
     TSUNIT_TEST(testMultiSectionsAtStreamLevelPMT);
+    TSUNIT_TEST(testMultiThreads);
     TSUNIT_TEST_END();
 
 private:
     // Unitary test for one table.
     void testTable(const char* name, const ts::UChar* ref_xml, const uint8_t* ref_sections, size_t ref_sections_size);
+    // Compile an XML document using a given number of threads.
+    bool compileXML(const ts::UString& xml, size_t threads, ts::ByteBlock& sections, ts::Standards& standards);
     ts::Report& report();
     ts::UString _tempFileNameBin;
     ts::UString _tempFileNameXML;
@@ -768,3 +772,82 @@ void SectionFileTest::testMemory()
     TSUNIT_EQUAL(0, ::memcmp(out2, psi_pat1_sections, sizeof(psi_pat1_sections)));
     TSUNIT_EQUAL(0, ::memcmp(out2 + 32, psi_pmt_scte35_sections, sizeof(psi_pmt_scte35_sections)));
 }
+
+bool SectionFileTest::compileXML(const ts::UString& xml, size_t threads, ts::ByteBlock& sections, ts::Standards& standards)
+{
+    ts::DuckContext duck(&report());
+    ts::SectionFile file(duck);
+    file.setMaxThreads(threads);
+    const bool success = file.parseXML(xml);
+
+    std::stringstream strm(std::ios::out | std::ios::binary);
+    TSUNIT_ASSERT(file.saveBinary(strm));
+    const std::string bin(strm.str());
+    sections.copy(bin.data(), bin.size());
+    standards = duck.standards();
+    return success;
+}
+
+void SectionFileTest::testMultiThreads()
+{
+    // A document with enough tables to use several threads and an ATSC table in the middle.
+    ts::UString xml(u"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<tsduck>\n");
+    ts::UString bad_xml(xml);
+    for (size_t i = 0; i < 200; ++i) {
+        ts::UString table;
+        switch (i % 4) {
+            case 0:
+                table.format(u"<PAT version=\"%d\" transport_stream_id=\"%d\"><service service_id=\"%d\" program_map_PID=\"%d\"/></PAT>\n", {i % 32, i, i + 1, i + 100});
+                break;
+            case 1:
+                table.format(u"<PMT version=\"%d\" service_id=\"%d\" PCR_PID=\"%d\"><CA_descriptor CA_system_id=\"%d\" CA_PID=\"%d\"/>"
+                             u"<component stream_type=\"0x1B\" elementary_PID=\"%d\"/></PMT>\n", {i % 32, i, i + 100, i + 0x100, i + 200, i + 100});
+                break;
+            case 2:
+                table.format(u"<SDT version=\"%d\" transport_stream_id=\"%d\" original_network_id=\"%d\"><service service_id=\"%d\">"
+                             u"<service_descriptor service_type=\"1\" service_provider_name=\"Provider\" service_name=\"Cha\u00EEne %d\"/></service></SDT>\n", {i % 32, i, i + 1, i + 2, i});
+                break;
+            default:
+                if (i == 99) {
+                    table.format(u"<STT system_time=\"%d\" GPS_UTC_offset=\"18\" DS_status=\"false\"/>\n", {1000000 + i});
+                }
+                else {
+                    table.format(u"<TOT UTC_time=\"2023-01-02 03:04:%02d\"/>\n", {i % 60});
+                }
+                break;
+        }
+        xml.append(table);
+        bad_xml.append(table);
+        if (i == 77) {
+            // A valid XML element which fails to compile (invalid DS_hour). The standards of the
+            // STT are not added to the context, the prediction of the compilation threads is wrong.
+            bad_xml.append(u"<STT system_time=\"1\" GPS_UTC_offset=\"18\" DS_status=\"false\" DS_hour=\"30\"/>\n");
+        }
+    }
+    xml.append(u"</tsduck>\n");
+    bad_xml.append(u"</tsduck>\n");
+
+    ts::ByteBlock ref_sections;
+    ts::Standards ref_standards = ts::Standards::NONE;
+    TSUNIT_ASSERT(compileXML(xml, 1, ref_sections, ref_standards));
+    TSUNIT_ASSERT(!ref_sections.empty());
+    TSUNIT_ASSERT(ref_standards == (ts::Standards::MPEG | ts::Standards::DVB | ts::Standards::ATSC));
+
+    ts::ByteBlock bad_ref_sections;
+    ts::Standards bad_ref_standards = ts::Standards::NONE;
+    TSUNIT_ASSERT(!compileXML(bad_xml, 1, bad_ref_sections, bad_ref_standards));
+    TSUNIT_ASSERT(bad_ref_sections == ref_sections);
+
+    for (size_t threads = 2; threads <= 8; threads *= 2) {
+        ts::ByteBlock sections;
+        ts::Standards standards = ts::Standards::NONE;
+        TSUNIT_ASSERT(compileXML(xml, threads, sections, standards));
+        TSUNIT_ASSERT(sections == ref_sections);
+        TSUNIT_ASSERT(standards == ref_standards);
+
+        // After the table which fails to compile, the remaining tables are compiled sequentially.
+        TSUNIT_ASSERT(!compileXML(bad_xml, threads, sections, standards));
+        TSUNIT_ASSERT(sections == bad_ref_sections);
+        TSUNIT_ASSERT(standards == bad_ref_standards);
+    }
+}
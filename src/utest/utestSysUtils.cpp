@@ -38,6 +38,7 @@
 #include "tsMonotonic.h"
 #include "tsTime.h"
 #include "tsUID.h"
+#include "tsStartupProfile.h"
 #include "tsunit.h"
 
 #if defined(TS_WINDOWS)
@@ -83,6 +84,7 @@ public:
     void testAbsoluteFilePath();
     void testCleanupFilePath();
     void testRelativeFilePath();
+    void testStartupProfile();
 
     TSUNIT_TEST_BEGIN(SysUtilsTest);
     TSUNIT_TEST(testCurrentProcessId);
@@ -111,6 +113,7 @@ public:
     TSUNIT_TEST(testAbsoluteFilePath);
     TSUNIT_TEST(testCleanupFilePath);
     TSUNIT_TEST(testRelativeFilePath);
+    TSUNIT_TEST(testStartupProfile);
     TSUNIT_TEST_END();
 
 private:
@@ -892,3 +895,35 @@ void SysUtilsTest::testRelativeFilePath()
     TSUNIT_EQUAL(u"ab/cd/ef", ts::RelativeFilePath(u"/ab/cd/ef", u"/"));
 #endif
 }
+
+void SysUtilsTest::testStartupProfile()
+{
+    const bool enabled = ts::StartupProfile::IsEnabled();
+
+    // Nothing is recorded when disabled.
+    ts::StartupProfile::Enable(false);
+    ts::StartupProfile::Clear();
+    ts::StartupProfile::AddPhase(u"phase one", 1000);
+    TSUNIT_EQUAL(u"", ts::StartupProfile::ToText());
+
+    // Phases are cumulated in order of first occurence.
+    ts::StartupProfile::Enable(true);
+    TSUNIT_ASSERT(ts::StartupProfile::IsEnabled());
+    ts::StartupProfile::AddPhase(u"phase one", 1234000);
+    ts::StartupProfile::AddPhase(u"second phase", 27000);
+    ts::StartupProfile::AddPhase(u"phase one", 1000000);
+    const ts::UString text(ts::StartupProfile::ToText());
+    debug() << "SysUtilsTest::testStartupProfile:" << std::endl << text;
+    TSUNIT_EQUAL(u"  phase one .....     2,234 us (2 times)\n"
+                 u"  second phase ..        27 us\n", text);
+
+    {
+        ts::StartupProfile::Phase phase(u"measured phase");
+    }
+    TSUNIT_ASSERT(ts::StartupProfile::ToText().contain(u"measured phase"));
+    TSUNIT_ASSERT(ts::StartupProfile::SinceStartup() > 0);
+
+    // Restore previous state.
+    ts::StartupProfile::Clear();
+    ts::StartupProfile::Enable(enabled);
+}
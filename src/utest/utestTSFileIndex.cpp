@@ -0,0 +1,229 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for classes ts::TSFileIndex and ts::TSFileIndexer
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSFileIndexer.h"
+#include "tsTSPacket.h"
+#include "tsDuckContext.h"
+#include "tsNullReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSFileIndexTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testAdd();
+    void testSaveLoad();
+    void testSeek();
+    void testIndexer();
+
+    TSUNIT_TEST_BEGIN(TSFileIndexTest);
+    TSUNIT_TEST(testAdd);
+    TSUNIT_TEST(testSaveLoad);
+    TSUNIT_TEST(testSeek);
+    TSUNIT_TEST(testIndexer);
+    TSUNIT_TEST_END();
+
+private:
+    static ts::TSFileIndex::Entry NewEntry(ts::PacketCounter packet, ts::PID pid, uint8_t flags, uint64_t value);
+    static void BuildIndex(ts::TSFileIndex& index);
+};
+
+TSUNIT_REGISTER(TSFileIndexTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void TSFileIndexTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void TSFileIndexTest::afterTest()
+{
+}
+
+// Build an index entry.
+ts::TSFileIndex::Entry TSFileIndexTest::NewEntry(ts::PacketCounter packet, ts::PID pid, uint8_t flags, uint64_t value)
+{
+    ts::TSFileIndex::Entry e;
+    e.packet = packet;
+    e.pid = pid;
+    e.flags = flags;
+    if ((flags & ts::TSFileIndex::HAS_PCR) != 0) {
+        e.pcr = value;
+    }
+    if ((flags & ts::TSFileIndex::HAS_PTS) != 0) {
+        e.pts = value / ts::SYSTEM_CLOCK_SUBFACTOR;
+    }
+    return e;
+}
+
+// Build an index with one PCR per second on PID 100 (1000 packets per second)
+// and random access points in PID 200 at packets 1500 and 4200.
+void TSFileIndexTest::BuildIndex(ts::TSFileIndex& index)
+{
+    index.clear();
+    for (ts::PacketCounter i = 0; i <= 10; ++i) {
+        index.add(NewEntry(i * 1000, 100, ts::TSFileIndex::HAS_PCR, 1000000 + i * ts::SYSTEM_CLOCK_FREQ));
+        if (i == 2 || i == 5) {
+            // Random access points are added late.
+            index.add(NewEntry(i * 1000 - 800 + (i == 5 ? 500 : 0), 200, ts::TSFileIndex::HAS_PTS | ts::TSFileIndex::RANDOM_ACCESS, 2000000 + i * ts::SYSTEM_CLOCK_FREQ));
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+void TSFileIndexTest::testAdd()
+{
+    ts::TSFileIndex index;
+    BuildIndex(index);
+
+    const ts::TSFileIndex::EntryVector& entries(index.entries());
+    TSUNIT_EQUAL(13, entries.size());
+    for (size_t i = 1; i < entries.size(); ++i) {
+        TSUNIT_ASSERT(entries[i - 1].packet < entries[i].packet);
+    }
+    TSUNIT_EQUAL(1200, entries[2].packet);
+    TSUNIT_EQUAL(200, entries[2].pid);
+    TSUNIT_EQUAL(4700, entries[6].packet);
+
+    // Merge with an existing entry.
+    index.add(NewEntry(3000, 100, ts::TSFileIndex::HAS_PTS, 1234 * ts::SYSTEM_CLOCK_SUBFACTOR));
+    TSUNIT_EQUAL(13, entries.size());
+    TSUNIT_EQUAL(3000, entries[4].packet);
+    TSUNIT_EQUAL(ts::TSFileIndex::HAS_PCR | ts::TSFileIndex::HAS_PTS, entries[4].flags);
+    TSUNIT_EQUAL(1000000 + 3 * ts::SYSTEM_CLOCK_FREQ, entries[4].pcr);
+    TSUNIT_EQUAL(1234, entries[4].pts);
+}
+
+void TSFileIndexTest::testSaveLoad()
+{
+    ts::TSFileIndex index1;
+    BuildIndex(index1);
+
+    std::stringstream strm(std::ios::in | std::ios::out | std::ios::binary);
+    TSUNIT_ASSERT(index1.save(strm, CERR));
+    TSUNIT_EQUAL(16 + 13 * 26, strm.str().size());
+
+    ts::TSFileIndex index2;
+    TSUNIT_ASSERT(index2.load(strm, CERR));
+    TSUNIT_EQUAL(index1.entries().size(), index2.entries().size());
+    for (size_t i = 0; i < index1.entries().size(); ++i) {
+        const ts::TSFileIndex::Entry& e1(index1.entries()[i]);
+        const ts::TSFileIndex::Entry& e2(index2.entries()[i]);
+        TSUNIT_EQUAL(e1.packet, e2.packet);
+        TSUNIT_EQUAL(e1.pid, e2.pid);
+        TSUNIT_EQUAL(e1.flags, e2.flags);
+        TSUNIT_EQUAL(e1.pcr, e2.pcr);
+        TSUNIT_EQUAL(e1.pts, e2.pts);
+        TSUNIT_EQUAL(e1.dts, e2.dts);
+    }
+
+    // Truncated file.
+    std::stringstream strm2(strm.str().substr(0, 100), std::ios::in | std::ios::binary);
+    ts::TSFileIndex index3;
+    TSUNIT_ASSERT(!index3.load(strm2, NULLREP));
+    TSUNIT_ASSERT(index3.entries().empty());
+
+    // Not an index file.
+    std::stringstream strm3(std::string(100, 'x'), std::ios::in | std::ios::binary);
+    TSUNIT_ASSERT(!index3.load(strm3, NULLREP));
+}
+
+void TSFileIndexTest::testSeek()
+{
+    ts::TSFileIndex index;
+    BuildIndex(index);
+
+    TSUNIT_EQUAL(10000, index.duration());
+    TSUNIT_EQUAL(0, index.seekTime(0));
+    TSUNIT_EQUAL(0, index.seekTime(900));
+    TSUNIT_EQUAL(1000, index.seekTime(1000));
+    TSUNIT_EQUAL(1200, index.seekTime(2000));
+    TSUNIT_EQUAL(1200, index.seekTime(3500));
+    TSUNIT_EQUAL(3000, index.seekTime(3500, false));
+    TSUNIT_EQUAL(4700, index.seekTime(7000));
+    TSUNIT_EQUAL(10000, index.seekTime(50000, false));
+
+    TSUNIT_EQUAL(1200, index.nextRandomAccess(0));
+    TSUNIT_EQUAL(1200, index.nextRandomAccess(1200));
+    TSUNIT_EQUAL(4700, index.nextRandomAccess(1201));
+    TSUNIT_EQUAL(4700, index.nextRandomAccess(1300, 200));
+    TSUNIT_EQUAL(ts::NPOS, index.nextRandomAccess(0, 300));
+    TSUNIT_EQUAL(ts::NPOS, index.nextRandomAccess(4701));
+}
+
+void TSFileIndexTest::testIndexer()
+{
+    ts::DuckContext duck;
+    ts::TSFileIndex index;
+    ts::TSFileIndexer indexer(duck, index);
+
+    // One PCR every 100 packets, every 100 ms, starting 350 ms before the PCR wrap-around.
+    const uint64_t start = ts::PCR_SCALE - 350 * (ts::SYSTEM_CLOCK_FREQ / 1000);
+    ts::TSPacket pkt;
+    for (ts::PacketCounter i = 0; i < 10000; ++i) {
+        pkt.init(100, uint8_t(i));
+        if (i % 100 == 0) {
+            TSUNIT_ASSERT(pkt.setPCR((start + i * (ts::SYSTEM_CLOCK_FREQ / 1000)) % ts::PCR_SCALE, true));
+        }
+        indexer.feedPacket(pkt);
+    }
+    indexer.finish();
+
+    // One checkpoint per second plus the last PCR.
+    const ts::TSFileIndex::EntryVector& entries(index.entries());
+    TSUNIT_EQUAL(11, entries.size());
+    for (size_t i = 0; i < 10; ++i) {
+        TSUNIT_EQUAL(i * 1000, entries[i].packet);
+        TSUNIT_EQUAL(100, entries[i].pid);
+        TSUNIT_EQUAL(ts::TSFileIndex::HAS_PCR, entries[i].flags);
+    }
+    TSUNIT_EQUAL(9900, entries[10].packet);
+    TSUNIT_EQUAL(9900, index.duration());
+    TSUNIT_EQUAL(5000, index.seekTime(5500));
+}
@@ -46,9 +46,11 @@ public:
     virtual void afterTest() override;
 
     void testSize();
+    void testOutputTimeStamp();
 
     TSUNIT_TEST_BEGIN(TSPacketMetadataTest);
     TSUNIT_TEST(testSize);
+    TSUNIT_TEST(testOutputTimeStamp);
     TSUNIT_TEST_END();
 };
 
@@ -89,3 +91,28 @@ void TSPacketMetadataTest::testSize()
 
     TSUNIT_ASSUME(4 == sizeof(ts::TSPacketLabelSet));
 }
+
+void TSPacketMetadataTest::testOutputTimeStamp()
+{
+    ts::TSPacketMetadata mdata;
+    TSUNIT_ASSERT(!mdata.hasOutputTimeStamp());
+    TSUNIT_ASSERT(mdata.getOutputTimeStamp() < 0);
+
+    mdata.setOutputTimeStamp(123456789);
+    TSUNIT_ASSERT(mdata.hasOutputTimeStamp());
+    TSUNIT_EQUAL(123456789, mdata.getOutputTimeStamp());
+
+    // The output time stamp is local to the process and not serialized.
+    ts::ByteBlock bin;
+    mdata.serialize(bin);
+    ts::TSPacketMetadata mdata2;
+    mdata2.setOutputTimeStamp(1000);
+    TSUNIT_ASSERT(mdata2.deserialize(bin.data(), bin.size()));
+    TSUNIT_ASSERT(!mdata2.hasOutputTimeStamp());
+
+    mdata.clearOutputTimeStamp();
+    TSUNIT_ASSERT(!mdata.hasOutputTimeStamp());
+    mdata.setOutputTimeStamp(5);
+    mdata.reset();
+    TSUNIT_ASSERT(!mdata.hasOutputTimeStamp());
+}
@@ -41,6 +41,12 @@
 #include "tsTSDT.h"
 #include "tsEIT.h"
 #include "tsAIT.h"
+#include "tsPMTView.h"
+#include "tsSDTView.h"
+#include "tsNITView.h"
+#include "tsEITView.h"
+#include "tsBinaryTable.h"
+#include "tsServiceDescriptor.h"
 #include "tsCADescriptor.h"
 #include "tsAVCVideoDescriptor.h"
 #include "tsDVBAC3Descriptor.h"
@@ -51,6 +57,10 @@
 #include "tsTSPacket.h"
 #include "tsunit.h"
 
+#include "tables/psi_pmt_planete_sections.h"
+#include "tables/psi_sdt_r3_sections.h"
+#include "tables/psi_nit_tntv23_sections.h"
+
 
 //----------------------------------------------------------------------------
 // The test fixture
@@ -73,6 +83,10 @@ public:
     void testTOT();
     void testTSDT();
     void testCleanupPrivateDescriptors();
+    void testPMTView();
+    void testSDTView();
+    void testNITView();
+    void testEITView();
 
     TSUNIT_TEST_BEGIN(TableTest);
     TSUNIT_TEST(testAssignPMT);
@@ -86,6 +100,10 @@ public:
     TSUNIT_TEST(testTOT);
     TSUNIT_TEST(testTSDT);
     TSUNIT_TEST(testCleanupPrivateDescriptors);
+    TSUNIT_TEST(testPMTView);
+    TSUNIT_TEST(testSDTView);
+    TSUNIT_TEST(testNITView);
+    TSUNIT_TEST(testEITView);
     TSUNIT_TEST_END();
 };
 
@@ -368,3 +386,137 @@ void TableTest::testCleanupPrivateDescriptors()
     TSUNIT_EQUAL(1, dlist.count());
     TSUNIT_EQUAL(ts::DID_SERVICE, dlist[0]->tag());
 }
+
+void TableTest::testPMTView()
+{
+    ts::DuckContext duck;
+    ts::BinaryTable bin;
+    bin.addSection(new ts::Section(psi_pmt_planete_sections, sizeof(psi_pmt_planete_sections), ts::PID_NULL, ts::CRC32::CHECK));
+    TSUNIT_ASSERT(bin.isValid());
+
+    const ts::PMT pmt(duck, bin);
+    const ts::PMTView view(*bin.sectionAt(0));
+    TSUNIT_ASSERT(pmt.isValid());
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_EQUAL(pmt.service_id, view.serviceId());
+    TSUNIT_EQUAL(pmt.pcr_pid, view.pcrPID());
+    TSUNIT_EQUAL(pmt.descs.count(), view.descs().count());
+    TSUNIT_EQUAL(pmt.streams.size(), view.streams().count());
+
+    for (const auto& stream : view.streams()) {
+        const auto it = pmt.streams.find(stream.pid());
+        TSUNIT_ASSERT(it != pmt.streams.end());
+        TSUNIT_EQUAL(it->second.stream_type, stream.streamType());
+        TSUNIT_EQUAL(it->second.descs.count(), stream.descs().count());
+        size_t index = 0;
+        for (const auto& desc : stream.descs()) {
+            ts::Descriptor bindesc;
+            TSUNIT_ASSERT(desc.toDescriptor(bindesc));
+            TSUNIT_ASSERT(bindesc == *it->second.descs[index++]);
+        }
+    }
+
+    // A view on another table is invalid.
+    const ts::Section sdt_section(psi_sdt_r3_sections, sizeof(psi_sdt_r3_sections), ts::PID_NULL, ts::CRC32::CHECK);
+    TSUNIT_ASSERT(!ts::PMTView(sdt_section).isValid());
+}
+
+void TableTest::testSDTView()
+{
+    ts::DuckContext duck;
+    ts::BinaryTable bin;
+    bin.addSection(new ts::Section(psi_sdt_r3_sections, sizeof(psi_sdt_r3_sections), ts::PID_NULL, ts::CRC32::CHECK));
+    TSUNIT_ASSERT(bin.isValid());
+
+    const ts::SDT sdt(duck, bin);
+    const ts::SDTView view(*bin.sectionAt(0));
+    TSUNIT_ASSERT(sdt.isValid());
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_ASSERT(view.isActual());
+    TSUNIT_EQUAL(sdt.ts_id, view.tsId());
+    TSUNIT_EQUAL(sdt.onetw_id, view.onetwId());
+    TSUNIT_EQUAL(sdt.services.size(), view.services().count());
+
+    for (const auto& srv : view.services()) {
+        const auto it = sdt.services.find(srv.serviceId());
+        TSUNIT_ASSERT(it != sdt.services.end());
+        TSUNIT_EQUAL(it->second.running_status, srv.runningStatus());
+        TSUNIT_EQUAL(it->second.CA_controlled, srv.CAControlled());
+        TSUNIT_EQUAL(it->second.EITpf_present, srv.EITpfPresent());
+        TSUNIT_EQUAL(it->second.EITs_present, srv.EITsPresent());
+
+        ts::Service s1, s2;
+        it->second.updateService(duck, s1);
+        srv.updateService(duck, s2);
+        TSUNIT_EQUAL(s1.getName(), s2.getName());
+        TSUNIT_EQUAL(s1.getProvider(), s2.getProvider());
+        TSUNIT_EQUAL(s1.getTypeDVB(), s2.getTypeDVB());
+    }
+}
+
+void TableTest::testNITView()
+{
+    ts::DuckContext duck;
+    ts::BinaryTable bin;
+    bin.addSection(new ts::Section(psi_nit_tntv23_sections, sizeof(psi_nit_tntv23_sections), ts::PID_NULL, ts::CRC32::CHECK));
+    TSUNIT_ASSERT(bin.isValid());
+
+    const ts::NIT nit(duck, bin);
+    const ts::NITView view(*bin.sectionAt(0));
+    TSUNIT_ASSERT(nit.isValid());
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_EQUAL(ts::TID_NIT_ACT, view.tableId());
+    TSUNIT_EQUAL(nit.network_id, view.id());
+    TSUNIT_EQUAL(nit.descs.count(), view.descs().count());
+    TSUNIT_EQUAL(nit.transports.size(), view.transports().count());
+
+    for (const auto& ts : view.transports()) {
+        const auto it = nit.transports.find(ts::TransportStreamId(ts.tsId(), ts.onetwId()));
+        TSUNIT_ASSERT(it != nit.transports.end());
+        TSUNIT_EQUAL(it->second.descs.count(), ts.descs().count());
+    }
+}
+
+void TableTest::testEITView()
+{
+    ts::DuckContext duck;
+    ts::EIT eit(true, false, 0, 3, true, 0x1234, 0x5678, 0x9ABC);
+    eit.events[0].event_id = 0x0101;
+    eit.events[0].start_time = ts::Time(2023, 11, 22, 10, 30, 0);
+    eit.events[0].duration = 5400;
+    eit.events[0].running_status = 4;
+    eit.events[0].CA_controlled = true;
+    eit.events[0].descs.add(duck, ts::CADescriptor(0x0100, 0x0200));
+    eit.events[1].event_id = 0x0102;
+    eit.events[1].start_time = ts::Time(2023, 11, 22, 12, 0, 0);
+    eit.events[1].duration = 1800;
+
+    ts::BinaryTable bin;
+    TSUNIT_ASSERT(eit.serialize(duck, bin));
+    TSUNIT_EQUAL(1, bin.sectionCount());
+
+    const ts::EITView view(*bin.sectionAt(0));
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_EQUAL(ts::TID_EIT_S_ACT_MIN, view.tableId());
+    TSUNIT_EQUAL(0x1234, view.serviceId());
+    TSUNIT_EQUAL(0x5678, view.tsId());
+    TSUNIT_EQUAL(0x9ABC, view.onetwId());
+    TSUNIT_EQUAL(2, view.events().count());
+
+    auto it = view.events().begin();
+    TSUNIT_EQUAL(0x0101, it->eventId());
+    TSUNIT_ASSERT(it->startTime() == ts::Time(2023, 11, 22, 10, 30, 0));
+    TSUNIT_EQUAL(5400, it->duration());
+    TSUNIT_EQUAL(4, it->runningStatus());
+    TSUNIT_ASSERT(it->CAControlled());
+    TSUNIT_EQUAL(1, it->descs().count());
+    TSUNIT_EQUAL(ts::DID_CA, it->descs().begin()->tag());
+    ++it;
+    TSUNIT_EQUAL(0x0102, it->eventId());
+    TSUNIT_ASSERT(it->startTime() == ts::Time(2023, 11, 22, 12, 0, 0));
+    TSUNIT_EQUAL(1800, it->duration());
+    TSUNIT_ASSERT(!it->CAControlled());
+    TSUNIT_ASSERT(it->descs().empty());
+    ++it;
+    TSUNIT_ASSERT(it == view.events().end());
+}
@@ -0,0 +1,215 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for the serialization and deserialization of all tables.
+//  Also a benchmark of the table serialization, see TSUNIT_TABLES_ITERATIONS.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPSIRepository.h"
+#include "tsAbstractTable.h"
+#include "tsBinaryTable.h"
+#include "tsDuckContext.h"
+#include "tsMonotonic.h"
+#include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
+
+#include "tables/psi_bat_tvnum_sections.h"
+#include "tables/psi_cat_r3_sections.h"
+#include "tables/psi_nit_tntv23_sections.h"
+#include "tables/psi_pat_r4_sections.h"
+#include "tables/psi_pmt_hevc_sections.h"
+#include "tables/psi_pmt_planete_sections.h"
+#include "tables/psi_pmt_scte35_sections.h"
+#include "tables/psi_sdt_r3_sections.h"
+#include "tables/psi_tdt_tnt_sections.h"
+#include "tables/psi_tot_tnt_sections.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TableSerializationTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testAllTables();
+    void testRealTables();
+
+    TSUNIT_TEST_BEGIN(TableSerializationTest);
+    TSUNIT_TEST(testAllTables);
+    TSUNIT_TEST(testRealTables);
+    TSUNIT_TEST_END();
+
+private:
+    // Deserialize and reserialize a binary table, check that the result is identical.
+    // Return false if the table cannot be deserialized.
+    bool roundTrip(const ts::UString& name, ts::PSIRepository::TableFactory factory, const ts::BinaryTable& bin, utest::TSUnitBenchmark& bench);
+};
+
+TSUNIT_REGISTER(TableSerializationTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void TableSerializationTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void TableSerializationTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Deserialize and reserialize a binary table.
+//----------------------------------------------------------------------------
+
+bool TableSerializationTest::roundTrip(const ts::UString& name, ts::PSIRepository::TableFactory factory, const ts::BinaryTable& bin, utest::TSUnitBenchmark& bench)
+{
+    ts::DuckContext duck;
+    ts::AbstractTablePtr table(factory());
+    duck.addStandards(table->definingStandards());
+
+    ts::NanoSecond deserialize_time = 0;
+    ts::NanoSecond serialize_time = 0;
+    ts::BinaryTable bin2;
+
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        bench.start();
+        ts::Monotonic start(true);
+        table->deserialize(duck, bin);
+        ts::Monotonic middle(true);
+        bin2.clear();
+        table->serialize(duck, bin2);
+        ts::Monotonic end(true);
+        bench.stop();
+        deserialize_time += middle - start;
+        serialize_time += end - middle;
+        if (!table->isValid()) {
+            return false;
+        }
+    }
+
+    debug() << ts::UString::Format(u"TableSerializationTest: %-30s %2d sections, deserialize: %'9d ns, serialize: %'9d ns",
+                                   {name, bin.sectionCount(), deserialize_time / bench.iterations, serialize_time / bench.iterations})
+            << std::endl;
+
+    TSUNIT_ASSERT(bin2.isValid());
+    if (bin2 != bin) {
+        debug() << "TableSerializationTest: " << name << " has different binary content after deserialization" << std::endl;
+    }
+    TSUNIT_ASSERT(bin2 == bin);
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+// All registered tables, default content.
+void TableSerializationTest::testAllTables()
+{
+    utest::TSUnitBenchmark bench(u"TSUNIT_TABLES_ITERATIONS");
+
+    ts::UStringList names;
+    ts::PSIRepository::Instance()->getRegisteredTableNames(names);
+    TSUNIT_ASSERT(!names.empty());
+
+    size_t count = 0;
+    for (const auto& name : names) {
+        const ts::PSIRepository::TableFactory factory = ts::PSIRepository::Instance()->getTableFactory(name);
+        TSUNIT_ASSERT(factory != nullptr);
+
+        // Serialize a default instance of the table.
+        ts::DuckContext duck;
+        ts::AbstractTablePtr table(factory());
+        ts::BinaryTable bin;
+        if (table->serialize(duck, bin) && bin.isValid() && roundTrip(name, factory, bin, bench)) {
+            count++;
+        }
+    }
+    debug() << "TableSerializationTest: " << count << " tables out of " << names.size() << " serialized and deserialized" << std::endl;
+    bench.report(u"TableSerializationTest::testAllTables");
+}
+
+// Real tables from captured streams.
+namespace {
+    struct RealTable {
+        const char*    name;
+        ts::PID        pid;
+        const uint8_t* data;
+        size_t         size;
+    };
+    // Note: psi_bat_cplus_sections is not used because the captured section has a private_indicator
+    // set to zero, which is not preserved by the serialization (always set to one for long sections).
+    const RealTable real_tables[] = {
+        {"BAT", ts::PID_BAT, psi_bat_tvnum_sections, sizeof(psi_bat_tvnum_sections)},
+        {"CAT", ts::PID_CAT, psi_cat_r3_sections, sizeof(psi_cat_r3_sections)},
+        {"NIT", ts::PID_NIT, psi_nit_tntv23_sections, sizeof(psi_nit_tntv23_sections)},
+        {"PAT", ts::PID_PAT, psi_pat_r4_sections, sizeof(psi_pat_r4_sections)},
+        {"PMT", 0x01C9, psi_pmt_hevc_sections, sizeof(psi_pmt_hevc_sections)},
+        {"PMT", 0x0100, psi_pmt_planete_sections, sizeof(psi_pmt_planete_sections)},
+        {"PMT", 0x0100, psi_pmt_scte35_sections, sizeof(psi_pmt_scte35_sections)},
+        {"SDT", ts::PID_SDT, psi_sdt_r3_sections, sizeof(psi_sdt_r3_sections)},
+        {"TDT", ts::PID_TDT, psi_tdt_tnt_sections, sizeof(psi_tdt_tnt_sections)},
+        {"TOT", ts::PID_TOT, psi_tot_tnt_sections, sizeof(psi_tot_tnt_sections)},
+    };
+}
+
+void TableSerializationTest::testRealTables()
+{
+    utest::TSUnitBenchmark bench(u"TSUNIT_TABLES_ITERATIONS");
+
+    for (const auto& real : real_tables) {
+
+        // Split the binary data into sections.
+        ts::BinaryTable bin;
+        for (size_t index = 0; index + 3 <= real.size; ) {
+            const size_t size = 3 + (ts::GetUInt16(real.data + index + 1) & 0x0FFF);
+            TSUNIT_ASSERT(index + size <= real.size);
+            TSUNIT_ASSERT(bin.addSection(new ts::Section(real.data + index, size, real.pid, ts::CRC32::CHECK)));
+            index += size;
+        }
+        TSUNIT_ASSERT(bin.isValid());
+
+        const ts::PSIRepository::TableFactory factory = ts::PSIRepository::Instance()->getTableFactory(ts::UString::FromUTF8(real.name));
+        TSUNIT_ASSERT(factory != nullptr);
+        TSUNIT_ASSERT(roundTrip(ts::UString::FromUTF8(real.name), factory, bin, bench));
+    }
+    bench.report(u"TableSerializationTest::testRealTables");
+}
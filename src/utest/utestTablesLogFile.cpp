@@ -0,0 +1,262 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TablesLogFile
+//
+//----------------------------------------------------------------------------
+
+#include "tsTablesLogFile.h"
+#include "tsTablesLogger.h"
+#include "tsFileNameGenerator.h"
+#include "tsFileUtils.h"
+#include "tsNullReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TablesLogFileTest: public tsunit::Test
+{
+public:
+    TablesLogFileTest();
+
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testMessageSize();
+    void testLargeTable();
+    void testFile();
+
+    TSUNIT_TEST_BEGIN(TablesLogFileTest);
+    TSUNIT_TEST(testMessageSize);
+    TSUNIT_TEST(testLargeTable);
+    TSUNIT_TEST(testFile);
+    TSUNIT_TEST_END();
+
+private:
+    ts::UString     _tempFileName;
+    ts::UStringList _createdFiles;
+
+    void cleanup();
+    ts::Report& report();
+    static ts::BinaryTable* NewTable(ts::TID tid, uint16_t tid_ext, size_t section_count, size_t payload_size, ts::PID pid);
+};
+
+TSUNIT_REGISTER(TablesLogFileTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Constructor.
+TablesLogFileTest::TablesLogFileTest() :
+    _tempFileName(),
+    _createdFiles()
+{
+}
+
+// Test suite initialization method.
+void TablesLogFileTest::beforeTest()
+{
+    if (_tempFileName.empty()) {
+        _tempFileName = ts::TempFile(u".tlv");
+    }
+    cleanup();
+}
+
+// Test suite cleanup method.
+void TablesLogFileTest::afterTest()
+{
+    cleanup();
+}
+
+// Delete all files which were created by a test.
+void TablesLogFileTest::cleanup()
+{
+    _createdFiles.push_back(_tempFileName);
+    for (const auto& name : _createdFiles) {
+        ts::DeleteFile(name, NULLREP);
+        ts::DeleteFile(ts::TablesLogFile::IndexFileName(name), NULLREP);
+    }
+    _createdFiles.clear();
+}
+
+ts::Report& TablesLogFileTest::report()
+{
+    if (tsunit::Test::debugMode()) {
+        return CERR;
+    }
+    else {
+        return NULLREP;
+    }
+}
+
+// Build a table with sections of a given payload size.
+ts::BinaryTable* TablesLogFileTest::NewTable(ts::TID tid, uint16_t tid_ext, size_t section_count, size_t payload_size, ts::PID pid)
+{
+    ts::BinaryTable* table = new ts::BinaryTable;
+    for (size_t i = 0; i < section_count; ++i) {
+        ts::ByteBlock payload(payload_size, uint8_t(i));
+        table->addSection(new ts::Section(tid, true, tid_ext, 3, true, uint8_t(i), uint8_t(section_count - 1), payload.data(), payload.size(), pid));
+    }
+    return table;
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+void TablesLogFileTest::testMessageSize()
+{
+    ts::BinaryTable table;
+    table.addSection(new ts::Section(0x42, true, 0x1234, 7, true, 0, 0, "abcdefgh", 8, 0x0011));
+    TSUNIT_ASSERT(table.isValid());
+
+    std::vector<ts::ByteBlockPtr> messages;
+    ts::TablesLogFile::BuildMessages(table, ts::Time(2022, 5, 14, 10, 20, 30), messages);
+    TSUNIT_EQUAL(1, messages.size());
+    const ts::ByteBlock& msg(*messages[0]);
+
+    TSUNIT_EQUAL(msg.size(), ts::TablesLogFile::MessageSize(msg.data(), msg.size()));
+    TSUNIT_EQUAL(msg.size(), ts::TablesLogFile::MessageSize(msg.data(), msg.size() + 10));
+    TSUNIT_EQUAL(0, ts::TablesLogFile::MessageSize(msg.data(), msg.size() - 1));
+    TSUNIT_EQUAL(0, ts::TablesLogFile::MessageSize(msg.data(), 2));
+    TSUNIT_EQUAL(0, ts::TablesLogFile::MessageSize(nullptr, 100));
+
+    ts::SectionPtrVector sections;
+    ts::Time timestamp;
+    TSUNIT_ASSERT(ts::TablesLogger::AnalyzeUDPMessage(msg.data(), msg.size(), false, sections, timestamp));
+    TSUNIT_EQUAL(1, sections.size());
+    TSUNIT_ASSERT(*sections[0] == *table.sectionAt(0));
+    TSUNIT_EQUAL(0x0011, sections[0]->sourcePID());
+    TSUNIT_ASSERT(timestamp == ts::Time(2022, 5, 14, 10, 20, 30));
+}
+
+void TablesLogFileTest::testLargeTable()
+{
+    // 20 sections of 4000 bytes do not fit in the 16-bit length of one TLV message.
+    ts::BinaryTablePtr table(NewTable(0x50, 0x0100, 20, 4000, 0x0012));
+    TSUNIT_ASSERT(table->isValid());
+    TSUNIT_ASSERT(table->totalSize() > 0xFFFF);
+
+    std::vector<ts::ByteBlockPtr> messages;
+    ts::TablesLogFile::BuildMessages(*table, ts::Time::Epoch, messages);
+    TSUNIT_EQUAL(20, messages.size());
+
+    // Rebuild the table from the individual messages.
+    ts::BinaryTable table2;
+    for (const auto& msg : messages) {
+        TSUNIT_EQUAL(msg->size(), ts::TablesLogFile::MessageSize(msg->data(), msg->size()));
+        ts::SectionPtrVector sections;
+        ts::Time timestamp;
+        TSUNIT_ASSERT(ts::TablesLogger::AnalyzeUDPMessage(msg->data(), msg->size(), false, sections, timestamp));
+        TSUNIT_EQUAL(1, sections.size());
+        TSUNIT_EQUAL(0x0012, sections[0]->sourcePID());
+        TSUNIT_ASSERT(table2.addSection(sections[0]));
+    }
+    TSUNIT_ASSERT(table2.isValid());
+    TSUNIT_ASSERT(table2 == *table);
+}
+
+void TablesLogFileTest::testFile()
+{
+    // Log tables in rotating files with index, approximately 3 tables per file.
+    ts::BinaryTablePtr table1(NewTable(0x4A, 0x1001, 2, 1000, 0x0011));
+    ts::BinaryTablePtr table2(NewTable(0x4E, 0x2002, 1, 500, 0x0012));
+    const size_t max_size = 3 * (2 * 1000 + 100);
+    const size_t table_count = 10;
+    const ts::Time time0(2023, 1, 2, 3, 4, 5, 600);
+
+    ts::TablesLogFile log;
+    TSUNIT_ASSERT(log.open(_tempFileName, true, max_size, 0, report()));
+    for (size_t i = 0; i < table_count; ++i) {
+        TSUNIT_ASSERT(log.write(i % 2 == 0 ? *table1 : *table2, time0 + ts::MilliSecond(i * 1000), report()));
+    }
+    log.close(report());
+
+    // Read back all files, using the same name generator as the log file.
+    ts::FileNameGenerator names;
+    names.initCounter(_tempFileName);
+    size_t count = 0;
+    size_t files = 0;
+    while (count < table_count) {
+        const ts::UString name(names.newFileName());
+        _createdFiles.push_back(name);
+        TSUNIT_ASSERT(ts::FileExists(name));
+        TSUNIT_ASSERT(ts::GetFileSize(name) <= int64_t(max_size));
+        files++;
+
+        ts::TablesLogFile::IndexEntryVector index;
+        TSUNIT_ASSERT(ts::TablesLogFile::LoadIndex(ts::TablesLogFile::IndexFileName(name), index, report()));
+        TSUNIT_ASSERT(!index.empty());
+
+        std::ifstream strm(name.toUTF8().c_str(), std::ios::in | std::ios::binary);
+        ts::ByteBlock msg;
+        uint64_t offset = 0;
+        for (const auto& entry : index) {
+            const ts::BinaryTable& ref(count % 2 == 0 ? *table1 : *table2);
+            TSUNIT_EQUAL(offset, entry.offset);
+            TSUNIT_EQUAL(ref.sourcePID(), entry.pid);
+            TSUNIT_EQUAL(ref.tableId(), entry.tid);
+            TSUNIT_EQUAL(ref.tableIdExtension(), entry.tid_ext);
+            TSUNIT_EQUAL(ref.sectionCount(), entry.count);
+            TSUNIT_ASSERT(entry.timestamp == time0 + ts::MilliSecond(count * 1000));
+
+            TSUNIT_ASSERT(ts::TablesLogFile::ReadMessage(strm, msg, report()) > 0);
+            ts::SectionPtrVector sections;
+            ts::Time timestamp;
+            TSUNIT_ASSERT(ts::TablesLogger::AnalyzeUDPMessage(msg.data(), msg.size(), false, sections, timestamp));
+            TSUNIT_ASSERT(ts::BinaryTable(sections, false, false) == ref);
+            TSUNIT_ASSERT(timestamp == entry.timestamp);
+            offset += msg.size();
+            count++;
+        }
+        TSUNIT_EQUAL(0, ts::TablesLogFile::ReadMessage(strm, msg, report()));
+    }
+    TSUNIT_EQUAL(table_count, count);
+    TSUNIT_ASSERT(files > 1);
+    debug() << "TablesLogFileTest::testFile: " << count << " tables in " << files << " files" << std::endl;
+
+    // Truncated file: the incomplete message is an error.
+    const ts::UString name(_createdFiles.back());
+    ts::ByteBlock content;
+    TSUNIT_ASSERT(content.loadFromFile(name));
+    std::stringstream strm(std::string(reinterpret_cast<const char*>(content.data()), content.size() - 5), std::ios::in | std::ios::binary);
+    ts::ByteBlock msg;
+    size_t msg_count = 0;
+    while (ts::TablesLogFile::ReadMessage(strm, msg, NULLREP) > 0) {
+        msg_count++;
+    }
+    TSUNIT_ASSERT(msg_count < content.size());
+    TSUNIT_ASSERT(msg.empty());
+}
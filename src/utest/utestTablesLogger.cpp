@@ -0,0 +1,244 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TablesLogger
+//
+//----------------------------------------------------------------------------
+
+#include "tsTablesLogger.h"
+#include "tsTablesDisplay.h"
+#include "tsDuckContext.h"
+#include "tsReportBuffer.h"
+#include "tsArgs.h"
+#include "tsFileUtils.h"
+#include "tsNullReport.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TablesLoggerTest: public tsunit::Test
+{
+public:
+    TablesLoggerTest();
+
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testXMLJSON();
+    void testRewrite();
+
+    TSUNIT_TEST_BEGIN(TablesLoggerTest);
+    TSUNIT_TEST(testXMLJSON);
+    TSUNIT_TEST(testRewrite);
+    TSUNIT_TEST_END();
+
+private:
+    ts::UString _tempPrefix;
+
+    ts::UString tempName(const ts::UChar* suffix) const { return _tempPrefix + suffix; }
+    void cleanup();
+    static void BuildSections(ts::SectionPtrVector& sections);
+    static bool Run(const ts::UStringVector& options, ts::UString& log);
+    static ts::UString Load(const ts::UString& file_name);
+};
+
+TSUNIT_REGISTER(TablesLoggerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Constructor.
+TablesLoggerTest::TablesLoggerTest() :
+    _tempPrefix()
+{
+}
+
+// Test suite initialization method.
+void TablesLoggerTest::beforeTest()
+{
+    if (_tempPrefix.empty()) {
+        _tempPrefix = ts::TempFile(u"");
+    }
+    cleanup();
+}
+
+// Test suite cleanup method.
+void TablesLoggerTest::afterTest()
+{
+    cleanup();
+}
+
+void TablesLoggerTest::cleanup()
+{
+    for (const auto suffix : {u"1.xml", u"2.xml", u"3.json", u"4.json", u"5.bin"}) {
+        ts::DeleteFile(tempName(suffix), NULLREP);
+    }
+}
+
+// Build the sections of a PAT and a PMT.
+void TablesLoggerTest::BuildSections(ts::SectionPtrVector& sections)
+{
+    ts::DuckContext duck;
+    ts::PAT pat(3, true, 0x1234);
+    pat.pmts[1] = 0x0100;
+    pat.pmts[2] = 0x0200;
+    ts::PMT pmt(5, true, 1, 0x0101);
+    pmt.streams[0x0101].stream_type = ts::ST_AVC_VIDEO;
+    pmt.streams[0x0102].stream_type = ts::ST_MPEG2_AUDIO;
+
+    ts::BinaryTable bin1;
+    ts::BinaryTable bin2;
+    TSUNIT_ASSERT(pat.serialize(duck, bin1));
+    TSUNIT_ASSERT(pmt.serialize(duck, bin2));
+    bin1.setSourcePID(ts::PID_PAT);
+    bin2.setSourcePID(0x0100);
+
+    sections.clear();
+    sections.push_back(bin1.sectionAt(0));
+    sections.push_back(bin2.sectionAt(0));
+}
+
+// Run a tables logger with some options, return the log.
+bool TablesLoggerTest::Run(const ts::UStringVector& options, ts::UString& log)
+{
+    ts::ReportBuffer<> report;
+    ts::DuckContext duck(&report);
+    ts::TablesDisplay display(duck);
+    ts::TablesLogger logger(display);
+    ts::Args args(u"test", u"", ts::Args::NO_EXIT_ON_ERROR);
+    logger.defineArgs(args);
+    args.redirectReport(&report);
+
+    ts::SectionPtrVector sections;
+    BuildSections(sections);
+
+    const bool ok = args.analyze(u"test", options) && logger.loadArgs(duck, args) && logger.open();
+    if (ok) {
+        logger.feedSections(sections, ts::Time(2023, 4, 5, 6, 7, 8));
+        logger.close();
+    }
+    log = report.getMessages();
+    return ok && !logger.hasErrors();
+}
+
+// Load a text file.
+ts::UString TablesLoggerTest::Load(const ts::UString& file_name)
+{
+    ts::UStringList lines;
+    TSUNIT_ASSERT(ts::UString::Load(lines, file_name));
+    return ts::UString::Join(lines, u"\n");
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+// All XML and JSON outputs at the same time produce the same results as each output alone.
+void TablesLoggerTest::testXMLJSON()
+{
+    ts::UString log;
+    TSUNIT_ASSERT(Run({u"--xml-output", tempName(u"1.xml")}, log));
+    TSUNIT_ASSERT(log.empty());
+    TSUNIT_ASSERT(Run({u"--json-output", tempName(u"3.json")}, log));
+    TSUNIT_ASSERT(log.empty());
+
+    ts::UString xml_lines;
+    TSUNIT_ASSERT(Run({u"--log-xml-line"}, xml_lines));
+    ts::UString json_lines;
+    TSUNIT_ASSERT(Run({u"--log-json-line"}, json_lines));
+
+    TSUNIT_ASSERT(Run({u"--xml-output", tempName(u"2.xml"), u"--json-output", tempName(u"4.json"),
+                       u"--log-xml-line=XML: ", u"--log-json-line=JSON: ", u"--binary-output", tempName(u"5.bin")}, log));
+
+    const ts::UString xml(Load(tempName(u"1.xml")));
+    const ts::UString json(Load(tempName(u"3.json")));
+    debug() << "TablesLoggerTest::testXMLJSON: XML:" << std::endl << xml << std::endl
+            << "TablesLoggerTest::testXMLJSON: JSON:" << std::endl << json << std::endl
+            << "TablesLoggerTest::testXMLJSON: one-liners:" << std::endl << log << std::endl;
+
+    TSUNIT_ASSERT(xml.contain(u"<PAT version=\"3\""));
+    TSUNIT_ASSERT(xml.contain(u"<PMT version=\"5\""));
+    TSUNIT_EQUAL(xml, Load(tempName(u"2.xml")));
+    TSUNIT_ASSERT(json.contain(u"\"#name\": \"PAT\""));
+    TSUNIT_ASSERT(json.contain(u"\"#name\": \"PMT\""));
+    TSUNIT_EQUAL(json, Load(tempName(u"4.json")));
+    TSUNIT_ASSERT(ts::GetFileSize(tempName(u"5.bin")) > 0);
+
+    // One-liners are logged table by table, XML first.
+    ts::UStringVector xml_vec;
+    ts::UStringVector json_vec;
+    ts::UStringVector all_vec;
+    xml_lines.split(xml_vec, u'\n', true, true);
+    json_lines.split(json_vec, u'\n', true, true);
+    log.split(all_vec, u'\n', true, true);
+    TSUNIT_EQUAL(2, xml_vec.size());
+    TSUNIT_EQUAL(2, json_vec.size());
+    TSUNIT_EQUAL(4, all_vec.size());
+    for (size_t i = 0; i < 2; ++i) {
+        TSUNIT_ASSERT(xml_vec[i].contain(i == 0 ? u"<PAT" : u"<PMT"));
+        TSUNIT_EQUAL(u"XML: " + xml_vec[i], all_vec[2 * i]);
+        TSUNIT_EQUAL(u"JSON: " + json_vec[i], all_vec[2 * i + 1]);
+    }
+}
+
+// Rewritten XML and JSON files contain only the last table.
+void TablesLoggerTest::testRewrite()
+{
+    ts::UString log;
+    TSUNIT_ASSERT(Run({u"--xml-output", tempName(u"1.xml"), u"--rewrite-xml", u"--json-output", tempName(u"3.json"), u"--rewrite-json", u"--log-json-line"}, log));
+
+    const ts::UString xml(Load(tempName(u"1.xml")));
+    const ts::UString json(Load(tempName(u"3.json")));
+    debug() << "TablesLoggerTest::testRewrite: XML:" << std::endl << xml << std::endl
+            << "TablesLoggerTest::testRewrite: JSON:" << std::endl << json << std::endl;
+
+    TSUNIT_ASSERT(!xml.contain(u"<PAT"));
+    TSUNIT_ASSERT(xml.contain(u"<PMT version=\"5\""));
+
+    // Without --x2j-include-root, the JSON document is an array of tables.
+    TSUNIT_ASSERT(json.startWith(u"["));
+    TSUNIT_ASSERT(!json.contain(u"\"PAT\""));
+    TSUNIT_ASSERT(json.contain(u"\"#name\": \"PMT\""));
+    TSUNIT_ASSERT(!json.contain(u"\"tsduck\""));
+
+    // With --x2j-include-root, the JSON document is the "tsduck" root.
+    TSUNIT_ASSERT(Run({u"--json-output", tempName(u"3.json"), u"--rewrite-json", u"--x2j-include-root"}, log));
+    const ts::UString json2(Load(tempName(u"3.json")));
+    TSUNIT_ASSERT(json2.startWith(u"{"));
+    TSUNIT_ASSERT(json2.contain(u"\"#name\": \"tsduck\""));
+    TSUNIT_ASSERT(json2.contain(u"\"#name\": \"PMT\""));
+}
@@ -34,6 +34,10 @@
 #include "tsECMGSCS.h"
 #include "tsEMMGMUX.h"
 #include "tstlvMessageFactory.h"
+#include "tstlvConnection.h"
+#include "tsTCPServer.h"
+#include "tsSocketPoller.h"
+#include "tsIPUtils.h"
 #include "tsunit.h"
 
 
@@ -51,12 +55,14 @@ public:
     void testEMMG();
     void testECMGError();
     void testEMMGError();
+    void testBatchConnection();
 
     TSUNIT_TEST_BEGIN(TagLengthValueTest);
     TSUNIT_TEST(testECMG);
     TSUNIT_TEST(testEMMG);
     TSUNIT_TEST(testECMGError);
     TSUNIT_TEST(testEMMGError);
+    TSUNIT_TEST(testBatchConnection);
     TSUNIT_TEST_END();
 };
 
@@ -346,3 +352,101 @@ void TagLengthValueTest::testEMMGError()
     debug() << "TagLengthValueTest::testEMMGError: dump" << std::endl << str << std::endl;
     TSUNIT_EQUAL(refString, str);
 }
+
+void TagLengthValueTest::testBatchConnection()
+{
+    ts::IPInitialize();
+
+    // A TCP server on a dynamic port of the loopback interface.
+    ts::TCPServer server;
+    ts::IPv4SocketAddress addr(ts::IPv4Address::LocalHost, ts::IPv4SocketAddress::AnyPort);
+    TSUNIT_ASSERT(server.open(CERR));
+    TSUNIT_ASSERT(server.bind(addr, CERR));
+    TSUNIT_ASSERT(server.listen(5, CERR));
+    TSUNIT_ASSERT(server.getLocalAddress(addr, CERR));
+    addr.setAddress(ts::IPv4Address::LocalHost);
+
+    // Connect a client, accept it on the server side. Everything in the same thread.
+    ts::tlv::Connection<ts::NullMutex> client(ts::ecmgscs::Protocol::Instance());
+    ts::tlv::Connection<ts::NullMutex> session(ts::ecmgscs::Protocol::Instance());
+    ts::IPv4SocketAddress peer;
+    TSUNIT_ASSERT(client.open(CERR));
+    TSUNIT_ASSERT(client.connect(addr, CERR));
+    TSUNIT_ASSERT(server.accept(session, peer, CERR));
+
+    ts::SocketPoller poller;
+    TSUNIT_ASSERT(poller.add(session, &session, false, CERR));
+    TSUNIT_EQUAL(1, poller.size());
+
+    // Nothing to read yet.
+    std::vector<ts::SocketPoller::Event> events;
+    TSUNIT_ASSERT(poller.wait(events, 0, CERR));
+    TSUNIT_ASSERT(events.empty());
+
+    // Send three messages in one batch.
+    ts::ecmgscs::ChannelSetup setup;
+    setup.channel_id = 3;
+    setup.Super_CAS_id = 0x12345678;
+    ts::ecmgscs::StreamSetup stream;
+    stream.channel_id = 3;
+    stream.stream_id = 7;
+    stream.ECM_id = 9;
+    stream.nominal_CP_duration = 100;
+    ts::ecmgscs::CWProvision cw;
+    cw.channel_id = 3;
+    cw.stream_id = 7;
+    cw.CP_number = 21;
+    cw.CP_CW_combination.resize(2);
+    cw.CP_CW_combination[0].CP = 21;
+    cw.CP_CW_combination[0].CW = ts::ByteBlock(8, 0x55);
+    cw.CP_CW_combination[1].CP = 22;
+    cw.CP_CW_combination[1].CW = ts::ByteBlock(8, 0xAA);
+
+    ts::tlv::Logger logger(ts::Severity::Debug, &CERR);
+    TSUNIT_ASSERT(client.send({&setup, &stream, &cw}, logger));
+
+    // Receive all messages on the server side, without blocking on partial messages.
+    std::vector<ts::tlv::MessagePtr> all;
+    std::vector<ts::tlv::MessagePtr> msgs;
+    while (all.size() < 3) {
+        TSUNIT_ASSERT(poller.wait(events, 5000, CERR));
+        TSUNIT_EQUAL(1, events.size());
+        TSUNIT_ASSERT(events[0].context == &session);
+        TSUNIT_ASSERT(events[0].readable);
+        TSUNIT_ASSERT(session.receiveAvailable(msgs, logger));
+        all.insert(all.end(), msgs.begin(), msgs.end());
+    }
+    TSUNIT_EQUAL(3, all.size());
+
+    TSUNIT_EQUAL(ts::ecmgscs::Tags::channel_setup, all[0]->tag());
+    const ts::ecmgscs::ChannelSetup* m0 = dynamic_cast<const ts::ecmgscs::ChannelSetup*>(all[0].pointer());
+    TSUNIT_ASSERT(m0 != nullptr);
+    TSUNIT_EQUAL(0x12345678, m0->Super_CAS_id);
+
+    TSUNIT_EQUAL(ts::ecmgscs::Tags::stream_setup, all[1]->tag());
+    const ts::ecmgscs::StreamSetup* m1 = dynamic_cast<const ts::ecmgscs::StreamSetup*>(all[1].pointer());
+    TSUNIT_ASSERT(m1 != nullptr);
+    TSUNIT_EQUAL(7, m1->stream_id);
+    TSUNIT_EQUAL(9, m1->ECM_id);
+
+    TSUNIT_EQUAL(ts::ecmgscs::Tags::CW_provision, all[2]->tag());
+    const ts::ecmgscs::CWProvision* m2 = dynamic_cast<const ts::ecmgscs::CWProvision*>(all[2].pointer());
+    TSUNIT_ASSERT(m2 != nullptr);
+    TSUNIT_EQUAL(21, m2->CP_number);
+    TSUNIT_EQUAL(2, m2->CP_CW_combination.size());
+    TSUNIT_ASSERT(m2->CP_CW_combination[1].CW == ts::ByteBlock(8, 0xAA));
+
+    // Disconnection is reported as readable, then as a receive error.
+    client.disconnect(NULLREP);
+    client.close(NULLREP);
+    TSUNIT_ASSERT(poller.wait(events, 5000, CERR));
+    TSUNIT_EQUAL(1, events.size());
+    TSUNIT_ASSERT(events[0].readable);
+    TSUNIT_ASSERT(!session.receiveAvailable(msgs, logger));
+    TSUNIT_ASSERT(msgs.empty());
+
+    TSUNIT_ASSERT(poller.remove(session, CERR));
+    TSUNIT_EQUAL(0, poller.size());
+    session.close(NULLREP);
+    server.close(NULLREP);
+}
@@ -49,15 +49,22 @@ public:
     void testMinimum();
     void testMemory();
     void testFile();
+    void testFileSynchronous();
+    void testLargeFile();
+    void testWindow();
 
     TSUNIT_TEST_BEGIN(TimeShiftBufferTest);
     TSUNIT_TEST(testMinimum);
     TSUNIT_TEST(testMemory);
     TSUNIT_TEST(testFile);
+    TSUNIT_TEST(testFileSynchronous);
+    TSUNIT_TEST(testLargeFile);
+    TSUNIT_TEST(testWindow);
     TSUNIT_TEST_END();
 
 private:
-    void testCommon(uint8_t total, uint8_t memory);
+    void testCommon(uint8_t total, uint8_t memory, bool async = true);
+    void testWindowCommon(size_t total, size_t memory, size_t window);
 };
 
 TSUNIT_REGISTER(TimeShiftBufferTest);
@@ -82,10 +89,11 @@ void TimeShiftBufferTest::afterTest()
 // Unitary tests.
 //----------------------------------------------------------------------------
 
-void TimeShiftBufferTest::testCommon(uint8_t total, uint8_t memory)
+void TimeShiftBufferTest::testCommon(uint8_t total, uint8_t memory, bool async)
 {
     ts::TimeShiftBuffer buf(total);
     TSUNIT_ASSERT(buf.setMemoryPackets(memory));
+    TSUNIT_ASSERT(buf.setAsynchronousIO(async));
     TSUNIT_ASSERT(!buf.isOpen());
     TSUNIT_ASSERT(buf.open(CERR));
     TSUNIT_ASSERT(buf.isOpen());
@@ -166,3 +174,56 @@ void TimeShiftBufferTest::testFile()
 {
     testCommon(20, 4);
 }
+
+void TimeShiftBufferTest::testFileSynchronous()
+{
+    testCommon(20, 4, false);
+}
+
+void TimeShiftBufferTest::testLargeFile()
+{
+    testCommon(80, 40);
+    testCommon(80, 40, false);
+}
+
+void TimeShiftBufferTest::testWindowCommon(size_t total, size_t memory, size_t window)
+{
+    ts::TimeShiftBuffer buf(total);
+    TSUNIT_ASSERT(buf.setMemoryPackets(memory));
+    TSUNIT_ASSERT(buf.open(CERR));
+
+    // Shift 5 times the buffer size, by windows of packets. The packet index is stored in the payload.
+    const size_t end = 5 * total;
+    ts::TSPacketVector pkt(window);
+    ts::TSPacketMetadataVector mdata(window);
+    for (size_t index = 0; index < end; index += window) {
+        const size_t count = std::min(window, end - index);
+        for (size_t i = 0; i < count; ++i) {
+            pkt[i].init(100, 0, 0);
+            ts::PutUInt32(pkt[i].getPayload(), uint32_t(index + i));
+            mdata[i].reset();
+        }
+        TSUNIT_ASSERT(buf.shift(&pkt[0], &mdata[0], count, CERR));
+        for (size_t i = 0; i < count; ++i) {
+            if (index + i < total) {
+                TSUNIT_EQUAL(ts::PID_NULL, pkt[i].getPID());
+                TSUNIT_ASSERT(mdata[i].getInputStuffing());
+            }
+            else {
+                TSUNIT_EQUAL(100, pkt[i].getPID());
+                TSUNIT_EQUAL(index + i - total, ts::GetUInt32(pkt[i].getPayload()));
+                TSUNIT_ASSERT(!mdata[i].getInputStuffing());
+            }
+        }
+    }
+    TSUNIT_ASSERT(buf.close(CERR));
+}
+
+void TimeShiftBufferTest::testWindow()
+{
+    testWindowCommon(100, 200, 7);
+    testWindowCommon(1000, 64, 1);
+    testWindowCommon(1000, 64, 13);
+    testWindowCommon(1000, 64, 100);
+    testWindowCommon(1001, 500, 333);
+}
@@ -322,6 +322,13 @@ void UStringTest::testUTF()
     TSUNIT_EQUAL(s1, s2);
     TSUNIT_EQUAL(s1, s3);
     TSUNIT_EQUAL(s1, s4);
+
+    // Invalid sequences: leading bytes without the right continuation bytes and stray continuation bytes are ignored.
+    TSUNIT_EQUAL(u"a(b", ts::UString::FromUTF8("a\xC3(b"));
+    TSUNIT_EQUAL(u"az", ts::UString::FromUTF8("a\xE2\x82z"));
+    TSUNIT_EQUAL(u"aAb", ts::UString::FromUTF8("a\xF0\x9F\x98\x41\x80" "b"));
+    TSUNIT_EQUAL(u"ab", ts::UString::FromUTF8("a\xF4\x90\x80\x80" "b"));
+    TSUNIT_EQUAL(ts::UString(u"a") + ts::EURO_SIGN + u"b", ts::UString::FromUTF8("a\xE2\x82\xAC\xAC" "b"));
 }
 
 void UStringTest::testDiacritical()
@@ -34,6 +34,8 @@
 #include "tsxmlModelDocument.h"
 #include "tsxmlElement.h"
 #include "tsxmlDeclaration.h"
+#include "tsxmlNameTable.h"
+#include "tsTextParser.h"
 #include "tsSectionFile.h"
 #include "tsTextFormatter.h"
 #include "tsCerrReport.h"
@@ -67,6 +69,9 @@ public:
     void testSort();
     void testGetFloat();
     void testSetFloat();
+    void testParserUTF8();
+    void testInternedNames();
+    void testArena();
 
     TSUNIT_TEST_BEGIN(XMLTest);
     TSUNIT_TEST(testDocument);
@@ -82,6 +87,9 @@ public:
     TSUNIT_TEST(testSort);
     TSUNIT_TEST(testGetFloat);
     TSUNIT_TEST(testSetFloat);
+    TSUNIT_TEST(testParserUTF8);
+    TSUNIT_TEST(testInternedNames);
+    TSUNIT_TEST(testArena);
     TSUNIT_TEST_END();
 
 private:
@@ -778,3 +786,191 @@ void XMLTest::testSetFloat()
         u"</root>\n",
         doc.toString());
 }
+
+
+//----------------------------------------------------------------------------
+// Byte-level UTF-8 tokenizer.
+//----------------------------------------------------------------------------
+
+void XMLTest::testParserUTF8()
+{
+    // UTF-8 file with BOM, CR-LF, non-ASCII names, a character outside the BMP and a multi-line text.
+    const ts::ByteBlock fileData({
+        0xEF, 0xBB, 0xBF, '<', 'r', 'o', 'o', 't', '>', '\r', '\n',
+        ' ', '<', 0xC3, 0xA9, 'l', 0xC3, 0xA9, 'm', ' ', 'A', 'T', 'T', 'R', '=', '"', 0xE2, 0x82, 0xAC, '1', '"', '/', '>', '\r', '\n',
+        ' ', '<', 't', 'x', 't', '>', 'a', 0xF0, 0x9F, 0x98, 0x80, '\r', '\n',
+        'b', ' ', '&', 'l', 't', ';', '<', '/', 'T', 'X', 'T', '>', '\r', '\n',
+        ' ', '<', 'l', 'a', 's', 't', '/', '>', '\r', '\n',
+        '<', '/', 'r', 'o', 'o', 't', '>',
+    });
+    TSUNIT_ASSERT(fileData.saveToFile(_tempFileName, &report()));
+
+    ts::xml::Document doc(report());
+    TSUNIT_ASSERT(doc.load(_tempFileName, false));
+
+    const ts::xml::Element* root = doc.rootElement();
+    TSUNIT_ASSERT(root != nullptr);
+    TSUNIT_EQUAL(u"root", root->name());
+    TSUNIT_EQUAL(1, root->lineNumber());
+    TSUNIT_EQUAL(3, root->childrenCount());
+
+    const ts::xml::Element* elem = root->firstChildElement();
+    TSUNIT_ASSERT(elem != nullptr);
+    const ts::UString elemName({ts::LATIN_SMALL_LETTER_E_WITH_ACUTE, u'l', ts::LATIN_SMALL_LETTER_E_WITH_ACUTE, u'm'});
+    TSUNIT_EQUAL(elemName, elem->name());
+    TSUNIT_EQUAL(2, elem->lineNumber());
+    TSUNIT_EQUAL(u"ATTR", elem->attribute(u"attr").name());
+    TSUNIT_EQUAL(ts::UString({ts::EURO_SIGN, u'1'}), elem->attribute(u"attr").value());
+
+    elem = elem->nextSiblingElement();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"txt", elem->name());
+    TSUNIT_EQUAL(3, elem->lineNumber());
+    TSUNIT_EQUAL(ts::UString({u'a', 0xD83D, 0xDE00, u'\n', u'b', u' ', u'<'}), elem->text());
+
+    elem = elem->nextSiblingElement();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"last", elem->name());
+    TSUNIT_EQUAL(5, elem->lineNumber());
+
+    // Error reporting uses line numbers after multi-line texts.
+    ts::ReportBuffer<> rep;
+    ts::xml::Document bad(rep);
+    TSUNIT_ASSERT(!bad.parse(u"<a>\n<b>x\ny\nz</b>\n<c foo=bar/>\n</a>"));
+    TSUNIT_ASSERT(rep.getMessages().contain(u"line 5:"));
+
+    // Direct use of the tokenizer on UTF-16 input.
+    ts::TextParser parser(ts::UString({u' ', ts::GREEK_SMALL_LETTER_ALPHA, u'b', u'c', u'=', u'-', u'1', u'2', u'.', u'5', u'e', u'3', u' ', u'"', u'x', u'\\', u'"', u'y', u'"', u'\n', u'"', u'z'}), NULLREP);
+    ts::UString str;
+    TSUNIT_ASSERT(parser.skipWhiteSpace());
+    TSUNIT_ASSERT(parser.isAtXMLNameStart());
+    TSUNIT_ASSERT(parser.match(ts::UString({ts::GREEK_CAPITAL_LETTER_ALPHA, u'B'}), false, ts::CASE_INSENSITIVE));
+    TSUNIT_ASSERT(!parser.match(ts::UString({ts::GREEK_CAPITAL_LETTER_ALPHA, u'B'}), false, ts::CASE_SENSITIVE));
+    TSUNIT_ASSERT(parser.parseXMLName(str));
+    TSUNIT_EQUAL(ts::UString({ts::GREEK_SMALL_LETTER_ALPHA, u'b', u'c'}), str);
+    TSUNIT_ASSERT(parser.match(u"=", true));
+    TSUNIT_ASSERT(parser.isAtNumberStart());
+    TSUNIT_ASSERT(parser.parseNumericLiteral(str, false, true));
+    TSUNIT_EQUAL(u"-12.5e3", str);
+    TSUNIT_ASSERT(parser.skipWhiteSpace());
+    TSUNIT_ASSERT(parser.parseStringLiteral(str));
+    TSUNIT_EQUAL(u"\"x\\\"y\"", str);
+    TSUNIT_ASSERT(parser.eol());
+    TSUNIT_EQUAL(1, parser.lineNumber());
+    TSUNIT_ASSERT(parser.skipWhiteSpace());
+    TSUNIT_EQUAL(2, parser.lineNumber());
+    // A string literal does not span lines.
+    TSUNIT_ASSERT(!parser.parseStringLiteral(str));
+    TSUNIT_ASSERT(!parser.eof());
+    TSUNIT_ASSERT(parser.skipLine());
+    TSUNIT_ASSERT(parser.eof());
+}
+
+
+//----------------------------------------------------------------------------
+// Interned element and attribute names.
+//----------------------------------------------------------------------------
+
+void XMLTest::testInternedNames()
+{
+    ts::xml::Document doc(report());
+    TSUNIT_ASSERT(doc.parse(
+        u"<root>\n"
+        u"  <event event_id='1' Duration='00:10:00'/>\n"
+        u"  <event duration='00:20:00' event_id='2'/>\n"
+        u"</root>"));
+
+    const ts::xml::Element* root = doc.rootElement();
+    TSUNIT_ASSERT(root != nullptr);
+    const ts::xml::Element* e1 = root->firstChildElement();
+    TSUNIT_ASSERT(e1 != nullptr);
+    const ts::xml::Element* e2 = e1->nextSiblingElement();
+    TSUNIT_ASSERT(e2 != nullptr);
+
+    // Same names are stored once.
+    TSUNIT_EQUAL(u"event", e1->name());
+    TSUNIT_ASSERT(&e1->name() == &e2->name());
+    TSUNIT_ASSERT(&e1->attribute(u"event_id").name() == &e2->attribute(u"EVENT_ID").name());
+    TSUNIT_ASSERT(&e1->attribute(u"duration").name() != &e2->attribute(u"duration").name());
+    TSUNIT_EQUAL(u"Duration", e1->attribute(u"duration").name());
+    TSUNIT_EQUAL(u"duration", e2->attribute(u"DURATION").name());
+
+    // Parsing the same names again does not add names in the table.
+    const size_t count = ts::xml::NameTable::Instance()->size();
+    ts::xml::Document doc2(report());
+    TSUNIT_ASSERT(doc2.parse(u"<root><event event_id='3' duration='00:30:00'/></root>"));
+    TSUNIT_EQUAL(count, ts::xml::NameTable::Instance()->size());
+
+    // Attributes are still sorted by case-insensitive name and case-insensitive on lookup.
+    ts::UStringList names;
+    e1->getAttributesNames(names);
+    TSUNIT_EQUAL(u"Duration, event_id", ts::UString::Join(names));
+    std::map<ts::UString, ts::UString> attrs;
+    e1->getAttributes(attrs);
+    TSUNIT_EQUAL(2, attrs.size());
+    TSUNIT_EQUAL(u"00:10:00", attrs[u"duration"]);
+
+    // Updating an attribute with another case keeps a single attribute.
+    ts::xml::Element* e3 = doc2.rootElement()->firstChildElement();
+    TSUNIT_ASSERT(e3 != nullptr);
+    e3->setAttribute(u"DURATION", u"01:00:00");
+    e3->getAttributesNames(names);
+    TSUNIT_EQUAL(u"DURATION, event_id", ts::UString::Join(names));
+    TSUNIT_EQUAL(u"01:00:00", e3->attribute(u"Duration").value());
+    e3->deleteAttribute(u"duration");
+    TSUNIT_ASSERT(!e3->hasAttribute(u"Duration"));
+    TSUNIT_ASSERT(e3->hasAttribute(u"event_id"));
+
+    // Case-sensitive attributes.
+    ts::xml::Element cs(NULLREP, 0, ts::CASE_SENSITIVE);
+    cs.setAttribute(u"foo", u"1");
+    cs.setAttribute(u"Foo", u"2");
+    TSUNIT_ASSERT(!cs.hasAttribute(u"FOO"));
+    TSUNIT_EQUAL(u"1", cs.attribute(u"foo").value());
+    TSUNIT_EQUAL(u"2", cs.attribute(u"Foo").value());
+}
+
+
+//----------------------------------------------------------------------------
+// Nodes of a parsed document are allocated in its arena.
+//----------------------------------------------------------------------------
+
+void XMLTest::testArena()
+{
+    ts::xml::Document* doc1 = new ts::xml::Document(report());
+    TSUNIT_ASSERT(doc1->parse(u"<root><a x='1'><b>text</b></a><c y='2'/></root>"));
+
+    // Move an element of the parsed document into a document which is built programmatically.
+    ts::xml::Document doc2(report());
+    ts::xml::Element* root2 = doc2.initialize(u"other");
+    TSUNIT_ASSERT(root2 != nullptr);
+    ts::xml::Element* a = doc1->rootElement()->findFirstChild(u"a");
+    TSUNIT_ASSERT(a != nullptr);
+    a->reparent(root2);
+
+    // Delete the parsed document, the moved nodes remain valid.
+    delete doc1;
+    TSUNIT_EQUAL(u"a", a->name());
+    TSUNIT_EQUAL(u"1", a->attribute(u"x").value());
+    TSUNIT_EQUAL(u"text", a->findFirstChild(u"b")->text());
+
+    // Nodes created programmatically and cloned nodes are mixed with nodes from the arena.
+    a->addElement(u"d")->setAttribute(u"z", u"3");
+    ts::xml::Node* copy = a->clone();
+    a->setAttribute(u"w", u"4");
+    ts::TextFormatter out(report());
+    root2->print(out.setString());
+    TSUNIT_EQUAL(
+        u"<other>\n"
+        u"  <a x=\"1\" w=\"4\">\n"
+        u"    <b>text</b>\n"
+        u"    <d z=\"3\"/>\n"
+        u"  </a>\n"
+        u"</other>",
+        out.toString());
+    delete copy;
+
+    // Deleting the last nodes of the first arena.
+    delete a;
+    TSUNIT_EQUAL(0, root2->childrenCount());
+}